@@ -42,6 +42,10 @@ namespace components {
 ///
 /// @snippet samples/clickhouse_service/tests/conftest.py  Clickhouse service sample - secdist
 ///
+/// Secure connections of a host resume the TLS sessions of the previous
+/// connections to the host (see engine::io::TlsSessionCache), the handshake
+/// counters are reported in the `tls-sessions` statistics of the host.
+///
 /// ## Static options:
 /// Name                  | Description                                      | Default value
 /// --------------------- | ------------------------------------------------ | ---------------
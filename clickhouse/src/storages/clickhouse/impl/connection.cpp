@@ -76,9 +76,11 @@ class Connection::ConnectionBrokenGuard final {
 Connection::Connection(clients::dns::Resolver& resolver,
                        const EndpointSettings& endpoint,
                        const AuthSettings& auth,
-                       const ConnectionSettings& connection_settings)
+                       const ConnectionSettings& connection_settings,
+                       engine::io::TlsSessionCache* tls_session_cache)
     : client_{NativeClientFactory::Create(resolver, endpoint, auth,
-                                          connection_settings)} {}
+                                          connection_settings,
+                                          tls_session_cache)} {}
 
 ExecutionResult Connection::Execute(OptionalCommandControl optional_cc,
                                     const Query& query) {
@@ -24,7 +24,8 @@ class InsertionRequest;
 class Connection final {
  public:
   Connection(clients::dns::Resolver&, const EndpointSettings&,
-             const AuthSettings&, const ConnectionSettings&);
+             const AuthSettings&, const ConnectionSettings&,
+             engine::io::TlsSessionCache* tls_session_cache);
 
   ExecutionResult Execute(OptionalCommandControl, const Query&);
 
@@ -10,6 +10,7 @@
 
 #include <userver/clients/dns/resolver.hpp>
 #include <userver/engine/io/socket.hpp>
+#include <userver/engine/io/tls_session_cache.hpp>
 #include <userver/engine/io/tls_wrapper.hpp>
 #include <userver/engine/sleep.hpp>
 #include <userver/tracing/span.hpp>
@@ -113,10 +114,12 @@ class ClickhouseSocketAdapter : public clickhouse_cpp::SocketBase {
 class ClickhouseTlsSocketAdapter : public clickhouse_cpp::SocketBase {
  public:
   ClickhouseTlsSocketAdapter(engine::io::Sockaddr addr,
-                             engine::Deadline& deadline)
+                             engine::Deadline& deadline,
+                             engine::io::TlsSessionCache* session_cache)
       : deadline_{deadline},
         tls_socket_{engine::io::TlsWrapper::StartTlsClient(
-            CreateSocket(addr, deadline_), {}, deadline_)} {}
+            CreateSocket(addr, deadline_), {}, deadline_,
+            MakeHandshakeOptions(session_cache))} {}
 
   std::unique_ptr<clickhouse_cpp::InputStream> makeInputStream()
       const override {
@@ -131,6 +134,13 @@ class ClickhouseTlsSocketAdapter : public clickhouse_cpp::SocketBase {
   }
 
  private:
+  static engine::io::TlsHandshakeOptions MakeHandshakeOptions(
+      engine::io::TlsSessionCache* session_cache) {
+    engine::io::TlsHandshakeOptions options;
+    options.session_cache = session_cache;
+    return options;
+  }
+
   engine::Deadline& deadline_;
   mutable TlsSocket tls_socket_;
 };
@@ -138,9 +148,11 @@ class ClickhouseTlsSocketAdapter : public clickhouse_cpp::SocketBase {
 class ClickhouseSocketFactory final : public clickhouse_cpp::SocketFactory {
  public:
   ClickhouseSocketFactory(clients::dns::Resolver& resolver, ConnectionMode mode,
+                          engine::io::TlsSessionCache* tls_session_cache,
                           engine::Deadline& operations_deadline)
       : resolver_{resolver},
         mode_{mode},
+        tls_session_cache_{tls_session_cache},
         operations_deadline_{operations_deadline} {}
 
   ~ClickhouseSocketFactory() override = default;
@@ -159,7 +171,7 @@ class ClickhouseSocketFactory final : public clickhouse_cpp::SocketFactory {
                 current_addr, operations_deadline_);
           case ConnectionMode::kSecure:
             return std::make_unique<ClickhouseTlsSocketAdapter>(
-                current_addr, operations_deadline_);
+                current_addr, operations_deadline_, tls_session_cache_);
         }
       } catch (const std::exception&) {
       }
@@ -176,6 +188,7 @@ class ClickhouseSocketFactory final : public clickhouse_cpp::SocketFactory {
  private:
   clients::dns::Resolver& resolver_;
   ConnectionMode mode_;
+  engine::io::TlsSessionCache* tls_session_cache_;
 
   engine::Deadline& operations_deadline_;
 };
@@ -194,11 +207,12 @@ clickhouse_cpp::CompressionMethod GetCompressionMethod(
 
 NativeClientWrapper::NativeClientWrapper(
     clients::dns::Resolver& resolver,
-    const clickhouse_cpp::ClientOptions& options, ConnectionMode mode) {
+    const clickhouse_cpp::ClientOptions& options, ConnectionMode mode,
+    engine::io::TlsSessionCache* tls_session_cache) {
   SetDeadline(engine::Deadline::FromDuration(kConnectTimeout));
 
   auto socket_factory = std::make_unique<ClickhouseSocketFactory>(
-      resolver, mode, operations_deadline_);
+      resolver, mode, tls_session_cache, operations_deadline_);
   native_client_ = std::make_unique<clickhouse_cpp::Client>(
       options, std::move(socket_factory));
 }
@@ -229,7 +243,8 @@ void NativeClientWrapper::SetDeadline(engine::Deadline deadline) {
 
 NativeClientWrapper NativeClientFactory::Create(
     clients::dns::Resolver& resolver, const EndpointSettings& endpoint,
-    const AuthSettings& auth, const ConnectionSettings& connection_settings) {
+    const AuthSettings& auth, const ConnectionSettings& connection_settings,
+    engine::io::TlsSessionCache* tls_session_cache) {
   const auto options = clickhouse_cpp::ClientOptions{}
                            .SetHost(endpoint.host)
                            .SetPort(endpoint.port)
@@ -241,7 +256,8 @@ NativeClientWrapper NativeClientFactory::Create(
 
   tracing::Span span{scopes::kConnect};
   return NativeClientWrapper{resolver, options,
-                             connection_settings.connection_mode};
+                             connection_settings.connection_mode,
+                             tls_session_cache};
 }
 
 }  // namespace storages::clickhouse::impl
@@ -5,6 +5,7 @@
 
 #include <userver/clients/dns/resolver_fwd.hpp>
 #include <userver/engine/deadline.hpp>
+#include <userver/engine/io/tls_session_cache.hpp>
 
 #include <storages/clickhouse/impl/settings.hpp>
 #include <storages/clickhouse/impl/wrap_clickhouse_cpp.hpp>
@@ -24,7 +25,8 @@ class NativeClientWrapper final {
  public:
   NativeClientWrapper(clients::dns::Resolver&,
                       const clickhouse_cpp::ClientOptions&,
-                      ConnectionSettings::ConnectionMode);
+                      ConnectionSettings::ConnectionMode,
+                      engine::io::TlsSessionCache* tls_session_cache);
   ~NativeClientWrapper();
 
   void Execute(const clickhouse_cpp::Query& query, engine::Deadline deadline);
@@ -42,10 +44,11 @@ class NativeClientWrapper final {
 
 class NativeClientFactory final {
  public:
-  static NativeClientWrapper Create(clients::dns::Resolver&,
-                                    const EndpointSettings&,
-                                    const AuthSettings&,
-                                    const ConnectionSettings&);
+  /// @param tls_session_cache resumes the sessions of the secure connections,
+  /// may be null
+  static NativeClientWrapper Create(
+      clients::dns::Resolver&, const EndpointSettings&, const AuthSettings&,
+      const ConnectionSettings&, engine::io::TlsSessionCache* tls_session_cache);
 };
 
 }  // namespace storages::clickhouse::impl
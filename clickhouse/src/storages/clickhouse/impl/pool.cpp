@@ -58,8 +58,12 @@ void Pool::Insert(OptionalCommandControl optional_cc,
 formats::json::Value Pool::GetStatistics() const {
   auto builder = formats::json::ValueBuilder{formats::json::Type::kObject};
 
-  builder[impl_->GetHostName()] =
-      stats::PoolStatisticsToJson(impl_->GetStatistics());
+  formats::json::ValueBuilder pool_stats{
+      stats::PoolStatisticsToJson(impl_->GetStatistics())};
+  if (const auto* tls_session_cache = impl_->GetTlsSessionCache()) {
+    pool_stats["tls-sessions"] = tls_session_cache->GetStatistics();
+  }
+  builder[impl_->GetHostName()] = pool_stats.ExtractValue();
   return builder.ExtractValue();
 }
 
@@ -62,6 +62,11 @@ PoolImpl::PoolImpl(clients::dns::Resolver& resolver, PoolSettings&& settings)
       given_away_semaphore_{pool_settings_.max_pool_size},
       connecting_semaphore_{kMaxSimultaneouslyConnectingClients},
       queue_{pool_settings_.max_pool_size} {
+  if (pool_settings_.connection_settings.connection_mode ==
+      ConnectionSettings::ConnectionMode::kSecure) {
+    tls_session_cache_.emplace();
+  }
+
   std::vector<engine::TaskWithResult<void>> tasks;
   tasks.reserve(pool_settings_.initial_pool_size);
   for (size_t i = 0; i < pool_settings_.initial_pool_size; ++i) {
@@ -112,6 +117,11 @@ const std::string& PoolImpl::GetHostName() const {
   return pool_settings_.endpoint_settings.host;
 }
 
+const engine::io::TlsSessionCache* PoolImpl::GetTlsSessionCache()
+    const noexcept {
+  return tls_session_cache_ ? &*tls_session_cache_ : nullptr;
+}
+
 stats::StatementTimer PoolImpl::GetExecuteTimer() {
   return stats::StatementTimer{statistics_.queries};
 }
@@ -124,7 +134,8 @@ Connection* PoolImpl::Create() {
   try {
     auto conn = std::make_unique<Connection>(
         resolver_, pool_settings_.endpoint_settings,
-        pool_settings_.auth_settings, pool_settings_.connection_settings);
+        pool_settings_.auth_settings, pool_settings_.connection_settings,
+        tls_session_cache_ ? &*tls_session_cache_ : nullptr);
 
     auto& stats = GetStatistics().connections;
     ++stats.created;
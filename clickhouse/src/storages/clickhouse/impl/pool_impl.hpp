@@ -3,10 +3,12 @@
 #include <atomic>
 #include <chrono>
 #include <memory>
+#include <optional>
 
 #include <boost/lockfree/queue.hpp>
 
 #include <userver/clients/dns/resolver_fwd.hpp>
+#include <userver/engine/io/tls_session_cache.hpp>
 #include <userver/engine/semaphore.hpp>
 #include <userver/utils/datetime/steady_coarse_clock.hpp>
 #include <userver/utils/periodic_task.hpp>
@@ -51,6 +53,9 @@ class PoolImpl final : public std::enable_shared_from_this<PoolImpl> {
 
   stats::PoolStatistics& GetStatistics() noexcept;
 
+  /// Returns null for the non-secure connections
+  const engine::io::TlsSessionCache* GetTlsSessionCache() const noexcept;
+
   const std::string& GetHostName() const;
 
   void StartMaintenance();
@@ -76,6 +81,9 @@ class PoolImpl final : public std::enable_shared_from_this<PoolImpl> {
   clients::dns::Resolver& resolver_;
   const PoolSettings pool_settings_;
 
+  // resumes the TLS sessions of the reconnects, set for the secure connections
+  std::optional<engine::io::TlsSessionCache> tls_session_cache_;
+
   engine::Semaphore given_away_semaphore_;
   engine::Semaphore connecting_semaphore_;
 
@@ -56,6 +56,9 @@ UTEST(Metrics, Basic) {
 
   EXPECT_EQ(insert_stats["total"].As<uint64_t>(), 2);
   EXPECT_EQ(insert_stats["error"].As<uint64_t>(), 1);
+
+  // no TLS session resumption for the non-secure connections
+  EXPECT_TRUE(stats["tls-sessions"].IsMissing());
 }
 
 UTEST(Metrics, ActiveConnections) {
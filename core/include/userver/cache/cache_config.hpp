@@ -1,6 +1,7 @@
 #pragma once
 
 #include <chrono>
+#include <cstddef>
 #include <optional>
 #include <stdexcept>
 #include <string>
@@ -60,6 +61,7 @@ struct Config final {
   std::optional<std::string> task_processor_name;
   std::chrono::milliseconds cleanup_interval;
   bool is_strong_period;
+  std::size_t full_update_shards_concurrency;
 
   FirstUpdateMode first_update_mode;
   FirstUpdateType first_update_type;
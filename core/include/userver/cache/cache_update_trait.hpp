@@ -3,23 +3,23 @@
 /// @file userver/cache/cache_update_trait.hpp
 /// @brief @copybrief cache::CacheUpdateTrait
 
+#include <cstddef>
+#include <functional>
+#include <memory>
 #include <string>
+#include <vector>
 
 #include <userver/cache/cache_statistics.hpp>
 #include <userver/cache/update_type.hpp>
 #include <userver/components/component_fwd.hpp>
 #include <userver/dump/fwd.hpp>
 #include <userver/engine/task/task_processor_fwd.hpp>
+#include <userver/rcu/fwd.hpp>
 #include <userver/utils/fast_pimpl.hpp>
 #include <userver/utils/flags.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
-namespace rcu {
-template <typename T>
-class ReadablePtr;
-}  // namespace rcu
-
 namespace cache {
 
 struct CacheDependencies;
@@ -73,6 +73,30 @@ class CacheUpdateTrait {
   /// that the cached data has been modified
   void OnCacheModified();
 
+  /// @cond
+  // For internal use only. Runs `publish` atomically with recording the
+  // changes for the delta dumps, an empty `write_changes` means that the
+  // changes are unknown.
+  void PublishWithDumpChanges(
+      const std::function<void()>& publish,
+      const std::function<void(dump::Writer&)>& write_changes);
+
+  // For internal use only. Runs `snapshot` atomically with forgetting the
+  // changes already contained in the snapshot.
+  void SnapshotForFullDump(const std::function<void()>& snapshot) const;
+  /// @endcond
+
+  /// @brief Override to split full updates into key range shards that are
+  /// loaded concurrently, see `CachingComponentBase::LoadFullUpdateShard`
+  /// @returns the number of shards, 1 disables the sharded full updates
+  virtual std::size_t GetFullUpdateShardsCount() const;
+
+  /// @brief Calls `load_shard` for each shard in [0, shards_count) on the cache
+  /// task processor, `full-update-shards-concurrency` shards at a time
+  /// @throws If `load_shard` throws, the rest of the shards are not loaded
+  void RunFullUpdateShards(std::size_t shards_count,
+                           const std::function<void(std::size_t)>& load_shard);
+
   /// @cond
   // For internal use only
   rcu::ReadablePtr<Config> GetConfig() const;
@@ -94,12 +118,21 @@ class CacheUpdateTrait {
  private:
   virtual void Cleanup() = 0;
 
+  /// Called instead of `Update(UpdateType::kFull, ...)` if
+  /// `GetFullUpdateShardsCount()` is greater than 1
+  virtual void UpdateFullSharded(std::size_t shards_count,
+                                 UpdateStatisticsScope& stats_scope);
+
   virtual void GetAndWrite(dump::Writer& writer) const;
 
   virtual void ReadAndSet(dump::Reader& reader);
 
+  virtual void ReadAndSetWithDeltas(
+      dump::Reader& reader,
+      const std::vector<std::unique_ptr<dump::Reader>>& deltas);
+
   class Impl;
-  utils::FastPimpl<Impl, 2528, 16> impl_;
+  utils::FastPimpl<Impl, 2688, 16> impl_;
 };
 
 }  // namespace cache
@@ -3,21 +3,29 @@
 /// @file userver/cache/caching_component_base.hpp
 /// @brief @copybrief components::CachingComponentBase
 
+#include <cstddef>
+#include <functional>
+#include <iterator>
 #include <memory>
+#include <stdexcept>
 #include <string>
+#include <type_traits>
 #include <utility>
+#include <vector>
 
 #include <userver/cache/cache_update_trait.hpp>
 #include <userver/cache/exceptions.hpp>
 #include <userver/components/component_fwd.hpp>
 #include <userver/components/loggable_component_base.hpp>
 #include <userver/concurrent/async_event_channel.hpp>
+#include <userver/dump/common.hpp>
 #include <userver/dump/helpers.hpp>
 #include <userver/dump/meta.hpp>
 #include <userver/dump/operations.hpp>
 #include <userver/engine/async.hpp>
 #include <userver/rcu/rcu.hpp>
 #include <userver/utils/impl/wait_token_storage.hpp>
+#include <userver/utils/meta.hpp>
 #include <userver/utils/shared_readable_ptr.hpp>
 #include <userver/yaml_config/schema.hpp>
 
@@ -55,6 +63,7 @@ namespace components {
 /// config-settings | enables dynamic reconfiguration with CacheConfigSet | true
 /// additional-cleanup-interval | how often to run background RCU garbage collector | 10 seconds
 /// is-strong-period | whether to include Update execution time in update-interval | false
+/// full-update-shards-concurrency | how many shards of a sharded full update are loaded concurrently | 4
 /// testsuite-force-periodic-update | override testsuite-periodic-update-enabled in TestsuiteSupport component config | --
 ///
 /// ### Update types
@@ -76,6 +85,27 @@ namespace components {
 /// If both `update-interval` and `full-update-interval` are present,
 /// `full-and-incremental` types is assumed. Otherwise `only-full` is used.
 ///
+/// ### Sharded full updates
+///  Full updates of big caches may be split into key range shards that are
+///  loaded concurrently on the cache `task-processor`: override
+///  CacheUpdateTrait::GetFullUpdateShardsCount and LoadFullUpdateShard.
+///  The loaded shards are merged with MergeFullUpdateShard and Set as a whole,
+///  CacheUpdateTrait::Update is then only called for incremental updates.
+///
+/// Big caches with incremental updates may use cache::PersistentHashMap as
+/// the data type, so that an update does not copy the whole cache.
+///
+/// ### Delta dumps
+///  If `dump.max-delta-count` is set, an incremental update may publish its
+///  data with SetWithChanges together with the changes it has applied. Then
+///  the next dump only contains the changes published since the previous
+///  dump, until the chain of deltas is compacted into a new full dump.
+///  ApplyDumpChanges must be overridden to apply the changes on top of the
+///  data read from the full dump by ReadContentsForDeltas. The changes are
+///  kept in memory until the next dump is written. A Set call without changes
+///  or more than 64MiB of changes since the last dump make the next dump
+///  a full one.
+///
 /// @see `dump::Dumper` for more info on persistent cache dumps and
 /// corresponding config options.
 
@@ -116,6 +146,15 @@ class CachingComponentBase : public LoggableComponentBase,
   void Set(std::unique_ptr<const T> value_ptr);
   void Set(T&& value);
 
+  /// @brief Sets the data of an incremental update along with the dumpable
+  /// `changes` applied by it, see "Delta dumps".
+  template <typename Changes>
+  void SetWithChanges(std::unique_ptr<const T> value_ptr,
+                      const Changes& changes);
+
+  template <typename Changes>
+  void SetWithChanges(T&& value, const Changes& changes);
+
   template <typename... Args>
   void Emplace(Args&&... args);
 
@@ -126,6 +165,20 @@ class CachingComponentBase : public LoggableComponentBase,
   /// returning nullptr.
   virtual bool MayReturnNull() const;
 
+  /// @brief Loads the shard `shard` out of `shards_count` of a sharded full
+  /// update.
+  ///
+  /// Called concurrently for different shards, must only use `stats_scope`
+  /// to account the read documents.
+  virtual std::unique_ptr<T> LoadFullUpdateShard(
+      std::size_t shard, std::size_t shards_count,
+      cache::UpdateStatisticsScope& stats_scope);
+
+  /// @brief Merges a loaded shard into the data of the first shard.
+  ///
+  /// By default supports the standard associative containers and vectors.
+  virtual void MergeFullUpdateShard(T& result, T&& shard) const;
+
   /// @{
   /// Override to use custom serialization for cache dumps
   virtual void WriteContents(dump::Writer& writer, const T& contents) const;
@@ -133,13 +186,32 @@ class CachingComponentBase : public LoggableComponentBase,
   virtual std::unique_ptr<const T> ReadContents(dump::Reader& reader) const;
   /// @}
 
+  /// @brief Reads the full dump that the delta dumps are applied to.
+  ///
+  /// By default copies the data returned by ReadContents. Override together
+  /// with ReadContents to read the data without a copy.
+  virtual std::unique_ptr<T> ReadContentsForDeltas(dump::Reader& reader) const;
+
+  /// @brief Override to read the changes passed to SetWithChanges from
+  /// a delta dump and apply them to `data`
+  virtual void ApplyDumpChanges(T& data, dump::Reader& reader) const;
+
  private:
   void OnAllComponentsLoaded() override;
 
   void Cleanup() final;
 
+  void UpdateFullSharded(std::size_t shards_count,
+                         cache::UpdateStatisticsScope& stats_scope) final;
+
   void GetAndWrite(dump::Writer& writer) const final;
   void ReadAndSet(dump::Reader& reader) final;
+  void ReadAndSetWithDeltas(
+      dump::Reader& reader,
+      const std::vector<std::unique_ptr<dump::Reader>>& deltas) final;
+
+  void DoSet(std::unique_ptr<const T> value_ptr,
+             const std::function<void(dump::Writer&)>& write_changes);
 
   rcu::Variable<std::shared_ptr<const T>> cache_;
   concurrent::AsyncEventChannel<const std::shared_ptr<const T>&> event_channel_;
@@ -197,6 +269,28 @@ utils::SharedReadablePtr<T> CachingComponentBase<T>::GetUnsafe() const {
 
 template <typename T>
 void CachingComponentBase<T>::Set(std::unique_ptr<const T> value_ptr) {
+  DoSet(std::move(value_ptr), {});
+}
+
+template <typename T>
+template <typename Changes>
+void CachingComponentBase<T>::SetWithChanges(std::unique_ptr<const T> value_ptr,
+                                             const Changes& changes) {
+  DoSet(std::move(value_ptr),
+        [&changes](dump::Writer& writer) { writer.Write(changes); });
+}
+
+template <typename T>
+template <typename Changes>
+void CachingComponentBase<T>::SetWithChanges(T&& value,
+                                             const Changes& changes) {
+  SetWithChanges(std::make_unique<T>(std::move(value)), changes);
+}
+
+template <typename T>
+void CachingComponentBase<T>::DoSet(
+    std::unique_ptr<const T> value_ptr,
+    const std::function<void(dump::Writer&)>& write_changes) {
   auto deleter = [token = wait_token_storage_.GetToken(),
                   &cache_task_processor =
                       GetCacheTaskProcessor()](const T* raw_ptr) mutable {
@@ -213,7 +307,7 @@ void CachingComponentBase<T>::Set(std::unique_ptr<const T> value_ptr) {
 
   const std::shared_ptr<const T> new_value(value_ptr.release(),
                                            std::move(deleter));
-  cache_.Assign(new_value);
+  PublishWithDumpChanges([&] { cache_.Assign(new_value); }, write_changes);
   event_channel_.SendEvent(new_value);
   OnCacheModified();
 }
@@ -231,7 +325,8 @@ void CachingComponentBase<T>::Emplace(Args&&... args) {
 
 template <typename T>
 void CachingComponentBase<T>::Clear() {
-  cache_.Assign(std::make_unique<const T>());
+  PublishWithDumpChanges([&] { cache_.Assign(std::make_unique<const T>()); },
+                         {});
 }
 
 template <typename T>
@@ -239,9 +334,74 @@ bool CachingComponentBase<T>::MayReturnNull() const {
   return false;
 }
 
+template <typename T>
+std::unique_ptr<T> CachingComponentBase<T>::LoadFullUpdateShard(
+    std::size_t, std::size_t, cache::UpdateStatisticsScope&) {
+  throw std::logic_error("LoadFullUpdateShard is not implemented for cache " +
+                         Name());
+}
+
+namespace impl {
+
+template <typename T>
+using HasMerge = decltype(std::declval<T&>().merge(std::declval<T&>()));
+
+template <typename T>
+using HasReserve = decltype(std::declval<T&>().reserve(std::size_t{}));
+
+}  // namespace impl
+
+template <typename T>
+void CachingComponentBase<T>::MergeFullUpdateShard(T& result, T&& shard) const {
+  if constexpr (meta::kIsDetected<impl::HasMerge, T>) {
+    // moves the nodes without copying the items
+    result.merge(shard);
+  } else if constexpr (meta::kIsVector<T>) {
+    result.insert(result.end(), std::make_move_iterator(shard.begin()),
+                  std::make_move_iterator(shard.end()));
+  } else {
+    throw std::logic_error(
+        "MergeFullUpdateShard is not implemented for cache " + Name());
+  }
+}
+
+template <typename T>
+void CachingComponentBase<T>::UpdateFullSharded(
+    std::size_t shards_count, cache::UpdateStatisticsScope& stats_scope) {
+  std::vector<std::unique_ptr<T>> shards(shards_count);
+  RunFullUpdateShards(shards_count, [&](std::size_t shard) {
+    shards[shard] = LoadFullUpdateShard(shard, shards_count, stats_scope);
+  });
+
+  for (const auto& shard : shards) {
+    if (!shard) throw std::logic_error("Empty full update shard in " + Name());
+  }
+
+  auto result = std::move(shards.front());
+  if constexpr (meta::kIsDetected<impl::HasReserve, T> &&
+                meta::kIsSizable<T>) {
+    std::size_t size = 0;
+    for (std::size_t i = 1; i < shards_count; ++i) {
+      size += std::size(*shards[i]);
+    }
+    result->reserve(std::size(*result) + size);
+  }
+  for (std::size_t i = 1; i < shards_count; ++i) {
+    MergeFullUpdateShard(*result, std::move(*shards[i]));
+    shards[i].reset();
+  }
+
+  std::size_t documents_count = 0;
+  if constexpr (meta::kIsSizable<T>) documents_count = std::size(*result);
+  Set(std::move(result));
+  stats_scope.Finish(documents_count);
+}
+
 template <typename T>
 void CachingComponentBase<T>::GetAndWrite(dump::Writer& writer) const {
-  const auto contents = GetUnsafe();
+  std::shared_ptr<const T> contents;
+  // The changes published after the snapshot go to the next delta dump
+  SnapshotForFullDump([&] { contents = cache_.ReadCopy(); });
   if (!contents) throw cache::EmptyCacheError(Name());
   WriteContents(writer, *contents);
 }
@@ -251,6 +411,27 @@ void CachingComponentBase<T>::ReadAndSet(dump::Reader& reader) {
   Set(ReadContents(reader));
 }
 
+template <typename T>
+void CachingComponentBase<T>::ReadAndSetWithDeltas(
+    dump::Reader& reader,
+    const std::vector<std::unique_ptr<dump::Reader>>& deltas) {
+  if (deltas.empty()) {
+    Set(ReadContents(reader));
+    return;
+  }
+
+  auto contents = ReadContentsForDeltas(reader);
+  if (!contents) throw cache::EmptyCacheError(Name());
+  for (const auto& delta : deltas) {
+      // Written by CacheUpdateTrait: the count and the SetWithChanges records
+    const auto count = delta->Read<std::size_t>();
+    for (std::size_t i = 0; i < count; ++i) {
+      ApplyDumpChanges(*contents, *delta);
+    }
+  }
+  Set(std::move(contents));
+}
+
 template <typename T>
 void CachingComponentBase<T>::WriteContents(dump::Writer& writer,
                                             const T& contents) const {
@@ -272,6 +453,27 @@ std::unique_ptr<const T> CachingComponentBase<T>::ReadContents(
   }
 }
 
+template <typename T>
+std::unique_ptr<T> CachingComponentBase<T>::ReadContentsForDeltas(
+    dump::Reader& reader) const {
+  if constexpr (std::is_copy_constructible_v<T>) {
+    const auto contents = ReadContents(reader);
+    if (!contents) return nullptr;
+    return std::make_unique<T>(*contents);
+  } else {
+    throw std::logic_error(
+        "ReadContentsForDeltas must be overridden for non-copyable data, "
+        "cache " +
+        Name());
+  }
+}
+
+template <typename T>
+void CachingComponentBase<T>::ApplyDumpChanges(T&, dump::Reader&) const {
+  throw std::logic_error("ApplyDumpChanges is not implemented for cache " +
+                         Name());
+}
+
 template <typename T>
 void CachingComponentBase<T>::OnAllComponentsLoaded() {
   AssertPeriodicUpdateStarted();
@@ -3,15 +3,22 @@
 /// @file userver/cache/expirable_lru_cache.hpp
 /// @brief @copybrief cache::ExpirableLruCache
 
+#include <algorithm>
+#include <mutex>
 #include <optional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include <userver/cache/lru_cache_config.hpp>
 #include <userver/cache/lru_cache_statistics.hpp>
 #include <userver/cache/nway_lru_cache.hpp>
 #include <userver/concurrent/mutex_set.hpp>
+#include <userver/concurrent/variable.hpp>
 #include <userver/engine/async.hpp>
 #include <userver/utils/datetime.hpp>
 #include <userver/utils/impl/wait_token_storage.hpp>
+#include <userver/utils/meta.hpp>
 
 // TODO remove
 #include <userver/logging/log.hpp>
@@ -24,6 +31,16 @@ namespace cache {
 /// @brief Class for expirable LRU cache. Use cache::LruMap for not expirable
 /// LRU Cache.
 ///
+/// If `Value` is `std::optional`, the empty results of the update function
+/// may be kept in a separate negative LRU, see SetNegativeWaySize. Then the
+/// keys known to be absent neither evict the values nor call the update
+/// function until their own lifetime expires.
+///
+/// With SetRefreshAhead the keys that are read close to their expiry are not
+/// updated one by one, but queued and refreshed by a single
+/// BulkUpdateValueFunc call in RefreshAhead, which the owner of the cache
+/// calls periodically.
+///
 /// Example usage:
 ///
 /// @snippet cache/expirable_lru_cache_test.cpp Sample ExpirableLruCache
@@ -32,6 +49,9 @@ template <typename Key, typename Value, typename Hash = std::hash<Key>,
 class ExpirableLruCache final {
  public:
   using UpdateValueFunc = std::function<Value(const Key&)>;
+  /// Returns the values for all the keys in the same order
+  using BulkUpdateValueFunc =
+      std::function<std::vector<Value>(const std::vector<Key>&)>;
 
   /// Cache read mode
   enum class ReadMode {
@@ -46,10 +66,24 @@ class ExpirableLruCache final {
 
   void SetWaySize(size_t way_size);
 
+  /// Switches the eviction policy of all the ways, keeps the cached values
+  void SetPolicy(CachePolicy policy);
+
+  /// Limits the weight of each way in bytes (see cache::GetWeight), 0 is
+  /// unlimited
+  void SetWayMaxWeight(size_t way_max_weight);
+
   std::chrono::milliseconds GetMaxLifetime() const noexcept;
 
   void SetMaxLifetime(std::chrono::milliseconds max_lifetime);
 
+  /// Limits the number of the absent keys in each way of the negative LRU,
+  /// 0 disables the negative LRU
+  void SetNegativeWaySize(size_t way_size);
+
+  /// TTL for the absent keys in the negative LRU, 0 is unlimited
+  void SetNegativeLifetime(std::chrono::milliseconds lifetime);
+
   /**
    * Sets background update mode. If "background_update" mode is kDisabled,
    * expiring values are not updated in background (asynchronously) or are
@@ -57,6 +91,12 @@ class ExpirableLruCache final {
    */
   void SetBackgroundUpdate(BackgroundUpdateMode background_update);
 
+  /// Queues the keys that should be updated in background for RefreshAhead
+  /// instead of updating each of them in a separate task. At most
+  /// `max_keys` of the most frequently read keys are refreshed at once,
+  /// 0 disables the queue.
+  void SetRefreshAhead(size_t max_keys);
+
   /**
    * @returns GetOptional("key", update_func) if it is not std::nullopt.
    * Otherwise the result of update_func(key) is returned, and additionally
@@ -102,6 +142,15 @@ class ExpirableLruCache final {
 
   size_t GetSizeApproximate() const;
 
+  /// Number of the keys in the negative LRU
+  size_t GetNegativeSizeApproximate() const;
+
+  /// Total weight of the cached values, 0 if the weight is unlimited
+  size_t GetWeightApproximate() const;
+
+  /// Total weight of the values evicted to make room for the new ones
+  size_t GetEvictedWeightApproximate() const;
+
   /// Clear cache
   void Invalidate();
 
@@ -111,6 +160,13 @@ class ExpirableLruCache final {
   /// Add async task for updating value by update_func(key)
   void UpdateInBackground(const Key& key, UpdateValueFunc update_func);
 
+  /// Updates the queued keys (see SetRefreshAhead) by a single
+  /// `update_func` call in the current task. The keys are locked against
+  /// the concurrent updates by Get, the keys that are being updated are
+  /// skipped.
+  /// @returns the number of the refreshed keys
+  size_t RefreshAhead(const BulkUpdateValueFunc& update_func);
+
  private:
   bool IsExpired(std::chrono::steady_clock::time_point update_time,
                  std::chrono::steady_clock::time_point now) const;
@@ -118,17 +174,46 @@ class ExpirableLruCache final {
   bool ShouldUpdate(std::chrono::steady_clock::time_point update_time,
                     std::chrono::steady_clock::time_point now) const;
 
+  bool IsNegativeExpired(std::chrono::steady_clock::time_point update_time,
+                         std::chrono::steady_clock::time_point now) const;
+
+  // `now` is std::nullopt to ignore the negative lifetime
+  bool IsKnownAbsent(
+      const Key& key,
+      std::optional<std::chrono::steady_clock::time_point> now);
+
+  template <typename V>
+  void DoPut(const Key& key, V&& value,
+             std::chrono::steady_clock::time_point now);
+
+  void UpdateAhead(const Key& key, const UpdateValueFunc& update_func);
+
  private:
   struct MapValue {
     Value value;
     std::chrono::steady_clock::time_point update_time;
+
+    friend size_t GetCacheWeight(const MapValue& map_value) {
+      return sizeof(MapValue) - sizeof(Value) +
+             cache::GetWeight(map_value.value);
+    }
   };
 
   cache::NWayLRU<Key, MapValue, Hash, Equal> lru_;
+  // update times of the keys for which the update function returned nullopt
+  cache::NWayLRU<Key, std::chrono::steady_clock::time_point, Hash, Equal>
+      negative_lru_;
+  std::atomic<bool> negative_enabled_{false};
+  std::atomic<std::chrono::milliseconds> negative_lifetime_{
+      std::chrono::milliseconds(0)};
   std::atomic<std::chrono::milliseconds> max_lifetime_{
       std::chrono::milliseconds(0)};
   std::atomic<BackgroundUpdateMode> background_update_mode_{
       BackgroundUpdateMode::kDisabled};
+  std::atomic<size_t> refresh_ahead_max_keys_{0};
+  // number of reads of the keys waiting for RefreshAhead
+  concurrent::Variable<std::unordered_map<Key, size_t, Hash, Equal>>
+      refresh_ahead_queue_;
   impl::ExpirableLruCacheStatistics stats_;
   concurrent::MutexSet<Key, Hash, Equal> mutex_set_;
   utils::impl::WaitTokenStorage wait_token_storage_;
@@ -138,6 +223,8 @@ template <typename Key, typename Value, typename Hash, typename Equal>
 ExpirableLruCache<Key, Value, Hash, Equal>::ExpirableLruCache(
     size_t ways, size_t way_size, const Hash& hash, const Equal& equal)
     : lru_(ways, way_size, hash, equal),
+      negative_lru_(ways, 1, hash, equal),
+      refresh_ahead_queue_(0, hash, equal),
       mutex_set_{ways, way_size, hash, equal} {}
 
 template <typename Key, typename Value, typename Hash, typename Equal>
@@ -150,6 +237,18 @@ void ExpirableLruCache<Key, Value, Hash, Equal>::SetWaySize(size_t way_size) {
   lru_.UpdateWaySize(way_size);
 }
 
+template <typename Key, typename Value, typename Hash, typename Equal>
+void ExpirableLruCache<Key, Value, Hash, Equal>::SetPolicy(
+    CachePolicy policy) {
+  lru_.UpdatePolicy(policy);
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+void ExpirableLruCache<Key, Value, Hash, Equal>::SetWayMaxWeight(
+    size_t way_max_weight) {
+  lru_.UpdateWayMaxWeight(way_max_weight);
+}
+
 template <typename Key, typename Value, typename Hash, typename Equal>
 std::chrono::milliseconds
 ExpirableLruCache<Key, Value, Hash, Equal>::GetMaxLifetime() const noexcept {
@@ -162,12 +261,36 @@ void ExpirableLruCache<Key, Value, Hash, Equal>::SetMaxLifetime(
   max_lifetime_ = max_lifetime;
 }
 
+template <typename Key, typename Value, typename Hash, typename Equal>
+void ExpirableLruCache<Key, Value, Hash, Equal>::SetNegativeWaySize(
+    size_t way_size) {
+  negative_lru_.UpdateWaySize(std::max<size_t>(way_size, 1));
+  negative_enabled_ = way_size != 0 && meta::kIsOptional<Value>;
+  if (way_size == 0) negative_lru_.Invalidate();
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+void ExpirableLruCache<Key, Value, Hash, Equal>::SetNegativeLifetime(
+    std::chrono::milliseconds lifetime) {
+  negative_lifetime_ = lifetime;
+}
+
 template <typename Key, typename Value, typename Hash, typename Equal>
 void ExpirableLruCache<Key, Value, Hash, Equal>::SetBackgroundUpdate(
     BackgroundUpdateMode background_update) {
   background_update_mode_ = background_update;
 }
 
+template <typename Key, typename Value, typename Hash, typename Equal>
+void ExpirableLruCache<Key, Value, Hash, Equal>::SetRefreshAhead(
+    size_t max_keys) {
+  refresh_ahead_max_keys_ = max_keys;
+  if (max_keys == 0) {
+    auto queue = refresh_ahead_queue_.UniqueLock();
+    queue->clear();
+  }
+}
+
 template <typename Key, typename Value, typename Hash, typename Equal>
 Value ExpirableLruCache<Key, Value, Hash, Equal>::Get(
     const Key& key, const UpdateValueFunc& update_func, ReadMode read_mode) {
@@ -185,10 +308,13 @@ Value ExpirableLruCache<Key, Value, Hash, Equal>::Get(
   if (old_value && !IsExpired(old_value->update_time, now)) {
     return std::move(old_value->value);
   }
+  if (IsKnownAbsent(key, now)) {
+    return Value{};
+  }
 
   auto value = update_func(key);
   if (read_mode == ReadMode::kUseCache) {
-    lru_.Put(key, {value, now});
+    DoPut(key, value, now);
   }
   return value;
 }
@@ -204,7 +330,7 @@ std::optional<Value> ExpirableLruCache<Key, Value, Hash, Equal>::GetOptional(
       impl::CacheHit(stats_);
 
       if (ShouldUpdate(old_value->update_time, now)) {
-        UpdateInBackground(key, update_func);
+        UpdateAhead(key, update_func);
       }
 
       return std::move(old_value->value);
@@ -212,6 +338,10 @@ std::optional<Value> ExpirableLruCache<Key, Value, Hash, Equal>::GetOptional(
       impl::CacheStale(stats_);
     }
   }
+  if (IsKnownAbsent(key, now)) {
+    impl::CacheNegativeHit(stats_);
+    return Value{};
+  }
   impl::CacheMiss(stats_);
 
   return std::nullopt;
@@ -227,6 +357,10 @@ ExpirableLruCache<Key, Value, Hash, Equal>::GetOptionalUnexpirable(
     impl::CacheHit(stats_);
     return old_value->value;
   }
+  if (IsKnownAbsent(key, std::nullopt)) {
+    impl::CacheNegativeHit(stats_);
+    return Value{};
+  }
   impl::CacheMiss(stats_);
 
   return std::nullopt;
@@ -243,11 +377,15 @@ ExpirableLruCache<Key, Value, Hash, Equal>::GetOptionalUnexpirableWithUpdate(
     impl::CacheHit(stats_);
 
     if (ShouldUpdate(old_value->update_time, now)) {
-      UpdateInBackground(key, update_func);
+      UpdateAhead(key, update_func);
     }
 
     return old_value->value;
   }
+  if (IsKnownAbsent(key, std::nullopt)) {
+    impl::CacheNegativeHit(stats_);
+    return Value{};
+  }
   impl::CacheMiss(stats_);
 
   return std::nullopt;
@@ -269,6 +407,10 @@ ExpirableLruCache<Key, Value, Hash, Equal>::GetOptionalNoUpdate(
       impl::CacheStale(stats_);
     }
   }
+  if (IsKnownAbsent(key, now)) {
+    impl::CacheNegativeHit(stats_);
+    return Value{};
+  }
   impl::CacheMiss(stats_);
 
   return std::nullopt;
@@ -277,13 +419,13 @@ ExpirableLruCache<Key, Value, Hash, Equal>::GetOptionalNoUpdate(
 template <typename Key, typename Value, typename Hash, typename Equal>
 void ExpirableLruCache<Key, Value, Hash, Equal>::Put(const Key& key,
                                                      const Value& value) {
-  lru_.Put(key, {value, utils::datetime::SteadyNow()});
+  DoPut(key, value, utils::datetime::SteadyNow());
 }
 
 template <typename Key, typename Value, typename Hash, typename Equal>
 void ExpirableLruCache<Key, Value, Hash, Equal>::Put(const Key& key,
                                                      Value&& value) {
-  lru_.Put(key, {std::move(value), utils::datetime::SteadyNow()});
+  DoPut(key, std::move(value), utils::datetime::SteadyNow());
 }
 
 template <typename Key, typename Value, typename Hash, typename Equal>
@@ -297,15 +439,36 @@ size_t ExpirableLruCache<Key, Value, Hash, Equal>::GetSizeApproximate() const {
   return lru_.GetSize();
 }
 
+template <typename Key, typename Value, typename Hash, typename Equal>
+size_t ExpirableLruCache<Key, Value, Hash, Equal>::GetNegativeSizeApproximate()
+    const {
+  return negative_lru_.GetSize();
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+size_t ExpirableLruCache<Key, Value, Hash, Equal>::GetWeightApproximate()
+    const {
+  return lru_.GetWeight();
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+size_t
+ExpirableLruCache<Key, Value, Hash, Equal>::GetEvictedWeightApproximate()
+    const {
+  return lru_.GetEvictedWeight();
+}
+
 template <typename Key, typename Value, typename Hash, typename Equal>
 void ExpirableLruCache<Key, Value, Hash, Equal>::Invalidate() {
   lru_.Invalidate();
+  negative_lru_.Invalidate();
 }
 
 template <typename Key, typename Value, typename Hash, typename Equal>
 void ExpirableLruCache<Key, Value, Hash, Equal>::InvalidateByKey(
     const Key& key) {
   lru_.InvalidateByKey(key);
+  negative_lru_.InvalidateByKey(key);
 }
 
 template <typename Key, typename Value, typename Hash, typename Equal>
@@ -325,11 +488,84 @@ void ExpirableLruCache<Key, Value, Hash, Equal>::UpdateInBackground(
     }
 
     auto now = utils::datetime::SteadyNow();
-    auto value = update_func(key);
-    lru_.Put(key, {value, now});
+    DoPut(key, update_func(key), now);
   }).Detach();
 }
 
+template <typename Key, typename Value, typename Hash, typename Equal>
+size_t ExpirableLruCache<Key, Value, Hash, Equal>::RefreshAhead(
+    const BulkUpdateValueFunc& update_func) {
+  const auto max_keys = refresh_ahead_max_keys_.load();
+  std::vector<std::pair<Key, size_t>> queued;
+  {
+    auto queue = refresh_ahead_queue_.UniqueLock();
+    queued.assign(std::make_move_iterator(queue->begin()),
+                  std::make_move_iterator(queue->end()));
+    queue->clear();
+  }
+  if (queued.empty() || max_keys == 0) return 0;
+
+  if (queued.size() > max_keys) {
+    // the rest will be queued again if they are still read
+    std::nth_element(queued.begin(), queued.begin() + max_keys, queued.end(),
+                     [](const auto& lhs, const auto& rhs) {
+                       return lhs.second > rhs.second;
+                     });
+    queued.resize(max_keys);
+  }
+
+  // Same per-key locks as in Get, so that a value fetched by a concurrent
+  // miss does not get overwritten by an older one. The keys that are being
+  // updated right now are skipped.
+  std::vector<Key> keys;
+  std::vector<concurrent::ItemMutex<Key, Equal>> mutexes;
+  std::vector<std::unique_lock<concurrent::ItemMutex<Key, Equal>>> locks;
+  keys.reserve(queued.size());
+  mutexes.reserve(queued.size());
+  locks.reserve(queued.size());
+  for (auto& item : queued) {
+    auto mutex = mutex_set_.GetMutexForKey(item.first);
+    if (!mutex.try_lock()) continue;
+    locks.emplace_back(mutexes.emplace_back(std::move(mutex)), std::adopt_lock);
+    keys.push_back(std::move(item.first));
+  }
+  if (keys.empty()) return 0;
+
+  stats_.total.background_updates++;
+  stats_.recent.GetCurrentCounter().background_updates++;
+
+  const auto now = utils::datetime::SteadyNow();
+  auto values = update_func(keys);
+  if (values.size() != keys.size()) {
+    LOG_ERROR() << "Bulk update returned " << values.size()
+                << " values for " << keys.size() << " keys, ignoring them";
+    return 0;
+  }
+  for (size_t i = 0; i < keys.size(); ++i) {
+    DoPut(keys[i], std::move(values[i]), now);
+  }
+  return keys.size();
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+void ExpirableLruCache<Key, Value, Hash, Equal>::UpdateAhead(
+    const Key& key, const UpdateValueFunc& update_func) {
+  const auto max_keys = refresh_ahead_max_keys_.load();
+  if (max_keys == 0) {
+    UpdateInBackground(key, update_func);
+    return;
+  }
+
+  auto queue = refresh_ahead_queue_.UniqueLock();
+  const auto it = queue->find(key);
+  if (it != queue->end()) {
+    ++it->second;
+  } else if (queue->size() < max_keys * 4) {
+    // bounded to not grow between the RefreshAhead calls
+    queue->emplace(key, 1);
+  }
+}
+
 template <typename Key, typename Value, typename Hash, typename Equal>
 bool ExpirableLruCache<Key, Value, Hash, Equal>::IsExpired(
     std::chrono::steady_clock::time_point update_time,
@@ -343,10 +579,49 @@ bool ExpirableLruCache<Key, Value, Hash, Equal>::ShouldUpdate(
     std::chrono::steady_clock::time_point update_time,
     std::chrono::steady_clock::time_point now) const {
   auto max_lifetime = max_lifetime_.load();
-  return (background_update_mode_.load() == BackgroundUpdateMode::kEnabled) &&
+  return (background_update_mode_.load() == BackgroundUpdateMode::kEnabled ||
+          refresh_ahead_max_keys_.load() != 0) &&
          max_lifetime.count() != 0 && update_time + max_lifetime / 2 < now;
 }
 
+template <typename Key, typename Value, typename Hash, typename Equal>
+bool ExpirableLruCache<Key, Value, Hash, Equal>::IsNegativeExpired(
+    std::chrono::steady_clock::time_point update_time,
+    std::chrono::steady_clock::time_point now) const {
+  auto lifetime = negative_lifetime_.load();
+  return lifetime.count() != 0 && update_time + lifetime < now;
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+bool ExpirableLruCache<Key, Value, Hash, Equal>::IsKnownAbsent(
+    const Key& key, std::optional<std::chrono::steady_clock::time_point> now) {
+  if (!negative_enabled_.load()) return false;
+  return negative_lru_
+      .Get(key,
+           [&](std::chrono::steady_clock::time_point update_time) {
+             return !now || !IsNegativeExpired(update_time, *now);
+           })
+      .has_value();
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+template <typename V>
+void ExpirableLruCache<Key, Value, Hash, Equal>::DoPut(
+    const Key& key, V&& value, std::chrono::steady_clock::time_point now) {
+  if constexpr (meta::kIsOptional<Value>) {
+    if (negative_enabled_.load()) {
+      if (!value) {
+        // the absent keys do not evict the cached values
+        negative_lru_.Put(key, now);
+        lru_.InvalidateByKey(key);
+        return;
+      }
+      negative_lru_.InvalidateByKey(key);
+    }
+  }
+  lru_.Put(key, {std::forward<V>(value), now});
+}
+
 template <typename Key, typename Value, typename Hash = std::hash<Key>,
           typename Equal = std::equal_to<Key>>
 class LruCacheWrapper final {
@@ -0,0 +1,206 @@
+#pragma once
+
+/// @file userver/cache/flat_map.hpp
+/// @brief @copybrief cache::FlatMap
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <userver/dump/operations.hpp>
+#include <userver/dump/unsafe.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace cache {
+
+/// @ingroup userver_containers
+///
+/// @brief Immutable sorted map of trivially copyable keys and values with a
+/// flat memory layout.
+///
+/// The keys and the values are stored as two plain arrays, and the dump
+/// contains exactly the same arrays. When the dump is read by
+/// dump::FileReader, the map references the memory-mapped dump file instead
+/// of deserializing the items, so a cache of any size is loaded from the dump
+/// nearly instantly and does not take heap memory. The pages of the file are
+/// loaded by the kernel on the first access.
+///
+/// The layout uses the native byte order and type representation, change
+/// the `format-version` of the dump if `Key` or `Value` changes.
+///
+/// Lookups are binary searches, O(log N).
+template <typename Key, typename Value>
+class FlatMap final {
+  static_assert(std::is_trivially_copyable_v<Key> &&
+                    std::is_default_constructible_v<Key>,
+                "Key must be a trivially copyable type");
+  static_assert(std::is_trivially_copyable_v<Value> &&
+                    std::is_default_constructible_v<Value>,
+                "Value must be a trivially copyable type");
+
+ public:
+  using key_type = Key;
+  using mapped_type = Value;
+
+  FlatMap() = default;
+
+  /// @brief Builds the map, the last value wins for the duplicate keys
+  explicit FlatMap(std::vector<std::pair<Key, Value>> items);
+
+  /// @returns the value for the key, or std::nullopt
+  std::optional<Value> Get(const Key& key) const;
+
+  bool Contains(const Key& key) const { return Find(key) != size_; }
+
+  std::size_t size() const noexcept { return size_; }
+
+  bool empty() const noexcept { return size_ == 0; }
+
+  /// Calls `func(key, value)` for all the items in the order of keys
+  template <typename Function>
+  void VisitAll(Function func) const;
+
+  /// @cond
+  // For internal use only
+  std::string_view GetKeysData() const noexcept {
+    return {keys_, size_ * sizeof(Key)};
+  }
+
+  // For internal use only
+  std::string_view GetValuesData() const noexcept {
+    return {values_, size_ * sizeof(Value)};
+  }
+
+  // For internal use only
+  FlatMap(std::size_t size, dump::SharedStringView keys,
+          dump::SharedStringView values);
+  /// @endcond
+
+ private:
+  // the arrays may be unaligned in a memory-mapped dump
+  Key LoadKey(std::size_t index) const noexcept {
+    Key key;
+    std::memcpy(&key, keys_ + index * sizeof(Key), sizeof(Key));
+    return key;
+  }
+
+  Value LoadValue(std::size_t index) const noexcept {
+    Value value;
+    std::memcpy(&value, values_ + index * sizeof(Value), sizeof(Value));
+    return value;
+  }
+
+  std::size_t Find(const Key& key) const;
+
+  std::shared_ptr<const void> keys_owner_;
+  std::shared_ptr<const void> values_owner_;
+  const char* keys_{nullptr};
+  const char* values_{nullptr};
+  std::size_t size_{0};
+};
+
+template <typename Key, typename Value>
+FlatMap<Key, Value>::FlatMap(std::vector<std::pair<Key, Value>> items) {
+  std::stable_sort(
+      items.begin(), items.end(),
+      [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+  // keep the last of the equal keys
+  const auto last_unique = std::unique(
+      items.rbegin(), items.rend(), [](const auto& lhs, const auto& rhs) {
+        return !(lhs.first < rhs.first) && !(rhs.first < lhs.first);
+      });
+  items.erase(items.begin(), last_unique.base());
+
+  size_ = items.size();
+  auto buffer = std::make_shared<std::string>(
+      size_ * (sizeof(Key) + sizeof(Value)), '\0');
+  char* keys = buffer->data();
+  char* values = keys + size_ * sizeof(Key);
+  for (std::size_t i = 0; i < size_; ++i) {
+    std::memcpy(keys + i * sizeof(Key), &items[i].first, sizeof(Key));
+    std::memcpy(values + i * sizeof(Value), &items[i].second, sizeof(Value));
+  }
+
+  keys_ = keys;
+  values_ = values;
+  keys_owner_ = buffer;
+  values_owner_ = std::move(buffer);
+}
+
+template <typename Key, typename Value>
+FlatMap<Key, Value>::FlatMap(std::size_t size, dump::SharedStringView keys,
+                             dump::SharedStringView values)
+    : keys_owner_(std::move(keys.owner)),
+      values_owner_(std::move(values.owner)),
+      keys_(keys.data.data()),
+      values_(values.data.data()),
+      size_(size) {
+  // the keys are not validated to avoid touching the whole mapped dump
+}
+
+template <typename Key, typename Value>
+std::optional<Value> FlatMap<Key, Value>::Get(const Key& key) const {
+  const auto index = Find(key);
+  if (index == size_) return std::nullopt;
+  return LoadValue(index);
+}
+
+template <typename Key, typename Value>
+template <typename Function>
+void FlatMap<Key, Value>::VisitAll(Function func) const {
+  for (std::size_t i = 0; i < size_; ++i) func(LoadKey(i), LoadValue(i));
+}
+
+template <typename Key, typename Value>
+std::size_t FlatMap<Key, Value>::Find(const Key& key) const {
+  std::size_t first = 0;
+  std::size_t count = size_;
+  while (count > 0) {
+    const auto step = count / 2;
+    if (LoadKey(first + step) < key) {
+      first += step + 1;
+      count -= step + 1;
+    } else {
+      count = step;
+    }
+  }
+
+  if (first == size_ || key < LoadKey(first)) return size_;
+  return first;
+}
+
+/// @brief Dump support for cache::FlatMap
+template <typename Key, typename Value>
+void Write(dump::Writer& writer, const FlatMap<Key, Value>& map) {
+  writer.Write(map.size());
+  dump::WriteStringViewUnsafe(writer, map.GetKeysData());
+  dump::WriteStringViewUnsafe(writer, map.GetValuesData());
+}
+
+/// @brief Dump support for cache::FlatMap, does not copy the data from
+/// memory-mapped dumps
+template <typename Key, typename Value>
+FlatMap<Key, Value> Read(dump::Reader& reader, dump::To<FlatMap<Key, Value>>) {
+  const auto size = reader.Read<std::size_t>();
+  if (size > std::numeric_limits<std::size_t>::max() /
+                 std::max(sizeof(Key), sizeof(Value))) {
+    throw dump::Error("Invalid FlatMap size in the dump");
+  }
+
+  auto keys = dump::ReadSharedUnsafe(reader, size * sizeof(Key));
+  auto values = dump::ReadSharedUnsafe(reader, size * sizeof(Value));
+  return FlatMap<Key, Value>(size, std::move(keys), std::move(values));
+}
+
+}  // namespace cache
+
+USERVER_NAMESPACE_END
@@ -3,12 +3,15 @@
 /// @file userver/cache/lru_cache_component_base.hpp
 /// @brief @copybrief cache::LruCacheComponent
 
+#include <vector>
+
 #include <userver/cache/expirable_lru_cache.hpp>
 #include <userver/cache/lru_cache_config.hpp>
 #include <userver/components/loggable_component_base.hpp>
 #include <userver/concurrent/async_event_source.hpp>
 #include <userver/dynamic_config/source.hpp>
 #include <userver/testsuite/component_control.hpp>
+#include <userver/utils/periodic_task.hpp>
 #include <userver/utils/statistics/storage.hpp>
 #include <userver/yaml_config/schema.hpp>
 
@@ -19,13 +22,16 @@ namespace cache {
 namespace impl {
 
 formats::json::Value GetCacheStatisticsAsJson(
-    const ExpirableLruCacheStatistics& stats, std::size_t size);
+    const ExpirableLruCacheStatistics& stats, std::size_t size,
+    std::size_t bytes, std::size_t evicted_bytes, std::size_t negative_size);
 
 template <typename Key, typename Value, typename Hash, typename Equal>
 formats::json::Value GetCacheStatisticsAsJson(
     const ExpirableLruCache<Key, Value, Hash, Equal>& cache) {
-  return GetCacheStatisticsAsJson(cache.GetStatistics(),
-                                  cache.GetSizeApproximate());
+  return GetCacheStatisticsAsJson(
+      cache.GetStatistics(), cache.GetSizeApproximate(),
+      cache.GetWeightApproximate(), cache.GetEvictedWeightApproximate(),
+      cache.GetNegativeSizeApproximate());
 }
 
 testsuite::ComponentControl& FindComponentControl(
@@ -53,6 +59,19 @@ yaml_config::Schema GetLruCacheComponentBaseSchema();
 /// Caching components must be configured in service config (see options below)
 /// and may be reconfigured dynamically via components::DynamicConfig.
 ///
+/// If `Value` is `std::optional`, the keys for which DoGetByKey returned
+/// `std::nullopt` may be remembered in a separate negative LRU of
+/// `negative-size` keys. Repeated lookups of the absent keys then do not call
+/// DoGetByKey and do not evict the cached values.
+///
+/// With `refresh-ahead-interval` the keys that are read during the second
+/// half of their `lifetime` are refreshed periodically in batches of up to
+/// `refresh-ahead-keys` most read keys. Override DoGetByKeys to fetch a batch
+/// with a single request. The refreshes run from OnAllComponentsLoaded() till
+/// OnAllComponentsAreStopping(), so DoGetByKeys is never called on a partially
+/// destroyed component. Derived components that override these functions must
+/// call the ones of LruCacheComponent.
+///
 /// ## Dynamic config
 /// * @ref USERVER_LRU_CACHES
 ///
@@ -62,6 +81,12 @@ yaml_config::Schema GetLruCacheComponentBaseSchema();
 /// size | max amount of items to store in cache | --
 /// ways | number of ways for associative cache | --
 /// lifetime | TTL for cache entries (0 is unlimited) | 0
+/// policy | eviction policy, `lru` or `w-tinylfu` (see cache::CachePolicy) | lru
+/// max-bytes | max total weight of the cached values (see cache::GetWeight), 0 is unlimited | 0
+/// negative-size | max amount of keys to remember as absent when `Value` is `std::optional` and DoGetByKey returns `std::nullopt`, 0 disables | 0
+/// negative-lifetime | TTL for the absent keys (0 is unlimited) | 0
+/// refresh-ahead-interval | period of the bulk refreshes of the keys that are read close to expiry, 0 disables them | 0
+/// refresh-ahead-keys | max amount of keys in a bulk refresh | 1000
 /// config-settings | enables dynamic reconfiguration with CacheConfigSet | true
 ///
 /// ## Example usage:
@@ -89,11 +114,20 @@ class LruCacheComponent : public components::LoggableComponentBase {
 
   CacheWrapper GetCache();
 
+  void OnAllComponentsLoaded() override;
+
+  void OnAllComponentsAreStopping() override;
+
   static yaml_config::Schema GetStaticConfigSchema();
 
  protected:
   virtual Value DoGetByKey(const Key& key) = 0;
 
+  /// Fetches the values for the refresh-ahead, by default calls DoGetByKey
+  /// for each key
+  /// @returns the values in the order of the keys
+  virtual std::vector<Value> DoGetByKeys(const std::vector<Key>& keys);
+
  private:
   void DropCache();
 
@@ -113,6 +147,7 @@ class LruCacheComponent : public components::LoggableComponentBase {
   concurrent::AsyncEventSubscriberScope config_subscription_;
   utils::statistics::Entry statistics_holder_;
   std::optional<testsuite::ComponentInvalidatorHolder> invalidator_holder_;
+  utils::PeriodicTask refresh_ahead_task_;
 };
 
 template <typename Key, typename Value, typename Hash, typename Equal>
@@ -126,6 +161,21 @@ LruCacheComponent<Key, Value, Hash, Equal>::LruCacheComponent(
                                      static_config_.GetWaySize())) {
   cache_->SetMaxLifetime(static_config_.config.lifetime);
   cache_->SetBackgroundUpdate(static_config_.config.background_update);
+  cache_->SetPolicy(static_config_.config.policy);
+  cache_->SetWayMaxWeight(
+      static_config_.config.GetWayMaxBytes(static_config_.ways));
+  if constexpr (!meta::kIsOptional<Value>) {
+    if (static_config_.config.negative_size != 0) {
+      throw std::runtime_error(
+          "negative-size requires std::optional values, cache=" + name_);
+    }
+  }
+  cache_->SetNegativeWaySize(
+      static_config_.config.GetNegativeWaySize(static_config_.ways));
+  cache_->SetNegativeLifetime(static_config_.config.negative_lifetime);
+  if (static_config_.refresh_ahead_interval.count() != 0) {
+    cache_->SetRefreshAhead(static_config_.refresh_ahead_keys);
+  }
 
   if (static_config_.use_dynamic_config) {
     LOG_INFO() << "Dynamic LRU cache config is enabled, subscribing on "
@@ -152,11 +202,31 @@ LruCacheComponent<Key, Value, Hash, Equal>::LruCacheComponent(
 
 template <typename Key, typename Value, typename Hash, typename Equal>
 LruCacheComponent<Key, Value, Hash, Equal>::~LruCacheComponent() {
+  refresh_ahead_task_.Stop();
   invalidator_holder_.reset();
   statistics_holder_.Unregister();
   config_subscription_.Unsubscribe();
 }
 
+template <typename Key, typename Value, typename Hash, typename Equal>
+void LruCacheComponent<Key, Value, Hash, Equal>::OnAllComponentsLoaded() {
+  // DoGetByKeys of the derived component is available only at this point
+  if (static_config_.refresh_ahead_interval.count() != 0) {
+    refresh_ahead_task_.Start(
+        "lru-refresh-ahead/" + name_, static_config_.refresh_ahead_interval,
+        [this] {
+          cache_->RefreshAhead([this](const std::vector<Key>& keys) {
+            return DoGetByKeys(keys);
+          });
+        });
+  }
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+void LruCacheComponent<Key, Value, Hash, Equal>::OnAllComponentsAreStopping() {
+  refresh_ahead_task_.Stop();
+}
+
 template <typename Key, typename Value, typename Hash, typename Equal>
 typename LruCacheComponent<Key, Value, Hash, Equal>::CacheWrapper
 LruCacheComponent<Key, Value, Hash, Equal>::GetCache() {
@@ -173,6 +243,15 @@ Value LruCacheComponent<Key, Value, Hash, Equal>::GetByKey(const Key& key) {
   return DoGetByKey(key);
 }
 
+template <typename Key, typename Value, typename Hash, typename Equal>
+std::vector<Value> LruCacheComponent<Key, Value, Hash, Equal>::DoGetByKeys(
+    const std::vector<Key>& keys) {
+  std::vector<Value> values;
+  values.reserve(keys.size());
+  for (const auto& key : keys) values.push_back(DoGetByKey(key));
+  return values;
+}
+
 template <typename Key, typename Value, typename Hash, typename Equal>
 void LruCacheComponent<Key, Value, Hash, Equal>::OnConfigUpdate(
     const dynamic_config::Snapshot& cfg) {
@@ -192,6 +271,10 @@ void LruCacheComponent<Key, Value, Hash, Equal>::UpdateConfig(
   cache_->SetWaySize(config.GetWaySize(static_config_.ways));
   cache_->SetMaxLifetime(config.lifetime);
   cache_->SetBackgroundUpdate(config.background_update);
+  cache_->SetPolicy(config.policy);
+  cache_->SetWayMaxWeight(config.GetWayMaxBytes(static_config_.ways));
+  cache_->SetNegativeWaySize(config.GetNegativeWaySize(static_config_.ways));
+  cache_->SetNegativeLifetime(config.negative_lifetime);
 }
 
 template <typename Key, typename Value, typename Hash, typename Equal>
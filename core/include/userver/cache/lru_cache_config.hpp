@@ -5,6 +5,7 @@
 #include <optional>
 #include <unordered_map>
 
+#include <userver/cache/policy.hpp>
 #include <userver/components/component_fwd.hpp>
 #include <userver/dynamic_config/snapshot.hpp>
 #include <userver/formats/json_fwd.hpp>
@@ -27,9 +28,19 @@ struct LruCacheConfig final {
 
   std::size_t GetWaySize(std::size_t ways) const;
 
+  /// 0 if the weight is unlimited
+  std::size_t GetWayMaxBytes(std::size_t ways) const;
+
+  /// 0 if the negative LRU is disabled
+  std::size_t GetNegativeWaySize(std::size_t ways) const;
+
   std::size_t size;
   std::chrono::milliseconds lifetime;
   BackgroundUpdateMode background_update;
+  CachePolicy policy;
+  std::size_t max_bytes;
+  std::size_t negative_size;
+  std::chrono::milliseconds negative_lifetime;
 };
 
 LruCacheConfig Parse(const formats::json::Value& value,
@@ -44,6 +55,9 @@ struct LruCacheConfigStatic final {
   LruCacheConfig config;
   std::size_t ways;
   bool use_dynamic_config;
+  /// 0 if the refresh-ahead is disabled
+  std::chrono::milliseconds refresh_ahead_interval;
+  std::size_t refresh_ahead_keys;
 };
 
 std::unordered_map<std::string, LruCacheConfig> ParseLruCacheConfigSet(
@@ -14,6 +14,7 @@ struct ExpirableLruCacheStatisticsBase final {
   std::atomic<std::size_t> hits{0};
   std::atomic<std::size_t> misses{0};
   std::atomic<std::size_t> stale{0};
+  std::atomic<std::size_t> negative_hits{0};
   std::atomic<std::size_t> background_updates{0};
 
   ExpirableLruCacheStatisticsBase();
@@ -39,6 +40,9 @@ void CacheMiss(ExpirableLruCacheStatistics& stats);
 
 void CacheStale(ExpirableLruCacheStatistics& stats);
 
+/// Hit of the negative LRU, also counted as a hit
+void CacheNegativeHit(ExpirableLruCacheStatistics& stats);
+
 }  // namespace cache::impl
 
 USERVER_NAMESPACE_END
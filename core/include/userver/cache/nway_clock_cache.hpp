@@ -0,0 +1,266 @@
+#pragma once
+
+/// @file userver/cache/nway_clock_cache.hpp
+/// @brief @copybrief cache::NWayClockCache
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <userver/concurrent/hash_map.hpp>
+#include <userver/engine/mutex.hpp>
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace cache {
+
+/// @ingroup userver_containers
+///
+/// @brief N-way cache with the CLOCK (second chance) eviction and lock-free
+/// lookups.
+///
+/// Has the same interface as cache::NWayLRU. Readers look the keys up in
+/// a concurrent::HashMap index of all the items and only set the "referenced"
+/// bit of the found item, so hot keys do not serialize the readers. Writers
+/// lock the way and update only the changed keys of the index, so writes are
+/// O(1) and do not copy the way.
+template <typename T, typename U, typename Hash = std::hash<T>,
+          typename Equal = std::equal_to<T>>
+class NWayClockCache final {
+ public:
+  NWayClockCache(size_t ways, size_t way_size, const Hash& hash = Hash(),
+                 const Equal& equal = Equal());
+
+  void Put(const T& key, U value);
+
+  template <typename Validator>
+  std::optional<U> Get(const T& key, Validator validator);
+
+  std::optional<U> Get(const T& key) {
+    return Get(key, [](const U&) { return true; });
+  }
+
+  U GetOr(const T& key, const U& default_value);
+
+  void Invalidate();
+
+  void InvalidateByKey(const T& key);
+
+  /// Iterates over all items. May be slow for big caches.
+  template <typename Function>
+  void VisitAll(Function func) const;
+
+  size_t GetSize() const;
+
+  void UpdateWaySize(size_t way_size);
+
+ private:
+  struct Entry {
+    Entry(const T& key, U value) : key(key), value(std::move(value)) {}
+
+    const T key;
+    const U value;
+    mutable std::atomic<bool> referenced{false};
+  };
+
+  using EntryPtr = std::shared_ptr<Entry>;
+
+  struct Way {
+    mutable engine::Mutex mutex;
+    // CLOCK ring of the entries of the way, guarded by mutex
+    std::vector<EntryPtr> ring;
+    std::unordered_map<T, size_t, Hash, Equal> ring_index;
+    size_t hand{0};
+    size_t max_size{0};
+  };
+
+  Way& GetWay(const T& key);
+
+  void InvalidateEntry(const Entry& entry);
+  void Insert(Way& way, EntryPtr entry);
+  void Erase(Way& way, const T& key);
+  size_t FindVictim(Way& way) const;
+  void RemoveSlot(Way& way, size_t slot);
+
+  // not resized, so Way does not need to be movable
+  std::vector<Way> caches_;
+  Hash hash_fn_;
+  // entries of all the ways for the lock-free lookups, a key is updated
+  // under the lock of its way
+  concurrent::HashMap<T, Entry, Hash, Equal> index_;
+};
+
+template <typename T, typename U, typename Hash, typename Eq>
+NWayClockCache<T, U, Hash, Eq>::NWayClockCache(size_t ways, size_t way_size,
+                                               const Hash& hash,
+                                               const Eq& equal)
+    : caches_(ways), hash_fn_(hash), index_(0, hash, equal) {
+  if (ways == 0) throw std::logic_error("Ways must be positive");
+  UpdateWaySize(way_size);
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+void NWayClockCache<T, U, Hash, Eq>::Put(const T& key, U value) {
+  auto& way = GetWay(key);
+  auto entry = std::make_shared<Entry>(key, std::move(value));
+
+  std::unique_lock<engine::Mutex> lock(way.mutex);
+  Insert(way, std::move(entry));
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+template <typename Validator>
+std::optional<U> NWayClockCache<T, U, Hash, Eq>::Get(const T& key,
+                                                     Validator validator) {
+  const auto entry = std::as_const(index_).Get(key);
+  if (!entry) return std::nullopt;
+
+  // avoid the cache line invalidation for the hot keys
+  if (!entry->referenced.load(std::memory_order_relaxed)) {
+    entry->referenced.store(true, std::memory_order_relaxed);
+  }
+
+  if (validator(entry->value)) return entry->value;
+  InvalidateEntry(*entry);
+  return std::nullopt;
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+U NWayClockCache<T, U, Hash, Eq>::GetOr(const T& key, const U& default_value) {
+  auto value = Get(key);
+  if (value) return std::move(*value);
+  return default_value;
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+void NWayClockCache<T, U, Hash, Eq>::Invalidate() {
+  for (auto& way : caches_) {
+    std::unique_lock<engine::Mutex> lock(way.mutex);
+    for (const auto& entry : way.ring) index_.Erase(entry->key);
+    way.ring.clear();
+    way.ring_index.clear();
+    way.hand = 0;
+  }
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+void NWayClockCache<T, U, Hash, Eq>::InvalidateByKey(const T& key) {
+  auto& way = GetWay(key);
+  std::unique_lock<engine::Mutex> lock(way.mutex);
+  Erase(way, key);
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+void NWayClockCache<T, U, Hash, Eq>::InvalidateEntry(const Entry& entry) {
+  auto& way = GetWay(entry.key);
+  std::unique_lock<engine::Mutex> lock(way.mutex);
+  // the entry might have been replaced with a fresh one after the lookup
+  const auto it = way.ring_index.find(entry.key);
+  if (it == way.ring_index.end() || way.ring[it->second].get() != &entry) {
+    return;
+  }
+  RemoveSlot(way, it->second);
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+template <typename Function>
+void NWayClockCache<T, U, Hash, Eq>::VisitAll(Function func) const {
+  for (const auto& way : caches_) {
+    std::unique_lock<engine::Mutex> lock(way.mutex);
+    for (const auto& entry : way.ring) func(entry->key, entry->value);
+  }
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+size_t NWayClockCache<T, U, Hash, Eq>::GetSize() const {
+  size_t size{0};
+  for (const auto& way : caches_) {
+    std::unique_lock<engine::Mutex> lock(way.mutex);
+    size += way.ring.size();
+  }
+  return size;
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+void NWayClockCache<T, U, Hash, Eq>::UpdateWaySize(size_t way_size) {
+  if (way_size == 0) way_size = 1;
+  for (auto& way : caches_) {
+    std::unique_lock<engine::Mutex> lock(way.mutex);
+    way.max_size = way_size;
+    while (way.ring.size() > way_size) RemoveSlot(way, FindVictim(way));
+  }
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+typename NWayClockCache<T, U, Hash, Eq>::Way&
+NWayClockCache<T, U, Hash, Eq>::GetWay(const T& key) {
+  auto n = hash_fn_(key) % caches_.size();
+  return caches_[n];
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+void NWayClockCache<T, U, Hash, Eq>::Insert(Way& way, EntryPtr entry) {
+  const auto it = way.ring_index.find(entry->key);
+  if (it != way.ring_index.end()) {
+    // an update counts as a use
+    entry->referenced.store(true, std::memory_order_relaxed);
+    way.ring[it->second] = entry;
+    index_.InsertOrAssign(entry->key, std::move(entry));
+    return;
+  }
+
+  size_t slot = way.ring.size();
+  if (way.ring.size() < way.max_size) {
+    way.ring.push_back(nullptr);
+  } else {
+    slot = FindVictim(way);
+    const auto& victim_key = way.ring[slot]->key;
+    index_.Erase(victim_key);
+    way.ring_index.erase(victim_key);
+  }
+  way.ring_index.emplace(entry->key, slot);
+  way.ring[slot] = entry;
+  index_.InsertOrAssign(entry->key, std::move(entry));
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+void NWayClockCache<T, U, Hash, Eq>::Erase(Way& way, const T& key) {
+  const auto it = way.ring_index.find(key);
+  if (it == way.ring_index.end()) return;
+  RemoveSlot(way, it->second);
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+size_t NWayClockCache<T, U, Hash, Eq>::FindVictim(Way& way) const {
+  UASSERT(!way.ring.empty());
+  // terminates in at most two rounds, as the bits are reset on the first one
+  while (true) {
+    if (way.hand >= way.ring.size()) way.hand = 0;
+    const auto& entry = *way.ring[way.hand];
+    if (!entry.referenced.exchange(false, std::memory_order_relaxed)) {
+      return way.hand++;
+    }
+    ++way.hand;
+  }
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+void NWayClockCache<T, U, Hash, Eq>::RemoveSlot(Way& way, size_t slot) {
+  index_.Erase(way.ring[slot]->key);
+  way.ring_index.erase(way.ring[slot]->key);
+  if (slot + 1 != way.ring.size()) {
+    way.ring[slot] = std::move(way.ring.back());
+    way.ring_index[way.ring[slot]->key] = slot;
+  }
+  way.ring.pop_back();
+}
+
+}  // namespace cache
+
+USERVER_NAMESPACE_END
@@ -17,7 +17,8 @@ template <typename T, typename U, typename Hash = std::hash<T>,
 class NWayLRU final {
  public:
   NWayLRU(size_t ways, size_t way_size, const Hash& hash = Hash(),
-          const Equal& equal = Equal());
+          const Equal& equal = Equal(),
+          CachePolicy policy = CachePolicy::kLRU);
 
   void Put(const T& key, U value);
 
@@ -42,6 +43,15 @@ class NWayLRU final {
 
   void UpdateWaySize(size_t way_size);
 
+  void UpdatePolicy(CachePolicy policy);
+
+  /// Limits the weight of each way, see cache::LruMap::SetMaxWeight
+  void UpdateWayMaxWeight(size_t way_max_weight);
+
+  size_t GetWeight() const;
+
+  size_t GetEvictedWeight() const;
+
  private:
   struct Way {
     Way(Way&& other) noexcept : cache(std::move(other.cache)) {}
@@ -61,13 +71,16 @@ class NWayLRU final {
 
 template <typename T, typename U, typename Hash, typename Eq>
 NWayLRU<T, U, Hash, Eq>::NWayLRU(size_t ways, size_t way_size, const Hash& hash,
-                                 const Eq& equal)
+                                 const Eq& equal, CachePolicy policy)
     : caches_(), hash_fn_(hash) {
   caches_.reserve(ways);
   for (size_t i = 0; i < ways; ++i) caches_.emplace_back(hash, equal);
   if (ways == 0) throw std::logic_error("Ways must be positive");
 
-  for (auto& way : caches_) way.cache.SetMaxSize(way_size);
+  for (auto& way : caches_) {
+    way.cache.SetMaxSize(way_size);
+    way.cache.SetPolicy(policy);
+  }
 }
 
 template <typename T, typename U, typename Hash, typename Eq>
@@ -143,6 +156,42 @@ void NWayLRU<T, U, Hash, Eq>::UpdateWaySize(size_t way_size) {
   }
 }
 
+template <typename T, typename U, typename Hash, typename Eq>
+void NWayLRU<T, U, Hash, Eq>::UpdatePolicy(CachePolicy policy) {
+  for (auto& way : caches_) {
+    std::unique_lock<engine::Mutex> lock(way.mutex);
+    way.cache.SetPolicy(policy);
+  }
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+void NWayLRU<T, U, Hash, Eq>::UpdateWayMaxWeight(size_t way_max_weight) {
+  for (auto& way : caches_) {
+    std::unique_lock<engine::Mutex> lock(way.mutex);
+    way.cache.SetMaxWeight(way_max_weight);
+  }
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+size_t NWayLRU<T, U, Hash, Eq>::GetWeight() const {
+  size_t weight{0};
+  for (const auto& way : caches_) {
+    std::unique_lock<engine::Mutex> lock(way.mutex);
+    weight += way.cache.GetWeight();
+  }
+  return weight;
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+size_t NWayLRU<T, U, Hash, Eq>::GetEvictedWeight() const {
+  size_t weight{0};
+  for (const auto& way : caches_) {
+    std::unique_lock<engine::Mutex> lock(way.mutex);
+    weight += way.cache.GetEvictedWeight();
+  }
+  return weight;
+}
+
 template <typename T, typename U, typename Hash, typename Eq>
 typename NWayLRU<T, U, Hash, Eq>::Way& NWayLRU<T, U, Hash, Eq>::GetWay(
     const T& key) {
@@ -0,0 +1,464 @@
+#pragma once
+
+/// @file userver/cache/persistent_hash_map.hpp
+/// @brief @copybrief cache::PersistentHashMap
+
+#include <atomic>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <userver/dump/operations.hpp>
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace cache {
+
+/// @ingroup userver_containers
+///
+/// @brief Hash map with structural sharing (hash array mapped trie).
+///
+/// Copying is O(1): the copies share all the data, and a modification copies
+/// only the O(log32(N)) nodes on the path to the changed key. Applying K
+/// changes to a copy costs O(K) time and memory, while the original keeps
+/// being readable.
+///
+/// Meant to be the data type of components::CachingComponentBase with
+/// incremental updates:
+/// @code
+///   auto data = *Get();  // cheap copy
+///   for (auto& [key, value] : changed_rows) {
+///     data.InsertOrAssign(key, std::move(value));
+///   }
+///   Set(std::move(data));
+/// @endcode
+///
+/// Nodes that are not shared with other copies are modified in place, so
+/// building a new map does not copy anything either.
+///
+/// Lookups take a few cache misses per trie level and are several times
+/// slower than in std::unordered_map, so prefer the latter for small or
+/// rarely updated caches.
+///
+/// Thread safety matches Standard Library containers: distinct copies may be
+/// used concurrently. Iterators are invalidated by any modification.
+template <typename Key, typename Value, typename Hash = std::hash<Key>,
+          typename Equal = std::equal_to<Key>>
+class PersistentHashMap final {
+ public:
+  using key_type = Key;
+  using mapped_type = Value;
+  using value_type = std::pair<const Key, Value>;
+
+  class ConstIterator;
+  using const_iterator = ConstIterator;
+  using iterator = ConstIterator;
+
+  explicit PersistentHashMap(const Hash& hash = Hash(),
+                             const Equal& equal = Equal())
+      : hash_(hash), equal_(equal) {}
+
+  /// @returns pointer to the value or nullptr if there is no such key
+  const Value* Get(const Key& key) const;
+
+  bool Contains(const Key& key) const { return Get(key) != nullptr; }
+
+  /// @returns true if the key is a new one
+  bool InsertOrAssign(Key key, Value value);
+
+  /// @returns true if the key was removed
+  bool Erase(const Key& key);
+
+  void Clear() noexcept;
+
+  std::size_t size() const noexcept { return size_; }
+  bool empty() const noexcept { return size_ == 0; }
+
+  ConstIterator begin() const { return ConstIterator{root_.get()}; }
+  ConstIterator end() const { return ConstIterator{}; }
+
+ private:
+  static constexpr unsigned kBits = 5;
+  static constexpr unsigned kHashBits = sizeof(std::size_t) * 8;
+
+  struct Entry {
+    Entry(std::size_t key_hash, Key&& key, Value&& mapped)
+        : hash(key_hash), value(std::move(key), std::move(mapped)) {}
+
+    const std::size_t hash;
+    const value_type value;
+  };
+
+  using EntryPtr = std::shared_ptr<const Entry>;
+
+  struct Node;
+
+  // Nodes are modified in place only if the map is their sole owner. Unlike
+  // shared_ptr::use_count(), the unique ownership check here is an acquire
+  // load that pairs with the release of the last reference by another copy,
+  // so the accesses of that copy happen before the modification.
+  class NodePtr final {
+   public:
+    NodePtr() = default;
+    explicit NodePtr(Node* node) noexcept : node_(node) {}
+
+    NodePtr(const NodePtr& other) noexcept : node_(other.node_) {
+      if (node_) node_->refs.fetch_add(1, std::memory_order_relaxed);
+    }
+    NodePtr(NodePtr&& other) noexcept
+        : node_(std::exchange(other.node_, nullptr)) {}
+    NodePtr& operator=(NodePtr other) noexcept {
+      std::swap(node_, other.node_);
+      return *this;
+    }
+    ~NodePtr() { reset(); }
+
+    void reset() noexcept {
+      if (node_ && node_->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        delete node_;
+      }
+      node_ = nullptr;
+    }
+
+    bool IsUnique() const noexcept {
+      UASSERT(node_);
+      return node_->refs.load(std::memory_order_acquire) == 1;
+    }
+
+    Node* get() const noexcept { return node_; }
+    Node& operator*() const noexcept { return *node_; }
+    Node* operator->() const noexcept { return node_; }
+    explicit operator bool() const noexcept { return node_ != nullptr; }
+
+   private:
+    Node* node_{nullptr};
+  };
+
+  // Entries and children are ordered by their hash bits at the node level.
+  // Nodes deeper than kHashBits hold the full hash collisions and do not use
+  // the bitmaps.
+  struct Node {
+    Node() = default;
+    Node(const Node& other)
+        : entry_map(other.entry_map),
+          child_map(other.child_map),
+          entries(other.entries),
+          children(other.children) {}
+
+    std::atomic<std::size_t> refs{1};
+    std::uint32_t entry_map{0};
+    std::uint32_t child_map{0};
+    std::vector<EntryPtr> entries;
+    std::vector<NodePtr> children;
+  };
+
+  static std::uint32_t GetBit(std::size_t hash, unsigned shift) noexcept {
+    return std::uint32_t{1} << ((hash >> shift) & ((1 << kBits) - 1));
+  }
+
+  static std::size_t GetPos(std::uint32_t map, std::uint32_t bit) noexcept {
+    return std::bitset<32>{map & (bit - 1)}.count();
+  }
+
+  static Node& MakeMutable(NodePtr& node);
+  static NodePtr MakeNode(EntryPtr first, EntryPtr second, unsigned shift);
+
+  bool DoInsert(NodePtr& node_ptr, EntryPtr&& entry, unsigned shift);
+  void DoErase(NodePtr& node_ptr, const Key& key, std::size_t hash,
+               unsigned shift);
+
+  NodePtr root_;
+  std::size_t size_{0};
+  Hash hash_;
+  Equal equal_;
+};
+
+/// Forward iterator over std::pair<const Key, Value>
+template <typename Key, typename Value, typename Hash, typename Equal>
+class PersistentHashMap<Key, Value, Hash, Equal>::ConstIterator final {
+ public:
+  using iterator_category = std::forward_iterator_tag;
+  using value_type = typename PersistentHashMap::value_type;
+  using difference_type = std::ptrdiff_t;
+  using reference = const value_type&;
+  using pointer = const value_type*;
+
+  ConstIterator() = default;
+
+  reference operator*() const {
+    UASSERT(current_);
+    return *current_;
+  }
+  pointer operator->() const { return &**this; }
+
+  ConstIterator& operator++() {
+    Advance();
+    return *this;
+  }
+
+  ConstIterator operator++(int) {
+    auto copy = *this;
+    Advance();
+    return copy;
+  }
+
+  bool operator==(const ConstIterator& other) const {
+    return current_ == other.current_;
+  }
+  bool operator!=(const ConstIterator& other) const {
+    return !(*this == other);
+  }
+
+ private:
+  friend class PersistentHashMap;
+
+  struct Frame {
+    const Node* node;
+    std::size_t entry;
+    std::size_t child;
+  };
+
+  explicit ConstIterator(const Node* root) {
+    if (!root) return;
+    stack_.push_back({root, 0, 0});
+    Advance();
+  }
+
+  void Advance() {
+    while (!stack_.empty()) {
+      auto& frame = stack_.back();
+      if (frame.entry < frame.node->entries.size()) {
+        current_ = &frame.node->entries[frame.entry++]->value;
+        return;
+      }
+      if (frame.child < frame.node->children.size()) {
+        const Node* child = frame.node->children[frame.child++].get();
+        stack_.push_back({child, 0, 0});
+        continue;
+      }
+      stack_.pop_back();
+    }
+    current_ = nullptr;
+  }
+
+  std::vector<Frame> stack_;
+  const value_type* current_{nullptr};
+};
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+const Value* PersistentHashMap<Key, Value, Hash, Equal>::Get(
+    const Key& key) const {
+  const auto hash = hash_(key);
+  const Node* node = root_.get();
+  for (unsigned shift = 0; node; shift += kBits) {
+    if (shift >= kHashBits) {
+      for (const auto& entry : node->entries) {
+        if (equal_(entry->value.first, key)) return &entry->value.second;
+      }
+      return nullptr;
+    }
+
+    const auto bit = GetBit(hash, shift);
+    if (node->entry_map & bit) {
+      const auto& entry = node->entries[GetPos(node->entry_map, bit)];
+      if (entry->hash != hash || !equal_(entry->value.first, key)) {
+        return nullptr;
+      }
+      return &entry->value.second;
+    }
+    if (!(node->child_map & bit)) return nullptr;
+    node = node->children[GetPos(node->child_map, bit)].get();
+  }
+  return nullptr;
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+bool PersistentHashMap<Key, Value, Hash, Equal>::InsertOrAssign(Key key,
+                                                                Value value) {
+  const auto hash = hash_(key);
+  auto entry = std::make_shared<const Entry>(hash, std::move(key),
+                                             std::move(value));
+  if (!root_) root_ = NodePtr{new Node{}};
+
+  const bool is_new = DoInsert(root_, std::move(entry), 0);
+  if (is_new) ++size_;
+  return is_new;
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+bool PersistentHashMap<Key, Value, Hash, Equal>::Erase(const Key& key) {
+  // avoid copying the path to a missing key
+  if (!Contains(key)) return false;
+
+  DoErase(root_, key, hash_(key), 0);
+  --size_;
+  return true;
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+void PersistentHashMap<Key, Value, Hash, Equal>::Clear() noexcept {
+  root_.reset();
+  size_ = 0;
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+typename PersistentHashMap<Key, Value, Hash, Equal>::Node&
+PersistentHashMap<Key, Value, Hash, Equal>::MakeMutable(NodePtr& node) {
+  UASSERT(node);
+  // Only this map references a unique node, nobody can start sharing it
+  // concurrently
+  if (!node.IsUnique()) node = NodePtr{new Node{*node}};
+  return *node;
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+typename PersistentHashMap<Key, Value, Hash, Equal>::NodePtr
+PersistentHashMap<Key, Value, Hash, Equal>::MakeNode(EntryPtr first,
+                                                     EntryPtr second,
+                                                     unsigned shift) {
+  NodePtr node{new Node{}};
+  if (shift >= kHashBits) {
+    node->entries = {std::move(first), std::move(second)};
+    return node;
+  }
+
+  const auto first_bit = GetBit(first->hash, shift);
+  const auto second_bit = GetBit(second->hash, shift);
+  if (first_bit == second_bit) {
+    node->child_map = first_bit;
+    node->children.push_back(
+        MakeNode(std::move(first), std::move(second), shift + kBits));
+    return node;
+  }
+
+  node->entry_map = first_bit | second_bit;
+  if (first_bit < second_bit) {
+    node->entries = {std::move(first), std::move(second)};
+  } else {
+    node->entries = {std::move(second), std::move(first)};
+  }
+  return node;
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+bool PersistentHashMap<Key, Value, Hash, Equal>::DoInsert(NodePtr& node_ptr,
+                                                          EntryPtr&& entry,
+                                                          unsigned shift) {
+  auto& node = MakeMutable(node_ptr);
+
+  if (shift >= kHashBits) {
+    for (auto& existing : node.entries) {
+      if (equal_(existing->value.first, entry->value.first)) {
+        existing = std::move(entry);
+        return false;
+      }
+    }
+    node.entries.push_back(std::move(entry));
+    return true;
+  }
+
+  const auto bit = GetBit(entry->hash, shift);
+  if (node.entry_map & bit) {
+    const auto pos = GetPos(node.entry_map, bit);
+    auto& existing = node.entries[pos];
+    if (existing->hash == entry->hash &&
+        equal_(existing->value.first, entry->value.first)) {
+      existing = std::move(entry);
+      return false;
+    }
+
+    auto child = MakeNode(std::move(existing), std::move(entry), shift + kBits);
+    node.entries.erase(node.entries.begin() + pos);
+    node.entry_map ^= bit;
+    node.children.insert(
+        node.children.begin() + GetPos(node.child_map, bit), std::move(child));
+    node.child_map |= bit;
+    return true;
+  }
+
+  if (node.child_map & bit) {
+    return DoInsert(node.children[GetPos(node.child_map, bit)],
+                    std::move(entry), shift + kBits);
+  }
+
+  node.entries.insert(node.entries.begin() + GetPos(node.entry_map, bit),
+                      std::move(entry));
+  node.entry_map |= bit;
+  return true;
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+void PersistentHashMap<Key, Value, Hash, Equal>::DoErase(NodePtr& node_ptr,
+                                                         const Key& key,
+                                                         std::size_t hash,
+                                                         unsigned shift) {
+  auto& node = MakeMutable(node_ptr);
+
+  if (shift >= kHashBits) {
+    for (auto it = node.entries.begin(); it != node.entries.end(); ++it) {
+      if (equal_((*it)->value.first, key)) {
+        node.entries.erase(it);
+        return;
+      }
+    }
+    UINVARIANT(false, "Erased key is missing");
+  }
+
+  const auto bit = GetBit(hash, shift);
+  if (node.entry_map & bit) {
+    node.entries.erase(node.entries.begin() + GetPos(node.entry_map, bit));
+    node.entry_map ^= bit;
+    return;
+  }
+
+  UASSERT(node.child_map & bit);
+  const auto child_pos = GetPos(node.child_map, bit);
+  auto& child = node.children[child_pos];
+  DoErase(child, key, hash, shift + kBits);
+
+  // keep the trie compact: a lone entry moves up to the parent
+  if (child->children.empty() && child->entries.size() == 1) {
+    auto entry = child->entries.front();
+    node.children.erase(node.children.begin() + child_pos);
+    node.child_map ^= bit;
+    node.entries.insert(node.entries.begin() + GetPos(node.entry_map, bit),
+                        std::move(entry));
+    node.entry_map |= bit;
+  }
+}
+
+/// @brief Dump support for cache::PersistentHashMap
+template <typename Key, typename Value, typename Hash, typename Equal>
+void Write(dump::Writer& writer,
+           const PersistentHashMap<Key, Value, Hash, Equal>& map) {
+  writer.Write(map.size());
+  for (const auto& [key, value] : map) {
+    writer.Write(key);
+    writer.Write(value);
+  }
+}
+
+/// @brief Dump support for cache::PersistentHashMap
+template <typename Key, typename Value, typename Hash, typename Equal>
+PersistentHashMap<Key, Value, Hash, Equal> Read(
+    dump::Reader& reader,
+    dump::To<PersistentHashMap<Key, Value, Hash, Equal>>) {
+  const auto size = reader.Read<std::size_t>();
+  PersistentHashMap<Key, Value, Hash, Equal> result;
+  for (std::size_t i = 0; i < size; ++i) {
+    auto key = reader.Read<Key>();
+    auto value = reader.Read<Value>();
+    result.InsertOrAssign(std::move(key), std::move(value));
+  }
+  return result;
+}
+
+}  // namespace cache
+
+USERVER_NAMESPACE_END
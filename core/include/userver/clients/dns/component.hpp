@@ -3,6 +3,9 @@
 /// @file userver/clients/dns/component.hpp
 /// @brief @copybrief clients::dns::Component
 
+#include <string>
+#include <unordered_set>
+
 #include <userver/clients/dns/resolver.hpp>
 #include <userver/components/loggable_component_base.hpp>
 #include <userver/utils/statistics/entry.hpp>
@@ -33,6 +36,9 @@ namespace clients::dns {
 /// cache-size-per-way | size of each way of network cache | 256
 /// cache-max-reply-ttl | TTL limit for network replies caching | 5m
 /// cache-failure-ttl | TTL for network failures caching | 5s
+/// cache-max-stale | max time after the expiration to serve a cached reply while it is being updated | 5m
+/// cache-refresh-interval | interval of background updates of the recently used names that are about to expire, 0 disables background updates | 1s
+/// names-statistics | names to export the per-name metrics for, the metrics of the other names are only aggregated | []
 ///
 /// ## Static configuration example:
 ///
@@ -55,6 +61,7 @@ class Component final : public components::LoggableComponentBase {
 
  private:
   Resolver resolver_;
+  std::unordered_set<std::string> names_with_statistics_;
   utils::statistics::Entry statistics_holder_;
 };
 
@@ -39,6 +39,14 @@ struct ResolverConfig {
 
   /// Network cache failure TTL
   std::chrono::milliseconds cache_failure_ttl{std::chrono::seconds{5}};
+
+  /// Max time after the expiration to serve a cached reply while it is being
+  /// updated
+  std::chrono::milliseconds cache_max_stale{std::chrono::minutes{5}};
+
+  /// Interval of background updates of the recently used names that are
+  /// about to expire, zero disables background updates
+  std::chrono::milliseconds cache_refresh_interval{std::chrono::seconds{1}};
 };
 
 }  // namespace clients::dns
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <string>
+#include <unordered_map>
+
 #include <userver/clients/dns/common.hpp>
 #include <userver/clients/dns/config.hpp>
 #include <userver/clients/dns/exception.hpp>
@@ -30,6 +33,15 @@ class Resolver {
     utils::statistics::RelaxedCounter<size_t> network_failure{0};
   };
 
+  /// Counters of a name resolved via network
+  struct NameCounters {
+    /// replies served from the network cache
+    size_t hits{0};
+    /// updates performed in background
+    size_t refreshes{0};
+    size_t refresh_failures{0};
+  };
+
   Resolver(engine::TaskProcessor& fs_task_processor,
            const ResolverConfig& config);
   Resolver(const Resolver&) = delete;
@@ -50,6 +62,10 @@ class Resolver {
   /// Returns lookup source counters.
   const LookupSourceCounters& GetLookupSourceCounters() const;
 
+  /// Returns counters of the recently used names that are resolved via
+  /// network and are kept up to date in background.
+  std::unordered_map<std::string, NameCounters> GetNameCounters() const;
+
   /// Forces the reload of lookup table file. Waits until the reload is done.
   void ReloadHosts();
 
@@ -61,7 +77,7 @@ class Resolver {
 
  private:
   class Impl;
-  constexpr static size_t kSize = 1568;
+  constexpr static size_t kSize = 2056;
   constexpr static size_t kAlignment = 16;
   utils::FastPimpl<Impl, kSize, kAlignment> impl_;
 };
@@ -7,7 +7,12 @@
 #error Use clients::Http from clients/http.hpp instead
 #endif
 
+#include <atomic>
+#include <chrono>
 #include <memory>
+#include <optional>
+#include <string>
+#include <vector>
 
 #include <userver/moodycamel/concurrentqueue_fwd.h>
 
@@ -40,6 +45,7 @@ class EasyWrapper;
 }  // namespace impl
 
 class DestinationStatistics;
+class ResponseCache;
 struct Config;
 struct TestsuiteConfig;
 
@@ -47,6 +53,23 @@ struct ClientSettings final {
   std::string thread_name_prefix;
   size_t io_threads = 8;
   bool defer_events = false;
+  /// Max total size of the in-process response cache, 0 disables the cache
+  size_t response_cache_max_bytes = 0;
+  size_t response_cache_max_entries = 10000;
+
+  /// URLs to establish connections to in advance, see Client::Prewarm()
+  std::vector<std::string> prewarm_destinations;
+  /// Number of connections to establish to each destination from each of the
+  /// io threads, as every thread has its own connection pool
+  size_t prewarm_connections_per_thread = 1;
+  std::chrono::milliseconds prewarm_timeout{1000};
+  /// Period of the check that re-establishes the prewarmed connections of
+  /// the io threads that have fewer than prewarm_connections_per_thread open
+  /// connections to a destination, zero disables the check. Destinations with
+  /// the same origin share the connections.
+  /// A change of the DNS records of a destination does not trigger prewarming,
+  /// as curl reuses the connections to the old addresses by the host name.
+  std::chrono::milliseconds prewarm_interval{0};
 };
 
 ClientSettings Parse(const yaml_config::YamlConfig& value,
@@ -84,6 +107,24 @@ class Client final {
 
   const http::DestinationStatistics& GetDestinationStatistics() const;
 
+  /// @brief Returns statistics of the response cache, std::nullopt if the
+  /// cache is disabled by ClientSettings::response_cache_max_bytes.
+  std::optional<ResponseCacheStatistics> GetResponseCacheStatistics() const;
+
+  /// @brief Establishes connections to ClientSettings::prewarm_destinations
+  /// from all the io threads by sending concurrent HEAD requests. Blocks
+  /// until the requests are finished. Any HTTP response is a success.
+  ///
+  /// If ClientSettings::prewarm_interval is not zero, starts a periodic top-up
+  /// of the io threads whose open connections to a destination fell below
+  /// the prewarmed amount. Connections to other hosts are not counted, and
+  /// threads with enough connections are not sent any requests.
+  void Prewarm();
+
+  /// @brief Returns statistics of the connection prewarming, std::nullopt if
+  /// there are no ClientSettings::prewarm_destinations.
+  std::optional<PrewarmStatistics> GetPrewarmStatistics() const;
+
   void SetTestsuiteConfig(const TestsuiteConfig& config);
 
   void SetConfig(const Config&);
@@ -109,6 +150,11 @@ class Client final {
 
  private:
   void ReinitEasy();
+  std::shared_ptr<Request> CreateRequestForMulti(size_t multi_index);
+  void TopUpPrewarmedConnections();
+  // connections[destination][multi]
+  void SendPrewarmRequests(const std::vector<std::vector<size_t>>& connections);
+  void SetupRequest(Request& request);
 
   InstanceStatistics GetMultiStatistics(size_t n) const;
 
@@ -152,6 +198,18 @@ class Client final {
   std::shared_ptr<curl::ConnectRateLimiter> connect_rate_limiter_;
 
   clients::dns::Resolver* resolver_{nullptr};
+
+  std::shared_ptr<ResponseCache> response_cache_;
+
+  const std::vector<std::string> prewarm_destinations_;
+  const size_t prewarm_connections_per_thread_;
+  const std::chrono::milliseconds prewarm_timeout_;
+  const std::chrono::milliseconds prewarm_interval_;
+  std::atomic<uint64_t> prewarm_attempts_{0};
+  std::atomic<uint64_t> prewarm_established_{0};
+  std::atomic<uint64_t> prewarm_failures_{0};
+  std::atomic<std::chrono::milliseconds> prewarm_last_duration_{};
+  utils::PeriodicTask prewarm_task_;
 };
 
 }  // namespace clients::http
@@ -48,6 +48,12 @@ using TaxiConfig = DynamicConfig;
 /// testsuite-enabled | enable testsuite testing support | false
 /// testsuite-timeout | if set, force the request timeout regardless of the value passed in code | -
 /// testsuite-allowed-url-prefixes | if set, checks that all URLs start with any of the passed prefixes, asserts if not. Set for testing purposes only. | ''
+/// response-cache-max-bytes | max total size of the in-process cache of GET responses that honours Cache-Control, ETag and Last-Modified; 0 disables the cache | 0
+/// response-cache-max-entries | max number of responses in the in-process response cache | 10000
+/// prewarm-destinations | URLs to send HEAD requests to at start to establish connections to the upstreams | -
+/// prewarm-connections-per-thread | number of connections to establish to each of the prewarm-destinations from each of the threads | 1
+/// prewarm-timeout | timeout of a prewarm request | 1s
+/// prewarm-interval | period of the check that re-establishes connections for the threads that have fewer open connections to a destination than were prewarmed, 0 to prewarm only at start; DNS changes do not trigger prewarming | 0
 /// dns_resolver | server hostname resolver type (getaddrinfo or async) | 'getaddrinfo'
 ///
 /// ## Static configuration example:
@@ -0,0 +1,94 @@
+#pragma once
+
+/// @file userver/clients/http/impl/body_chain.hpp
+/// @brief @copybrief clients::http::impl::BodyChain
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace clients::http::impl {
+
+/// @brief Accumulates the HTTP response body without reallocations.
+///
+/// If the size of the body is known in advance (`Content-Length`), the data
+/// is written into a single presized buffer. Otherwise the data goes into
+/// a chain of fixed-size chunks that are taken from and returned to a process
+/// wide pool, so growing the body never moves the already received bytes.
+///
+/// Not thread safe, except for concurrent calls of the const member functions.
+class BodyChain final {
+ public:
+  static constexpr std::size_t kChunkSize = 16 * 1024;
+
+  /// Bodies above this size are never presized to protect from bogus
+  /// `Content-Length` values, they are accumulated in chunks instead.
+  static constexpr std::size_t kMaxReserve = 64 * 1024 * 1024;
+
+  BodyChain() = default;
+  /// Copies the data into a single contiguous buffer
+  BodyChain(const BodyChain& other);
+  BodyChain(BodyChain&& other) noexcept;
+  BodyChain& operator=(const BodyChain& other);
+  BodyChain& operator=(BodyChain&& other) noexcept;
+  ~BodyChain();
+
+  /// Presizes the contiguous buffer, does nothing if some data was already
+  /// appended or if `size` exceeds kMaxReserve.
+  void Reserve(std::size_t size);
+
+  void Append(std::string_view data);
+
+  /// Drops the data, returns chunks to the pool
+  void Clear() noexcept;
+
+  std::size_t Size() const noexcept { return size_; }
+  bool IsEmpty() const noexcept { return size_ == 0; }
+
+  /// Returns the views of the data in order, views are valid until the next
+  /// modification of the BodyChain.
+  std::vector<std::string_view> GetBuffers() const;
+
+  /// @brief Returns the data as a single contiguous view.
+  ///
+  /// Data of a single buffer is returned as is. Otherwise the data is copied
+  /// into a contiguous string on the first call, the string is kept until the
+  /// next modification of the BodyChain. The view is valid until the next
+  /// modification of the BodyChain.
+  std::string_view View() const;
+
+  /// Returns the data as a single string and clears the BodyChain. Does not
+  /// copy the data if it was written into the presized buffer.
+  std::string Extract();
+
+ private:
+  struct Chunk final {
+    std::size_t size{0};
+    std::array<char, kChunkSize> data;
+  };
+
+  struct ChunkDeleter final {
+    void operator()(Chunk* chunk) const noexcept;
+  };
+  using ChunkPtr = std::unique_ptr<Chunk, ChunkDeleter>;
+
+  static ChunkPtr AcquireChunk();
+
+  void DropJoined() noexcept;
+
+  std::string contiguous_;
+  std::vector<ChunkPtr> chunks_;
+  std::size_t size_{0};
+  // Contiguous copy of the chunks built by View(), owned by the BodyChain
+  mutable std::atomic<std::string*> joined_{nullptr};
+};
+
+}  // namespace clients::http::impl
+
+USERVER_NAMESPACE_END
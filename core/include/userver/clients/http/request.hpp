@@ -10,6 +10,7 @@
 #include <userver/clients/http/error.hpp>
 #include <userver/clients/http/response.hpp>
 #include <userver/clients/http/response_future.hpp>
+#include <userver/clients/http/streamed_response.hpp>
 #include <userver/crypto/certificate.hpp>
 #include <userver/crypto/private_key.hpp>
 
@@ -19,6 +20,7 @@ USERVER_NAMESPACE_BEGIN
 namespace clients::http {
 
 class RequestState;
+class ResponseCache;
 namespace impl {
 class EasyWrapper;
 }  // namespace impl
@@ -61,10 +63,15 @@ class Request final : public std::enable_shared_from_this<Request> {
   /// Request cookies container type
   using Cookies = std::unordered_map<std::string, std::string>;
 
+  /// Default limit of buffered chunks for async_perform_stream_body(), cURL
+  /// delivers up to 16KiB per chunk
+  static constexpr std::size_t kDefaultMaxQueuedChunks = 64;
+
   explicit Request(std::shared_ptr<impl::EasyWrapper>&&,
                    std::shared_ptr<RequestStats>&& req_stats,
                    const std::shared_ptr<DestinationStatistics>& dest_stats,
-                   clients::dns::Resolver* resolver);
+                   clients::dns::Resolver* resolver,
+                   std::shared_ptr<ResponseCache> response_cache = {});
 
   /// Specifies method
   std::shared_ptr<Request> method(HttpMethod method);
@@ -176,6 +183,15 @@ class Request final : public std::enable_shared_from_this<Request> {
   /// Useful to proxy replies 'as is'.
   std::shared_ptr<Request> DisableReplyDecoding();
 
+  /// Do not use the client response cache for this request: the response is
+  /// neither taken from the cache nor stored into it.
+  ///
+  /// Only GET requests are cached and only if the cache is enabled via
+  /// ClientSettings::response_cache_max_bytes. Requests with
+  /// DisableReplyDecoding() or a custom `Accept-Encoding` header bypass the
+  /// cache.
+  std::shared_ptr<Request> DisableResponseCache();
+
   /// Enable auto add header with client timeout.
   std::shared_ptr<Request> EnableAddClientTimeoutHeader();
 
@@ -206,6 +222,14 @@ class Request final : public std::enable_shared_from_this<Request> {
   /// @snippet src/clients/http/client_test.cpp  HTTP Client - request reuse
   [[nodiscard]] std::shared_ptr<Response> perform();
 
+  /// @brief Perform request asynchronously, receiving the body chunk by chunk.
+  ///
+  /// At most `max_queued_chunks` received chunks are buffered, receiving is
+  /// paused until the reader catches up. Streamed requests are not retried
+  /// and bypass the response cache.
+  [[nodiscard]] StreamedResponse async_perform_stream_body(
+      std::size_t max_queued_chunks = kDefaultMaxQueuedChunks);
+
   /// Returns a reference to the original URL of a request
   const std::string& GetUrl() const;
 
@@ -5,10 +5,14 @@
 
 #include <iosfwd>
 #include <string>
+#include <string_view>
 #include <unordered_map>
+#include <vector>
 
 #include <userver/clients/http/error.hpp>
+#include <userver/clients/http/impl/body_chain.hpp>
 #include <userver/clients/http/local_stats.hpp>
+#include <userver/formats/json_fwd.hpp>
 #include <userver/utils/str_icase.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -50,14 +54,38 @@ class Response final {
   Response() = default;
 
   /// response string
-  std::string& sink_string() { return response_; }
+  std::string& sink_string() {
+    MaterializeBody();
+    return response_;
+  }
 
-  /// body as string
-  std::string body() const& { return response_; }
-  std::string&& body() && { return std::move(response_); }
+  /// @cond
+  /// Place for the response body that is filled by the HTTP client
+  impl::BodyChain& sink_chain() { return body_chain_; }
+  /// @endcond
 
-  /// body as string_view
-  std::string_view body_view() const { return response_; }
+  /// body as string
+  std::string body() const& { return std::string{body_view()}; }
+  std::string&& body() && {
+    MaterializeBody();
+    return std::move(response_);
+  }
+
+  /// @brief body as string_view
+  ///
+  /// A body received into several buffers is concatenated on the first call
+  /// and the contiguous copy is kept with the response. Use GetBodyBuffers()
+  /// or GetBodyAsJson() to avoid the concatenation.
+  std::string_view body_view() const;
+
+  /// @brief body as a sequence of buffers, avoids concatenation of the
+  /// received data.
+  ///
+  /// The views are valid until the response is modified.
+  std::vector<std::string_view> GetBodyBuffers() const;
+
+  /// body parsed as JSON without concatenation of the received data
+  formats::json::Value GetBodyAsJson() const;
 
   /// return referece to headers
   const Headers& headers() const { return headers_; }
@@ -80,8 +108,14 @@ class Response final {
   void SetStatusCode(Status status_code) { status_code_ = status_code; }
 
  private:
+  void MaterializeBody();
+
   Headers headers_;
+  // The body is either in response_ or in body_chain_. It is moved to
+  // response_ only by the non-const accessors, so the const ones may be called
+  // concurrently.
   std::string response_;
+  impl::BodyChain body_chain_;
   Status status_code_{Status::Invalid};
   LocalStats stats_;
 };
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <chrono>
 #include <cstdint>
 #include <memory>
 #include <unordered_map>
@@ -134,6 +135,33 @@ struct PoolStatistics {
   std::vector<InstanceStatistics> multi;
 };
 
+/// Statistics of the optional in-process response cache of clients::http::Client
+struct ResponseCacheStatistics {
+  /// responses served without a network request
+  uint64_t hits{0};
+  /// requests that were performed over the network
+  uint64_t misses{0};
+  /// stale responses confirmed by `304 Not Modified`
+  uint64_t revalidations{0};
+  uint64_t stores{0};
+  uint64_t evictions{0};
+  size_t entries{0};
+  size_t bytes{0};
+  size_t max_bytes{0};
+};
+
+/// Statistics of the connection prewarming of clients::http::Client
+struct PrewarmStatistics {
+  /// prewarm requests sent
+  uint64_t attempts{0};
+  /// prewarm requests that got any HTTP response
+  uint64_t established{0};
+  /// prewarm requests that failed to connect or timed out
+  uint64_t failures{0};
+  /// duration of the last prewarm round
+  std::chrono::milliseconds last_duration{0};
+};
+
 enum class FormatMode {
   kModeAll,
   kModeDestination,
@@ -145,6 +173,12 @@ formats::json::ValueBuilder StatisticsToJson(
 
 formats::json::ValueBuilder PoolStatisticsToJson(const PoolStatistics& stats);
 
+formats::json::ValueBuilder ResponseCacheStatisticsToJson(
+    const ResponseCacheStatistics& stats);
+
+formats::json::ValueBuilder PrewarmStatisticsToJson(
+    const PrewarmStatistics& stats);
+
 }  // namespace http
 }  // namespace clients
 
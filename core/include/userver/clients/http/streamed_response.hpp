@@ -0,0 +1,82 @@
+#pragma once
+
+/// @file userver/clients/http/streamed_response.hpp
+/// @brief @copybrief clients::http::StreamedResponse
+
+#include <memory>
+#include <string>
+
+#include <userver/clients/http/response.hpp>
+#include <userver/clients/http/response_future.hpp>
+#include <userver/concurrent/queue.hpp>
+#include <userver/engine/future.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace clients::http {
+
+class RequestState;
+
+/// Queue of the received body chunks. There is a single producer, so the
+/// chunks are delivered in order.
+using StreamedBodyQueue = concurrent::NonFifoSpscQueue<std::string>;
+
+/// @brief HTTP response with the body that is received chunk by chunk.
+///
+/// Status and headers are available as soon as the headers of the final
+/// response are received, before any of the body.
+/// The body is received into a bounded queue, receiving is paused while the
+/// queue is full, so a slow reader does not cause unbounded memory growth.
+///
+/// @code
+///   auto response = http_client.CreateRequest()
+///                       ->get(url)
+///                       ->timeout(std::chrono::minutes{10})
+///                       ->async_perform_stream_body();
+///   if (response.StatusCode() != clients::http::Status::OK) return;
+///
+///   std::string chunk;
+///   while (response.ReadChunk(chunk)) Process(chunk);
+/// @endcode
+class StreamedResponse final {
+ public:
+  StreamedResponse(StreamedResponse&&) noexcept = default;
+  StreamedResponse& operator=(StreamedResponse&&) noexcept = default;
+  StreamedResponse(const StreamedResponse&) = delete;
+  StreamedResponse& operator=(const StreamedResponse&) = delete;
+  ~StreamedResponse();
+
+  /// Waits for the status line and the headers.
+  /// @throws HttpException if the request failed before the headers arrived
+  Status StatusCode();
+
+  /// Waits for the status line and the headers.
+  /// @throws HttpException if the request failed before the headers arrived
+  const Headers& GetHeaders();
+
+  /// @brief Waits for the next chunk of the body.
+  /// @returns false if the body is over
+  /// @throws HttpException if the request failed
+  bool ReadChunk(std::string& output);
+
+  /// @cond
+  StreamedResponse(ResponseFuture&& response_future,
+                   engine::Future<std::shared_ptr<Response>>&& headers_future,
+                   StreamedBodyQueue::Consumer&& consumer,
+                   std::shared_ptr<RequestState> request_state);
+  /// @endcond
+
+ private:
+  void WaitForHeaders();
+
+  ResponseFuture response_future_;
+  engine::Future<std::shared_ptr<Response>> headers_future_;
+  StreamedBodyQueue::Consumer consumer_;
+  std::shared_ptr<RequestState> request_state_;
+  std::shared_ptr<Response> response_;
+  bool is_finished_{false};
+};
+
+}  // namespace clients::http
+
+USERVER_NAMESPACE_END
@@ -4,6 +4,7 @@
 #include <userver/components/impl/component_base.hpp>
 #include <userver/concurrent/async_event_source.hpp>
 #include <userver/dynamic_config/source.hpp>
+#include <userver/utils/statistics/entry.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -18,8 +19,14 @@ namespace components {
 /// The functionality is not in Trace or Logger components because that
 /// introduces circular dependency between Logger and DynamicConfig.
 ///
+/// Exports the statistics of the loggers with `per_thread_buffer_size` as
+/// `logger.queue-size`, `logger.buffers`, `logger.dropped`,
+/// `logger.write-errors` and `logger.flush-latency-us` labeled with the
+/// logger name.
+///
 /// ## Dynamic config
 /// * @ref USERVER_NO_LOG_SPANS
+/// * @ref USERVER_SPAN_SAMPLING
 ///
 /// ## Static options:
 /// Name | Description | Default value
@@ -47,6 +54,7 @@ class LoggingConfigurator final : public impl::ComponentBase {
   void OnConfigUpdate(const dynamic_config::Snapshot& config);
 
   concurrent::AsyncEventSubscriberScope config_subscription_;
+  utils::statistics::Entry statistics_holder_;
 };
 
 /// }@
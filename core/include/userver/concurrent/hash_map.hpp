@@ -0,0 +1,721 @@
+#pragma once
+
+/// @file userver/concurrent/hash_map.hpp
+/// @brief @copybrief concurrent::HashMap
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <userver/engine/mutex.hpp>
+#include <userver/rcu/rcu.hpp>
+#include <userver/rcu/rcu_map.hpp>
+#include <userver/utils/assert.hpp>
+#include <userver/utils/fixed_array.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace concurrent {
+
+namespace impl {
+
+// Reserves the current era of the rcu hazard eras domain. Nodes and tables
+// retired at or after the reserved era are not destroyed until the
+// reservation is released, so everything reachable from the map after the
+// reservation may be read without locks.
+class EraReservation final {
+ public:
+  EraReservation() : record_(rcu::impl::AcquireEraRecord()) {
+    auto era = rcu::impl::EraRecord::kFree;
+    for (auto current_era = rcu::impl::global_era.load(); current_era != era;
+         current_era = rcu::impl::global_era.load()) {
+      era = current_era;
+      record_.era.store(era);
+    }
+  }
+
+  EraReservation(const EraReservation&) = delete;
+  EraReservation& operator=(const EraReservation&) = delete;
+
+  ~EraReservation() { record_.Release(); }
+
+ private:
+  rcu::impl::EraRecord& record_;
+};
+
+template <typename Key, typename Value>
+struct HashMapNode final {
+  HashMapNode(std::size_t hash, const Key& key, std::shared_ptr<Value> value)
+      : hash(hash), key(key), value(std::move(value)) {}
+
+  const std::size_t hash;
+  const Key key;
+  const std::shared_ptr<Value> value;
+  std::atomic<HashMapNode*> next{nullptr};
+};
+
+template <typename Key, typename Value>
+struct HashMapTable final {
+  using Node = HashMapNode<Key, Value>;
+
+  explicit HashMapTable(std::size_t size)
+      : buckets(std::make_unique<std::atomic<Node*>[]>(size)), size(size) {
+    UASSERT_MSG((size & (size - 1)) == 0, "Size must be a power of 2");
+  }
+
+  HashMapTable(const HashMapTable&) = delete;
+  HashMapTable& operator=(const HashMapTable&) = delete;
+
+  ~HashMapTable() {
+    for (std::size_t i = 0; i < size; ++i) {
+      auto* node = buckets[i].load(std::memory_order_relaxed);
+      while (node) {
+        auto* next = node->next.load(std::memory_order_relaxed);
+        delete node;
+        node = next;
+      }
+    }
+  }
+
+  std::atomic<Node*>& GetBucket(std::size_t hash) {
+    return buckets[hash & (size - 1)];
+  }
+
+  const std::unique_ptr<std::atomic<Node*>[]> buckets;
+  const std::size_t size;
+};
+
+}  // namespace impl
+
+/// @brief Forward iterator for the concurrent::HashMap
+///
+/// Use member functions of concurrent::HashMap to retrieve the iterator.
+/// Nodes visited by the iterator and all of its copies are kept alive until
+/// the last copy is destroyed.
+template <typename Key, typename Value, typename IterValue>
+class HashMapIterator final {
+  using Node = impl::HashMapNode<Key, Value>;
+  using Table = impl::HashMapTable<Key, Value>;
+
+ public:
+  using iterator_category = std::input_iterator_tag;
+  using difference_type = ptrdiff_t;
+  using value_type = std::pair<Key, std::shared_ptr<IterValue>>;
+  using reference = const value_type&;
+  using pointer = const value_type*;
+
+  HashMapIterator() = default;
+
+  HashMapIterator operator++(int) {
+    HashMapIterator tmp(*this);
+    ++*this;
+    return tmp;
+  }
+
+  HashMapIterator& operator++() {
+    UASSERT(node_);
+    node_ = node_->next.load(std::memory_order_acquire);
+    SkipEmptyBuckets();
+    return *this;
+  }
+
+  reference operator*() const { return current_; }
+  pointer operator->() const { return &current_; }
+
+  bool operator==(const HashMapIterator& rhs) const {
+    return node_ == rhs.node_;
+  }
+  bool operator!=(const HashMapIterator& rhs) const { return !(*this == rhs); }
+
+  /// @cond
+  /// For internal use only
+  HashMapIterator(std::shared_ptr<const impl::EraReservation> reservation,
+                  Table* table)
+      : reservation_(std::move(reservation)), table_(table) {
+    node_ = table_->buckets[0].load(std::memory_order_acquire);
+    SkipEmptyBuckets();
+  }
+  /// @endcond
+
+ private:
+  void SkipEmptyBuckets() {
+    while (!node_ && ++bucket_ < table_->size) {
+      node_ = table_->buckets[bucket_].load(std::memory_order_acquire);
+    }
+    if (node_) {
+      current_ = value_type{node_->key, node_->value};
+    } else {
+      // release the reservation early, the end is reached
+      reservation_.reset();
+    }
+  }
+
+  std::shared_ptr<const impl::EraReservation> reservation_;
+  Table* table_{nullptr};
+  std::size_t bucket_{0};
+  Node* node_{nullptr};
+  value_type current_;
+};
+
+/// @ingroup userver_concurrency userver_containers
+///
+/// @brief Concurrent hash map with lock-free lookups and per-key updates
+///
+/// Provides the same interface as rcu::RcuMap, but a keyset change copies
+/// nothing except the inserted node, so the map suits large maps with a
+/// steady key churn.
+///
+/// Lookups and iteration take no locks. Writers lock one of the internal
+/// stripes chosen by the key hash, so the writers of different stripes do
+/// not contend. Erased nodes are reclaimed using the hazard eras domain of
+/// rcu::Variable (see rcu::ReclamationType::kHazardEras): a node is destroyed
+/// once every reader that might have seen it is done.
+///
+/// The bucket array doubles when the number of keys exceeds the number
+/// of buckets. The hashes are mixed before use, so the keys are spread over
+/// the stripes and buckets even with an identity `Hash`. Growing locks all the stripes and rebuilds the nodes, which is
+/// amortized O(1) per insertion.
+///
+/// Values are stored in `shared_ptr`s and are not copied during keyset
+/// change.
+/// @note No synchronization is provided for value access, it must be
+/// implemented by Value when necessary.
+/// @warning A live iterator delays the destruction of all the nodes erased
+/// after its creation, prefer GetSnapshot() for long-running operations.
+///
+/// ## Example usage:
+///
+/// @snippet concurrent/hash_map_test.cpp  Sample concurrent::HashMap usage
+///
+/// @see @ref md_en_userver_synchronization
+template <typename Key, typename Value, typename Hash = std::hash<Key>,
+          typename Equal = std::equal_to<Key>>
+class HashMap final {
+  static_assert(!std::is_reference_v<Key>);
+  static_assert(!std::is_reference_v<Value>);
+  static_assert(!std::is_const_v<Key>);
+
+ public:
+  template <typename ValuePtrType>
+  struct InsertReturnTypeImpl {
+    ValuePtrType value;
+    bool inserted;
+  };
+
+  using ValuePtr = std::shared_ptr<Value>;
+  using Iterator = HashMapIterator<Key, Value, Value>;
+  using ConstValuePtr = std::shared_ptr<const Value>;
+  using ConstIterator = HashMapIterator<Key, Value, const Value>;
+  using Snapshot = std::unordered_map<Key, ConstValuePtr, Hash, Equal>;
+  using InsertReturnType = InsertReturnTypeImpl<ValuePtr>;
+
+  explicit HashMap(std::size_t buckets_hint = 0, const Hash& hash = Hash{},
+                   const Equal& equal = Equal{});
+  ~HashMap();
+
+  HashMap(const HashMap&) = delete;
+  HashMap(HashMap&&) = delete;
+  HashMap& operator=(const HashMap&) = delete;
+  HashMap& operator=(HashMap&&) = delete;
+
+  /// Returns an estimated size of the map at some point in time
+  std::size_t SizeApprox() const;
+
+  /// Returns the number of buckets at some point in time
+  std::size_t GetBucketsCount() const;
+
+  /// @name Iteration support
+  /// @details Iteration is weakly consistent: every key present during the
+  /// whole iteration is visited exactly once, keys inserted or erased
+  /// concurrently may or may not be visited.
+  /// @{
+  ConstIterator begin() const;
+  ConstIterator end() const;
+  Iterator begin();
+  Iterator end();
+  /// @}
+
+  /// @brief Returns a readonly value pointer by its key if exists
+  /// @throws rcu::MissingKeyException if the key is not present
+  const ConstValuePtr operator[](const Key&) const;
+
+  /// @brief Returns a modifiable value pointer by key if exists or
+  /// default-creates one
+  const ValuePtr operator[](const Key&);
+
+  /// @brief Inserts a new element into the container if there is no element
+  /// with the key in the container.
+  /// Returns a pair consisting of a pointer to the inserted element, or the
+  /// already-existing element if no insertion happened, and a bool denoting
+  /// whether the insertion took place.
+  InsertReturnType Insert(const Key& key, ValuePtr value);
+
+  /// @brief Inserts a new element into the container constructed in-place with
+  /// the given args if there is no element with the key in the container.
+  /// Returns a pair consisting of a pointer to the inserted element, or the
+  /// already-existing element if no insertion happened, and a bool denoting
+  /// whether the insertion took place.
+  template <typename... Args>
+  InsertReturnType Emplace(const Key& key, Args&&... args);
+
+  /// @brief If a key equivalent to `key` already exists in the container, does
+  /// nothing.
+  /// Otherwise, behaves like `Emplace` except that the element is constructed
+  /// only after the key is found missing under the writer lock.
+  /// Returns a pair consisting of a pointer to the inserted element, or the
+  /// already-existing element if no insertion happened, and a bool denoting
+  /// whether the insertion took place.
+  template <typename... Args>
+  InsertReturnType TryEmplace(const Key& key, Args&&... args);
+
+  /// @brief If a key equivalent to `key` already exists in the container,
+  /// replaces the associated value. Otherwise, inserts a new pair into the map.
+  void InsertOrAssign(const Key& key, ValuePtr value);
+
+  /// @brief Returns a readonly value pointer by its key or an empty pointer
+  // Protects from assignment to map[key]
+  // NOLINTNEXTLINE(readability-const-return-type)
+  const ConstValuePtr Get(const Key&) const;
+
+  /// @brief Returns a modifiable value pointer by key or an empty pointer
+  // Protects from assignment to map[key]
+  // NOLINTNEXTLINE(readability-const-return-type)
+  const ValuePtr Get(const Key&);
+
+  /// @brief Removes a key from the map
+  /// @returns whether the key was present
+  bool Erase(const Key&);
+
+  /// @brief Removes a key from the map returning its value
+  /// @returns a value if the key was present, empty pointer otherwise
+  ValuePtr Pop(const Key&);
+
+  /// Resets the map to an empty state
+  void Clear();
+
+  /// Replace current data by data from `new_map`.
+  void Assign(std::unordered_map<Key, ValuePtr> new_map);
+
+  /// @brief Returns a readonly copy of the map
+  /// @note Equivalent to `{begin(), end()}` construct, preferable
+  /// for long-running operations.
+  Snapshot GetSnapshot() const;
+
+ private:
+  using Node = impl::HashMapNode<Key, Value>;
+  using Table = impl::HashMapTable<Key, Value>;
+
+  struct Retired final {
+    std::uint64_t era;
+    std::unique_ptr<Node> node;
+    std::unique_ptr<Table> table;
+  };
+
+  struct Stripe final {
+    engine::Mutex mutex;
+    std::atomic<std::size_t> size{0};
+    std::vector<Retired> retired;
+    std::vector<std::uint64_t> reserved_eras;
+  };
+
+  // Must be a power of 2, the minimal number of buckets
+  static constexpr std::size_t kStripesCount = 64;
+  static constexpr std::size_t kScanRetiredThreshold = 32;
+
+  using KeysPerStripe = std::array<std::size_t, kStripesCount>;
+
+  static std::size_t GetTableSize(std::size_t keys_count);
+
+  std::size_t GetHash(const Key& key) const;
+
+  Stripe& GetStripe(std::size_t hash);
+  std::atomic<Node*>* FindLocked(Table& table, std::size_t hash,
+                                 const Key& key);
+  template <typename Factory>
+  InsertReturnType DoInsert(const Key& key, Factory&& factory);
+  ValuePtr DoPop(const Key& key);
+  void Unlink(Stripe& stripe, std::atomic<Node*>& link, Node* replacement);
+  void Retire(Stripe& stripe, Retired retired,
+              std::size_t scan_threshold = kScanRetiredThreshold);
+  void ScanRetired(Stripe& stripe);
+  bool IsOverloaded(const Stripe& stripe, const Table& table) const;
+  void Grow(std::size_t old_size);
+  void ReplaceTable(std::unique_ptr<Table> new_table,
+                    const KeysPerStripe& keys_per_stripe);
+  std::vector<std::unique_lock<engine::Mutex>> LockAllStripes();
+  template <typename Iter>
+  Iter MakeBegin() const;
+
+  Hash hash_;
+  Equal equal_;
+  std::atomic<Table*> table_;
+  utils::FixedArray<Stripe> stripes_;
+};
+
+template <typename K, typename V, typename H, typename E>
+HashMap<K, V, H, E>::HashMap(std::size_t buckets_hint, const H& hash,
+                             const E& equal)
+    : hash_(hash),
+      equal_(equal),
+      table_(new Table(GetTableSize(buckets_hint))),
+      stripes_(kStripesCount) {}
+
+template <typename K, typename V, typename H, typename E>
+HashMap<K, V, H, E>::~HashMap() {
+  // Nobody may read the map during destruction, so no eras are checked
+  delete table_.load();
+}
+
+template <typename K, typename V, typename H, typename E>
+std::size_t HashMap<K, V, H, E>::SizeApprox() const {
+  std::size_t result = 0;
+  for (const auto& stripe : stripes_) {
+    result += stripe.size.load(std::memory_order_relaxed);
+  }
+  return result;
+}
+
+template <typename K, typename V, typename H, typename E>
+std::size_t HashMap<K, V, H, E>::GetBucketsCount() const {
+  const impl::EraReservation reservation;
+  return table_.load()->size;
+}
+
+template <typename K, typename V, typename H, typename E>
+auto HashMap<K, V, H, E>::begin() const -> ConstIterator {
+  return MakeBegin<ConstIterator>();
+}
+
+template <typename K, typename V, typename H, typename E>
+auto HashMap<K, V, H, E>::end() const -> ConstIterator {
+  return ConstIterator();
+}
+
+template <typename K, typename V, typename H, typename E>
+auto HashMap<K, V, H, E>::begin() -> Iterator {
+  return MakeBegin<Iterator>();
+}
+
+template <typename K, typename V, typename H, typename E>
+auto HashMap<K, V, H, E>::end() -> Iterator {
+  return Iterator();
+}
+
+template <typename K, typename V, typename H, typename E>
+template <typename Iter>
+Iter HashMap<K, V, H, E>::MakeBegin() const {
+  // the reservation must precede the table load
+  auto reservation = std::make_shared<const impl::EraReservation>();
+  return Iter(std::move(reservation), table_.load());
+}
+
+template <typename K, typename V, typename H, typename E>
+auto HashMap<K, V, H, E>::operator[](const K& key) const
+    -> const ConstValuePtr {
+  if (auto value = Get(key)) {
+    return value;
+  }
+  throw rcu::MissingKeyException("Key ") << key << " is missing";
+}
+
+template <typename K, typename V, typename H, typename E>
+auto HashMap<K, V, H, E>::operator[](const K& key) -> const ValuePtr {
+  auto value = Get(key);
+  if (!value) {
+    value = DoInsert(key, [] { return std::make_shared<V>(); }).value;
+  }
+  return value;
+}
+
+template <typename K, typename V, typename H, typename E>
+auto HashMap<K, V, H, E>::Insert(const K& key, ValuePtr value)
+    -> InsertReturnType {
+  InsertReturnType result{Get(key), false};
+  if (result.value) return result;
+
+  return DoInsert(key, [&value] { return std::move(value); });
+}
+
+template <typename K, typename V, typename H, typename E>
+template <typename... Args>
+auto HashMap<K, V, H, E>::Emplace(const K& key, Args&&... args)
+    -> InsertReturnType {
+  InsertReturnType result{Get(key), false};
+  if (result.value) return result;
+
+  auto value = std::make_shared<V>(std::forward<Args>(args)...);
+  return DoInsert(key, [&value] { return std::move(value); });
+}
+
+template <typename K, typename V, typename H, typename E>
+template <typename... Args>
+auto HashMap<K, V, H, E>::TryEmplace(const K& key, Args&&... args)
+    -> InsertReturnType {
+  InsertReturnType result{Get(key), false};
+  if (!result.value) {
+    // the value is constructed only if the key is still missing under the lock
+    result = DoInsert(key, [&] {
+      return std::make_shared<V>(std::forward<Args>(args)...);
+    });
+  }
+  return result;
+}
+
+template <typename K, typename V, typename H, typename E>
+void HashMap<K, V, H, E>::InsertOrAssign(const K& key, ValuePtr value) {
+  const auto hash = GetHash(key);
+  auto& stripe = GetStripe(hash);
+  std::size_t table_size = 0;
+  {
+    std::lock_guard lock(stripe.mutex);
+    auto& table = *table_.load();
+    auto* link = FindLocked(table, hash, key);
+    auto node = std::make_unique<Node>(hash, key, std::move(value));
+    if (auto* old_node = link->load()) {
+      node->next.store(old_node->next.load());
+      Unlink(stripe, *link, node.release());
+      return;
+    }
+
+    node->next.store(table.GetBucket(hash).load());
+    table.GetBucket(hash).store(node.release(), std::memory_order_release);
+    stripe.size.store(stripe.size.load() + 1, std::memory_order_relaxed);
+    if (!IsOverloaded(stripe, table)) return;
+    table_size = table.size;
+  }
+  Grow(table_size);
+}
+
+template <typename K, typename V, typename H, typename E>
+auto HashMap<K, V, H, E>::Get(const K& key) const -> const ConstValuePtr {
+  return const_cast<HashMap*>(this)->Get(key);
+}
+
+template <typename K, typename V, typename H, typename E>
+auto HashMap<K, V, H, E>::Get(const K& key) -> const ValuePtr {
+  const auto hash = GetHash(key);
+  const impl::EraReservation reservation;
+
+  auto& bucket = table_.load()->GetBucket(hash);
+  for (auto* node = bucket.load(std::memory_order_acquire); node;
+       node = node->next.load(std::memory_order_acquire)) {
+    if (node->hash == hash && equal_(node->key, key)) return node->value;
+  }
+  return {};
+}
+
+template <typename K, typename V, typename H, typename E>
+bool HashMap<K, V, H, E>::Erase(const K& key) {
+  return DoPop(key) != nullptr;
+}
+
+template <typename K, typename V, typename H, typename E>
+auto HashMap<K, V, H, E>::Pop(const K& key) -> ValuePtr {
+  return DoPop(key);
+}
+
+template <typename K, typename V, typename H, typename E>
+void HashMap<K, V, H, E>::Clear() {
+  Assign({});
+}
+
+template <typename K, typename V, typename H, typename E>
+void HashMap<K, V, H, E>::Assign(std::unordered_map<K, ValuePtr> new_map) {
+  auto table = std::make_unique<Table>(GetTableSize(new_map.size()));
+  KeysPerStripe keys_per_stripe{};
+  for (auto& [key, value] : new_map) {
+    const auto hash = GetHash(key);
+    auto& bucket = table->GetBucket(hash);
+    auto* node = new Node(hash, key, std::move(value));
+    node->next.store(bucket.load(std::memory_order_relaxed));
+    bucket.store(node, std::memory_order_relaxed);
+    ++keys_per_stripe[hash & (kStripesCount - 1)];
+  }
+
+  const auto locks = LockAllStripes();
+  ReplaceTable(std::move(table), keys_per_stripe);
+}
+
+template <typename K, typename V, typename H, typename E>
+auto HashMap<K, V, H, E>::GetSnapshot() const -> Snapshot {
+  return {begin(), end()};
+}
+
+template <typename K, typename V, typename H, typename E>
+std::size_t HashMap<K, V, H, E>::GetTableSize(std::size_t keys_count) {
+  std::size_t size = kStripesCount;
+  while (size < keys_count) size *= 2;
+  return size;
+}
+
+template <typename K, typename V, typename H, typename E>
+std::size_t HashMap<K, V, H, E>::GetHash(const K& key) const {
+  // Both the stripe and the bucket are taken from the low bits, mix the high
+  // bits into them to cope with hashes like the identity std::hash<int>
+  const std::uint64_t hash = hash_(key) * 0x9E3779B97F4A7C15ULL;
+  return static_cast<std::size_t>(hash ^ (hash >> 32));
+}
+
+template <typename K, typename V, typename H, typename E>
+auto HashMap<K, V, H, E>::GetStripe(std::size_t hash) -> Stripe& {
+  // The table size is a multiple of kStripesCount, so all the keys of a bucket
+  // belong to the same stripe with any table size
+  return stripes_[hash & (kStripesCount - 1)];
+}
+
+template <typename K, typename V, typename H, typename E>
+auto HashMap<K, V, H, E>::FindLocked(Table& table, std::size_t hash,
+                                     const K& key) -> std::atomic<Node*>* {
+  auto* link = &table.GetBucket(hash);
+  for (auto* node = link->load(); node; node = link->load()) {
+    if (node->hash == hash && equal_(node->key, key)) break;
+    link = &node->next;
+  }
+  return link;
+}
+
+template <typename K, typename V, typename H, typename E>
+template <typename Factory>
+auto HashMap<K, V, H, E>::DoInsert(const K& key, Factory&& factory)
+    -> InsertReturnType {
+  const auto hash = GetHash(key);
+  auto& stripe = GetStripe(hash);
+  InsertReturnType result{nullptr, true};
+  std::size_t table_size = 0;
+  {
+    std::lock_guard lock(stripe.mutex);
+    auto& table = *table_.load();
+    if (auto* node = FindLocked(table, hash, key)->load()) {
+      return {node->value, false};
+    }
+
+    result.value = factory();
+    auto& bucket = table.GetBucket(hash);
+    auto* node = new Node(hash, key, result.value);
+    node->next.store(bucket.load());
+    bucket.store(node, std::memory_order_release);
+    stripe.size.store(stripe.size.load() + 1, std::memory_order_relaxed);
+    if (!IsOverloaded(stripe, table)) return result;
+    table_size = table.size;
+  }
+  Grow(table_size);
+  return result;
+}
+
+template <typename K, typename V, typename H, typename E>
+auto HashMap<K, V, H, E>::DoPop(const K& key) -> ValuePtr {
+  const auto hash = GetHash(key);
+  auto& stripe = GetStripe(hash);
+
+  std::lock_guard lock(stripe.mutex);
+  auto* link = FindLocked(*table_.load(), hash, key);
+  auto* node = link->load();
+  if (!node) return {};
+
+  auto value = node->value;
+  Unlink(stripe, *link, node->next.load());
+  stripe.size.store(stripe.size.load() - 1, std::memory_order_relaxed);
+  return value;
+}
+
+template <typename K, typename V, typename H, typename E>
+void HashMap<K, V, H, E>::Unlink(Stripe& stripe, std::atomic<Node*>& link,
+                                 Node* replacement) {
+  // The unlinked node keeps its `next`, so the readers standing on it may
+  // continue the traversal
+  std::unique_ptr<Node> node{link.load()};
+  link.store(replacement, std::memory_order_release);
+  Retire(stripe, {0, std::move(node), nullptr});
+}
+
+template <typename K, typename V, typename H, typename E>
+void HashMap<K, V, H, E>::Retire(Stripe& stripe, Retired retired,
+                                 std::size_t scan_threshold) {
+  // Readers that reserve a later era can not reach the retired object
+  retired.era = rcu::impl::global_era.fetch_add(1);
+  stripe.retired.push_back(std::move(retired));
+  if (stripe.retired.size() >= scan_threshold) ScanRetired(stripe);
+}
+
+template <typename K, typename V, typename H, typename E>
+void HashMap<K, V, H, E>::ScanRetired(Stripe& stripe) {
+  rcu::impl::CollectReservedEras(stripe.reserved_eras);
+  const auto min_era = stripe.reserved_eras.empty()
+                           ? std::numeric_limits<std::uint64_t>::max()
+                           : stripe.reserved_eras.front();
+
+  auto& retired = stripe.retired;
+  std::size_t kept = 0;
+  for (auto& item : retired) {
+    if (item.era >= min_era) retired[kept++] = std::move(item);
+  }
+  retired.erase(retired.begin() + kept, retired.end());
+}
+
+template <typename K, typename V, typename H, typename E>
+bool HashMap<K, V, H, E>::IsOverloaded(const Stripe& stripe,
+                                       const Table& table) const {
+  // Each stripe owns exactly `size / kStripesCount` buckets. A stripe within
+  // its share is the fast path, otherwise the total size is checked, so that
+  // a single stripe with a skewed hash does not grow the table indefinitely.
+  return stripe.size.load(std::memory_order_relaxed) >
+             table.size / kStripesCount &&
+         SizeApprox() > table.size;
+}
+
+template <typename K, typename V, typename H, typename E>
+void HashMap<K, V, H, E>::Grow(std::size_t old_size) {
+  const auto locks = LockAllStripes();
+  auto& old_table = *table_.load();
+  if (old_table.size != old_size) return;  // someone has already grown it
+
+  auto table = std::make_unique<Table>(old_size * 2);
+  KeysPerStripe keys_per_stripe{};
+  for (std::size_t i = 0; i < old_table.size; ++i) {
+    for (auto* node = old_table.buckets[i].load(); node;
+         node = node->next.load()) {
+      auto& bucket = table->GetBucket(node->hash);
+      auto* new_node = new Node(node->hash, node->key, node->value);
+      new_node->next.store(bucket.load(std::memory_order_relaxed));
+      bucket.store(new_node, std::memory_order_relaxed);
+      ++keys_per_stripe[node->hash & (kStripesCount - 1)];
+    }
+  }
+  ReplaceTable(std::move(table), keys_per_stripe);
+}
+
+template <typename K, typename V, typename H, typename E>
+void HashMap<K, V, H, E>::ReplaceTable(std::unique_ptr<Table> new_table,
+                                       const KeysPerStripe& keys_per_stripe) {
+  std::unique_ptr<Table> old_table{table_.exchange(new_table.release())};
+  for (std::size_t i = 0; i < kStripesCount; ++i) {
+    stripes_[i].size.store(keys_per_stripe[i], std::memory_order_relaxed);
+  }
+  // An old table holds a copy of every node and there is no erase on the
+  // insert-only workloads to reach the threshold, so it is reclaimed at once
+  // if no reader can see it
+  Retire(stripes_[0], {0, nullptr, std::move(old_table)},
+         /*scan_threshold=*/1);
+}
+
+template <typename K, typename V, typename H, typename E>
+auto HashMap<K, V, H, E>::LockAllStripes()
+    -> std::vector<std::unique_lock<engine::Mutex>> {
+  std::vector<std::unique_lock<engine::Mutex>> locks;
+  locks.reserve(kStripesCount);
+  for (auto& stripe : stripes_) locks.emplace_back(stripe.mutex);
+  return locks;
+}
+
+}  // namespace concurrent
+
+USERVER_NAMESPACE_END
@@ -23,6 +23,15 @@ std::chrono::milliseconds ParseMs(
 extern const std::string_view kDump;
 extern const std::string_view kMaxDumpAge;
 
+/// Compression of the dump file contents
+enum class CompressionType {
+  kNone,
+  kZlib,
+};
+
+CompressionType Parse(const yaml_config::YamlConfig& value,
+                      formats::parse::To<CompressionType>);
+
 struct ConfigPatch final {
   std::optional<bool> dumps_enabled;
   std::optional<std::chrono::milliseconds> min_dump_interval;
@@ -46,6 +55,8 @@ struct Config final {
   std::optional<std::chrono::milliseconds> max_dump_age;
   bool max_dump_age_set;
   bool dump_is_encrypted;
+  CompressionType compression;
+  uint64_t max_delta_count;
 
   bool dumps_enabled;
   std::chrono::milliseconds min_dump_interval;
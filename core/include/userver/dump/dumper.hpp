@@ -7,6 +7,7 @@
 #include <memory>
 #include <optional>
 #include <string>
+#include <vector>
 
 #include <userver/components/component_fwd.hpp>
 #include <userver/dump/helpers.hpp>
@@ -42,6 +43,20 @@ class DumpableEntity {
   virtual void GetAndWrite(dump::Writer& writer) const = 0;
 
   virtual void ReadAndSet(dump::Reader& reader) = 0;
+
+  /// @brief Writes the changes made since the data was last written by
+  /// `GetAndWrite` or `GetAndWriteDelta`, or read by `ReadAndSetWithDeltas`
+  /// @returns `false` if the changes are unknown, then `Dumper` writes a full
+  /// dump instead
+  /// @note Only called if `max-delta-count` is set
+  virtual bool GetAndWriteDelta(dump::Writer& writer) const;
+
+  /// @brief Reads a full dump, applies the deltas written by
+  /// `GetAndWriteDelta` on top of it in order and sets the result
+  ///
+  /// The default implementation only supports an empty `deltas`.
+  virtual void ReadAndSetWithDeltas(
+      dump::Reader& reader, const std::vector<std::unique_ptr<Reader>>& deltas);
 };
 
 enum class UpdateType {
@@ -84,6 +99,8 @@ enum class UpdateType {
 /// `min-interval` | `string` (duration) | `WriteDumpAsync` calls performed in a fast succession are ignored | `0s`
 /// `fs-task-processor` | `string` | `TaskProcessor` for blocking disk IO | `fs-task-processor`
 /// `encrypted` | `boolean` | Whether to encrypt the dump | `false`
+/// `compression` | `string` | Compression of the dump: `none` or `zlib` | `none`
+/// `max-delta-count` | `integer` | Max number of delta dumps written on top of a full dump, `0` disables delta dumps | `0`
 /// `first-update-mode` | `string` | specifies whether required or best-effort first update will be used | skip
 /// `first-update-type` | `string` | specifies whether incremental and/or full first update will be used | full
 ///
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <memory>
 #include <stdexcept>
 #include <string>
 #include <string_view>
@@ -44,6 +45,8 @@ class Writer {
   friend void WriteStringViewUnsafe(Writer& writer, std::string_view value);
 };
 
+struct SharedStringView;
+
 /// A general interface for binary data input
 class Reader {
  public:
@@ -68,7 +71,16 @@ class Reader {
   /// @throws `Error` on read operation failure
   virtual std::string_view ReadRaw(std::size_t max_size) = 0;
 
+  /// @brief Returns the owner of the memory returned by `ReadRaw` if the
+  /// memory stays valid until the owner is destroyed, e.g. for a memory-mapped
+  /// dump file, or `nullptr` otherwise
+  virtual std::shared_ptr<const void> GetRawMemoryOwner() const {
+    return nullptr;
+  }
+
   friend std::string_view ReadUnsafeAtMost(Reader& reader, std::size_t size);
+
+  friend SharedStringView ReadSharedUnsafe(Reader& reader, std::size_t size);
 };
 
 namespace impl {
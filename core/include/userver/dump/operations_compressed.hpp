@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include <userver/dump/config.hpp>
+#include <userver/dump/factory.hpp>
+#include <userver/dump/operations.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace dump {
+
+/// @brief Compresses the data in blocks and writes them to another `Writer`.
+///
+/// The blocks are compressed concurrently in the current task processor,
+/// which is the `fs-task-processor` of the dumper.
+class CompressedWriter final : public Writer {
+ public:
+  CompressedWriter(std::unique_ptr<Writer> inner, CompressionType compression);
+
+  ~CompressedWriter() override;
+
+  void Finish() override;
+
+ private:
+  struct Block {
+    std::size_t raw_size{0};
+    std::string data;
+  };
+
+  void WriteRaw(std::string_view data) override;
+
+  void SubmitBlock();
+  void WriteBlock(const Block& block);
+
+  std::unique_ptr<Writer> inner_;
+  const CompressionType compression_;
+  std::string buffer_;
+  std::deque<engine::TaskWithResult<Block>> pending_;
+};
+
+/// @brief Reads the blocks written by `CompressedWriter` from another `Reader`.
+///
+/// The blocks are read ahead and decompressed concurrently in the current
+/// task processor.
+class CompressedReader final : public Reader {
+ public:
+  CompressedReader(std::unique_ptr<Reader> inner, CompressionType compression);
+
+  ~CompressedReader() override;
+
+  void Finish() override;
+
+ private:
+  std::string_view ReadRaw(std::size_t max_size) override;
+
+  void ReadAhead();
+  bool NextBlock();
+
+  std::unique_ptr<Reader> inner_;
+  const CompressionType compression_;
+  std::string block_;
+  std::size_t position_{0};
+  std::string buffer_;
+  std::deque<engine::TaskWithResult<std::string>> pending_;
+  bool inner_finished_{false};
+};
+
+/// Wraps the readers and writers of another factory with compression
+class CompressedOperationsFactory final : public OperationsFactory {
+ public:
+  CompressedOperationsFactory(std::unique_ptr<OperationsFactory> inner,
+                              CompressionType compression);
+
+  std::unique_ptr<Reader> CreateReader(std::string full_path) override;
+
+  std::unique_ptr<Writer> CreateWriter(std::string full_path,
+                                       tracing::ScopeTime& scope) override;
+
+ private:
+  const std::unique_ptr<OperationsFactory> inner_;
+  const CompressionType compression_;
+};
+
+}  // namespace dump
+
+USERVER_NAMESPACE_END
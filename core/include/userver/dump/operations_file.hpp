@@ -1,6 +1,8 @@
 #pragma once
 
 #include <chrono>
+#include <memory>
+#include <string_view>
 
 #include <boost/filesystem/operations.hpp>
 
@@ -35,7 +37,10 @@ class FileWriter final : public Writer {
   utils::StreamingCpuRelax cpu_relax_;
 };
 
-/// A handle to a dump file. File operations block the thread.
+/// @brief A handle to a dump file. File operations block the thread.
+///
+/// The file is memory-mapped, so the data is not copied on read, and
+/// values read with `ReadSharedUnsafe` may keep referencing the file.
 class FileReader final : public Reader {
  public:
   /// @brief Opens an existing dump file
@@ -47,9 +52,12 @@ class FileReader final : public Reader {
  private:
   std::string_view ReadRaw(std::size_t max_size) override;
 
-  fs::blocking::CFile file_;
+  std::shared_ptr<const void> GetRawMemoryOwner() const override;
+
   std::string path_;
-  std::string curr_chunk_;
+  std::shared_ptr<const void> mapping_;
+  std::string_view contents_;
+  std::size_t position_{0};
 };
 
 class FileOperationsFactory final : public OperationsFactory {
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <memory>
 #include <string_view>
 
 #include <userver/dump/operations.hpp>
@@ -27,6 +28,19 @@ std::string_view ReadStringViewUnsafe(Reader& reader, std::size_t size);
 /// @warning The `string_view` will be invalidated on the next `Read` operation
 std::string_view ReadUnsafeAtMost(Reader& reader, std::size_t max_size);
 
+/// @brief A `std::string_view` that keeps its memory alive
+struct SharedStringView final {
+  std::string_view data;
+  std::shared_ptr<const void> owner;
+};
+
+/// @brief Reads a non-size-prefixed `std::string_view` that outlives the
+/// `Reader`
+/// @note The data is not copied if the dump is memory-mapped, e.g. read
+/// by `FileReader`, so the values may reference the dump file directly
+/// @note The caller must somehow know the string size in advance
+SharedStringView ReadSharedUnsafe(Reader& reader, std::size_t size);
+
 }  // namespace dump
 
 USERVER_NAMESPACE_END
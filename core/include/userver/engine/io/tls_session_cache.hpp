@@ -0,0 +1,106 @@
+#pragma once
+
+/// @file userver/engine/io/tls_session_cache.hpp
+/// @brief @copybrief engine::io::TlsSessionCache
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <userver/formats/json_fwd.hpp>
+#include <userver/utils/fast_pimpl.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::io {
+
+/// @brief Shared TLS session storage for engine::io::TlsWrapper
+///
+/// Allows to resume TLS sessions across connections, avoiding full handshakes.
+///
+/// Client side stores up to `max_sessions` sessions keyed by the server name
+/// and address. Server side issues session tickets encrypted with the ticket
+/// keys, a random key is generated on construction. Keys should be set via
+/// SetTicketKeys() to share tickets between processes and hosts.
+///
+/// Thread safe. Must outlive all the wrappers that use it.
+class TlsSessionCache final {
+ public:
+  /// Size of the ticket key: 16 bytes of key name, 32 bytes of HMAC secret and
+  /// 32 bytes of AES key (same as in nginx `ssl_session_ticket_key`)
+  static constexpr std::size_t kTicketKeySize = 80;
+
+  static constexpr std::size_t kDefaultMaxSessions = 10000;
+
+  struct Statistics {
+    std::size_t client_full_handshakes{0};
+    std::size_t client_resumed_handshakes{0};
+    std::size_t server_full_handshakes{0};
+    std::size_t server_resumed_handshakes{0};
+    std::size_t cached_sessions{0};
+  };
+
+  explicit TlsSessionCache(std::size_t max_sessions = kDefaultMaxSessions);
+  ~TlsSessionCache();
+
+  TlsSessionCache(const TlsSessionCache&) = delete;
+  TlsSessionCache& operator=(const TlsSessionCache&) = delete;
+
+  /// @brief Replaces the server ticket keys.
+  ///
+  /// The first key is used to encrypt new tickets, the rest are only
+  /// used to decrypt the tickets issued before the rotation. Such tickets are
+  /// renewed on use.
+  /// @throws TlsException if there are no keys or a key has invalid size
+  void SetTicketKeys(const std::vector<std::string>& keys);
+
+  /// Drops the cached client sessions
+  void Clear();
+
+  Statistics GetStatistics() const;
+
+  /// @cond
+  class Impl;
+
+  // For internal use only
+  Impl& GetImpl() noexcept { return *impl_; }
+  /// @endcond
+
+ private:
+  constexpr static std::size_t kSize = 280;
+  constexpr static std::size_t kAlignment = 8;
+  utils::FastPimpl<Impl, kSize, kAlignment> impl_;
+};
+
+formats::json::Value Serialize(const TlsSessionCache::Statistics& stats,
+                               formats::serialize::To<formats::json::Value>);
+
+/// @brief Secdist module with the TLS session ticket keys for
+/// TlsSessionCache::SetTicketKeys
+///
+/// Expects base64 encoded keys in secdist:
+/// @code{.json}
+/// {"tls_session_ticket_keys": ["<newest key>", "<previous key>"]}
+/// @endcode
+///
+/// Keys are rotated by subscribing to secdist updates:
+/// @code
+///   secdist_subscription_ = secdist.UpdateAndListen(
+///       this, "tls-ticket-keys", &MyComponent::OnSecdistUpdate);
+///
+///   void MyComponent::OnSecdistUpdate(
+///       const storages::secdist::SecdistConfig& config) {
+///     session_cache_.SetTicketKeys(
+///         config.Get<engine::io::TlsTicketKeys>().keys);
+///   }
+/// @endcode
+struct TlsTicketKeys {
+  explicit TlsTicketKeys(const formats::json::Value& secdist_doc);
+
+  /// Raw ticket keys, the newest one first
+  std::vector<std::string> keys;
+};
+
+}  // namespace engine::io
+
+USERVER_NAMESPACE_END
@@ -3,6 +3,8 @@
 /// @file userver/engine/io/tls_wrapper.hpp
 /// @brief TLS socket wrappers
 
+#include <sys/types.h>
+
 #include <string>
 #include <vector>
 
@@ -11,6 +13,7 @@
 #include <userver/engine/deadline.hpp>
 #include <userver/engine/io/common.hpp>
 #include <userver/engine/io/socket.hpp>
+#include <userver/engine/task/task_processor_fwd.hpp>
 #include <userver/utils/clang_format_workarounds.hpp>
 #include <userver/utils/fast_pimpl.hpp>
 
@@ -18,6 +21,26 @@ USERVER_NAMESPACE_BEGIN
 
 namespace engine::io {
 
+class TlsSessionCache;
+
+/// Optional TLS handshake parameters
+struct TlsHandshakeOptions {
+  /// Shared cache to resume the sessions from, disabled if not set.
+  /// Must outlive the wrapper.
+  TlsSessionCache* session_cache{nullptr};
+
+  /// Task processor to run the handshake on, e.g. to keep the CPU-heavy
+  /// crypto away from the request handling. Current one is used if not set.
+  TaskProcessor* handshake_task_processor{nullptr};
+
+  /// @brief Offload the record encryption to the kernel (kTLS).
+  ///
+  /// Requires OpenSSL 3.0+ with kTLS support, the `tls` kernel module and
+  /// a cipher supported by the kernel. Userspace encryption is used
+  /// otherwise, see TlsWrapper::IsKernelTlsEnabled().
+  bool enable_kernel_tls{false};
+};
+
 /// Class for TLS communications over a Socket.
 ///
 /// Not thread safe.
@@ -29,13 +52,21 @@ class USERVER_NODISCARD TlsWrapper final : public ReadableBase {
   /// Starts a TLS client on an opened socket
   static TlsWrapper StartTlsClient(Socket&& socket,
                                    const std::string& server_name,
-                                   Deadline deadline);
+                                   Deadline deadline,
+                                   const TlsHandshakeOptions& options = {});
 
   /// Starts a TLS server on an opened socket
   static TlsWrapper StartTlsServer(
       Socket&& socket, const crypto::Certificate& cert,
       const crypto::PrivateKey& key, Deadline deadline,
-      const std::vector<crypto::Certificate>& cert_authorities = {});
+      const std::vector<crypto::Certificate>& cert_authorities = {},
+      const TlsHandshakeOptions& options = {});
+
+  /// Whether the session was resumed instead of a full handshake
+  bool IsSessionReused() const;
+
+  /// Whether the sent records are encrypted by the kernel
+  bool IsKernelTlsEnabled() const;
 
   ~TlsWrapper() override;
 
@@ -67,9 +98,21 @@ class USERVER_NODISCARD TlsWrapper final : public ReadableBase {
   /// @note Can return less than len if socket is closed by peer.
   [[nodiscard]] size_t SendAll(const void* buf, size_t len, Deadline deadline);
 
+  /// @brief Sends len bytes of the file starting from offset.
+  ///
+  /// Uses zero-copy `sendfile` if kernel TLS is enabled, otherwise reads the
+  /// file in chunks on the fs_task_processor and encrypts them in userspace.
+  /// @note Can return less than len if socket is closed by peer or the file
+  /// is shorter.
+  [[nodiscard]] size_t SendFile(int fd, off_t offset, size_t len,
+                                TaskProcessor& fs_task_processor,
+                                Deadline deadline);
+
   /// @brief Finishes TLS session and returns the socket.
   /// @warning Wrapper becomes invalid on entry and can only be used to retry
   ///   socket extraction if interrupted.
+  /// @note The socket is closed if kernel TLS was enabled, as it cannot be
+  ///   used for plaintext anymore.
   [[nodiscard]] Socket StopTls(Deadline deadline);
 
   /// @brief Receives at least one byte from the socket.
@@ -91,7 +134,7 @@ class USERVER_NODISCARD TlsWrapper final : public ReadableBase {
   explicit TlsWrapper(Socket&&);
 
   class Impl;
-  constexpr static size_t kSize = 296;
+  constexpr static size_t kSize = 304;
   constexpr static size_t kAlignment = 8;
   utils::FastPimpl<Impl, kSize, kAlignment> impl_;
 };
@@ -0,0 +1,92 @@
+#pragma once
+
+/// @file userver/logging/binary_format.hpp
+/// @brief Reader of the logs written in logging::Format::kBinary
+
+#include <chrono>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <variant>
+#include <vector>
+
+#include <userver/logging/level.hpp>
+#include <userver/logging/log_helper.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+/// @brief Binary log records
+///
+/// A log file of the logging::Format::kBinary logger is a sequence of
+/// records:
+///
+/// Size | Description
+/// ---- | -----------
+/// 4 bytes | little endian size of the rest of the record
+/// 1 byte  | version of the record layout, logging::binary::kRecordVersion
+/// 8 bytes | little endian nanoseconds since the Unix epoch
+/// 1 byte  | logging::Level
+/// ...     | fields up to the end of the record
+///
+/// Each field is a key followed by a value. The key is either a one byte
+/// index of a frequently used key (module, task_id, trace_id, ...) or a zero
+/// byte followed by a varint length and the key itself. The value is a one
+/// byte logging::binary::ValueType followed by the data: a 4 byte little
+/// endian length and the bytes for strings, a varint for integers (zigzag
+/// encoded for the signed ones), 8 bytes for doubles and 1 byte for booleans.
+///
+/// Neither keys nor values are escaped, use the `log-converter` tool or
+/// the functions below to get the TSKV or JSON text.
+namespace logging::binary {
+
+/// Version of the record layout written into each record
+inline constexpr std::uint8_t kRecordVersion = 1;
+
+/// Type of the field value
+enum class ValueType : std::uint8_t {
+  kString = 1,
+  kSigned,
+  kUnsigned,
+  kDouble,
+  kBool,
+  kHex,
+  kHexShort,
+};
+
+using Value = std::variant<std::string_view, std::int64_t, std::uint64_t,
+                           double, bool, Hex, HexShort>;
+
+struct Field final {
+  std::string_view key;
+  Value value;
+};
+
+/// Fields of the record refer to the parsed data
+struct Record final {
+  std::chrono::system_clock::time_point timestamp;
+  Level level{Level::kNone};
+  std::vector<Field> fields;
+};
+
+/// Thrown on malformed log data
+class ParseError : public std::runtime_error {
+ public:
+  using std::runtime_error::runtime_error;
+};
+
+/// @brief Parses the first record of `data` and removes it from `data`
+/// @returns false if `data` does not contain a complete record, e.g. when the
+/// log file is still being written
+/// @throws ParseError on malformed record
+bool ReadRecord(std::string_view& data, Record& record);
+
+/// Appends the record in the default TSKV layout without a trailing newline
+void FormatAsTskv(const Record& record, std::string& result);
+
+/// Appends the record as a JSON object without a trailing newline
+void FormatAsJson(const Record& record, std::string& result);
+
+}  // namespace logging::binary
+
+USERVER_NAMESPACE_END
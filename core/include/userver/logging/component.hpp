@@ -21,6 +21,10 @@ namespace logging {
 struct LoggerConfig;
 }
 
+namespace utils::statistics {
+class Writer;
+}
+
 namespace components {
 
 // clang-format off
@@ -37,11 +41,12 @@ namespace components {
 /// ---- | ----------- | -------------
 /// file_path | path to the log file | -
 /// level | log verbosity | info
-/// format | log output format, either `tskv` or `ltsv` | tskv
-/// pattern | message formatting pattern, see [spdlog wiki](https://github.com/gabime/spdlog/wiki/3.-Custom-formatting#pattern-flags) for details, %%v means message text | tskv or ltsv prologue with timestamp, timezone and level fields
+/// format | log output format, either `tskv`, `ltsv` or `binary` (see logging::binary, convert with the `log-converter` tool) | tskv
+/// pattern | message formatting pattern, see [spdlog wiki](https://github.com/gabime/spdlog/wiki/3.-Custom-formatting#pattern-flags) for details, %%v means message text; ignored for the `binary` format | tskv or ltsv prologue with timestamp, timezone and level fields
 /// flush_level | messages of this and higher levels get flushed to the file immediately | warning
 /// message_queue_size | the size of internal message queue, must be a power of 2 | 65536
 /// overflow_behavior | message handling policy while the queue is full: `discard` drops messages, `block` waits until message gets into the queue | discard
+/// per_thread_buffer_size | if non-zero, each thread puts the formatted messages into its own ring buffer of this size in bytes instead of the shared message queue, must be a power of 2; `overflow_behavior` applies to the buffers; messages are ordered per thread, so the messages of different threads and of a task that has moved to another thread may be reordered | 0
 /// testsuite-capture | if exists, setups additional TCP log sink for testing purposes | {}
 ///
 /// ### testsuite-capture options:
@@ -84,6 +89,9 @@ class Logging final : public impl::ComponentBase {
   /// Reopens log files after rotation
   void OnLogRotate();
 
+  /// Writes the statistics of the loggers with `per_thread_buffer_size`
+  void WriteStatistics(utils::statistics::Writer& writer) const;
+
   class TestsuiteCaptureSink;
 
   static yaml_config::Schema GetStaticConfigSchema();
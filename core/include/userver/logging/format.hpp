@@ -10,7 +10,12 @@ USERVER_NAMESPACE_BEGIN
 namespace logging {
 
 /// Log formats
-enum class Format { kTskv, kLtsv };
+enum class Format {
+  kTskv,
+  kLtsv,
+  /// Length prefixed records without escaping, see logging::binary
+  kBinary,
+};
 
 /// Parse Format enum from string
 Format FormatFromString(std::string_view format_str);
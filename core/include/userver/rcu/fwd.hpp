@@ -0,0 +1,26 @@
+#pragma once
+
+/// @file userver/rcu/fwd.hpp
+/// @brief Forward declarations for rcu::Variable and rcu::RcuMap
+
+USERVER_NAMESPACE_BEGIN
+
+namespace rcu {
+
+struct DefaultRcuTraits;
+
+template <typename T, typename RcuTraits = DefaultRcuTraits>
+class Variable;
+
+template <typename T, typename RcuTraits = DefaultRcuTraits>
+class ReadablePtr;
+
+template <typename T, typename RcuTraits = DefaultRcuTraits>
+class WritablePtr;
+
+template <typename Key, typename Value, typename RcuTraits = DefaultRcuTraits>
+class RcuMap;
+
+}  // namespace rcu
+
+USERVER_NAMESPACE_END
@@ -3,14 +3,21 @@
 /// @file userver/rcu/rcu.hpp
 /// @brief Implementation of hazard pointer
 
+#include <algorithm>
 #include <atomic>
+#include <cstdint>
 #include <cstdlib>
+#include <limits>
 #include <list>
+#include <memory>
+#include <type_traits>
 #include <unordered_set>
+#include <vector>
 
 #include <userver/engine/async.hpp>
 #include <userver/engine/mutex.hpp>
 #include <userver/logging/log.hpp>
+#include <userver/rcu/fwd.hpp>
 #include <userver/utils/assert.hpp>
 #include <userver/utils/clang_format_workarounds.hpp>
 #include <userver/utils/impl/wait_token_storage.hpp>
@@ -24,11 +31,40 @@ USERVER_NAMESPACE_BEGIN
 /// with modified API
 namespace rcu {
 
-template <typename T>
-class Variable;
+/// @brief Memory reclamation backend of rcu::Variable, see RcuTraits
+enum class ReclamationType {
+  /// Every variable keeps its own list of hazard pointers, a write collects
+  /// them into a set to find the old values that are not read anymore.
+  kHazardPointers,
+  /// All the variables share a process-wide pool of hazard eras. A write
+  /// scans the pool into a reused buffer, without per-variable lists and per-
+  /// write allocations. A reader that holds a ReadablePtr for a long time
+  /// only delays the reclamation of the values that were current at that
+  /// time.
+  kHazardEras,
+};
+
+/// @brief Default traits of rcu::Variable and rcu::RcuMap
+///
+/// The traits are passed as the last template argument, e.g.
+/// `rcu::Variable<T, rcu::HazardEraRcuTraits>`.
+struct DefaultRcuTraits {
+  static constexpr ReclamationType kReclamation =
+      ReclamationType::kHazardPointers;
+};
+
+/// @brief Traits of rcu::Variable and rcu::RcuMap that reclaim the old values
+/// using the shared hazard eras domain, see ReclamationType::kHazardEras
+struct HazardEraRcuTraits {
+  static constexpr ReclamationType kReclamation = ReclamationType::kHazardEras;
+};
 
 namespace impl {
 
+template <typename RcuTraits>
+inline constexpr bool kUsesHazardEras =
+    RcuTraits::kReclamation == ReclamationType::kHazardEras;
+
 // Hazard pointer implementation. Pointers form a linked list. \p ptr points
 // to the data they 'hold', next - to the next element in a list.
 // kUsed is a filler value to show that hazard pointer is not free. Please see
@@ -37,7 +73,7 @@ namespace impl {
 // std::atomic<HazardPointerRecord*> global_head' Every rcu::Variable has its
 // own list of hazard pointers. Thus, move-assignment on hazard pointers is
 // difficult to implement.
-template <typename T>
+template <typename T, typename RcuTraits>
 struct HazardPointerRecord final {
   // You see, objects are created 'filled', that is for the purposes of hazard
   // pointer list, they contain value. This eliminates some race conditions,
@@ -46,30 +82,93 @@ struct HazardPointerRecord final {
   // somewhere into kernel space and will cause SEGFAULT
   static inline T* const kUsed = reinterpret_cast<T*>(1);
 
-  explicit HazardPointerRecord(const Variable<T>& owner) : owner(owner) {}
+  explicit HazardPointerRecord(const Variable<T, RcuTraits>& owner)
+      : owner(owner) {}
 
   std::atomic<T*> ptr = kUsed;
-  const Variable<T>& owner;
+  const Variable<T, RcuTraits>& owner;
   std::atomic<HazardPointerRecord*> next{nullptr};
 
   // Simple operation that marks this hazard pointer as no longer used.
   void Release() { ptr = nullptr; }
 };
 
-template <typename T>
+template <typename T, typename RcuTraits>
 struct CachedData {
-  impl::HazardPointerRecord<T>* hp{nullptr};
-  const Variable<T>* variable{nullptr};
+  impl::HazardPointerRecord<T, RcuTraits>* hp{nullptr};
+  const Variable<T, RcuTraits>* variable{nullptr};
   // ensures that `variable` points to the instance that filled the cache
   uint64_t variable_epoch{0};
 };
 
-template <typename T>
+template <typename T, typename RcuTraits>
 // NOLINTNEXTLINE(misc-definitions-in-headers)
-thread_local CachedData<T> cache;
+thread_local CachedData<T, RcuTraits> cache;
 
 uint64_t GetNextEpoch() noexcept;
 
+// Hazard eras implementation. The era is a global counter that is advanced
+// on each retirement of a value. Every value remembers the era when it became
+// current (birth era) and the era when it was replaced (retire era). A reader
+// publishes the era at which it has read the value in an EraRecord, so the
+// retired value may be destroyed if no record holds an era from its
+// [birth era, retire era] interval. The records form an application-wide
+// lock-free list that only grows, they are reused by all the variables.
+struct EraRecord final {
+  static constexpr std::uint64_t kFree = 0;
+  // the record is owned by a reader, but protects nothing yet
+  static constexpr std::uint64_t kUsed =
+      std::numeric_limits<std::uint64_t>::max();
+
+  std::atomic<std::uint64_t> era{kUsed};
+  // the variable being read, only accessed by the reader owning the record
+  const void* owner{nullptr};
+  // immutable after the record is published
+  EraRecord* next{nullptr};
+
+  void Release() { era = kFree; }
+};
+
+extern std::atomic<std::uint64_t> global_era;
+
+EraRecord& AcquireEraRecordSlow();
+
+// NOLINTNEXTLINE(misc-definitions-in-headers)
+inline thread_local EraRecord* cached_era_record{nullptr};
+
+inline EraRecord& AcquireEraRecord() {
+  auto* record = cached_era_record;
+  std::uint64_t era = EraRecord::kFree;
+  if (record && record->era.load() == EraRecord::kFree &&
+      record->era.compare_exchange_strong(era, EraRecord::kUsed)) {
+    return *record;
+  }
+
+  record = &AcquireEraRecordSlow();
+  cached_era_record = record;
+  return *record;
+}
+
+// Replaces the contents of `eras` with the sorted eras held by the readers
+void CollectReservedEras(std::vector<std::uint64_t>& eras);
+
+template <typename T>
+struct RetiredPtr final {
+  std::unique_ptr<T> ptr;
+  std::uint64_t birth_era;
+  std::uint64_t retire_era;
+};
+
+template <typename T>
+struct EraReclamationState final {
+  std::uint64_t current_birth_era{0};
+  std::vector<RetiredPtr<T>> retired;
+  // reused between the scans to not allocate on every write
+  std::vector<std::uint64_t> reserved_eras;
+};
+
+struct NoEraReclamationState final {};
+
 }  // namespace impl
 
 /// Reader smart pointer for rcu::Variable<T>. You may use operator*() or
@@ -77,29 +176,21 @@ uint64_t GetNextEpoch() noexcept;
 /// ReadablePtr references the same immutable value: if Variable's value is
 /// changed during ReadablePtr lifetime, it will not affect value referenced by
 /// ReadablePtr.
-template <typename T>
+template <typename T, typename RcuTraits>
 class USERVER_NODISCARD ReadablePtr final {
- public:
-  explicit ReadablePtr(const Variable<T>& ptr)
-      : hp_record_(&ptr.MakeHazardPointer()) {
-    // This cycle guarantees that at the end of it both t_ptr_ and
-    // hp_record_->ptr will both be set to
-    // 1. something meaningful
-    // 2. and that this meaningful value was not removed between assigning to
-    //    t_ptr_ and storing  it in a hazard pointer
-    do {
-      t_ptr_ = ptr.GetCurrent();
+  using Record = std::conditional_t<impl::kUsesHazardEras<RcuTraits>,
+                                    impl::EraRecord,
+                                    impl::HazardPointerRecord<T, RcuTraits>>;
 
-      hp_record_->ptr.store(t_ptr_);
-    } while (t_ptr_ != ptr.GetCurrent());
-  }
+ public:
+  explicit ReadablePtr(const Variable<T, RcuTraits>& ptr) { Protect(ptr); }
 
-  ReadablePtr(ReadablePtr<T>&& other) noexcept
+  ReadablePtr(ReadablePtr<T, RcuTraits>&& other) noexcept
       : t_ptr_(other.t_ptr_), hp_record_(other.hp_record_) {
     other.t_ptr_ = nullptr;
   }
 
-  ReadablePtr& operator=(ReadablePtr<T>&& other) noexcept {
+  ReadablePtr& operator=(ReadablePtr<T, RcuTraits>&& other) noexcept {
     // What do we have here?
     // 1. 'other' may point to the same variable - or to a different one.
     // 2. therefore, its hazard pointer may belong to the same list,
@@ -142,11 +233,12 @@ class USERVER_NODISCARD ReadablePtr final {
     return *this;
   }
 
-  ReadablePtr(const ReadablePtr<T>& other)
-      : ReadablePtr(other.hp_record_->owner) {}
+  ReadablePtr(const ReadablePtr<T, RcuTraits>& other) {
+    Protect(other.GetOwner());
+  }
 
-  ReadablePtr& operator=(const ReadablePtr<T>& other) {
-    if (this != &other) *this = ReadablePtr<T>{other};
+  ReadablePtr& operator=(const ReadablePtr<T, RcuTraits>& other) {
+    if (this != &other) *this = ReadablePtr<T, RcuTraits>{other};
     return *this;
   }
 
@@ -170,6 +262,43 @@ class USERVER_NODISCARD ReadablePtr final {
   const T& operator*() && { return *GetOnRvalue(); }
 
  private:
+  const Variable<T, RcuTraits>& GetOwner() const {
+    if constexpr (impl::kUsesHazardEras<RcuTraits>) {
+      return *static_cast<const Variable<T, RcuTraits>*>(hp_record_->owner);
+    } else {
+      return hp_record_->owner;
+    }
+  }
+
+  void Protect(const Variable<T, RcuTraits>& ptr) {
+    if constexpr (impl::kUsesHazardEras<RcuTraits>) {
+      hp_record_ = &impl::AcquireEraRecord();
+      hp_record_->owner = &ptr;
+      // The value read at some era is alive while the era is reserved. Repeat
+      // until the era does not change between reserving it and reading the
+      // value.
+      auto era = impl::EraRecord::kFree;
+      for (auto current_era = impl::global_era.load(); current_era != era;
+           current_era = impl::global_era.load()) {
+        era = current_era;
+        hp_record_->era.store(era);
+        t_ptr_ = ptr.GetCurrent();
+      }
+    } else {
+      hp_record_ = &ptr.MakeHazardPointer();
+      // This cycle guarantees that at the end of it both t_ptr_ and
+      // hp_record_->ptr will both be set to
+      // 1. something meaningful
+      // 2. and that this meaningful value was not removed between assigning
+      //    to t_ptr_ and storing  it in a hazard pointer
+      do {
+        t_ptr_ = ptr.GetCurrent();
+
+        hp_record_->ptr.store(t_ptr_);
+      } while (t_ptr_ != ptr.GetCurrent());
+    }
+  }
+
   const T* GetOnRvalue() {
     static_assert(!sizeof(T),
                   "Don't use temporary ReadablePtr, store it to a variable");
@@ -184,7 +313,8 @@ class USERVER_NODISCARD ReadablePtr final {
   // Invariant is this: if t_ptr_ is not nullptr, then hp_record_ is also
   // not nullptr and points to hazard pointer containing same T*.
   // Thus, if t_ptr_ is nullptr, then hp_record_ is undefined.
-  impl::HazardPointerRecord<T>* hp_record_;
+  // With hazard eras the record holds the era instead of the pointer.
+  Record* hp_record_;
 };
 
 /// Smart pointer for rcu::Variable<T> for changing RCU value. It stores a
@@ -197,11 +327,11 @@ class USERVER_NODISCARD ReadablePtr final {
 /// @note you may not pass WritablePtr between coroutines as it owns
 /// engine::Mutex, which must be unlocked in the same coroutine that was used to
 /// lock the mutex.
-template <typename T>
+template <typename T, typename RcuTraits>
 class USERVER_NODISCARD WritablePtr final {
  public:
   /// For internal use only. Use `var.StartWrite()` instead
-  explicit WritablePtr(Variable<T>& var)
+  explicit WritablePtr(Variable<T, RcuTraits>& var)
       : var_(var),
         lock_(var.mutex_),
         ptr_(std::make_unique<T>(*var_.GetCurrent())) {
@@ -210,7 +340,8 @@ class USERVER_NODISCARD WritablePtr final {
 
   /// For internal use only. Use `var.Emplace(args...)` instead
   template <typename... Args>
-  WritablePtr(Variable<T>& var, std::in_place_t, Args&&... initial_value_args)
+  WritablePtr(Variable<T, RcuTraits>& var, std::in_place_t,
+              Args&&... initial_value_args)
       : var_(var),
         lock_(var.mutex_),
         ptr_(std::make_unique<T>(std::forward<Args>(initial_value_args)...)) {
@@ -218,7 +349,7 @@ class USERVER_NODISCARD WritablePtr final {
                 << " with custom initial value";
   }
 
-  WritablePtr(WritablePtr<T>&& other) noexcept
+  WritablePtr(WritablePtr<T, RcuTraits>&& other) noexcept
       : var_(other.var_),
         lock_(std::move(other.lock_)),
         ptr_(std::move(other.ptr_)) {
@@ -238,8 +369,7 @@ class USERVER_NODISCARD WritablePtr final {
     UASSERT(ptr_ != nullptr);
     LOG_TRACE() << "Committing ptr=" << ptr_.get();
 
-    std::unique_ptr<T> old_ptr(var_.current_.exchange(ptr_.release()));
-    var_.Retire(std::move(old_ptr), lock_);
+    var_.Publish(std::move(ptr_), lock_);
     lock_.unlock();
   }
 
@@ -263,7 +393,7 @@ class USERVER_NODISCARD WritablePtr final {
     std::abort();
   }
 
-  Variable<T>& var_;
+  Variable<T, RcuTraits>& var_;
   std::unique_lock<engine::Mutex> lock_;
   std::unique_ptr<T> ptr_;
 };
@@ -291,12 +421,15 @@ enum class DestructionType { kSync, kAsync };
 ///
 /// @note There is no way to create a "null" `Variable`.
 ///
+/// The way the old values are reclaimed is chosen by `RcuTraits`, see
+/// rcu::ReclamationType.
+///
 /// ## Example usage:
 ///
 /// @snippet rcu/rcu_test.cpp  Sample rcu::Variable usage
 ///
 /// @see @ref md_en_userver_synchronization
-template <typename T>
+template <typename T, typename RcuTraits>
 class Variable final {
  public:
   /// Create a new `Variable` with an in-place constructed initial value.
@@ -310,7 +443,9 @@ class Variable final {
                               ? DestructionType::kSync
                               : DestructionType::kAsync),
         epoch_(impl::GetNextEpoch()),
-        current_(new T(std::forward<Args>(initial_value_args)...)) {}
+        current_(new T(std::forward<Args>(initial_value_args)...)) {
+    InitBirthEra();
+  }
 
   /// Create a new `Variable` with an in-place constructed initial value.
   /// @param destruction_type controls whether destruction of old values should
@@ -321,7 +456,9 @@ class Variable final {
   Variable(DestructionType destruction_type, Args&&... initial_value_args)
       : destruction_type_(destruction_type),
         epoch_(impl::GetNextEpoch()),
-        current_(new T(std::forward<Args>(initial_value_args)...)) {}
+        current_(new T(std::forward<Args>(initial_value_args)...)) {
+    InitBirthEra();
+  }
 
   Variable(const Variable&) = delete;
   Variable(Variable&&) = delete;
@@ -347,7 +484,9 @@ class Variable final {
   }
 
   /// Obtain a smart pointer which can be used to read the current value.
-  ReadablePtr<T> Read() const { return ReadablePtr<T>(*this); }
+  ReadablePtr<T, RcuTraits> Read() const {
+    return ReadablePtr<T, RcuTraits>(*this);
+  }
 
   /// Obtain a copy of contained value.
   T ReadCopy() const {
@@ -358,24 +497,29 @@ class Variable final {
   /// Obtain a smart pointer that will *copy* the current value. The pointer can
   /// be used to make changes to the value and to set the `Variable` to the
   /// changed value.
-  WritablePtr<T> StartWrite() { return WritablePtr<T>(*this); }
+  WritablePtr<T, RcuTraits> StartWrite() {
+    return WritablePtr<T, RcuTraits>(*this);
+  }
 
   /// Obtain a smart pointer to a newly in-place constructed value, but does
   /// not replace the current one yet (in contrast with regular `Emplace`).
   template <typename... Args>
-  WritablePtr<T> StartWriteEmplace(Args&&... args) {
-    return WritablePtr<T>(*this, std::in_place, std::forward<Args>(args)...);
+  WritablePtr<T, RcuTraits> StartWriteEmplace(Args&&... args) {
+    return WritablePtr<T, RcuTraits>(*this, std::in_place,
+                                     std::forward<Args>(args)...);
   }
 
   /// Replaces the `Variable`'s value with the provided one.
   void Assign(T new_value) {
-    WritablePtr<T>(*this, std::in_place, std::move(new_value)).Commit();
+    WritablePtr<T, RcuTraits>(*this, std::in_place, std::move(new_value))
+        .Commit();
   }
 
   /// Replaces the `Variable`'s value with an in-place constructed one.
   template <typename... Args>
   void Emplace(Args&&... args) {
-    WritablePtr<T>(*this, std::in_place, std::forward<Args>(args)...).Commit();
+    WritablePtr<T, RcuTraits>(*this, std::in_place, std::forward<Args>(args)...)
+        .Commit();
   }
 
   void Cleanup() {
@@ -386,20 +530,49 @@ class Variable final {
       return;
     }
 
-    ScanRetiredList(CollectHazardPtrs(lock));
+    if constexpr (impl::kUsesHazardEras<RcuTraits>) {
+      ScanRetiredEras(lock);
+    } else {
+      ScanRetiredList(CollectHazardPtrs(lock));
+    }
   }
 
  private:
+  using HazardPointerRecord = impl::HazardPointerRecord<T, RcuTraits>;
+
   T* GetCurrent() const { return current_.load(); }
 
-  impl::HazardPointerRecord<T>* MakeHazardPointerCached() const {
-    auto& cache = impl::cache<T>;
+  void InitBirthEra() {
+    if constexpr (impl::kUsesHazardEras<RcuTraits>) {
+      era_state_.current_birth_era = impl::global_era.load();
+    }
+  }
+
+  void Publish(std::unique_ptr<T> new_ptr,
+               std::unique_lock<engine::Mutex>& lock) {
+    if constexpr (impl::kUsesHazardEras<RcuTraits>) {
+      // read before the value becomes visible to the readers
+      const auto birth_era = impl::global_era.load();
+      std::unique_ptr<T> old_ptr(current_.exchange(new_ptr.release()));
+      LOG_TRACE() << "Retiring ptr=" << old_ptr.get();
+      era_state_.retired.push_back({std::move(old_ptr),
+                                    era_state_.current_birth_era,
+                                    impl::global_era.fetch_add(1)});
+      era_state_.current_birth_era = birth_era;
+      ScanRetiredEras(lock);
+    } else {
+      std::unique_ptr<T> old_ptr(current_.exchange(new_ptr.release()));
+      Retire(std::move(old_ptr), lock);
+    }
+  }
+
+  HazardPointerRecord* MakeHazardPointerCached() const {
+    auto& cache = impl::cache<T, RcuTraits>;
     auto* hp = cache.hp;
     T* ptr = nullptr;
     if (hp && cache.variable == this && cache.variable_epoch == epoch_) {
       if (hp->ptr.load() == nullptr &&
-          hp->ptr.compare_exchange_strong(
-              ptr, impl::HazardPointerRecord<T>::kUsed)) {
+          hp->ptr.compare_exchange_strong(ptr, HazardPointerRecord::kUsed)) {
         return hp;
       }
     }
@@ -407,15 +580,14 @@ class Variable final {
     return nullptr;
   }
 
-  impl::HazardPointerRecord<T>* MakeHazardPointerFast() const {
+  HazardPointerRecord* MakeHazardPointerFast() const {
     // Look for any hazard pointer with nullptr data ptr.
     // Mark it with kUsed (to reserve it for ourselves) and return it.
     auto* hp = hp_record_head_.load();
     while (hp) {
       T* t_ptr = nullptr;
       if (hp->ptr.load() == nullptr &&
-          hp->ptr.compare_exchange_strong(
-              t_ptr, impl::HazardPointerRecord<T>::kUsed)) {
+          hp->ptr.compare_exchange_strong(t_ptr, HazardPointerRecord::kUsed)) {
         return hp;
       }
 
@@ -424,14 +596,14 @@ class Variable final {
     return nullptr;
   }
 
-  impl::HazardPointerRecord<T>& MakeHazardPointer() const {
+  HazardPointerRecord& MakeHazardPointer() const {
     auto* hp = MakeHazardPointerCached();
     if (!hp) {
       hp = MakeHazardPointerFast();
       // all buckets are full, create a new one
       if (!hp) hp = MakeHazardPointerSlow();
 
-      auto& cache = impl::cache<T>;
+      auto& cache = impl::cache<T, RcuTraits>;
       cache.hp = hp;
       cache.variable = this;
       cache.variable_epoch = epoch_;
@@ -440,10 +612,10 @@ class Variable final {
     return *hp;
   }
 
-  impl::HazardPointerRecord<T>* MakeHazardPointerSlow() const {
+  HazardPointerRecord* MakeHazardPointerSlow() const {
     // allocate new pointer, and add it to the list (atomically)
-    auto hp = new impl::HazardPointerRecord<T>(*this);
-    impl::HazardPointerRecord<T>* old_hp;
+    auto hp = new HazardPointerRecord(*this);
+    HazardPointerRecord* old_hp;
     do {
       old_hp = hp_record_head_.load();
       hp->next = old_hp;
@@ -494,6 +666,30 @@ class Variable final {
     return hazard_ptrs;
   }
 
+  // Destroys the retired values that are not protected by any reserved era
+  void ScanRetiredEras(std::unique_lock<engine::Mutex>&) {
+    auto& retired = era_state_.retired;
+    if (retired.empty()) return;
+
+    auto& eras = era_state_.reserved_eras;
+    impl::CollectReservedEras(eras);
+
+    std::size_t kept = 0;
+    for (std::size_t i = 0; i < retired.size(); ++i) {
+      const auto it =
+          std::lower_bound(eras.begin(), eras.end(), retired[i].birth_era);
+      if (it != eras.end() && *it <= retired[i].retire_era) {
+        // the value may be used by a reader
+        if (kept != i) retired[kept] = std::move(retired[i]);
+        ++kept;
+      } else {
+        LOG_TRACE() << "Retire, not used ptr=" << retired[i].ptr.get();
+        DeleteAsync(std::move(retired[i].ptr));
+      }
+    }
+    retired.resize(kept);
+  }
+
   void DeleteAsync(std::unique_ptr<T> ptr) {
     switch (destruction_type_) {
       case DestructionType::kSync:
@@ -514,16 +710,20 @@ class Variable final {
   const DestructionType destruction_type_;
   const uint64_t epoch_;
 
-  mutable std::atomic<impl::HazardPointerRecord<T>*> hp_record_head_{{nullptr}};
+  mutable std::atomic<HazardPointerRecord*> hp_record_head_{{nullptr}};
 
   engine::Mutex mutex_;  // for current_ changes and retire_list_head_ access
   // may be read without mutex_ locked, but must be changed with held mutex_
   std::atomic<T*> current_;
   std::list<std::unique_ptr<T>> retire_list_head_;
+  // for the hazard eras, protected by mutex_
+  std::conditional_t<impl::kUsesHazardEras<RcuTraits>,
+                     impl::EraReclamationState<T>, impl::NoEraReclamationState>
+      era_state_;
   utils::impl::WaitTokenStorage wait_token_storage_;
 
-  friend class ReadablePtr<T>;
-  friend class WritablePtr<T>;
+  friend class ReadablePtr<T, RcuTraits>;
+  friend class WritablePtr<T, RcuTraits>;
 };
 
 }  // namespace rcu
@@ -10,6 +10,7 @@
 #include <unordered_map>
 #include <utility>
 
+#include <userver/rcu/fwd.hpp>
 #include <userver/rcu/rcu.hpp>
 #include <userver/utils/traceful_exception.hpp>
 
@@ -26,7 +27,7 @@ class MissingKeyException : public utils::TracefulException {
 /// @brief Forward iterator for the rcu::RcuMap
 ///
 /// Use member functions of rcu::RcuMap to retrieve the iterator.
-template <typename Key, typename Value, typename IterValue>
+template <typename Key, typename Value, typename IterValue, typename RcuTraits>
 class RcuMapIterator final {
   using MapType = std::unordered_map<Key, std::shared_ptr<Value>>;
   using BaseIterator = typename MapType::const_iterator;
@@ -50,13 +51,13 @@ class RcuMapIterator final {
 
   /// @cond
   /// For internal use only
-  RcuMapIterator(ReadablePtr<MapType>&& ptr, BaseIterator iter);
+  RcuMapIterator(ReadablePtr<MapType, RcuTraits>&& ptr, BaseIterator iter);
   /// @endcond
 
  private:
   void UpdateCurrent();
 
-  std::optional<ReadablePtr<MapType>> ptr_;
+  std::optional<ReadablePtr<MapType, RcuTraits>> ptr_;
   BaseIterator it_;
   value_type current_;
 };
@@ -72,12 +73,15 @@ class RcuMapIterator final {
 /// @note No synchronization is provided for value access, it must be
 /// implemented by Value when necessary.
 ///
+/// `RcuTraits` choose the reclamation of the old maps, see
+/// rcu::ReclamationType.
+///
 /// ## Example usage:
 ///
 /// @snippet rcu/rcu_map_test.cpp  Sample rcu::RcuMap usage
 ///
 /// @see @ref md_en_userver_synchronization
-template <typename Key, typename Value>
+template <typename Key, typename Value, typename RcuTraits>
 class RcuMap final {
   static_assert(!std::is_reference_v<Key>);
   static_assert(!std::is_reference_v<Value>);
@@ -88,9 +92,9 @@ class RcuMap final {
   struct InsertReturnTypeImpl;
 
   using ValuePtr = std::shared_ptr<Value>;
-  using Iterator = RcuMapIterator<Key, Value, Value>;
+  using Iterator = RcuMapIterator<Key, Value, Value, RcuTraits>;
   using ConstValuePtr = std::shared_ptr<const Value>;
-  using ConstIterator = RcuMapIterator<Key, Value, const Value>;
+  using ConstIterator = RcuMapIterator<Key, Value, const Value, RcuTraits>;
   using Snapshot = std::unordered_map<Key, ConstValuePtr>;
   using InsertReturnType = InsertReturnTypeImpl<ValuePtr>;
 
@@ -195,74 +199,76 @@ class RcuMap final {
 
   using MapType = std::unordered_map<Key, ValuePtr>;
 
-  rcu::Variable<MapType> rcu_;
+  rcu::Variable<MapType, RcuTraits> rcu_;
 };
 
-template <typename K, typename V>
+template <typename K, typename V, typename Traits>
 template <typename ValuePtrType>
-struct RcuMap<K, V>::InsertReturnTypeImpl {
+struct RcuMap<K, V, Traits>::InsertReturnTypeImpl {
   ValuePtrType value;
   bool inserted;
 };
 
-template <typename K, typename V>
-typename RcuMap<K, V>::ConstIterator RcuMap<K, V>::begin() const {
+template <typename K, typename V, typename Traits>
+typename RcuMap<K, V, Traits>::ConstIterator RcuMap<K, V, Traits>::begin()
+    const {
   auto ptr = rcu_.Read();
   const auto iter = ptr->cbegin();
   return {std::move(ptr), iter};
 }
 
-template <typename K, typename V>
-typename RcuMap<K, V>::ConstIterator RcuMap<K, V>::end() const {
+template <typename K, typename V, typename Traits>
+typename RcuMap<K, V, Traits>::ConstIterator RcuMap<K, V, Traits>::end() const {
   // End iterator must be empty, because otherwise begin and end calls will
   // return iterators that point into different map snapshots.
   return {};
 }
 
-template <typename K, typename V>
-typename RcuMap<K, V>::Iterator RcuMap<K, V>::begin() {
+template <typename K, typename V, typename Traits>
+typename RcuMap<K, V, Traits>::Iterator RcuMap<K, V, Traits>::begin() {
   auto ptr = rcu_.Read();
   const auto iter = ptr->cbegin();
   return {std::move(ptr), iter};
 }
 
-template <typename K, typename V>
-typename RcuMap<K, V>::Iterator RcuMap<K, V>::end() {
+template <typename K, typename V, typename Traits>
+typename RcuMap<K, V, Traits>::Iterator RcuMap<K, V, Traits>::end() {
   // End iterator must be empty, because otherwise begin and end calls will
   // return iterators that point into different map snapshots.
   return {};
 }
 
-template <typename K, typename V>
-size_t RcuMap<K, V>::SizeApprox() const {
+template <typename K, typename V, typename Traits>
+size_t RcuMap<K, V, Traits>::SizeApprox() const {
   auto ptr = rcu_.Read();
   return ptr->size();
 }
 
-template <typename K, typename V>
+template <typename K, typename V, typename Traits>
 // Protects from assignment to map[key]
 // NOLINTNEXTLINE(readability-const-return-type)
-const typename RcuMap<K, V>::ConstValuePtr RcuMap<K, V>::operator[](
-    const K& key) const {
+const typename RcuMap<K, V, Traits>::ConstValuePtr
+RcuMap<K, V, Traits>::operator[](const K& key) const {
   if (auto value = Get(key)) {
     return value;
   }
   throw MissingKeyException("Key ") << key << " is missing";
 }
 
-template <typename K, typename V>
+template <typename K, typename V, typename Traits>
 // Protects from assignment to map[key]
 // NOLINTNEXTLINE(readability-const-return-type)
-const typename RcuMap<K, V>::ConstValuePtr RcuMap<K, V>::Get(
+const typename RcuMap<K, V, Traits>::ConstValuePtr RcuMap<K, V, Traits>::Get(
     const K& key) const {
   // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
-  return const_cast<RcuMap<K, V>*>(this)->Get(key);
+  return const_cast<RcuMap<K, V, Traits>*>(this)->Get(key);
 }
 
-template <typename K, typename V>
+template <typename K, typename V, typename Traits>
 // Protects from assignment to map[key]
 // NOLINTNEXTLINE(readability-const-return-type)
-const typename RcuMap<K, V>::ValuePtr RcuMap<K, V>::operator[](const K& key) {
+const typename RcuMap<K, V, Traits>::ValuePtr RcuMap<K, V, Traits>::operator[](
+    const K& key) {
   auto value = Get(key);
   if (!value) {
     auto txn = rcu_.StartWrite();
@@ -273,28 +279,28 @@ const typename RcuMap<K, V>::ValuePtr RcuMap<K, V>::operator[](const K& key) {
   return value;
 }
 
-template <typename K, typename V>
-typename RcuMap<K, V>::InsertReturnType RcuMap<K, V>::Insert(
-    const K& key, typename RcuMap<K, V>::ValuePtr value) {
+template <typename K, typename V, typename Traits>
+typename RcuMap<K, V, Traits>::InsertReturnType RcuMap<K, V, Traits>::Insert(
+    const K& key, typename RcuMap<K, V, Traits>::ValuePtr value) {
   InsertReturnType result{Get(key), false};
   if (result.value) return result;
 
   return DoInsert(key, std::move(value));
 }
 
-template <typename K, typename V>
+template <typename K, typename V, typename Traits>
 template <typename... Args>
-typename RcuMap<K, V>::InsertReturnType RcuMap<K, V>::Emplace(const K& key,
-                                                              Args&&... args) {
+typename RcuMap<K, V, Traits>::InsertReturnType RcuMap<K, V, Traits>::Emplace(
+    const K& key, Args&&... args) {
   InsertReturnType result{Get(key), false};
   if (result.value) return result;
 
   return DoInsert(key, std::make_shared<V>(std::forward<Args>(args)...));
 }
 
-template <typename K, typename V>
-typename RcuMap<K, V>::InsertReturnType RcuMap<K, V>::DoInsert(
-    const K& key, typename RcuMap<K, V>::ValuePtr value) {
+template <typename K, typename V, typename Traits>
+typename RcuMap<K, V, Traits>::InsertReturnType RcuMap<K, V, Traits>::DoInsert(
+    const K& key, typename RcuMap<K, V, Traits>::ValuePtr value) {
   auto txn = rcu_.StartWrite();
   auto insertion_result = txn->emplace(key, std::move(value));
   InsertReturnType result{insertion_result.first->second,
@@ -303,10 +309,10 @@ typename RcuMap<K, V>::InsertReturnType RcuMap<K, V>::DoInsert(
   return result;
 }
 
-template <typename K, typename V>
+template <typename K, typename V, typename Traits>
 template <typename... Args>
-typename RcuMap<K, V>::InsertReturnType RcuMap<K, V>::TryEmplace(
-    const K& key, Args&&... args) {
+typename RcuMap<K, V, Traits>::InsertReturnType
+RcuMap<K, V, Traits>::TryEmplace(const K& key, Args&&... args) {
   InsertReturnType result{Get(key), false};
   if (!result.value) {
     auto txn = rcu_.StartWrite();
@@ -323,26 +329,28 @@ typename RcuMap<K, V>::InsertReturnType RcuMap<K, V>::TryEmplace(
   return result;
 }
 
-template <typename Key, typename Value>
+template <typename Key, typename Value, typename Traits>
 template <typename RawKey>
-void RcuMap<Key, Value>::InsertOrAssign(RawKey&& key, RcuMap::ValuePtr value) {
+void RcuMap<Key, Value, Traits>::InsertOrAssign(RawKey&& key,
+                                                RcuMap::ValuePtr value) {
   auto txn = rcu_.StartWrite();
   txn->insert_or_assign(std::forward<RawKey>(key), std::move(value));
   txn.Commit();
 }
 
-template <typename K, typename V>
+template <typename K, typename V, typename Traits>
 // Protects from assignment to map[key]
 // NOLINTNEXTLINE(readability-const-return-type)
-const typename RcuMap<K, V>::ValuePtr RcuMap<K, V>::Get(const K& key) {
+const typename RcuMap<K, V, Traits>::ValuePtr RcuMap<K, V, Traits>::Get(
+    const K& key) {
   auto snapshot = rcu_.Read();
   auto it = snapshot->find(key);
   if (it == snapshot->end()) return {};
   return it->second;
 }
 
-template <typename K, typename V>
-bool RcuMap<K, V>::Erase(const K& key) {
+template <typename K, typename V, typename Traits>
+bool RcuMap<K, V, Traits>::Erase(const K& key) {
   if (Get(key)) {
     auto txn = rcu_.StartWrite();
     if (txn->erase(key)) {
@@ -353,8 +361,9 @@ bool RcuMap<K, V>::Erase(const K& key) {
   return false;
 }
 
-template <typename K, typename V>
-typename RcuMap<K, V>::ValuePtr RcuMap<K, V>::Pop(const K& key) {
+template <typename K, typename V, typename Traits>
+typename RcuMap<K, V, Traits>::ValuePtr RcuMap<K, V, Traits>::Pop(
+    const K& key) {
   auto value = Get(key);
   if (value) {
     auto txn = rcu_.StartWrite();
@@ -363,55 +372,60 @@ typename RcuMap<K, V>::ValuePtr RcuMap<K, V>::Pop(const K& key) {
   return value;
 }
 
-template <typename K, typename V>
-void RcuMap<K, V>::Clear() {
+template <typename K, typename V, typename Traits>
+void RcuMap<K, V, Traits>::Clear() {
   rcu_.Assign({});
 }
 
-template <typename K, typename V>
-void RcuMap<K, V>::Assign(
-    std::unordered_map<K, typename RcuMap<K, V>::ValuePtr> new_map) {
+template <typename K, typename V, typename Traits>
+void RcuMap<K, V, Traits>::Assign(
+    std::unordered_map<K, typename RcuMap<K, V, Traits>::ValuePtr> new_map) {
   rcu_.Assign(std::move(new_map));
 }
 
-template <typename K, typename V>
-typename RcuMap<K, V>::Snapshot RcuMap<K, V>::GetSnapshot() const {
+template <typename K, typename V, typename Traits>
+typename RcuMap<K, V, Traits>::Snapshot RcuMap<K, V, Traits>::GetSnapshot()
+    const {
   return {begin(), end()};
 }
 
-template <typename Key, typename Value, typename IterValue>
-RcuMapIterator<Key, Value, IterValue>::RcuMapIterator(
-    ReadablePtr<MapType>&& ptr, typename MapType::const_iterator iter)
+template <typename Key, typename Value, typename IterValue, typename Traits>
+RcuMapIterator<Key, Value, IterValue, Traits>::RcuMapIterator(
+    ReadablePtr<MapType, Traits>&& ptr, typename MapType::const_iterator iter)
     : ptr_(std::move(ptr)), it_(iter) {
   UpdateCurrent();
 }
 
-template <typename Key, typename Value, typename IterValue>
-auto RcuMapIterator<Key, Value, IterValue>::operator++(int) -> RcuMapIterator {
+template <typename Key, typename Value, typename IterValue, typename Traits>
+auto RcuMapIterator<Key, Value, IterValue, Traits>::operator++(int)
+    -> RcuMapIterator {
   RcuMapIterator tmp(*this);
   ++*this;
   return tmp;
 }
 
-template <typename Key, typename Value, typename IterValue>
-auto RcuMapIterator<Key, Value, IterValue>::operator++() -> RcuMapIterator& {
+template <typename Key, typename Value, typename IterValue, typename Traits>
+auto RcuMapIterator<Key, Value, IterValue, Traits>::operator++()
+    -> RcuMapIterator& {
   ++it_;
   UpdateCurrent();
   return *this;
 }
 
-template <typename Key, typename Value, typename IterValue>
-auto RcuMapIterator<Key, Value, IterValue>::operator*() const -> reference {
+template <typename Key, typename Value, typename IterValue, typename Traits>
+auto RcuMapIterator<Key, Value, IterValue, Traits>::operator*() const
+    -> reference {
   return current_;
 }
 
-template <typename Key, typename Value, typename IterValue>
-auto RcuMapIterator<Key, Value, IterValue>::operator-> () const -> pointer {
+template <typename Key, typename Value, typename IterValue, typename Traits>
+auto RcuMapIterator<Key, Value, IterValue, Traits>::operator->() const
+    -> pointer {
   return &current_;
 }
 
-template <typename Key, typename Value, typename IterValue>
-bool RcuMapIterator<Key, Value, IterValue>::operator==(
+template <typename Key, typename Value, typename IterValue, typename Traits>
+bool RcuMapIterator<Key, Value, IterValue, Traits>::operator==(
     const RcuMapIterator& rhs) const {
   if (ptr_) {
     if (rhs.ptr_) {
@@ -424,14 +438,14 @@ bool RcuMapIterator<Key, Value, IterValue>::operator==(
   }
 }
 
-template <typename Key, typename Value, typename IterValue>
-bool RcuMapIterator<Key, Value, IterValue>::operator!=(
+template <typename Key, typename Value, typename IterValue, typename Traits>
+bool RcuMapIterator<Key, Value, IterValue, Traits>::operator!=(
     const RcuMapIterator& rhs) const {
   return !(*this == rhs);
 }
 
-template <typename Key, typename Value, typename IterValue>
-void RcuMapIterator<Key, Value, IterValue>::UpdateCurrent() {
+template <typename Key, typename Value, typename IterValue, typename Traits>
+void RcuMapIterator<Key, Value, IterValue, Traits>::UpdateCurrent() {
   if (it_ != (*ptr_)->end()) {
     current_ = *it_;
   }
@@ -26,6 +26,15 @@ namespace server::handlers {
 /// ## Scheme
 /// Accepts a path argument `prefix` and pass it to
 /// utils::statistics::Storage::GetAsJson()
+///
+/// The optional `format` argument selects the output format:
+/// * `json` (default) - utils::statistics::Storage::GetAsJson()
+/// * `prometheus` - utils::statistics::ToPrometheusFormat()
+/// * `openmetrics` - utils::statistics::ToOpenMetricsFormat()
+/// * `graphite` - utils::statistics::ToGraphiteFormat()
+///
+/// All the formats except `json` are written in a single pass without
+/// building the JSON of the whole metrics tree.
 
 // clang-format on
 class ServerMonitor final : public HttpHandlerBase {
@@ -141,6 +141,16 @@ class Span final {
   /// @brief Returns level for tags logging
   logging::Level GetLogLevel() const;
 
+  /// @brief Overrides the head-based sampling decision for the trace of this
+  /// Span and its future children, e.g. with the one of the upstream service.
+  ///
+  /// Spans of a not sampled trace are not logged, unless the tail-based
+  /// retention of @ref USERVER_SPAN_SAMPLING keeps them.
+  void SetSampled(bool sampled);
+
+  /// @brief Returns the head-based sampling decision for the trace
+  bool IsSampled() const noexcept;
+
   /// @brief Sets the local log level that disables logging of this span if
   /// the local log level set and greater than the main log level of the Span.
   void SetLocalLogLevel(std::optional<logging::Level> log_level);
@@ -12,12 +12,15 @@ USERVER_NAMESPACE_BEGIN
 namespace tracing {
 
 struct NoLogSpans;
+struct SpanSampling;
 
 class Tracer : public std::enable_shared_from_this<Tracer> {
  public:
   static void SetNoLogSpans(NoLogSpans&& spans);
   static bool IsNoLogSpan(const std::string& name);
 
+  static void SetSpanSampling(SpanSampling&& sampling);
+
   static void SetTracer(TracerPtr tracer);
 
   static TracerPtr GetTracer();
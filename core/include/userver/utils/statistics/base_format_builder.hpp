@@ -0,0 +1,38 @@
+#pragma once
+
+/// @file userver/utils/statistics/base_format_builder.hpp
+/// @brief @copybrief utils::statistics::BaseFormatBuilder
+
+#include <string_view>
+#include <vector>
+
+#include <userver/utils/statistics/labels.hpp>
+#include <userver/utils/statistics/metric_value.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::statistics {
+
+/// @brief Base class for the metrics output formats
+///
+/// utils::statistics::Storage::VisitMetrics() calls HandleMetric() for each
+/// metric in a single pass, without building any intermediate representation.
+/// Implementations are expected to append the metric to their output right
+/// away.
+class BaseFormatBuilder {
+ public:
+  virtual ~BaseFormatBuilder();
+
+  /// @param path dot-separated name of the metric
+  /// @param labels labels of the metric, outer labels go first
+  /// @param value value of the metric
+  ///
+  /// All the arguments are valid only for the duration of the call.
+  virtual void HandleMetric(std::string_view path,
+                            const std::vector<LabelView>& labels,
+                            const MetricValue& value) = 0;
+};
+
+}  // namespace utils::statistics
+
+USERVER_NAMESPACE_END
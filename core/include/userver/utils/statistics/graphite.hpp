@@ -0,0 +1,22 @@
+#pragma once
+
+/// @file userver/utils/statistics/graphite.hpp
+/// @brief Statistics output in Graphite plaintext format
+
+#include <string>
+
+#include <userver/utils/statistics/storage.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::statistics {
+
+/// Returns the metrics in the Graphite plaintext format with tags, one
+/// `path;label=value value timestamp` line per metric. Characters that are
+/// not allowed by Graphite are replaced by '_'.
+std::string ToGraphiteFormat(const Storage& storage,
+                             const StatisticsRequest& request = {});
+
+}  // namespace utils::statistics
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,252 @@
+#pragma once
+
+/// @file userver/utils/statistics/hdr_histogram.hpp
+/// @brief @copybrief utils::statistics::HdrHistogram
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <string_view>
+
+#include <userver/utils/statistics/sharded_percentile.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::statistics {
+
+namespace impl {
+
+void AppendVarint(std::string& out, std::uint64_t value);
+
+/// Removes the parsed varint from `data`
+/// @throws std::runtime_error on truncated or too long varint
+std::uint64_t ParseVarint(std::string_view& data);
+
+[[noreturn]] void ThrowInvalidHdrHistogram(std::string_view reason);
+
+}  // namespace impl
+
+// clang-format off
+
+/// @brief Log-linear (HDR-style) histogram with bounded relative error
+///
+/// Values in [0..2^SubBucketBits) have their own buckets. Each next power of
+/// two range [2^(k-1)..2^k) is split into 2^(SubBucketBits-1) buckets of
+/// equal width, so the relative error of GetPercentile() does not exceed
+/// 2^(1-SubBucketBits) over the whole [0..2^MaxValueBits) range.
+/// Larger values are accounted in the last bucket.
+///
+/// The defaults keep 1.6% precision for values up to 2^32 in 1728 buckets,
+/// which is less memory than utils::statistics::Percentile<2048>.
+///
+/// Histograms with the same template arguments are mergeable via Add(), so
+/// they could be used with utils::statistics::RecentPeriod and
+/// utils::statistics::ShardedHistogram (see ShardedHdrHistogram). Use
+/// Serialize() and Deserialize() to merge histograms from different hosts.
+///
+/// @code
+/// utils::statistics::RecentPeriod<utils::statistics::HdrHistogram<>,
+///                                 utils::statistics::HdrHistogram<>>
+///     timings;
+///
+/// timings.GetCurrentCounter().Account(ms.count());
+/// stats_builder["timings"] =
+///     utils::statistics::PercentileToJson(timings.GetStatsForPeriod());
+/// @endcode
+///
+/// @tparam SubBucketBits precision of the histogram
+/// @tparam MaxValueBits values up to 2^MaxValueBits-1 are accounted precisely
+/// @tparam Counter bucket type
+
+// clang-format on
+template <std::size_t SubBucketBits = 7, std::size_t MaxValueBits = 32,
+          typename Counter = std::uint32_t>
+class HdrHistogram final {
+  static_assert(SubBucketBits >= 1 && SubBucketBits <= MaxValueBits &&
+                MaxValueBits <= std::numeric_limits<std::size_t>::digits);
+
+ public:
+  /// Values in [0..kExactValues) are accounted precisely
+  static constexpr std::size_t kExactValues = std::size_t{1} << SubBucketBits;
+
+  static constexpr std::size_t kBucketsCount =
+      kExactValues + (MaxValueBits - SubBucketBits) * (kExactValues / 2);
+
+  /// Larger values are accounted as kMaxValue
+  static constexpr std::size_t kMaxValue =
+      MaxValueBits == std::numeric_limits<std::size_t>::digits
+          ? std::numeric_limits<std::size_t>::max()
+          : (std::size_t{1} << (MaxValueBits % 64)) - 1;
+
+  HdrHistogram() { Reset(); }
+
+  HdrHistogram(const HdrHistogram& other) noexcept { *this = other; }
+
+  // NOLINTNEXTLINE(cert-oop54-cpp)
+  HdrHistogram& operator=(const HdrHistogram& rhs) noexcept {
+    if (this == &rhs) return *this;
+
+    Counter sum = 0;
+    for (std::size_t i = 0; i < kBucketsCount; ++i) {
+      const auto value = rhs.values_[i].load(std::memory_order_relaxed);
+      values_[i].store(value, std::memory_order_relaxed);
+      sum += value;
+    }
+    count_ = sum;
+    return *this;
+  }
+
+  /// @brief Account for another value
+  /// @param count how many times the value is accounted for
+  void Account(std::size_t value, Counter count = 1) {
+    values_[BucketIndex(value)].fetch_add(count, std::memory_order_relaxed);
+    count_.fetch_add(count, std::memory_order_release);
+  }
+
+  /// @brief Get X percentile - the upper bound of the first bucket so that
+  /// total number of elements in the buckets up to it is no less than
+  /// X percent
+  /// @param percent - value in [0..100] - requested percentile
+  ///                  if outside of 100, then returns the upper bound of the
+  ///                  last bucket that has any element in it.
+  std::size_t GetPercentile(double percent) const {
+    if (count_ == 0) return 0;
+
+    std::size_t sum = 0;
+    const std::size_t want_sum =
+        count_.load(std::memory_order_acquire) * percent;
+    std::size_t max_value = 0;
+    for (std::size_t i = 0; i < kBucketsCount; ++i) {
+      const auto value = values_[i].load(std::memory_order_relaxed);
+      if (!value) continue;
+
+      sum += value;
+      if (sum * 100 > want_sum) return BucketUpperBound(i);
+      max_value = BucketUpperBound(i);
+    }
+
+    return max_value;
+  }
+
+  template <class Duration = std::chrono::seconds>
+  void Add(const HdrHistogram& other,
+           [[maybe_unused]] Duration this_epoch_duration = Duration(),
+           [[maybe_unused]] Duration before_this_epoch_duration = Duration()) {
+    Counter sum = 0;
+    for (std::size_t i = 0; i < kBucketsCount; ++i) {
+      const auto value = other.values_[i].load(std::memory_order_relaxed);
+      if (!value) continue;
+
+      sum += value;
+      values_[i].fetch_add(value, std::memory_order_relaxed);
+    }
+    count_.fetch_add(sum, std::memory_order_release);
+  }
+
+  void Reset() {
+    for (auto& value : values_) value.store(0, std::memory_order_relaxed);
+    count_ = 0;
+  }
+
+  /// @brief Total number of elements
+  Counter Count() const { return count_; }
+
+  /// @brief Returns the compact binary representation of the histogram.
+  /// Only non-empty buckets are stored.
+  std::string Serialize() const {
+    std::string result;
+    result.push_back(kSerializationVersion);
+    result.push_back(static_cast<char>(SubBucketBits));
+    result.push_back(static_cast<char>(MaxValueBits));
+
+    std::size_t next_index = 0;
+    for (std::size_t i = 0; i < kBucketsCount; ++i) {
+      const auto value = values_[i].load(std::memory_order_relaxed);
+      if (!value) continue;
+
+      impl::AppendVarint(result, i - next_index);
+      impl::AppendVarint(result, value);
+      next_index = i + 1;
+    }
+    return result;
+  }
+
+  /// @brief Parses the result of Serialize() of a histogram with the same
+  /// template arguments
+  /// @throws std::runtime_error if the data is invalid
+  static HdrHistogram Deserialize(std::string_view data) {
+    if (data.size() < 3 || data[0] != kSerializationVersion ||
+        static_cast<std::size_t>(data[1]) != SubBucketBits ||
+        static_cast<std::size_t>(data[2]) != MaxValueBits) {
+      impl::ThrowInvalidHdrHistogram("incompatible header");
+    }
+    data.remove_prefix(3);
+
+    HdrHistogram result;
+    std::size_t next_index = 0;
+    while (!data.empty()) {
+      const auto index = next_index + impl::ParseVarint(data);
+      const auto value = impl::ParseVarint(data);
+      if (index >= kBucketsCount || index < next_index) {
+        impl::ThrowInvalidHdrHistogram("bucket index is out of range");
+      }
+      if (value > std::numeric_limits<Counter>::max()) {
+        impl::ThrowInvalidHdrHistogram("bucket value is out of range");
+      }
+
+      result.values_[index].store(value, std::memory_order_relaxed);
+      result.count_ += value;
+      next_index = index + 1;
+    }
+    return result;
+  }
+
+  /// @brief Returns the index of the bucket that accounts `value`
+  static constexpr std::size_t BucketIndex(std::size_t value) noexcept {
+    if (value > kMaxValue) value = kMaxValue;
+    if (value < kExactValues) return value;
+
+    const std::size_t shift = BitWidth(value) - SubBucketBits;
+    return kExactValues + (shift - 1) * (kExactValues / 2) +
+           ((value >> shift) - kExactValues / 2);
+  }
+
+  /// @brief Returns the largest value that is accounted in the bucket
+  static constexpr std::size_t BucketUpperBound(std::size_t index) noexcept {
+    if (index < kExactValues) return index;
+
+    const std::size_t shift = (index - kExactValues) / (kExactValues / 2) + 1;
+    const std::size_t sub_bucket =
+        (index - kExactValues) % (kExactValues / 2) + kExactValues / 2;
+    // wraps around to kMaxValue for the last bucket of a 64 bit histogram
+    return ((sub_bucket + 1) << shift) - 1;
+  }
+
+ private:
+  static constexpr char kSerializationVersion = 1;
+
+  static constexpr std::size_t BitWidth(std::size_t value) noexcept {
+    static_assert(sizeof(std::size_t) == sizeof(unsigned long long));
+    return std::numeric_limits<std::size_t>::digits - __builtin_clzll(value);
+  }
+
+  std::array<std::atomic<Counter>, kBucketsCount> values_;
+  std::atomic<Counter> count_;
+};
+
+/// utils::statistics::ShardedHistogram over utils::statistics::HdrHistogram
+template <std::size_t SubBucketBits = 7, std::size_t MaxValueBits = 32,
+          typename Counter = std::uint32_t>
+using ShardedHdrHistogram =
+    ShardedHistogram<HdrHistogram<SubBucketBits, MaxValueBits, Counter>,
+                     Counter,
+                     HdrHistogram<SubBucketBits, MaxValueBits,
+                                  Counter>::kExactValues>;
+
+}  // namespace utils::statistics
+
+USERVER_NAMESPACE_END
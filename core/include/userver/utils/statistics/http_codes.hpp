@@ -4,7 +4,7 @@
 #include <memory>
 #include <unordered_map>
 
-#include <userver/utils/statistics/relaxed_counter.hpp>
+#include <userver/utils/statistics/sharded_counter.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -37,7 +37,7 @@ class HttpCodes final {
 
  private:
   using ValueType = std::uint64_t;
-  using Counter = RelaxedCounter<ValueType>;
+  using Counter = ShardedCounter<ValueType>;
 
   Counter code_1xx;
   Counter code_2xx;
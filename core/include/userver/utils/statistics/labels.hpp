@@ -0,0 +1,60 @@
+#pragma once
+
+/// @file userver/utils/statistics/labels.hpp
+/// @brief @copybrief utils::statistics::LabelView
+
+#include <string>
+#include <string_view>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::statistics {
+
+class Label;
+
+/// @brief Non owning label name+value storage.
+class LabelView final {
+ public:
+  LabelView() = delete;
+  constexpr LabelView(std::string_view name, std::string_view value) noexcept
+      : name_(name), value_(value) {}
+  explicit LabelView(const Label& label) noexcept;
+
+  constexpr std::string_view Name() const noexcept { return name_; }
+  constexpr std::string_view Value() const noexcept { return value_; }
+
+ private:
+  std::string_view name_;
+  std::string_view value_;
+};
+
+bool operator<(const LabelView& x, const LabelView& y) noexcept;
+bool operator==(const LabelView& x, const LabelView& y) noexcept;
+inline bool operator!=(const LabelView& x, const LabelView& y) noexcept {
+  return !(x == y);
+}
+
+/// @brief Label name+value storage.
+class Label final {
+ public:
+  Label() = default;
+  explicit Label(LabelView view);
+  Label(std::string name, std::string value);
+
+  const std::string& Name() const noexcept { return name_; }
+  const std::string& Value() const noexcept { return value_; }
+
+ private:
+  std::string name_;
+  std::string value_;
+};
+
+bool operator<(const Label& x, const Label& y) noexcept;
+bool operator==(const Label& x, const Label& y) noexcept;
+inline bool operator!=(const Label& x, const Label& y) noexcept {
+  return !(x == y);
+}
+
+}  // namespace utils::statistics
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,74 @@
+#pragma once
+
+/// @file userver/utils/statistics/metric_value.hpp
+/// @brief @copybrief utils::statistics::MetricValue
+
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <variant>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::statistics {
+
+/// @brief The value of a metric: an integer or a floating point number
+///
+/// Unsigned values above the maximum of std::int64_t are stored as the
+/// maximum, so that the overflown counters do not turn negative.
+class MetricValue final {
+ public:
+  constexpr MetricValue() noexcept : value_(std::int64_t{0}) {}
+
+  // NOLINTNEXTLINE(google-explicit-constructor)
+  template <typename T, std::enable_if_t<std::is_arithmetic_v<T>, int> = 0>
+  constexpr MetricValue(T value) noexcept
+      : value_(Convert(value)) {}
+
+  constexpr bool IsInt() const noexcept {
+    return std::holds_alternative<std::int64_t>(value_);
+  }
+
+  /// @pre IsInt()
+  constexpr std::int64_t AsInt() const {
+    return std::get<std::int64_t>(value_);
+  }
+
+  /// @pre !IsInt()
+  constexpr double AsFloat() const { return std::get<double>(value_); }
+
+  /// Calls `visitor` with either std::int64_t or double
+  template <typename VisitorFunc>
+  decltype(auto) Visit(VisitorFunc visitor) const {
+    return std::visit(visitor, value_);
+  }
+
+  constexpr bool operator==(const MetricValue& other) const noexcept {
+    return value_ == other.value_;
+  }
+
+  constexpr bool operator!=(const MetricValue& other) const noexcept {
+    return value_ != other.value_;
+  }
+
+ private:
+  template <typename T>
+  static constexpr std::variant<std::int64_t, double> Convert(T value) {
+    if constexpr (std::is_floating_point_v<T>) {
+      return static_cast<double>(value);
+    } else if constexpr (std::is_unsigned_v<T> &&
+                         sizeof(T) >= sizeof(std::int64_t)) {
+      constexpr auto kMax = std::numeric_limits<std::int64_t>::max();
+      return value > static_cast<T>(kMax) ? kMax
+                                          : static_cast<std::int64_t>(value);
+    } else {
+      return static_cast<std::int64_t>(value);
+    }
+  }
+
+  std::variant<std::int64_t, double> value_;
+};
+
+}  // namespace utils::statistics
+
+USERVER_NAMESPACE_END
@@ -25,6 +25,7 @@ namespace utils::statistics {
  * @tparam ExtraBucketSize ExtraBuckets store values with this precision
  * @see GetPercentile
  * @see Account
+ * @see utils::statistics::HdrHistogram for the values with a long tail
  *
  * Example:
  * Precisely count for first 500 milliseconds of execution using uint32_t
@@ -86,22 +87,23 @@ class Percentile final {
 
   /** \brief Account for another value. Value is truncated [0..M) and
    *  added to the corresponding bucket
+   * @param count how many times the value is accounted for
    */
-  void Account(size_t value) {
+  void Account(size_t value, Counter count = 1) {
     value = std::max<size_t>(0, value);
     if (value < values_.size()) {
-      values_[value].fetch_add(1, std::memory_order_relaxed);
+      values_[value].fetch_add(count, std::memory_order_relaxed);
     } else {
       if (!extra_values_.empty()) {
         size_t extra_bucket =
             (value - values_.size() + ExtraBucketSize / 2) / ExtraBucketSize;
         extra_bucket = std::min<size_t>(extra_bucket, extra_values_.size() - 1);
-        extra_values_[extra_bucket].fetch_add(1, std::memory_order_relaxed);
+        extra_values_[extra_bucket].fetch_add(count, std::memory_order_relaxed);
       } else {
-        values_.back().fetch_add(1, std::memory_order_relaxed);
+        values_.back().fetch_add(count, std::memory_order_relaxed);
       }
     }
-    count_.fetch_add(1, std::memory_order_release);
+    count_.fetch_add(count, std::memory_order_release);
   }
 
   /** \brief Get X percentile - min value P in [0..M) so that total number
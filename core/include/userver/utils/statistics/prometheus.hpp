@@ -0,0 +1,26 @@
+#pragma once
+
+/// @file userver/utils/statistics/prometheus.hpp
+/// @brief Statistics output in Prometheus and OpenMetrics text formats
+
+#include <string>
+
+#include <userver/utils/statistics/storage.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::statistics {
+
+/// Returns the metrics in the Prometheus text exposition format 0.0.4. Metric
+/// names are the metric paths with invalid characters replaced by '_'.
+std::string ToPrometheusFormat(const Storage& storage,
+                               const StatisticsRequest& request = {});
+
+/// Returns the metrics in the OpenMetrics 1.0 text format. All the metrics
+/// have the `unknown` type, the output ends with `# EOF`.
+std::string ToOpenMetricsFormat(const Storage& storage,
+                                const StatisticsRequest& request = {});
+
+}  // namespace utils::statistics
+
+USERVER_NAMESPACE_END
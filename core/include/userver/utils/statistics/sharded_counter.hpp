@@ -0,0 +1,119 @@
+#pragma once
+
+/// @file userver/utils/statistics/sharded_counter.hpp
+/// @brief @copybrief utils::statistics::ShardedCounter
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::statistics {
+
+namespace impl {
+
+// Enough to spread the writers of a big host, small enough to keep the
+// counters cheap in memory
+inline constexpr std::size_t kShardsCount = 16;
+inline constexpr std::size_t kCacheLineSize = 64;
+
+std::size_t AssignShardIndex() noexcept;
+
+inline thread_local std::size_t current_shard_index = kShardsCount;
+
+/// Returns the shard of the current thread. Threads are assigned to the shards
+/// in a round-robin manner on their first access.
+inline std::size_t GetShardIndex() noexcept {
+  auto index = current_shard_index;
+  if (index == kShardsCount) {
+    index = current_shard_index = AssignShardIndex();
+  }
+  return index;
+}
+
+}  // namespace impl
+
+/// @brief Counter of type T that is sharded over the threads
+///
+/// A drop-in replacement for utils::statistics::RelaxedCounter for hot paths.
+/// Each thread modifies its own cache line, so concurrent increments from
+/// different threads do not contend. The shards are summed up on each read,
+/// which makes the reads more expensive than the writes.
+///
+/// Increments and decrements of the same logical value may happen on
+/// different threads (e.g. a coroutine migrated between the increment and the
+/// decrement), the sum stays correct, even for unsigned types.
+///
+/// @note Uses impl::kShardsCount cache lines, prefer RelaxedCounter for the
+/// counters that are rarely modified.
+template <class T>
+class ShardedCounter final {
+ public:
+  using ValueType = T;
+
+  constexpr ShardedCounter() noexcept = default;
+  ShardedCounter(T desired) noexcept { Store(desired); }
+
+  ShardedCounter(const ShardedCounter& other) noexcept { Store(other.Load()); }
+
+  // NOLINTNEXTLINE(cert-oop54-cpp)
+  ShardedCounter& operator=(const ShardedCounter& other) noexcept {
+    Store(other.Load());
+    return *this;
+  }
+
+  ShardedCounter& operator=(T desired) noexcept {
+    Store(desired);
+    return *this;
+  }
+
+  /// @warning Not atomic with regard to the concurrent modifications
+  void Store(T desired) noexcept {
+    for (auto& shard : shards_) {
+      shard.value.store(T{}, std::memory_order_relaxed);
+    }
+    shards_[0].value.store(desired, std::memory_order_relaxed);
+  }
+
+  T Load() const noexcept {
+    T result{};
+    for (const auto& shard : shards_) {
+      result += shard.value.load(std::memory_order_relaxed);
+    }
+    return result;
+  }
+
+  operator T() const noexcept { return Load(); }
+
+  ShardedCounter& operator++() noexcept { return *this += 1; }
+
+  ShardedCounter& operator--() noexcept { return *this -= 1; }
+
+  ShardedCounter& operator+=(T arg) noexcept {
+    GetShard().fetch_add(arg, std::memory_order_relaxed);
+    return *this;
+  }
+
+  ShardedCounter& operator-=(T arg) noexcept {
+    GetShard().fetch_sub(arg, std::memory_order_relaxed);
+    return *this;
+  }
+
+ private:
+  static_assert(std::atomic<T>::is_always_lock_free);
+
+  struct alignas(impl::kCacheLineSize) Shard final {
+    std::atomic<T> value{T{}};
+  };
+
+  std::atomic<T>& GetShard() noexcept {
+    return shards_[impl::GetShardIndex()].value;
+  }
+
+  std::array<Shard, impl::kShardsCount> shards_{};
+};
+
+}  // namespace utils::statistics
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,113 @@
+#pragma once
+
+/// @file userver/utils/statistics/sharded_percentile.hpp
+/// @brief @copybrief utils::statistics::ShardedHistogram
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include <userver/utils/statistics/percentile.hpp>
+#include <userver/utils/statistics/sharded_counter.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::statistics {
+
+/// @brief Histogram for hot paths
+///
+/// Most of the values of a latency histogram fall into a few of the smallest
+/// buckets, so all the threads that account for them modify the same cache
+/// line. ShardedHistogram keeps the smallest buckets that fit into a cache
+/// line per thread (see utils::statistics::ShardedCounter), other values are
+/// accounted in a shared Histogram.
+///
+/// @tparam Histogram utils::statistics::Percentile or
+/// utils::statistics::HdrHistogram
+/// @tparam Counter bucket type of the Histogram
+/// @tparam ExactValues values in [0..ExactValues) have their own buckets
+/// in the Histogram
+///
+/// Use it as a Counter of utils::statistics::RecentPeriod with the Histogram
+/// as the Result:
+/// @code
+/// utils::statistics::RecentPeriod<
+///     utils::statistics::ShardedPercentile<2048, unsigned int, 120>,
+///     utils::statistics::Percentile<2048, unsigned int, 120>>
+///     timings;
+/// @endcode
+template <typename Histogram, typename Counter, size_t ExactValues>
+class ShardedHistogram final {
+ public:
+  using Result = Histogram;
+
+  /// Number of the smallest buckets that are sharded
+  static constexpr size_t kShardedBuckets =
+      std::min(ExactValues,
+               impl::kCacheLineSize / sizeof(std::atomic<Counter>));
+
+  ShardedHistogram() { Reset(); }
+
+  ShardedHistogram(const ShardedHistogram&) = delete;
+  ShardedHistogram& operator=(const ShardedHistogram&) = delete;
+
+  /// @copydoc Percentile::Account
+  void Account(size_t value, Counter count = 1) {
+    if (value < kShardedBuckets) {
+      shards_[impl::GetShardIndex()].values[value].fetch_add(
+          count, std::memory_order_relaxed);
+    } else {
+      shared_.Account(value, count);
+    }
+  }
+
+  void Reset() {
+    for (auto& shard : shards_) {
+      for (auto& value : shard.values) {
+        value.store(0, std::memory_order_relaxed);
+      }
+    }
+    shared_.Reset();
+  }
+
+  /// Adds the accounted values to `result`
+  void AddTo(Result& result) const {
+    result.Add(shared_);
+    for (size_t i = 0; i < kShardedBuckets; ++i) {
+      Counter sum = 0;
+      for (const auto& shard : shards_) {
+        sum += shard.values[i].load(std::memory_order_relaxed);
+      }
+      if (sum) result.Account(i, sum);
+    }
+  }
+
+ private:
+  struct alignas(impl::kCacheLineSize) Shard final {
+    std::array<std::atomic<Counter>, kShardedBuckets> values;
+  };
+
+  std::array<Shard, impl::kShardsCount> shards_;
+  Result shared_;
+};
+
+template <typename Histogram, typename Counter, size_t ExactValues>
+Histogram& operator+=(
+    Histogram& lhs,
+    const ShardedHistogram<Histogram, Counter, ExactValues>& rhs) {
+  rhs.AddTo(lhs);
+  return lhs;
+}
+
+/// utils::statistics::ShardedHistogram over utils::statistics::Percentile
+template <size_t M, typename Counter = uint32_t, size_t ExtraBuckets = 0,
+          size_t ExtraBucketSize = 500>
+using ShardedPercentile =
+    ShardedHistogram<Percentile<M, Counter, ExtraBuckets, ExtraBucketSize>,
+                     Counter, M>;
+
+}  // namespace utils::statistics
+
+USERVER_NAMESPACE_END
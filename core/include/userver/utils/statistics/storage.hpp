@@ -10,7 +10,10 @@
 #include <userver/engine/shared_mutex.hpp>
 #include <userver/formats/json/value_builder.hpp>
 #include <userver/utils/clang_format_workarounds.hpp>
+#include <userver/utils/statistics/base_format_builder.hpp>
 #include <userver/utils/statistics/entry.hpp>
+#include <userver/utils/statistics/labels.hpp>
+#include <userver/utils/statistics/writer.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -23,12 +26,16 @@ struct StatisticsRequest {
 using ExtenderFunc =
     std::function<formats::json::ValueBuilder(const StatisticsRequest&)>;
 
+using WriterFunc = std::function<void(Writer&)>;
+
 namespace impl {
 
 struct MetricsSource final {
   std::string prefix_path;
   std::vector<std::string> path_segments;
   ExtenderFunc extender;
+  WriterFunc writer{};
+  std::vector<Label> labels{};
 };
 
 using StorageData = std::list<MetricsSource>;
@@ -45,6 +52,12 @@ class Storage final {
   // Creates new Json::Value and calls every registered extender func over it.
   formats::json::ValueBuilder GetAsJson(const StatisticsRequest& request) const;
 
+  /// Passes all the metrics to `out` in a single pass. Writers registered via
+  /// RegisterWriter() write directly into `out`, the JSON of the extenders is
+  /// walked with Solomon metadata converted into labels.
+  void VisitMetrics(BaseFormatBuilder& out,
+                    const StatisticsRequest& request = {}) const;
+
   // Must be called from StatisticsStorage only. Don't call it from user
   // components.
   void StopRegisteringExtenders();
@@ -56,6 +69,12 @@ class Storage final {
   Entry RegisterExtender(std::initializer_list<std::string> prefix,
                          ExtenderFunc func);
 
+  /// Registers a function that writes metrics under the `prefix` path with
+  /// the `add_labels` labels. Unlike the extenders, the writers do not build
+  /// a JSON for each metrics request.
+  Entry RegisterWriter(std::string prefix, WriterFunc func,
+                       std::vector<Label> add_labels = {});
+
   void UnregisterExtender(impl::StorageIterator iterator) noexcept;
 
  private:
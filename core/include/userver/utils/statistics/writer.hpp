@@ -0,0 +1,110 @@
+#pragma once
+
+/// @file userver/utils/statistics/writer.hpp
+/// @brief @copybrief utils::statistics::Writer
+
+#include <atomic>
+#include <cstddef>
+#include <initializer_list>
+#include <string_view>
+#include <type_traits>
+
+#include <userver/utils/meta.hpp>
+#include <userver/utils/statistics/labels.hpp>
+#include <userver/utils/statistics/metric_value.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::statistics {
+
+class Storage;
+class Writer;
+
+namespace impl {
+
+struct WriterState;
+
+template <typename T>
+using HasLoad = decltype(std::declval<const T&>().Load());
+
+template <typename T>
+using HasWriterDumpMetric =
+    decltype(DumpMetric(std::declval<Writer&>(), std::declval<const T&>()));
+
+}  // namespace impl
+
+// clang-format off
+
+/// @brief Class for writing metrics directly into the output format
+///
+/// Unlike utils::statistics::ExtenderFunc, a writer does not build any
+/// intermediate representation of the metrics: each value goes straight into
+/// the utils::statistics::BaseFormatBuilder of the current request. Metrics
+/// collection through the writers takes a single pass and does not allocate
+/// memory proportional to the number of the metrics.
+///
+/// Metrics are written by assigning the values to the subpaths:
+/// @code
+/// void DumpMetric(utils::statistics::Writer& writer, const MyStats& stats) {
+///   writer["hits"] = stats.hits;  // std::atomic, RelaxedCounter...
+///   writer["misses"] = stats.misses.Load();
+///   writer["by-code"].ValueWithLabels(stats.ok, {"code", "200"});
+///   writer["nested"] = stats.nested;  // calls DumpMetric for the type
+/// }
+/// @endcode
+///
+/// Values of the user types are written via the `DumpMetric(Writer&, const T&)`
+/// function found by ADL.
+
+// clang-format on
+class Writer final {
+ public:
+  Writer(Writer&&) = delete;
+  Writer(const Writer&) = delete;
+  Writer& operator=(Writer&&) = delete;
+  Writer& operator=(const Writer&) = delete;
+
+  ~Writer();
+
+  /// Returns a writer for the `path` subpath of the current one
+  [[nodiscard]] Writer operator[](std::string_view path);
+
+  /// Writes the metric value under the current path
+  // NOLINTNEXTLINE(misc-unconventional-assign-operator)
+  template <typename T>
+  void operator=(const T& value) {
+    if constexpr (std::is_arithmetic_v<T>) {
+      Write(MetricValue{value});
+    } else if constexpr (meta::kIsInstantiationOf<std::atomic, T>) {
+      Write(MetricValue{value.load()});
+    } else if constexpr (meta::kIsDetected<impl::HasLoad, T>) {
+      Write(MetricValue{value.Load()});
+    } else {
+      static_assert(meta::kIsDetected<impl::HasWriterDumpMetric, T>,
+                    "Cannot find `DumpMetric(Writer&, const T&)` for the type");
+      DumpMetric(*this, value);
+    }
+  }
+
+  /// Writes the metric value with additional labels under the current path
+  void ValueWithLabels(MetricValue value,
+                       std::initializer_list<LabelView> labels);
+
+  /// @overload
+  void ValueWithLabels(MetricValue value, LabelView label);
+
+ private:
+  friend class Storage;
+
+  explicit Writer(impl::WriterState& state) noexcept;
+  Writer(impl::WriterState& state, std::string_view path);
+
+  void Write(MetricValue value);
+
+  impl::WriterState& state_;
+  const std::size_t initial_path_size_;
+};
+
+}  // namespace utils::statistics
+
+USERVER_NAMESPACE_END
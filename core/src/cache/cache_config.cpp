@@ -30,6 +30,8 @@ constexpr std::string_view kFullUpdateInterval = "full-update-interval";
 constexpr std::string_view kExceptionInterval = "exception-interval";
 constexpr std::string_view kCleanupInterval = "additional-cleanup-interval";
 constexpr std::string_view kIsStrongPeriod = "is-strong-period";
+constexpr std::string_view kFullUpdateShardsConcurrency =
+    "full-update-shards-concurrency";
 
 constexpr std::string_view kFirstUpdateFailOk = "first-update-fail-ok";
 constexpr std::string_view kUpdateTypes = "update-types";
@@ -41,6 +43,7 @@ constexpr std::string_view kFirstUpdateMode = "first-update-mode";
 constexpr std::string_view kFirstUpdateType = "first-update-type";
 
 constexpr auto kDefaultCleanupInterval = std::chrono::seconds{10};
+constexpr std::size_t kDefaultFullUpdateShardsConcurrency = 4;
 
 std::chrono::milliseconds GetDefaultJitter(std::chrono::milliseconds interval) {
   return interval / 10;
@@ -126,6 +129,9 @@ Config::Config(const yaml_config::YamlConfig& config,
       cleanup_interval(config[kCleanupInterval].As<std::chrono::milliseconds>(
           kDefaultCleanupInterval)),
       is_strong_period(config[kIsStrongPeriod].As<bool>(false)),
+      full_update_shards_concurrency(
+          config[kFullUpdateShardsConcurrency].As<std::size_t>(
+              kDefaultFullUpdateShardsConcurrency)),
       first_update_mode(
           config[dump::kDump][kFirstUpdateMode].As<FirstUpdateMode>(
               FirstUpdateMode::kSkip)),
@@ -140,6 +146,12 @@ Config::Config(const yaml_config::YamlConfig& config,
       exception_interval(config[kExceptionInterval]
                              .As<std::optional<std::chrono::milliseconds>>()),
       updates_enabled(config[kUpdatesEnabled].As<bool>(true)) {
+  if (full_update_shards_concurrency == 0) {
+    throw ConfigError(fmt::format("{} must be positive at '{}'",
+                                  kFullUpdateShardsConcurrency,
+                                  config.GetPath()));
+  }
+
   switch (allowed_update_types) {
     case AllowedUpdateTypes::kFullAndIncremental:
       if (!update_interval.count() || !full_update_interval.count()) {
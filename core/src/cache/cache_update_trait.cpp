@@ -1,5 +1,6 @@
 #include <userver/cache/cache_update_trait.hpp>
 
+#include <stdexcept>
 #include <utility>
 
 #include <cache/cache_dependencies.hpp>
@@ -41,14 +42,38 @@ void CacheUpdateTrait::AssertPeriodicUpdateStarted() {
 
 void CacheUpdateTrait::OnCacheModified() { impl_->OnCacheModified(); }
 
+void CacheUpdateTrait::PublishWithDumpChanges(
+    const std::function<void()>& publish,
+    const std::function<void(dump::Writer&)>& write_changes) {
+  impl_->PublishWithDumpChanges(publish, write_changes);
+}
+
+void CacheUpdateTrait::SnapshotForFullDump(
+    const std::function<void()>& snapshot) const {
+  impl_->SnapshotForFullDump(snapshot);
+}
+
 rcu::ReadablePtr<Config> CacheUpdateTrait::GetConfig() const {
   return impl_->GetConfig();
 }
 
+std::size_t CacheUpdateTrait::GetFullUpdateShardsCount() const { return 1; }
+
+void CacheUpdateTrait::RunFullUpdateShards(
+    std::size_t shards_count,
+    const std::function<void(std::size_t)>& load_shard) {
+  impl_->RunFullUpdateShards(shards_count, load_shard);
+}
+
 engine::TaskProcessor& CacheUpdateTrait::GetCacheTaskProcessor() const {
   return impl_->GetCacheTaskProcessor();
 }
 
+void CacheUpdateTrait::UpdateFullSharded(std::size_t, UpdateStatisticsScope&) {
+  throw std::logic_error("Sharded full updates are not implemented for cache " +
+                         Name());
+}
+
 void CacheUpdateTrait::GetAndWrite(dump::Writer&) const {
   dump::ThrowDumpUnimplemented(Name());
 }
@@ -57,6 +82,16 @@ void CacheUpdateTrait::ReadAndSet(dump::Reader&) {
   dump::ThrowDumpUnimplemented(Name());
 }
 
+void CacheUpdateTrait::ReadAndSetWithDeltas(
+    dump::Reader& reader,
+    const std::vector<std::unique_ptr<dump::Reader>>& deltas) {
+  if (!deltas.empty()) {
+    throw std::logic_error("Delta dumps are not implemented for cache " +
+                           Name());
+  }
+  ReadAndSet(reader);
+}
+
 }  // namespace cache
 
 USERVER_NAMESPACE_END
@@ -1,5 +1,8 @@
 #include <cache/cache_update_trait_impl.hpp>
 
+#include <algorithm>
+#include <utility>
+
 #include <userver/components/component.hpp>
 #include <userver/components/dump_configurator.hpp>
 #include <userver/dynamic_config/source.hpp>
@@ -16,7 +19,9 @@
 
 #include <cache/cache_dependencies.hpp>
 #include <dump/dump_locator.hpp>
+#include <userver/dump/common.hpp>
 #include <userver/dump/factory.hpp>
+#include <userver/dump/unsafe.hpp>
 #include <userver/testsuite/testsuite_support.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -25,12 +30,28 @@ namespace cache {
 
 namespace {
 
+// The changes are kept until the next dump, which may never happen if dumps
+// are disabled or fail. Past this size the next dump is a full one.
+constexpr std::size_t kMaxChangesBytes = 64 * 1024 * 1024;
+
 template <typename T>
 T CheckNotNull(T ptr) {
   UINVARIANT(ptr, "This pointer must not be null");
   return ptr;
 }
 
+class StringWriter final : public dump::Writer {
+ public:
+  explicit StringWriter(std::string& data) : data_(data) {}
+
+  void Finish() override {}
+
+ private:
+  void WriteRaw(std::string_view data) override { data_.append(data); }
+
+  std::string& data_;
+};
+
 }  // namespace
 
 void CacheUpdateTrait::Impl::Update(UpdateType update_type) {
@@ -67,7 +88,9 @@ CacheUpdateTrait::Impl::Impl(CacheDependencies&& dependencies,
       periodic_task_flags_{utils::PeriodicTask::Flags::kChaotic,
                            utils::PeriodicTask::Flags::kCritical},
       cache_modified_(false),
-      dumpable_(customized_trait_),
+      dumpable_(customized_trait_,
+                dependencies.dump_config &&
+                    dependencies.dump_config->max_delta_count > 0),
       dumper_(dependencies.dump_config
                   ? std::optional<dump::Dumper>(
                         std::in_place, *dependencies.dump_config,
@@ -215,7 +238,20 @@ void CacheUpdateTrait::Impl::StopPeriodicUpdates() {
 }
 
 formats::json::Value CacheUpdateTrait::Impl::ExtendStatistics() {
-  return formats::json::ValueBuilder{statistics_}.ExtractValue();
+  formats::json::ValueBuilder builder{statistics_};
+
+  const auto shard_durations = full_update_shard_durations_.Lock();
+  if (!shard_durations->empty()) {
+    formats::json::ValueBuilder shards(formats::json::Type::kObject);
+    utils::statistics::SolomonChildrenAreLabelValues(shards, "cache_shard");
+    for (std::size_t shard = 0; shard < shard_durations->size(); ++shard) {
+      shards[std::to_string(shard)]["last-update-duration-ms"] =
+          (*shard_durations)[shard].count();
+    }
+    builder["full"]["shards"] = shards.ExtractValue();
+  }
+
+  return builder.ExtractValue();
 }
 
 void CacheUpdateTrait::Impl::OnConfigUpdate(
@@ -286,6 +322,42 @@ engine::TaskProcessor& CacheUpdateTrait::Impl::GetCacheTaskProcessor() const {
   return task_processor_;
 }
 
+void CacheUpdateTrait::Impl::RunFullUpdateShards(
+    std::size_t shards_count,
+    const std::function<void(std::size_t)>& load_shard) {
+  std::vector<std::chrono::milliseconds> durations(shards_count);
+  std::atomic<std::size_t> next_shard{0};
+
+  const auto load_shards = [&] {
+    try {
+      for (auto shard = next_shard++; shard < shards_count;
+           shard = next_shard++) {
+        const auto start = utils::datetime::SteadyNow();
+        load_shard(shard);
+        durations[shard] = std::chrono::duration_cast<std::chrono::milliseconds>(
+            utils::datetime::SteadyNow() - start);
+      }
+    } catch (const std::exception&) {
+      // stop the other loaders, the update is going to fail anyway
+      next_shard = shards_count;
+      throw;
+    }
+  };
+
+  const auto concurrency = std::min(
+      shards_count, static_config_.full_update_shards_concurrency);
+  std::vector<engine::TaskWithResult<void>> tasks;
+  tasks.reserve(concurrency);
+  for (std::size_t i = 0; i < concurrency; ++i) {
+    tasks.push_back(utils::CriticalAsync(
+        task_processor_, "update-shard/" + name_, load_shards));
+  }
+  for (auto& task : tasks) task.Get();
+
+  auto shard_durations = full_update_shard_durations_.Lock();
+  *shard_durations = std::move(durations);
+}
+
 void CacheUpdateTrait::Impl::DoUpdate(UpdateType update_type) {
   const auto steady_now = utils::datetime::SteadyNow();
   const auto now =
@@ -299,7 +371,14 @@ void CacheUpdateTrait::Impl::DoUpdate(UpdateType update_type) {
   LOG_INFO() << "Updating cache update_type=" << update_type_str
              << " name=" << name_;
 
-  customized_trait_.Update(update_type, last_update_, now, stats);
+  const auto shards_count = update_type == UpdateType::kFull
+                                ? customized_trait_.GetFullUpdateShardsCount()
+                                : 1;
+  if (shards_count > 1) {
+    customized_trait_.UpdateFullSharded(shards_count, stats);
+  } else {
+    customized_trait_.Update(update_type, last_update_, now, stats);
+  }
   LOG_INFO() << "Updated cache update_type=" << update_type_str
              << " name=" << name_;
 
@@ -323,9 +402,20 @@ utils::PeriodicTask::Settings CacheUpdateTrait::Impl::GetPeriodicTaskSettings(
   return settings;
 }
 
+void CacheUpdateTrait::Impl::PublishWithDumpChanges(
+    const std::function<void()>& publish,
+    const std::function<void(dump::Writer&)>& write_changes) {
+  dumpable_.PublishWithChanges(publish, write_changes);
+}
+
+void CacheUpdateTrait::Impl::SnapshotForFullDump(
+    const std::function<void()>& snapshot) const {
+  dumpable_.SnapshotForFullDump(snapshot);
+}
+
 CacheUpdateTrait::Impl::DumpableEntityProxy::DumpableEntityProxy(
-    CacheUpdateTrait& cache)
-    : cache_(cache) {}
+    CacheUpdateTrait& cache, bool record_changes)
+    : cache_(cache), record_changes_(record_changes) {}
 
 void CacheUpdateTrait::Impl::DumpableEntityProxy::GetAndWrite(
     dump::Writer& writer) const {
@@ -337,6 +427,75 @@ void CacheUpdateTrait::Impl::DumpableEntityProxy::ReadAndSet(
   cache_.ReadAndSet(reader);
 }
 
+// A delta consists of the number of records followed by the records written
+// by `write_changes`, see CachingComponentBase::ReadAndSetWithDeltas
+bool CacheUpdateTrait::Impl::DumpableEntityProxy::GetAndWriteDelta(
+    dump::Writer& writer) const {
+  Changes delta;
+  {
+    auto changes = changes_.Lock();
+    if (!changes->is_complete) return false;
+    delta = std::exchange(*changes, Changes{});
+    changes->is_complete = true;
+  }
+
+  writer.Write(delta.count);
+  dump::WriteStringViewUnsafe(writer, delta.records);
+  return true;
+}
+
+void CacheUpdateTrait::Impl::DumpableEntityProxy::ReadAndSetWithDeltas(
+    dump::Reader& reader,
+    const std::vector<std::unique_ptr<dump::Reader>>& deltas) {
+  cache_.ReadAndSetWithDeltas(reader, deltas);
+
+  // The data matches the dump now
+  auto changes = changes_.Lock();
+  changes->Reset(true);
+}
+
+void CacheUpdateTrait::Impl::DumpableEntityProxy::PublishWithChanges(
+    const std::function<void()>& publish,
+    const std::function<void(dump::Writer&)>& write_changes) {
+  if (!record_changes_) {
+    publish();
+    return;
+  }
+
+  auto changes = changes_.Lock();
+  publish();
+  if (!write_changes) {
+    changes->Reset(false);
+    return;
+  }
+  if (!changes->is_complete) return;
+
+  StringWriter writer(changes->records);
+  write_changes(writer);
+  ++changes->count;
+
+  if (changes->records.size() > kMaxChangesBytes) {
+    LOG_WARNING() << "Changes of cache '" << cache_.Name() << "' exceed "
+                  << kMaxChangesBytes
+                  << " bytes since the last dump, the next dump will be full";
+    changes->Reset(false);
+  }
+}
+
+void CacheUpdateTrait::Impl::DumpableEntityProxy::SnapshotForFullDump(
+    const std::function<void()>& snapshot) const {
+  auto changes = changes_.Lock();
+  snapshot();
+  changes->Reset(true);
+}
+
+void CacheUpdateTrait::Impl::DumpableEntityProxy::Changes::Reset(
+    bool is_complete) {
+  records = {};
+  count = 0;
+  this->is_complete = is_complete;
+}
+
 }  // namespace cache
 
 USERVER_NAMESPACE_END
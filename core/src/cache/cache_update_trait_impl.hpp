@@ -2,13 +2,17 @@
 
 #include <atomic>
 #include <chrono>
+#include <cstddef>
+#include <functional>
 #include <memory>
 #include <optional>
 #include <stdexcept>
 #include <string>
+#include <vector>
 
 #include <userver/components/component_fwd.hpp>
 #include <userver/concurrent/async_event_channel.hpp>
+#include <userver/concurrent/variable.hpp>
 #include <userver/dynamic_config/fwd.hpp>
 #include <userver/engine/mutex.hpp>
 #include <userver/rcu/rcu.hpp>
@@ -54,6 +58,15 @@ class CacheUpdateTrait::Impl final {
 
   engine::TaskProcessor& GetCacheTaskProcessor() const;
 
+  void RunFullUpdateShards(std::size_t shards_count,
+                           const std::function<void(std::size_t)>& load_shard);
+
+  void PublishWithDumpChanges(
+      const std::function<void()>& publish,
+      const std::function<void(dump::Writer&)>& write_changes);
+
+  void SnapshotForFullDump(const std::function<void()>& snapshot) const;
+
  private:
   UpdateType NextUpdateType(const Config& config);
 
@@ -68,20 +81,46 @@ class CacheUpdateTrait::Impl final {
 
   formats::json::Value ExtendStatistics();
 
+  // Also keeps the changes published since the last dump for delta dumps
   class DumpableEntityProxy final : public dump::DumpableEntity {
    public:
-    explicit DumpableEntityProxy(CacheUpdateTrait& cache);
+    DumpableEntityProxy(CacheUpdateTrait& cache, bool record_changes);
 
     void GetAndWrite(dump::Writer& writer) const override;
 
     void ReadAndSet(dump::Reader& reader) override;
 
+    bool GetAndWriteDelta(dump::Writer& writer) const override;
+
+    void ReadAndSetWithDeltas(
+        dump::Reader& reader,
+        const std::vector<std::unique_ptr<dump::Reader>>& deltas) override;
+
+    void PublishWithChanges(
+        const std::function<void()>& publish,
+        const std::function<void(dump::Writer&)>& write_changes);
+
+    void SnapshotForFullDump(const std::function<void()>& snapshot) const;
+
    private:
+    struct Changes final {
+      void Reset(bool is_complete);
+
+      std::string records;
+      std::size_t count{0};
+      // false if some published data has no recorded changes
+      bool is_complete{false};
+    };
+
     CacheUpdateTrait& cache_;
+    const bool record_changes_;
+    mutable concurrent::Variable<Changes> changes_;
   };
 
   CacheUpdateTrait& customized_trait_;
   impl::Statistics statistics_;
+  concurrent::Variable<std::vector<std::chrono::milliseconds>>
+      full_update_shard_durations_;
   const Config static_config_;
   rcu::Variable<Config> config_;
   testsuite::CacheControl& cache_control_;
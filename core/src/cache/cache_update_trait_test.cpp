@@ -1,8 +1,10 @@
 #include <userver/cache/cache_update_trait.hpp>
 
+#include <atomic>
 #include <chrono>
 #include <optional>
 #include <utility>
+#include <vector>
 
 #include <fmt/format.h>
 #include <boost/filesystem.hpp>
@@ -13,6 +15,7 @@
 #include <userver/components/component.hpp>
 #include <userver/dump/common.hpp>
 #include <userver/dump/test_helpers.hpp>
+#include <userver/engine/sleep.hpp>
 #include <userver/formats/yaml/serialize.hpp>
 #include <userver/fs/blocking/temp_directory.hpp>
 #include <userver/fs/blocking/write.hpp>
@@ -520,4 +523,106 @@ UTEST_F(CacheUpdateTraitFaulty, TmpDoNotAccumulate) {
   EXPECT_EQ(dump_count(), 1);
 }
 
+namespace {
+
+class ShardedCache final : public cache::CacheMockBase {
+ public:
+  static constexpr auto kName = "sharded-cache";
+  static constexpr std::size_t kShardsCount = 8;
+
+  ShardedCache(const yaml_config::YamlConfig& config,
+               cache::MockEnvironment& environment)
+      : CacheMockBase(kName, config, environment) {
+    StartPeriodicUpdates();
+  }
+
+  ~ShardedCache() { StopPeriodicUpdates(); }
+
+  const std::vector<int>& GetShardLoads() const { return shard_loads_; }
+
+  std::size_t GetMaxConcurrency() const { return max_concurrency_; }
+
+  std::size_t GetIncrementalUpdates() const { return incremental_updates_; }
+
+  void SetFailingShard(std::optional<std::size_t> shard) {
+    failing_shard_ = shard;
+  }
+
+ private:
+  std::size_t GetFullUpdateShardsCount() const override { return kShardsCount; }
+
+  void UpdateFullSharded(std::size_t shards_count,
+                         cache::UpdateStatisticsScope& stats_scope) override {
+    std::vector<int> shard_loads(shards_count);
+    RunFullUpdateShards(shards_count, [&](std::size_t shard) {
+      const auto concurrency = ++concurrency_;
+      auto max_concurrency = max_concurrency_.load();
+      while (max_concurrency < concurrency &&
+             !max_concurrency_.compare_exchange_weak(max_concurrency,
+                                                     concurrency)) {
+      }
+      engine::SleepFor(std::chrono::milliseconds{10});
+      --concurrency_;
+
+      if (shard == failing_shard_) throw cache::MockError();
+      ++shard_loads[shard];
+      stats_scope.IncreaseDocumentsReadCount(1);
+    });
+
+    shard_loads_ = std::move(shard_loads);
+    stats_scope.Finish(shards_count);
+  }
+
+  void Update(cache::UpdateType type,
+              const std::chrono::system_clock::time_point&,
+              const std::chrono::system_clock::time_point&,
+              cache::UpdateStatisticsScope&) override {
+    ASSERT_EQ(type, cache::UpdateType::kIncremental);
+    ++incremental_updates_;
+  }
+
+  std::vector<int> shard_loads_;
+  std::atomic<std::size_t> concurrency_{0};
+  std::atomic<std::size_t> max_concurrency_{0};
+  std::size_t incremental_updates_{0};
+  std::optional<std::size_t> failing_shard_;
+};
+
+const std::string kShardedCacheConfig = R"(
+update-interval: 10h
+update-jitter: 10h
+full-update-interval: 20h
+additional-cleanup-interval: 10h
+full-update-shards-concurrency: 3
+)";
+
+}  // namespace
+
+UTEST_MT(CacheUpdateTrait, ShardedFullUpdate, 4) {
+  const yaml_config::YamlConfig config{
+      formats::yaml::FromString(kShardedCacheConfig), {}};
+  cache::MockEnvironment environment;
+
+  ShardedCache cache(config, environment);
+  EXPECT_EQ(cache.GetShardLoads(),
+            std::vector<int>(ShardedCache::kShardsCount, 1));
+  EXPECT_GT(cache.GetMaxConcurrency(), 1);
+  EXPECT_LE(cache.GetMaxConcurrency(), 3);
+
+  environment.cache_control.InvalidateCaches(cache::UpdateType::kIncremental,
+                                            {cache.Name()});
+  EXPECT_EQ(cache.GetIncrementalUpdates(), 1);
+
+  cache.SetFailingShard(5);
+  UEXPECT_THROW(environment.cache_control.InvalidateCaches(
+                    cache::UpdateType::kFull, {cache.Name()}),
+                cache::MockError);
+  EXPECT_EQ(cache.GetShardLoads(),
+            std::vector<int>(ShardedCache::kShardsCount, 1));
+
+  cache.SetFailingShard(std::nullopt);
+  UEXPECT_NO_THROW(environment.cache_control.InvalidateCaches(
+      cache::UpdateType::kFull, {cache.Name()}));
+}
+
 USERVER_NAMESPACE_END
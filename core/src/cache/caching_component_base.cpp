@@ -52,6 +52,10 @@ properties:
         type: boolean
         description: whether to include Update execution time in update-interval
         defaultDescription: false
+    full-update-shards-concurrency:
+        type: integer
+        description: how many shards of a sharded full update are loaded concurrently
+        defaultDescription: 4
     testsuite-force-periodic-update:
         type: boolean
         description: override testsuite-periodic-update-enabled in TestsuiteSupport component config
@@ -89,6 +93,17 @@ properties:
                 type: boolean
                 description: Whether to encrypt the dump
                 defaultDescription: false
+            compression:
+                type: string
+                description: Compression of the dump
+                defaultDescription: none
+                enum:
+                  - none
+                  - zlib
+            max-delta-count:
+                type: integer
+                description: Max number of delta dumps written on top of a full dump, 0 disables delta dumps
+                defaultDescription: 0
             first-update-mode:
                 type: string
                 description: specifies whether required or best-effort first update will be used
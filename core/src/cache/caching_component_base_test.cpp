@@ -0,0 +1,167 @@
+#include <userver/cache/caching_component_base.hpp>
+
+#include <memory>
+#include <numeric>
+#include <unordered_map>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include <components/component_list_test.hpp>
+#include <userver/components/minimal_component_list.hpp>
+#include <userver/components/run.hpp>
+#include <userver/fs/blocking/temp_directory.hpp>
+#include <userver/fs/blocking/write.hpp>
+#include <userver/testsuite/testsuite_support.hpp>
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr std::size_t kShardsCount = 5;
+constexpr int kItemsPerShard = 100;
+constexpr int kItemsCount = static_cast<int>(kShardsCount) * kItemsPerShard;
+
+template <typename T>
+class ShardedCache : public components::CachingComponentBase<T> {
+ public:
+  ShardedCache(const components::ComponentConfig& config,
+               const components::ComponentContext& context)
+      : components::CachingComponentBase<T>(config, context) {
+    this->StartPeriodicUpdates();
+    const auto contents = this->Get();
+    LoadedContents() = *contents;
+  }
+
+  ~ShardedCache() override { this->StopPeriodicUpdates(); }
+
+  static T& LoadedContents() {
+    static T contents;
+    return contents;
+  }
+
+ private:
+  std::size_t GetFullUpdateShardsCount() const override { return kShardsCount; }
+
+  std::unique_ptr<T> LoadFullUpdateShard(
+      std::size_t shard, std::size_t shards_count,
+      cache::UpdateStatisticsScope& stats_scope) override {
+    EXPECT_EQ(shards_count, kShardsCount);
+    auto result = std::make_unique<T>();
+    const auto first = static_cast<int>(shard) * kItemsPerShard;
+    for (int i = first; i < first + kItemsPerShard; ++i) {
+      if constexpr (meta::kIsVector<T>) {
+        result->push_back(i);
+      } else {
+        result->emplace(i, i * i);
+      }
+    }
+    stats_scope.IncreaseDocumentsReadCount(kItemsPerShard);
+    return result;
+  }
+
+  void Update(cache::UpdateType, const std::chrono::system_clock::time_point&,
+              const std::chrono::system_clock::time_point&,
+              cache::UpdateStatisticsScope&) override {
+    ADD_FAILURE() << "Full updates of " << this->Name() << " must be sharded";
+  }
+};
+
+// merged with std::unordered_map::merge
+class ShardedMapCache final
+    : public ShardedCache<std::unordered_map<int, int>> {
+ public:
+  static constexpr auto kName = "sharded-map-cache";
+
+  using ShardedCache::ShardedCache;
+};
+
+// merged by appending the shards in order
+class ShardedVectorCache final : public ShardedCache<std::vector<int>> {
+ public:
+  static constexpr auto kName = "sharded-vector-cache";
+
+  using ShardedCache::ShardedCache;
+};
+
+const auto kTmpDir = fs::blocking::TempDirectory::Create();
+const std::string kRuntimeConfingPath =
+    kTmpDir.GetPath() + "/runtime_config.json";
+const std::string kConfigVariablesPath =
+    kTmpDir.GetPath() + "/config_vars.json";
+
+const std::string kConfigVariables =
+    fmt::format("runtime_config_path: {}", kRuntimeConfingPath);
+
+const std::string kStaticConfig = R"(
+components_manager:
+  coro_pool:
+    initial_size: 50
+    max_size: 500
+  default_task_processor: main-task-processor
+  event_thread_pool:
+    threads: 1
+  task_processors:
+    main-task-processor:
+      thread_name: main-worker
+      worker_threads: 2
+  components:
+    manager-controller:  # Nothing
+    sharded-map-cache:
+      update-interval: 1h
+      full-update-shards-concurrency: 2
+      config-settings: false
+    sharded-vector-cache:
+      update-interval: 1h
+      full-update-shards-concurrency: 2
+      config-settings: false
+    logging:
+      fs-task-processor: main-task-processor
+      loggers:
+        default:
+          file_path: '@null'
+    tracer:
+        service-name: config-service
+    statistics-storage:
+      # Nothing
+    testsuite-support:
+    dynamic-config:
+      fs-cache-path: $runtime_config_path
+      fs-task-processor: main-task-processor
+    dynamic-config-fallbacks:
+      fallback-path: $runtime_config_path
+config_vars: )" + kConfigVariablesPath +
+                                  R"(
+)";
+
+}  // namespace
+
+TEST(CachingComponentBase, ShardedFullUpdate) {
+  auto component_list = components::MinimalComponentList();
+  component_list.Append<ShardedMapCache>();
+  component_list.Append<ShardedVectorCache>();
+  component_list.Append<components::TestsuiteSupport>();
+
+  tests::LogLevelGuard guard;
+
+  fs::blocking::RewriteFileContents(kRuntimeConfingPath, tests::kRuntimeConfig);
+  fs::blocking::RewriteFileContents(kConfigVariablesPath, kConfigVariables);
+
+  components::RunOnce(components::InMemoryConfig{kStaticConfig},
+                      component_list);
+
+  const auto& map = ShardedMapCache::LoadedContents();
+  EXPECT_EQ(map.size(), static_cast<std::size_t>(kItemsCount));
+  for (int i = 0; i < kItemsCount; ++i) {
+    const auto it = map.find(i);
+    ASSERT_NE(it, map.end()) << i;
+    EXPECT_EQ(it->second, i * i);
+  }
+
+  std::vector<int> expected_vector(kItemsCount);
+  std::iota(expected_vector.begin(), expected_vector.end(), 0);
+  EXPECT_EQ(ShardedVectorCache::LoadedContents(), expected_vector);
+}
+
+USERVER_NAMESPACE_END
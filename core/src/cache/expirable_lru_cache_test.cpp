@@ -1,8 +1,13 @@
+#include <algorithm>
+#include <optional>
 #include <string>
+#include <vector>
 
 #include <userver/utest/utest.hpp>
 
 #include <userver/cache/expirable_lru_cache.hpp>
+#include <userver/engine/async.hpp>
+#include <userver/engine/single_consumer_event.hpp>
 #include <userver/engine/sleep.hpp>
 #include <userver/utils/mock_now.hpp>
 
@@ -240,6 +245,125 @@ UTEST(ExpirableLruCache, InvalidateByKey) {
   EXPECT_EQ(Counter::One(), *counter);
 }
 
+UTEST(ExpirableLruCache, MaxWeight) {
+  cache::ExpirableLruCache<int, std::string> cache(1, 100);
+  cache.SetWayMaxWeight(3000);
+
+  for (int i = 0; i < 10; ++i) cache.Put(i, std::string(1000, 'x'));
+  EXPECT_EQ(2, cache.GetSizeApproximate());
+  EXPECT_LE(cache.GetWeightApproximate(), 3000);
+  EXPECT_GT(cache.GetWeightApproximate(), 2000);
+  EXPECT_GT(cache.GetEvictedWeightApproximate(), 8000);
+}
+
+UTEST(ExpirableLruCache, NegativeLookups) {
+  cache::ExpirableLruCache<int, std::optional<int>> cache(1, 2);
+  cache.SetNegativeWaySize(10);
+  cache.SetNegativeLifetime(std::chrono::seconds(2));
+  cache.Put(1, 1);
+  cache.Put(2, 2);
+
+  utils::datetime::MockNowSet(std::chrono::system_clock::now());
+
+  int calls = 0;
+  const auto update_absent = [&calls](int) -> std::optional<int> {
+    ++calls;
+    return std::nullopt;
+  };
+  for (int i = 0; i < 5; ++i) {
+    for (int key = 10; key < 15; ++key) {
+      EXPECT_EQ(std::nullopt, cache.Get(key, update_absent));
+    }
+  }
+  EXPECT_EQ(5, calls);
+  EXPECT_EQ(5, cache.GetNegativeSizeApproximate());
+  EXPECT_EQ(20, cache.GetStatistics().total.negative_hits.load());
+
+  // the absent keys did not evict the values
+  EXPECT_EQ(std::optional<int>{1}, cache.GetOptionalNoUpdate(1));
+  EXPECT_EQ(std::optional<int>{2}, cache.GetOptionalNoUpdate(2));
+
+  cache.Put(10, 10);
+  EXPECT_EQ(std::optional<int>{10}, cache.GetOptionalNoUpdate(10));
+  EXPECT_EQ(4, cache.GetNegativeSizeApproximate());
+
+  utils::datetime::MockSleep(std::chrono::seconds(3));
+  EXPECT_EQ(std::nullopt, cache.GetOptionalNoUpdate(11));
+  EXPECT_EQ(std::optional<std::optional<int>>{std::nullopt},
+            cache.GetOptionalUnexpirable(12));
+  EXPECT_EQ(std::nullopt, cache.Get(11, update_absent));
+  EXPECT_EQ(6, calls);
+
+  cache.Invalidate();
+  EXPECT_EQ(0, cache.GetNegativeSizeApproximate());
+}
+
+UTEST(ExpirableLruCache, RefreshAhead) {
+  auto cache = SimpleCache(1, 10);
+  cache.SetMaxLifetime(std::chrono::seconds(4));
+  cache.SetRefreshAhead(2);
+
+  utils::datetime::MockNowSet(std::chrono::system_clock::now());
+  cache.Put("a", 1);
+  cache.Put("b", 2);
+  cache.Put("c", 3);
+
+  utils::datetime::MockSleep(std::chrono::seconds(3));
+  // no separate background updates
+  EXPECT_EQ(1, cache.Get("a", UpdateNever()));
+  for (int i = 0; i < 2; ++i) EXPECT_EQ(2, cache.Get("b", UpdateNever()));
+  for (int i = 0; i < 3; ++i) EXPECT_EQ(3, cache.Get("c", UpdateNever()));
+
+  std::vector<SimpleCacheKey> refreshed;
+  EXPECT_EQ(2, cache.RefreshAhead([&](const std::vector<SimpleCacheKey>& keys) {
+    refreshed = keys;
+    return std::vector<SimpleCacheValue>(keys.size(), 10);
+  }));
+  std::sort(refreshed.begin(), refreshed.end());
+  EXPECT_EQ((std::vector<SimpleCacheKey>{"b", "c"}), refreshed);
+
+  utils::datetime::MockSleep(std::chrono::seconds(1));
+  EXPECT_EQ(10, cache.Get("b", UpdateNever()));
+  EXPECT_EQ(10, cache.Get("c", UpdateNever()));
+  EXPECT_EQ(0, cache.RefreshAhead([](const std::vector<SimpleCacheKey>&) {
+    ADD_FAILURE() << "Nothing should be refreshed";
+    return std::vector<SimpleCacheValue>{};
+  }));
+}
+
+UTEST(ExpirableLruCache, RefreshAheadSkipsKeysUpdatedByMiss) {
+  auto cache = SimpleCache(1, 10);
+  cache.SetMaxLifetime(std::chrono::seconds(4));
+  cache.SetRefreshAhead(2);
+
+  utils::datetime::MockNowSet(std::chrono::system_clock::now());
+  cache.Put("a", 1);
+  utils::datetime::MockSleep(std::chrono::seconds(3));
+  EXPECT_EQ(1, cache.Get("a", UpdateNever()));
+  utils::datetime::MockSleep(std::chrono::seconds(2));
+
+  // The miss of the expired key holds its lock during the update
+  engine::SingleConsumerEvent miss_started;
+  engine::SingleConsumerEvent finish_miss;
+  auto miss = engine::AsyncNoSpan([&] {
+    return cache.Get("a", [&](const SimpleCacheKey&) {
+      miss_started.Send();
+      EXPECT_TRUE(finish_miss.WaitForEvent());
+      return 2;
+    });
+  });
+  ASSERT_TRUE(miss_started.WaitForEvent());
+
+  EXPECT_EQ(0, cache.RefreshAhead([](const std::vector<SimpleCacheKey>&) {
+    ADD_FAILURE() << "The key being updated should be skipped";
+    return std::vector<SimpleCacheValue>{};
+  }));
+
+  finish_miss.Send();
+  EXPECT_EQ(2, miss.Get());
+  EXPECT_EQ(2, cache.Get("a", UpdateNever()));
+}
+
 UTEST(ExpirableLruCache, BackgroundUpdate) {
   auto counter = std::make_shared<Counter>();
 
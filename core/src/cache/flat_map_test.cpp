@@ -0,0 +1,94 @@
+#include <userver/cache/flat_map.hpp>
+
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <userver/dump/common.hpp>
+#include <userver/dump/operations_file.hpp>
+#include <userver/dump/test_helpers.hpp>
+#include <userver/fs/blocking/temp_directory.hpp>
+#include <userver/tracing/span.hpp>
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+struct Point {
+  std::int32_t x;
+  std::int32_t y;
+};
+
+using Map = cache::FlatMap<std::uint64_t, Point>;
+
+Map MakeMap(std::uint64_t size) {
+  std::vector<std::pair<std::uint64_t, Point>> items;
+  for (std::uint64_t i = size; i > 0; --i) {
+    items.emplace_back(i * 2, Point{static_cast<std::int32_t>(i), 0});
+  }
+  return Map(std::move(items));
+}
+
+}  // namespace
+
+TEST(FlatMap, Basic) {
+  Map map({{3, {3, 0}}, {1, {1, 0}}, {3, {3, 1}}, {2, {2, 0}}});
+  EXPECT_EQ(map.size(), 3);
+  EXPECT_FALSE(map.empty());
+
+  ASSERT_TRUE(map.Get(3));
+  EXPECT_EQ(map.Get(3)->y, 1);
+  EXPECT_TRUE(map.Contains(1));
+  EXPECT_FALSE(map.Contains(0));
+  EXPECT_FALSE(map.Get(4));
+
+  std::vector<std::uint64_t> keys;
+  map.VisitAll([&](std::uint64_t key, Point) { keys.push_back(key); });
+  EXPECT_EQ(keys, (std::vector<std::uint64_t>{1, 2, 3}));
+
+  EXPECT_TRUE(Map{}.empty());
+  EXPECT_FALSE(Map{}.Contains(1));
+}
+
+TEST(FlatMap, Dump) {
+  const auto map = MakeMap(1000);
+  const auto restored = dump::FromBinary<Map>(dump::ToBinary(map));
+
+  ASSERT_EQ(restored.size(), map.size());
+  for (std::uint64_t i = 0; i <= 2001; ++i) {
+    ASSERT_EQ(restored.Contains(i), map.Contains(i)) << i;
+  }
+  EXPECT_EQ(restored.Get(2000)->x, 1000);
+}
+
+UTEST(FlatMap, MappedDump) {
+  const auto dir = fs::blocking::TempDirectory::Create();
+  const auto path = dir.GetPath() + "/dump";
+
+  auto scope_time = tracing::Span::CurrentSpan().CreateScopeTime("dump");
+  dump::FileWriter writer(path, boost::filesystem::perms::owner_read,
+                          scope_time);
+  writer.Write(std::uint8_t{42});  // the map data is unaligned in the file
+  writer.Write(MakeMap(1000));
+  writer.Finish();
+
+  std::optional<Map> restored;
+  {
+    dump::FileReader reader(path);
+    EXPECT_EQ(reader.Read<std::uint8_t>(), 42);
+    restored.emplace(reader.Read<Map>());
+    reader.Finish();
+  }
+
+  // references the mapped file after the reader is destroyed
+  ASSERT_EQ(restored->size(), 1000);
+  EXPECT_EQ(restored->Get(2)->x, 1);
+  EXPECT_EQ(restored->Get(2000)->x, 1000);
+  EXPECT_FALSE(restored->Contains(3));
+}
+
+USERVER_NAMESPACE_END
@@ -20,18 +20,28 @@ constexpr const char* kStatisticsNameBackground = "background-updates";
 constexpr const char* kStatisticsNameHitRatio = "hit_ratio";
 constexpr const char* kStatisticsNameCurrentDocumentsCount =
     "current-documents-count";
+constexpr const char* kStatisticsNameCurrentBytes = "current-bytes";
+constexpr const char* kStatisticsNameEvictedBytes = "evicted-bytes";
+constexpr const char* kStatisticsNameNegativeHits = "negative-hits";
+constexpr const char* kStatisticsNameCurrentNegativeDocumentsCount =
+    "current-negative-documents-count";
 
 }  // namespace
 
 formats::json::Value GetCacheStatisticsAsJson(
-    const ExpirableLruCacheStatistics& stats, std::size_t size) {
+    const ExpirableLruCacheStatistics& stats, std::size_t size,
+    std::size_t bytes, std::size_t evicted_bytes, std::size_t negative_size) {
   formats::json::ValueBuilder builder;
   utils::statistics::SolomonLabelValue(builder, "cache_name");
 
   builder[kStatisticsNameCurrentDocumentsCount] = size;
+  builder[kStatisticsNameCurrentBytes] = bytes;
+  builder[kStatisticsNameEvictedBytes] = evicted_bytes;
+  builder[kStatisticsNameCurrentNegativeDocumentsCount] = negative_size;
   builder[kStatisticsNameHits] = stats.total.hits.load();
   builder[kStatisticsNameMisses] = stats.total.misses.load();
   builder[kStatisticsNameStale] = stats.total.stale.load();
+  builder[kStatisticsNameNegativeHits] = stats.total.negative_hits.load();
   builder[kStatisticsNameBackground] = stats.total.background_updates.load();
 
   auto s1min = stats.recent.GetStatsForPeriod();
@@ -74,6 +84,33 @@ properties:
         type: string
         description: TTL for cache entries (0 is unlimited)
         defaultDescription: 0
+    policy:
+        type: string
+        description: eviction policy, see cache::CachePolicy
+        defaultDescription: lru
+        enum:
+          - lru
+          - w-tinylfu
+    max-bytes:
+        type: integer
+        description: max total weight of the cached values in bytes, 0 is unlimited
+        defaultDescription: 0
+    negative-size:
+        type: integer
+        description: max amount of keys to remember as absent, 0 disables
+        defaultDescription: 0
+    negative-lifetime:
+        type: string
+        description: TTL for the absent keys (0 is unlimited)
+        defaultDescription: 0
+    refresh-ahead-interval:
+        type: string
+        description: period of the bulk refreshes of the keys that are read close to expiry, 0 disables them
+        defaultDescription: 0
+    refresh-ahead-keys:
+        type: integer
+        description: max amount of keys in a bulk refresh
+        defaultDescription: 1000
     config-settings:
         type: boolean
         description: enables dynamic reconfiguration with CacheConfigSet
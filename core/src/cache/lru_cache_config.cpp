@@ -18,6 +18,20 @@ constexpr std::string_view kSize = "size";
 constexpr std::string_view kLifetime = "lifetime";
 constexpr std::string_view kBackgroundUpdate = "background-update";
 constexpr std::string_view kLifetimeMs = "lifetime-ms";
+constexpr std::string_view kPolicy = "policy";
+constexpr std::string_view kMaxBytes = "max-bytes";
+constexpr std::string_view kNegativeSize = "negative-size";
+constexpr std::string_view kNegativeLifetime = "negative-lifetime";
+constexpr std::string_view kNegativeLifetimeMs = "negative-lifetime-ms";
+constexpr std::string_view kRefreshAheadInterval = "refresh-ahead-interval";
+constexpr std::string_view kRefreshAheadKeys = "refresh-ahead-keys";
+
+CachePolicy ParsePolicy(const std::string& policy) {
+  if (policy == "lru") return CachePolicy::kLRU;
+  if (policy == "w-tinylfu") return CachePolicy::kWTinyLFU;
+  throw std::runtime_error("Unknown cache policy '" + policy +
+                           "', expected 'lru' or 'w-tinylfu'");
+}
 
 }  // namespace
 
@@ -28,7 +42,12 @@ LruCacheConfig::LruCacheConfig(const yaml_config::YamlConfig& config)
       lifetime(config[kLifetime].As<std::chrono::milliseconds>(0)),
       background_update(config[kBackgroundUpdate].As<bool>(false)
                             ? BackgroundUpdateMode::kEnabled
-                            : BackgroundUpdateMode::kDisabled) {
+                            : BackgroundUpdateMode::kDisabled),
+      policy(ParsePolicy(config[kPolicy].As<std::string>("lru"))),
+      max_bytes(config[kMaxBytes].As<std::size_t>(0)),
+      negative_size(config[kNegativeSize].As<std::size_t>(0)),
+      negative_lifetime(
+          config[kNegativeLifetime].As<std::chrono::milliseconds>(0)) {
   if (size == 0) throw std::runtime_error("cache-size is non-positive");
 }
 
@@ -40,7 +59,12 @@ LruCacheConfig::LruCacheConfig(const formats::json::Value& value)
       lifetime(ParseMs(value[kLifetimeMs])),
       background_update(value[kBackgroundUpdate].As<bool>(false)
                             ? BackgroundUpdateMode::kEnabled
-                            : BackgroundUpdateMode::kDisabled) {
+                            : BackgroundUpdateMode::kDisabled),
+      policy(ParsePolicy(value[kPolicy].As<std::string>("lru"))),
+      max_bytes(value[kMaxBytes].As<std::size_t>(0)),
+      negative_size(value[kNegativeSize].As<std::size_t>(0)),
+      negative_lifetime(ParseMs(value[kNegativeLifetimeMs],
+                                std::chrono::milliseconds::zero())) {
   if (size == 0) throw std::runtime_error("cache-size is non-positive");
 }
 
@@ -49,6 +73,18 @@ std::size_t LruCacheConfig::GetWaySize(std::size_t ways) const {
   return way_size == 0 ? 1 : way_size;
 }
 
+std::size_t LruCacheConfig::GetWayMaxBytes(std::size_t ways) const {
+  if (max_bytes == 0) return 0;
+  const auto way_max_bytes = max_bytes / ways;
+  return way_max_bytes == 0 ? 1 : way_max_bytes;
+}
+
+std::size_t LruCacheConfig::GetNegativeWaySize(std::size_t ways) const {
+  if (negative_size == 0) return 0;
+  const auto way_size = negative_size / ways;
+  return way_size == 0 ? 1 : way_size;
+}
+
 LruCacheConfig Parse(const formats::json::Value& value,
                      formats::parse::To<LruCacheConfig>) {
   return LruCacheConfig{value};
@@ -58,8 +94,14 @@ LruCacheConfigStatic::LruCacheConfigStatic(
     const yaml_config::YamlConfig& config)
     : config(config),
       ways(config[kWays].As<std::size_t>()),
-      use_dynamic_config(config["config-settings"].As<bool>(true)) {
+      use_dynamic_config(config["config-settings"].As<bool>(true)),
+      refresh_ahead_interval(
+          config[kRefreshAheadInterval].As<std::chrono::milliseconds>(0)),
+      refresh_ahead_keys(config[kRefreshAheadKeys].As<std::size_t>(1000)) {
   if (ways <= 0) throw std::runtime_error("cache-ways is non-positive");
+  if (refresh_ahead_interval.count() != 0 && refresh_ahead_keys == 0) {
+    throw std::runtime_error("refresh-ahead-keys is non-positive");
+  }
 }
 
 LruCacheConfigStatic::LruCacheConfigStatic(
@@ -13,12 +13,14 @@ ExpirableLruCacheStatisticsBase::ExpirableLruCacheStatisticsBase(
     : hits(other.hits.load()),
       misses(other.misses.load()),
       stale(other.stale.load()),
+      negative_hits(other.negative_hits.load()),
       background_updates(other.background_updates.load()) {}
 
 void ExpirableLruCacheStatisticsBase::Reset() {
   hits = 0;
   misses = 0;
   stale = 0;
+  negative_hits = 0;
   background_updates = 0;
 }
 
@@ -27,6 +29,7 @@ ExpirableLruCacheStatisticsBase& ExpirableLruCacheStatisticsBase::operator+=(
   hits += other.hits.load();
   misses += other.misses.load();
   stale += other.stale.load();
+  negative_hits += other.negative_hits.load();
   background_updates += other.background_updates.load();
   return *this;
 }
@@ -49,6 +52,15 @@ void CacheStale(ExpirableLruCacheStatistics& stats) {
   LOG_TRACE() << "stale cache";
 }
 
+void CacheNegativeHit(ExpirableLruCacheStatistics& stats) {
+  ++stats.total.hits;
+  ++stats.total.negative_hits;
+  auto& recent = stats.recent.GetCurrentCounter();
+  ++recent.hits;
+  ++recent.negative_hits;
+  LOG_TRACE() << "cache negative hit";
+}
+
 }  // namespace cache::impl
 
 USERVER_NAMESPACE_END
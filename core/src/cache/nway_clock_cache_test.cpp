@@ -0,0 +1,121 @@
+#include <userver/utest/utest.hpp>
+
+#include <userver/cache/nway_clock_cache.hpp>
+#include <userver/engine/async.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+using Cache = cache::NWayClockCache<int, int>;
+
+UTEST(NWayClockCache, Ctr) {
+  UEXPECT_NO_THROW(Cache(1, 10));
+  UEXPECT_NO_THROW(Cache(10, 10));
+  UEXPECT_THROW(Cache(0, 10), std::logic_error);
+}
+
+UTEST(NWayClockCache, Set) {
+  Cache cache(1, 1);
+  EXPECT_EQ(0, cache.GetSize());
+
+  cache.Put(1, 1);
+  EXPECT_EQ(1, cache.GetSize());
+
+  cache.Put(2, 2);
+
+  EXPECT_EQ(2, cache.Get(2));
+  EXPECT_EQ(1, cache.GetSize());
+  EXPECT_FALSE(cache.Get(1).has_value());
+}
+
+UTEST(NWayClockCache, Update) {
+  Cache cache(1, 100);
+  for (int i = 0; i < 100; ++i) cache.Put(i, i);
+  for (int i = 0; i < 100; ++i) EXPECT_EQ(i, cache.Get(i));
+
+  cache.Put(42, -1);
+  EXPECT_EQ(-1, cache.Get(42));
+  EXPECT_EQ(100, cache.GetSize());
+}
+
+UTEST(NWayClockCache, SecondChance) {
+  Cache cache(1, 2);
+  cache.Put(1, 1);
+  cache.Put(2, 2);
+
+  EXPECT_EQ(1, cache.Get(1));
+  cache.Put(3, 3);
+
+  EXPECT_EQ(1, cache.Get(1));
+  EXPECT_FALSE(cache.Get(2).has_value());
+  EXPECT_EQ(3, cache.Get(3));
+}
+
+UTEST(NWayClockCache, GetExpired) {
+  Cache cache(1, 2);
+  cache.Put(1, 1);
+  cache.Put(2, 2);
+
+  EXPECT_EQ(1, cache.Get(1));
+  EXPECT_EQ(2, cache.GetSize());
+
+  EXPECT_FALSE(cache.Get(1, [](int) { return false; }).has_value());
+  EXPECT_EQ(1, cache.GetSize());
+  EXPECT_FALSE(cache.Get(1).has_value());
+
+  cache.Invalidate();
+  EXPECT_EQ(0, cache.GetSize());
+  EXPECT_FALSE(cache.Get(2).has_value());
+}
+
+UTEST(NWayClockCache, GetExpiredKeepsFreshValue) {
+  Cache cache(1, 2);
+  cache.Put(1, 1);
+
+  // a fresh value is put while the stale one is validated
+  EXPECT_FALSE(cache.Get(1, [&cache](int) {
+                      cache.Put(1, 2);
+                      return false;
+                    })
+                   .has_value());
+  EXPECT_EQ(2, cache.Get(1));
+  EXPECT_EQ(1, cache.GetSize());
+}
+
+UTEST(NWayClockCache, UpdateWaySize) {
+  Cache cache(2, 10);
+  for (int i = 0; i < 100; ++i) cache.Put(i, i);
+  EXPECT_EQ(20, cache.GetSize());
+
+  cache.UpdateWaySize(3);
+  EXPECT_EQ(6, cache.GetSize());
+
+  int found = 0;
+  cache.VisitAll([&found](int key, int value) {
+    EXPECT_EQ(key, value);
+    ++found;
+  });
+  EXPECT_EQ(6, found);
+}
+
+UTEST_MT(NWayClockCache, ConcurrentAccess, 4) {
+  Cache cache(4, 50);
+  std::vector<engine::TaskWithResult<void>> tasks;
+  for (int task = 0; task < 4; ++task) {
+    tasks.push_back(engine::AsyncNoSpan([&cache, task] {
+      for (int i = 0; i < 10000; ++i) {
+        const auto key = (i * 7 + task) % 300;
+        const auto value = cache.Get(key);
+        if (value) {
+          EXPECT_EQ(key, *value);
+        } else {
+          cache.Put(key, key);
+        }
+      }
+    }));
+  }
+  for (auto& task : tasks) task.Get();
+
+  EXPECT_LE(cache.GetSize(), 200);
+}
+
+USERVER_NAMESPACE_END
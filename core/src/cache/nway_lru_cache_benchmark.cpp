@@ -0,0 +1,101 @@
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <vector>
+
+#include <userver/cache/nway_clock_cache.hpp>
+#include <userver/cache/nway_lru_cache.hpp>
+#include <userver/engine/async.hpp>
+#include <userver/engine/run_standalone.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr unsigned kWays = 16;
+constexpr unsigned kWaySize = 1024;
+// a few hot keys, all of them are in cache
+constexpr unsigned kHotKeysCount = 64;
+
+}  // namespace
+
+// Arguments: threads count. All the threads read the same hot keys, the
+// benchmark measures the reads of the main one.
+template <typename Cache>
+void nway_cache_read_contention(benchmark::State& state) {
+  const std::size_t threads_count = state.range(0);
+
+  engine::RunStandalone(threads_count, [&] {
+    Cache cache(kWays, kWaySize);
+    for (unsigned i = 0; i < kHotKeysCount; ++i) cache.Put(i, i);
+
+    std::atomic<bool> run{true};
+    std::vector<engine::TaskWithResult<void>> tasks;
+    tasks.reserve(threads_count - 1);
+    for (std::size_t i = 0; i < threads_count - 1; ++i) {
+      tasks.push_back(engine::AsyncNoSpan([&] {
+        unsigned key = 0;
+        while (run) {
+          benchmark::DoNotOptimize(cache.Get(key++ % kHotKeysCount));
+        }
+      }));
+    }
+
+    unsigned key = 0;
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(cache.Get(key++ % kHotKeysCount));
+    }
+
+    run = false;
+    for (auto& task : tasks) task.Get();
+  });
+}
+BENCHMARK_TEMPLATE(nway_cache_read_contention,
+                   cache::NWayLRU<unsigned, unsigned>)
+    ->RangeMultiplier(2)
+    ->Range(1, 8);
+BENCHMARK_TEMPLATE(nway_cache_read_contention,
+                   cache::NWayClockCache<unsigned, unsigned>)
+    ->RangeMultiplier(2)
+    ->Range(1, 8);
+
+// Arguments: threads count. Keys do not fit into the cache, 1/8 of the reads
+// miss and put the value.
+template <typename Cache>
+void nway_cache_read_write(benchmark::State& state) {
+  const std::size_t threads_count = state.range(0);
+  constexpr unsigned kKeysCount = kWays * kWaySize * 8 / 7;
+
+  engine::RunStandalone(threads_count, [&] {
+    Cache cache(kWays, kWaySize);
+
+    std::atomic<bool> run{true};
+    const auto access = [&cache](unsigned key) {
+      if (!cache.Get(key)) cache.Put(key, key);
+    };
+
+    std::vector<engine::TaskWithResult<void>> tasks;
+    tasks.reserve(threads_count - 1);
+    for (std::size_t i = 0; i < threads_count - 1; ++i) {
+      tasks.push_back(engine::AsyncNoSpan([&, i] {
+        unsigned key = i * 7919;
+        while (run) access(key++ % kKeysCount);
+      }));
+    }
+
+    unsigned key = 0;
+    for (auto _ : state) access(key++ % kKeysCount);
+
+    run = false;
+    for (auto& task : tasks) task.Get();
+  });
+}
+BENCHMARK_TEMPLATE(nway_cache_read_write, cache::NWayLRU<unsigned, unsigned>)
+    ->RangeMultiplier(2)
+    ->Range(1, 8);
+BENCHMARK_TEMPLATE(nway_cache_read_write,
+                   cache::NWayClockCache<unsigned, unsigned>)
+    ->RangeMultiplier(2)
+    ->Range(1, 8);
+
+USERVER_NAMESPACE_END
@@ -1,5 +1,7 @@
 #include <userver/utest/utest.hpp>
 
+#include <string>
+
 #include <userver/cache/nway_lru_cache.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -54,4 +56,20 @@ UTEST(NWayLRU, SetMultipleWays) {
   EXPECT_EQ(1, cache.Get(1));
 }
 
+UTEST(NWayLRU, MaxWeight) {
+  cache::NWayLRU<int, std::string> cache(2, 100);
+  const auto item_weight =
+      cache::GetWeight(0) + cache::GetWeight(std::string(1000, 'x'));
+  cache.UpdateWayMaxWeight(item_weight * 3);
+
+  for (int i = 0; i < 100; ++i) cache.Put(i, std::string(1000, 'x'));
+  EXPECT_EQ(6, cache.GetSize());
+  EXPECT_EQ(item_weight * 6, cache.GetWeight());
+  EXPECT_EQ(item_weight * 94, cache.GetEvictedWeight());
+
+  cache.UpdateWayMaxWeight(0);
+  for (int i = 0; i < 100; ++i) cache.Put(i, std::string(1000, 'x'));
+  EXPECT_EQ(100, cache.GetSize());
+}
+
 USERVER_NAMESPACE_END
@@ -0,0 +1,78 @@
+#include <benchmark/benchmark.h>
+
+#include <type_traits>
+#include <unordered_map>
+
+#include <userver/cache/persistent_hash_map.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr unsigned kDeltaSize = 1000;
+
+template <typename Map>
+void Insert(Map& map, unsigned key, unsigned value) {
+  if constexpr (std::is_same_v<Map, std::unordered_map<unsigned, unsigned>>) {
+    map.insert_or_assign(key, value);
+  } else {
+    map.InsertOrAssign(key, value);
+  }
+}
+
+template <typename Map>
+Map MakeMap(unsigned size) {
+  Map map;
+  for (unsigned i = 0; i < size; ++i) Insert(map, i, i);
+  return map;
+}
+
+}  // namespace
+
+// Incremental cache update: copy the current snapshot and apply a delta of
+// kDeltaSize items. Argument is the cache size.
+template <typename Map>
+void cache_incremental_update(benchmark::State& state) {
+  const unsigned size = state.range(0);
+  const auto snapshot = MakeMap<Map>(size);
+
+  unsigned key = 0;
+  for (auto _ : state) {
+    auto next = snapshot;
+    for (unsigned i = 0; i < kDeltaSize; ++i) {
+      Insert(next, (key += 7919) % (size * 2), i);
+    }
+    benchmark::DoNotOptimize(next);
+  }
+}
+BENCHMARK_TEMPLATE(cache_incremental_update,
+                   std::unordered_map<unsigned, unsigned>)
+    ->RangeMultiplier(10)
+    ->Range(10'000, 1'000'000);
+BENCHMARK_TEMPLATE(cache_incremental_update,
+                   cache::PersistentHashMap<unsigned, unsigned>)
+    ->RangeMultiplier(10)
+    ->Range(10'000, 1'000'000);
+
+template <typename Map>
+void cache_lookup(benchmark::State& state) {
+  const unsigned size = state.range(0);
+  const auto map = MakeMap<Map>(size);
+
+  unsigned key = 0;
+  for (auto _ : state) {
+    if constexpr (std::is_same_v<Map, std::unordered_map<unsigned, unsigned>>) {
+      benchmark::DoNotOptimize(map.find((key += 7919) % size));
+    } else {
+      benchmark::DoNotOptimize(map.Get((key += 7919) % size));
+    }
+  }
+}
+BENCHMARK_TEMPLATE(cache_lookup, std::unordered_map<unsigned, unsigned>)
+    ->RangeMultiplier(10)
+    ->Range(10'000, 1'000'000);
+BENCHMARK_TEMPLATE(cache_lookup, cache::PersistentHashMap<unsigned, unsigned>)
+    ->RangeMultiplier(10)
+    ->Range(10'000, 1'000'000);
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,141 @@
+#include <userver/cache/persistent_hash_map.hpp>
+
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+#include <gtest/gtest.h>
+
+#include <userver/dump/common_containers.hpp>
+#include <userver/dump/test_helpers.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using Map = cache::PersistentHashMap<int, std::string>;
+
+// All the keys collide, to test the deepest nodes
+struct BadHash {
+  std::size_t operator()(int) const { return 42; }
+};
+
+}  // namespace
+
+TEST(PersistentHashMap, Basic) {
+  Map map;
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(map.Get(1), nullptr);
+
+  EXPECT_TRUE(map.InsertOrAssign(1, "one"));
+  EXPECT_FALSE(map.InsertOrAssign(1, "uno"));
+  EXPECT_TRUE(map.InsertOrAssign(2, "two"));
+  EXPECT_EQ(map.size(), 2);
+  EXPECT_EQ(*map.Get(1), "uno");
+  EXPECT_EQ(*map.Get(2), "two");
+
+  EXPECT_TRUE(map.Erase(1));
+  EXPECT_FALSE(map.Erase(1));
+  EXPECT_FALSE(map.Contains(1));
+  EXPECT_EQ(map.size(), 1);
+
+  map.Clear();
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(map.begin(), map.end());
+}
+
+TEST(PersistentHashMap, MatchesUnorderedMap) {
+  Map map;
+  std::unordered_map<int, std::string> expected;
+  for (int i = 0; i < 100000; ++i) {
+    const auto key = (i * 7919) % 50000;
+    if (i % 3 == 0) {
+      EXPECT_EQ(map.Erase(key), expected.erase(key) != 0);
+    } else {
+      const auto value = std::to_string(i);
+      EXPECT_EQ(map.InsertOrAssign(key, value),
+                expected.insert_or_assign(key, value).second);
+    }
+  }
+
+  EXPECT_EQ(map.size(), expected.size());
+  std::size_t visited = 0;
+  for (const auto& [key, value] : map) {
+    ASSERT_EQ(expected.at(key), value);
+    ++visited;
+  }
+  EXPECT_EQ(visited, expected.size());
+}
+
+TEST(PersistentHashMap, StructuralSharing) {
+  Map original;
+  for (int i = 0; i < 1000; ++i) original.InsertOrAssign(i, std::to_string(i));
+
+  auto copy = original;
+  copy.InsertOrAssign(1, "changed");
+  copy.InsertOrAssign(1000, "new");
+  copy.Erase(2);
+
+  EXPECT_EQ(*original.Get(1), "1");
+  EXPECT_EQ(original.Get(1000), nullptr);
+  EXPECT_EQ(*original.Get(2), "2");
+  EXPECT_EQ(original.size(), 1000);
+
+  EXPECT_EQ(*copy.Get(1), "changed");
+  EXPECT_EQ(*copy.Get(1000), "new");
+  EXPECT_EQ(copy.Get(2), nullptr);
+  EXPECT_EQ(copy.size(), 1000);
+}
+
+TEST(PersistentHashMap, ConcurrentSnapshotReader) {
+  Map map;
+  for (int i = 0; i < 10000; ++i) map.InsertOrAssign(i, std::to_string(i));
+
+  constexpr int kRounds = 10;
+  for (int round = 0; round < kRounds; ++round) {
+    // The writer modifies in place the nodes that the reader has released
+    std::thread reader([snapshot = map]() mutable {
+      std::size_t size = 0;
+      for ([[maybe_unused]] const auto& item : snapshot) ++size;
+      EXPECT_EQ(size, snapshot.size());
+      snapshot.Clear();
+    });
+    for (int i = round; i < 10000; i += 3) map.Erase(i);
+    for (int i = round; i < 10000; i += 5) map.InsertOrAssign(i, "new");
+    reader.join();
+  }
+
+  for (int i = kRounds - 1; i < 10000; i += 5) {
+    ASSERT_NE(map.Get(i), nullptr);
+    EXPECT_EQ(*map.Get(i), "new");
+  }
+}
+
+TEST(PersistentHashMap, HashCollisions) {
+  cache::PersistentHashMap<int, int, BadHash> map;
+  for (int i = 0; i < 10; ++i) map.InsertOrAssign(i, i);
+  auto copy = map;
+  for (int i = 0; i < 10; i += 2) copy.Erase(i);
+
+  EXPECT_EQ(map.size(), 10);
+  EXPECT_EQ(copy.size(), 5);
+  for (int i = 0; i < 10; ++i) {
+    ASSERT_NE(map.Get(i), nullptr);
+    EXPECT_EQ(*map.Get(i), i);
+    EXPECT_EQ(copy.Contains(i), i % 2 == 1);
+  }
+}
+
+TEST(PersistentHashMap, Dump) {
+  Map map;
+  for (int i = 0; i < 100; ++i) map.InsertOrAssign(i, std::to_string(i));
+
+  const auto restored = dump::FromBinary<Map>(dump::ToBinary(map));
+  EXPECT_EQ(restored.size(), map.size());
+  for (const auto& [key, value] : map) {
+    ASSERT_NE(restored.Get(key), nullptr);
+    EXPECT_EQ(*restored.Get(key), value);
+  }
+}
+
+USERVER_NAMESPACE_END
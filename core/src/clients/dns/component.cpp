@@ -40,6 +40,12 @@ ResolverConfig ParseResolverConfig(
   config.cache_failure_ttl =
       component_config["cache_failure_ttl"].As<std::chrono::milliseconds>(
           config.cache_failure_ttl);
+  config.cache_max_stale =
+      component_config["cache-max-stale"].As<std::chrono::milliseconds>(
+          config.cache_max_stale);
+  config.cache_refresh_interval =
+      component_config["cache-refresh-interval"].As<std::chrono::milliseconds>(
+          config.cache_refresh_interval);
   return config;
 }
 
@@ -51,6 +57,11 @@ Component::Component(const components::ComponentConfig& config,
       resolver_{context.GetTaskProcessor(
                     config["fs-task-processor"].As<std::string>()),
                 ParseResolverConfig(config)} {
+  for (auto& name : config["names-statistics"].As<std::vector<std::string>>(
+           std::vector<std::string>{})) {
+    names_with_statistics_.insert(std::move(name));
+  }
+
   auto& storage =
       context.FindComponent<components::StatisticsStorage>().GetStorage();
   statistics_holder_ = storage.RegisterExtender(
@@ -71,7 +82,38 @@ formats::json::Value Component::ExtendStatistics() {
   json_counters["network-failure"] = counters.network_failure.Load();
   utils::statistics::SolomonChildrenAreLabelValues(json_counters,
                                                    "dns_reply_source");
-  return formats::json::MakeObject("replies", json_counters.ExtractValue());
+
+  // Per name metrics are exported only for the listed names to keep the
+  // number of metrics bounded
+  Resolver::NameCounters total{};
+  std::size_t tracked = 0;
+  formats::json::ValueBuilder json_by_name{formats::json::Type::kObject};
+  for (const auto& [name, name_counters] : GetResolver().GetNameCounters()) {
+    ++tracked;
+    total.hits += name_counters.hits;
+    total.refreshes += name_counters.refreshes;
+    total.refresh_failures += name_counters.refresh_failures;
+
+    if (names_with_statistics_.count(name)) {
+      auto json_name = json_by_name[name];
+      json_name["hits"] = name_counters.hits;
+      json_name["refreshes"] = name_counters.refreshes;
+      json_name["refresh-failures"] = name_counters.refresh_failures;
+    }
+  }
+  utils::statistics::SolomonChildrenAreLabelValues(json_by_name, "dns_name");
+
+  formats::json::ValueBuilder json_names;
+  json_names["tracked"] = tracked;
+  json_names["hits"] = total.hits;
+  json_names["refreshes"] = total.refreshes;
+  json_names["refresh-failures"] = total.refresh_failures;
+  if (!names_with_statistics_.empty()) {
+    json_names["by-name"] = json_by_name.ExtractValue();
+  }
+
+  return formats::json::MakeObject("replies", json_counters.ExtractValue(),
+                                   "names", json_names.ExtractValue());
 }
 
 yaml_config::Schema Component::GetStaticConfigSchema() {
@@ -122,6 +164,21 @@ properties:
         type: string
         description: TTL for network failures caching
         defaultDescription: 5s
+    cache-max-stale:
+        type: string
+        description: max time after the expiration to serve a cached reply while it is being updated
+        defaultDescription: 5m
+    cache-refresh-interval:
+        type: string
+        description: interval of background updates of the recently used names that are about to expire, 0 disables background updates
+        defaultDescription: 1s
+    names-statistics:
+        type: array
+        description: names to export the per-name metrics for, the metrics of the other names are only aggregated
+        defaultDescription: '[]'
+        items:
+            type: string
+            description: domain name
 )");
 }
 
@@ -1,6 +1,7 @@
 #include <userver/clients/dns/resolver.hpp>
 
 #include <arpa/inet.h>
+#include <atomic>
 #include <cctype>
 #include <chrono>
 
@@ -12,10 +13,12 @@
 #include <userver/concurrent/mutex_set.hpp>
 #include <userver/engine/async.hpp>
 #include <userver/logging/log.hpp>
+#include <userver/rcu/rcu_map.hpp>
 #include <userver/utils/assert.hpp>
 #include <userver/utils/from_string.hpp>
 #include <userver/utils/impl/wait_token_storage.hpp>
 #include <userver/utils/mock_now.hpp>
+#include <userver/utils/periodic_task.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -110,6 +113,7 @@ class Resolver::Impl {
   ~Impl();
 
   const LookupSourceCounters& GetLookupSourceCounters() const;
+  std::unordered_map<std::string, NameCounters> GetNameCounters() const;
 
   void ReloadHosts();
   void FlushNetworkCache();
@@ -137,6 +141,18 @@ class Resolver::Impl {
     bool is_failure{false};
   };
 
+  struct NameStats {
+    utils::statistics::RelaxedCounter<size_t> hits{0};
+    utils::statistics::RelaxedCounter<size_t> refreshes{0};
+    utils::statistics::RelaxedCounter<size_t> refresh_failures{0};
+    std::atomic<std::chrono::steady_clock::time_point> last_hit{
+        utils::datetime::MockSteadyNow()};
+  };
+
+  void AccountHit(const std::string& name,
+                  std::chrono::steady_clock::time_point now);
+  void RefreshHotNames();
+
   template <typename Mutex>
   void MoveQueryToBackground(std::unique_lock<Mutex>& lock, Mutex&& mutex,
                              engine::Future<NetResolver::Response>&& future,
@@ -154,9 +170,16 @@ class Resolver::Impl {
   const std::chrono::milliseconds net_cache_update_margin_;
   const std::chrono::milliseconds net_cache_max_reply_ttl_;
   const std::chrono::milliseconds net_cache_failure_ttl_;
+  const std::chrono::milliseconds net_cache_max_stale_;
+  const std::chrono::milliseconds net_cache_refresh_interval_;
+  const size_t max_tracked_names_;
   cache::NWayLRU<std::string, NetCacheEntry> net_cache_;
   concurrent::MutexSet<std::string> net_cache_update_mutexes_;
+  // recently resolved via network names, the hot ones are updated in
+  // background by refresh_task_
+  rcu::RcuMap<std::string, NameStats> name_stats_;
   utils::impl::WaitTokenStorage wait_token_storage_;
+  utils::PeriodicTask refresh_task_;
 };
 
 Resolver::Impl::Impl(engine::TaskProcessor& fs_task_processor,
@@ -168,16 +191,42 @@ Resolver::Impl::Impl(engine::TaskProcessor& fs_task_processor,
       net_cache_update_margin_{config.network_timeout},
       net_cache_max_reply_ttl_{config.cache_max_reply_ttl},
       net_cache_failure_ttl_{config.cache_failure_ttl},
+      net_cache_max_stale_{config.cache_max_stale},
+      net_cache_refresh_interval_{config.cache_refresh_interval},
+      max_tracked_names_{config.cache_ways * config.cache_size_per_way},
       net_cache_{config.cache_ways, config.cache_size_per_way},
-      net_cache_update_mutexes_(config.cache_ways) {}
+      net_cache_update_mutexes_(config.cache_ways) {
+  if (net_cache_refresh_interval_ > std::chrono::milliseconds::zero()) {
+    refresh_task_.Start("dns_cache_refresh",
+                        utils::PeriodicTask::Settings(
+                            net_cache_refresh_interval_,
+                            {utils::PeriodicTask::Flags::kCritical}),
+                        [this] { RefreshHotNames(); });
+  }
+}
 
-Resolver::Impl::~Impl() { wait_token_storage_.WaitForAllTokens(); }
+Resolver::Impl::~Impl() {
+  refresh_task_.Stop();
+  wait_token_storage_.WaitForAllTokens();
+}
 
 const Resolver::LookupSourceCounters& Resolver::Impl::GetLookupSourceCounters()
     const {
   return source_counters_;
 }
 
+std::unordered_map<std::string, Resolver::NameCounters>
+Resolver::Impl::GetNameCounters() const {
+  std::unordered_map<std::string, NameCounters> result;
+  for (const auto& [name, stats] : name_stats_) {
+    auto& counters = result[name];
+    counters.hits = stats->hits.Load();
+    counters.refreshes = stats->refreshes.Load();
+    counters.refresh_failures = stats->refresh_failures.Load();
+  }
+  return result;
+}
+
 void Resolver::Impl::ReloadHosts() { file_resolver_.ReloadHosts(); }
 
 void Resolver::Impl::FlushNetworkCache() { net_cache_.Invalidate(); }
@@ -210,6 +259,12 @@ Resolver::Impl::NetCacheResult Resolver::Impl::QueryNetCache(
     return result;
   }
 
+  if (now - cached->expiration > net_cache_max_stale_) {
+    // too old to be served even while updating
+    return result;
+  }
+
+  AccountHit(name, now);
   result.addrs = cached->addrs;
   if (cached->expiration >= now) {
     ++source_counters_.cached;
@@ -234,6 +289,40 @@ void Resolver::Impl::AccountNetUpdateFailure() {
   ++source_counters_.network_failure;
 }
 
+void Resolver::Impl::AccountHit(const std::string& name,
+                                std::chrono::steady_clock::time_point now) {
+  const auto stats = name_stats_.Get(name);
+  if (!stats) return;
+  ++stats->hits;
+  stats->last_hit.store(now, std::memory_order_relaxed);
+}
+
+// Updates the names that are about to expire before the callers notice that,
+// names without hits for the max reply TTL are considered cold and are left
+// to expire.
+void Resolver::Impl::RefreshHotNames() {
+  const auto now = utils::datetime::MockSteadyNow();
+  const auto refresh_margin =
+      net_cache_update_margin_ + net_cache_refresh_interval_;
+
+  for (const auto& [name, stats] : name_stats_.GetSnapshot()) {
+    const auto cached = net_cache_.Get(name);
+    const auto last_hit = stats->last_hit.load(std::memory_order_relaxed);
+    const bool is_cold = last_hit + net_cache_max_reply_ttl_ < now;
+    if (!cached || cached->is_failure || is_cold) {
+      LOG_TRACE() << "Stopping background updates for '" << name << '\'';
+      name_stats_.Erase(name);
+      continue;
+    }
+
+    if (cached->expiration - now >= refresh_margin) continue;
+
+    auto mutex = GetUpdateMutex(name);
+    std::unique_lock lock{mutex, std::defer_lock};
+    StartBackgroundQuery(lock, std::move(mutex), name);
+  }
+}
+
 template <typename Mutex>
 AddrVector Resolver::Impl::DoForegroundQuery(std::unique_lock<Mutex>& lock,
                                              Mutex&& mutex,
@@ -270,6 +359,7 @@ void Resolver::Impl::StartBackgroundQuery(std::unique_lock<Mutex>& lock,
     return;
   }
   LOG_TRACE() << "Updating record for '" << name << "' in background";
+  if (const auto stats = name_stats_.Get(name)) ++stats->refreshes;
   auto future = net_resolver_.Resolve(name);
   MoveQueryToBackground(lock, std::forward<Mutex>(mutex), std::move(future),
                         name, FailureMode::kIgnore);
@@ -316,6 +406,8 @@ void Resolver::Impl::FinishNetUpdate(
                                          utils::datetime::MockSteadyNow() +
                                              net_cache_failure_ttl_,
                                          true});
+    } else if (const auto stats = name_stats_.Get(name)) {
+      ++stats->refresh_failures;
     }
     ++source_counters_.network_failure;
     throw;
@@ -331,6 +423,9 @@ void Resolver::Impl::FinishNetUpdate(
     net_cache_.Put(
         name, NetCacheEntry{std::move(response.addrs),
                             utils::datetime::MockSteadyNow() + effective_ttl});
+    if (name_stats_.SizeApprox() < max_tracked_names_) {
+      name_stats_.TryEmplace(name);
+    }
   } else {
     LOG_TRACE() << "Skipping cache update for '" << name << '\'';
   }
@@ -403,6 +498,11 @@ const Resolver::LookupSourceCounters& Resolver::GetLookupSourceCounters()
   return impl_->GetLookupSourceCounters();
 }
 
+std::unordered_map<std::string, Resolver::NameCounters>
+Resolver::GetNameCounters() const {
+  return impl_->GetNameCounters();
+}
+
 void Resolver::ReloadHosts() { impl_->ReloadHosts(); }
 
 void Resolver::FlushNetworkCache() { impl_->FlushNetworkCache(); }
@@ -0,0 +1,91 @@
+#include <benchmark/benchmark.h>
+
+#include <netinet/in.h>
+
+#include <string>
+#include <vector>
+
+#include <userver/clients/dns/config.hpp>
+#include <userver/clients/dns/resolver.hpp>
+#include <userver/engine/run_standalone.hpp>
+#include <userver/engine/task/task.hpp>
+#include <userver/utest/dns_server_mock.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr size_t kNamesCount = 256;
+constexpr int kReplyTtlSeconds = 1;
+
+engine::io::Sockaddr MakeV4Sockaddr() {
+  engine::io::Sockaddr sockaddr;
+  auto* sa = sockaddr.As<sockaddr_in>();
+  sa->sin_family = AF_INET;
+  sa->sin_addr.s_addr = htonl(0x7F000001);
+  return sockaddr;
+}
+
+engine::io::Sockaddr MakeV6Sockaddr() {
+  engine::io::Sockaddr sockaddr;
+  auto* sa = sockaddr.As<sockaddr_in6>();
+  sa->sin6_family = AF_INET6;
+  sa->sin6_addr.s6_addr[15] = 1;
+  return sockaddr;
+}
+
+utest::DnsServerMock::DnsAnswerVector DnsHandler(
+    const utest::DnsServerMock::DnsQuery& query) {
+  using RecordType = utest::DnsServerMock::RecordType;
+
+  static const auto kV4Sockaddr = MakeV4Sockaddr();
+  static const auto kV6Sockaddr = MakeV6Sockaddr();
+  if (query.type == RecordType::kA) {
+    return {{query.type, kV4Sockaddr, kReplyTtlSeconds}};
+  } else if (query.type == RecordType::kAAAA) {
+    return {{query.type, kV6Sockaddr, kReplyTtlSeconds}};
+  }
+  throw utest::DnsServerMock::NoAnswer{};
+}
+
+}  // namespace
+
+// Resolves a set of names with short TTLs, so that the records keep expiring
+// while the benchmark runs. Argument enables the background refresh of the
+// hot names.
+void dns_resolve_churn(benchmark::State& state) {
+  engine::RunStandalone(2, [&] {
+    const utest::DnsServerMock server_mock{&DnsHandler};
+
+    clients::dns::ResolverConfig config;
+    config.network_timeout = std::chrono::milliseconds{100};
+    config.network_custom_servers = {server_mock.GetServerAddress()};
+    config.cache_max_reply_ttl = std::chrono::seconds{kReplyTtlSeconds};
+    config.cache_refresh_interval =
+        state.range(0) ? std::chrono::milliseconds{100}
+                       : std::chrono::milliseconds::zero();
+    clients::dns::Resolver resolver{engine::current_task::GetTaskProcessor(),
+                                    config};
+
+    std::vector<std::string> names;
+    names.reserve(kNamesCount);
+    for (size_t i = 0; i < kNamesCount; ++i) {
+      names.push_back("host-" + std::to_string(i) + ".test");
+    }
+
+    const auto deadline =
+        engine::Deadline::FromDuration(std::chrono::seconds{5});
+    size_t i = 0;
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(
+          resolver.Resolve(names[i++ % kNamesCount], deadline));
+    }
+
+    const auto& counters = resolver.GetLookupSourceCounters();
+    state.counters["network"] = counters.network.Load();
+    state.counters["cached_stale"] = counters.cached_stale.Load();
+  });
+}
+BENCHMARK(dns_resolve_churn)->Arg(0)->Arg(1);
+
+USERVER_NAMESPACE_END
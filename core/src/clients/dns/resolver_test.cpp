@@ -57,7 +57,8 @@ constexpr static auto kNetV6String{"2a02:6b8:a::a"};
 struct MockedResolver {
   using ServerMock = utest::DnsServerMock;
 
-  MockedResolver(size_t cache_max_ttl, size_t cache_size_per_way)
+  MockedResolver(size_t cache_max_ttl, size_t cache_size_per_way,
+                 std::chrono::milliseconds cache_refresh_interval = {})
       : hosts_file{[] {
           auto file = fs::blocking::TempFile::Create();
           fs::blocking::RewriteFileContents(file.GetPath(), kTestHosts);
@@ -86,6 +87,7 @@ struct MockedResolver {
               config.cache_failure_ttl = std::chrono::seconds{cache_max_ttl},
               config.cache_ways = 1;
               config.cache_size_per_way = cache_size_per_way;
+              config.cache_refresh_interval = cache_refresh_interval;
               config.network_custom_servers = {server_mock.GetServerAddress()};
               return config;
             }()} {}
@@ -295,6 +297,53 @@ UTEST(Resolver, CacheStale) {
   EXPECT_EQ(counters.network_failure, 0);
 }
 
+UTEST(Resolver, CacheMaxStale) {
+  const auto test_deadline =
+      engine::Deadline::FromDuration(utest::kMaxTestWaitTime);
+
+  MockedResolver resolver{1, 1};
+
+  utils::datetime::MockNowSet({});
+
+  EXPECT_PRED_FORMAT2(CheckAddrs, resolver->Resolve("first", test_deadline),
+                      (Expected{kNetV6String, kNetV4String}));
+
+  utils::datetime::MockSleep(std::chrono::seconds{3600});
+
+  EXPECT_PRED_FORMAT2(CheckAddrs, resolver->Resolve("first", test_deadline),
+                      (Expected{kNetV6String, kNetV4String}));
+
+  const auto& counters = resolver->GetLookupSourceCounters();
+  EXPECT_EQ(counters.cached, 0);
+  EXPECT_EQ(counters.cached_stale, 0);
+  EXPECT_EQ(counters.network, 2);
+  EXPECT_EQ(counters.network_failure, 0);
+}
+
+UTEST(Resolver, BackgroundRefresh) {
+  const auto test_deadline =
+      engine::Deadline::FromDuration(utest::kMaxTestWaitTime);
+
+  MockedResolver resolver{1000, 2, std::chrono::milliseconds{10}};
+
+  EXPECT_PRED_FORMAT2(CheckAddrs, resolver->Resolve("hot", test_deadline),
+                      (Expected{kNetV6String, kNetV4String}));
+  EXPECT_PRED_FORMAT2(CheckAddrs, resolver->Resolve("hot", test_deadline),
+                      (Expected{kNetV6String, kNetV4String}));
+
+  // the record expires within the update margin, so it is refreshed
+  // without waiting for a caller
+  while (resolver->GetNameCounters()["hot"].refreshes == 0) {
+    ASSERT_FALSE(test_deadline.IsReached());
+    engine::SleepFor(std::chrono::milliseconds{10});
+  }
+
+  const auto name_counters = resolver->GetNameCounters();
+  ASSERT_EQ(name_counters.count("hot"), 1);
+  EXPECT_EQ(name_counters.at("hot").hits, 1);
+  EXPECT_EQ(name_counters.at("hot").refresh_failures, 0);
+}
+
 UTEST(Resolver, CacheFailures) {
   const auto test_deadline =
       engine::Deadline::FromDuration(utest::kMaxTestWaitTime);
@@ -0,0 +1,197 @@
+#include <userver/clients/http/impl/body_chain.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <utility>
+
+#include <moodycamel/concurrentqueue.h>
+
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace clients::http::impl {
+namespace {
+
+// 64MiB of idle chunks at most
+constexpr std::size_t kMaxPooledChunks = 4096;
+
+template <typename Chunk>
+class ChunkPool final {
+ public:
+  ~ChunkPool() {
+    Chunk* chunk = nullptr;
+    while (queue_.try_dequeue(chunk)) delete chunk;
+  }
+
+  Chunk* Acquire() {
+    Chunk* chunk = nullptr;
+    if (queue_.try_dequeue(chunk)) return chunk;
+    return new Chunk;
+  }
+
+  void Release(Chunk* chunk) noexcept {
+    try {
+      if (queue_.size_approx() < kMaxPooledChunks && queue_.enqueue(chunk)) {
+        return;
+      }
+    } catch (const std::bad_alloc&) {
+      // fallthrough
+    }
+    delete chunk;
+  }
+
+ private:
+  moodycamel::ConcurrentQueue<Chunk*> queue_;
+};
+
+template <typename Chunk>
+ChunkPool<Chunk>& GetChunkPool() {
+  static ChunkPool<Chunk> pool;
+  return pool;
+}
+
+}  // namespace
+
+void BodyChain::ChunkDeleter::operator()(Chunk* chunk) const noexcept {
+  chunk->size = 0;
+  GetChunkPool<Chunk>().Release(chunk);
+}
+
+BodyChain::BodyChain(const BodyChain& other) {
+  contiguous_.reserve(other.size_);
+  for (const auto buffer : other.GetBuffers()) contiguous_ += buffer;
+  size_ = other.size_;
+}
+
+BodyChain::BodyChain(BodyChain&& other) noexcept
+    : contiguous_(std::move(other.contiguous_)),
+      chunks_(std::move(other.chunks_)),
+      size_(std::exchange(other.size_, 0)),
+      joined_(other.joined_.exchange(nullptr)) {
+  other.Clear();
+}
+
+BodyChain& BodyChain::operator=(BodyChain&& other) noexcept {
+  if (this != &other) {
+    contiguous_ = std::move(other.contiguous_);
+    chunks_ = std::move(other.chunks_);
+    size_ = std::exchange(other.size_, 0);
+    DropJoined();
+    joined_ = other.joined_.exchange(nullptr);
+    other.Clear();
+  }
+  return *this;
+}
+
+BodyChain& BodyChain::operator=(const BodyChain& other) {
+  if (this != &other) *this = BodyChain{other};
+  return *this;
+}
+
+BodyChain::~BodyChain() { DropJoined(); }
+
+BodyChain::ChunkPtr BodyChain::AcquireChunk() {
+  return ChunkPtr{GetChunkPool<Chunk>().Acquire()};
+}
+
+void BodyChain::Reserve(std::size_t size) {
+  if (size_ != 0 || size > kMaxReserve) return;
+  contiguous_.reserve(size);
+}
+
+void BodyChain::Append(std::string_view data) {
+  if (data.empty()) return;
+  DropJoined();
+
+  if (chunks_.empty() &&
+      contiguous_.size() + data.size() <= contiguous_.capacity()) {
+    contiguous_.append(data);
+    size_ += data.size();
+    return;
+  }
+
+  while (!data.empty()) {
+    if (chunks_.empty() || chunks_.back()->size == kChunkSize) {
+      chunks_.push_back(AcquireChunk());
+    }
+
+    auto& chunk = *chunks_.back();
+    const auto to_copy = std::min(data.size(), kChunkSize - chunk.size);
+    std::memcpy(chunk.data.data() + chunk.size, data.data(), to_copy);
+    chunk.size += to_copy;
+    size_ += to_copy;
+    data.remove_prefix(to_copy);
+  }
+}
+
+void BodyChain::Clear() noexcept {
+  DropJoined();
+  contiguous_.clear();
+  chunks_.clear();
+  size_ = 0;
+}
+
+std::vector<std::string_view> BodyChain::GetBuffers() const {
+  std::vector<std::string_view> result;
+  result.reserve(chunks_.size() + 1);
+  if (!contiguous_.empty()) result.push_back(contiguous_);
+  for (const auto& chunk : chunks_) {
+    result.emplace_back(chunk->data.data(), chunk->size);
+  }
+  return result;
+}
+
+std::string_view BodyChain::View() const {
+  if (chunks_.empty()) return contiguous_;
+  if (contiguous_.empty() && chunks_.size() == 1) {
+    return {chunks_.front()->data.data(), chunks_.front()->size};
+  }
+
+  if (const auto* joined = joined_.load(std::memory_order_acquire)) {
+    return *joined;
+  }
+
+  auto candidate = std::make_unique<std::string>();
+  candidate->reserve(size_);
+  for (const auto buffer : GetBuffers()) candidate->append(buffer);
+
+  // Concurrent readers may join the data simultaneously, only one of the
+  // copies is kept
+  std::string* expected = nullptr;
+  if (joined_.compare_exchange_strong(expected, candidate.get(),
+                                      std::memory_order_acq_rel,
+                                      std::memory_order_acquire)) {
+    return *candidate.release();
+  }
+  return *expected;
+}
+
+std::string BodyChain::Extract() {
+  std::string result;
+  if (chunks_.empty()) {
+    result = std::move(contiguous_);
+  } else if (const std::unique_ptr<std::string> joined{
+                 joined_.exchange(nullptr, std::memory_order_relaxed)}) {
+    result = std::move(*joined);
+  } else {
+    result.reserve(size_);
+    result.append(contiguous_);
+    for (const auto& chunk : chunks_) {
+      result.append(chunk->data.data(), chunk->size);
+    }
+  }
+  UASSERT(result.size() == size_);
+
+  Clear();
+  return result;
+}
+
+void BodyChain::DropJoined() noexcept {
+  delete joined_.exchange(nullptr, std::memory_order_relaxed);
+}
+
+}  // namespace clients::http::impl
+
+USERVER_NAMESPACE_END
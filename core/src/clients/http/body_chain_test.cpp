@@ -0,0 +1,172 @@
+#include <userver/clients/http/impl/body_chain.hpp>
+
+#include <userver/clients/http/client.hpp>
+#include <userver/engine/async.hpp>
+#include <userver/engine/task/task.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+#include <userver/formats/json/serialize.hpp>
+#include <userver/formats/json/value.hpp>
+#include <userver/utest/http_client.hpp>
+#include <userver/utest/simple_server.hpp>
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using clients::http::impl::BodyChain;
+using HttpResponse = utest::SimpleServer::Response;
+using HttpRequest = utest::SimpleServer::Request;
+
+constexpr auto kTimeout = std::chrono::milliseconds{1000};
+
+std::string Concat(const std::vector<std::string_view>& buffers) {
+  std::string result;
+  for (const auto buffer : buffers) result += buffer;
+  return result;
+}
+
+std::string MakeJsonArray(std::size_t min_size) {
+  std::string result = "[";
+  for (int i = 0; result.size() < min_size; ++i) {
+    result += "\"element_" + std::to_string(i) + "\",";
+  }
+  result.back() = ']';
+  return result;
+}
+
+struct JsonCallback {
+  std::string json;
+  bool with_content_length;
+
+  HttpResponse operator()(const HttpRequest&) const {
+    std::string response = "HTTP/1.1 200 OK\r\nConnection: close\r\n";
+    if (with_content_length) {
+      response += "Content-Length: " + std::to_string(json.size()) + "\r\n";
+    }
+    return {response + "\r\n" + json, HttpResponse::kWriteAndClose};
+  }
+};
+
+}  // namespace
+
+TEST(HttpBodyChain, Chunks) {
+  const std::string data(BodyChain::kChunkSize * 2 + 100, '@');
+
+  BodyChain chain;
+  EXPECT_TRUE(chain.IsEmpty());
+  chain.Append(std::string_view{data}.substr(0, 10));
+  chain.Append(std::string_view{data}.substr(10));
+  EXPECT_EQ(chain.Size(), data.size());
+  EXPECT_GE(chain.GetBuffers().size(), 3);
+  EXPECT_EQ(Concat(chain.GetBuffers()), data);
+
+  const BodyChain copy{chain};
+  EXPECT_EQ(Concat(copy.GetBuffers()), data);
+
+  EXPECT_EQ(chain.Extract(), data);
+  EXPECT_TRUE(chain.IsEmpty());
+  EXPECT_TRUE(chain.GetBuffers().empty());
+
+  BodyChain moved{std::move(chain)};
+  EXPECT_TRUE(moved.IsEmpty());
+}
+
+TEST(HttpBodyChain, Reserve) {
+  const std::string data(BodyChain::kChunkSize * 3, '#');
+
+  BodyChain chain;
+  chain.Reserve(data.size());
+  for (std::size_t pos = 0; pos < data.size(); pos += 1000) {
+    chain.Append(std::string_view{data}.substr(pos, 1000));
+  }
+  EXPECT_EQ(chain.GetBuffers().size(), 1);
+
+  const auto* buffer_data = chain.GetBuffers().front().data();
+  const auto extracted = chain.Extract();
+  EXPECT_EQ(extracted, data);
+  EXPECT_EQ(extracted.data(), buffer_data);
+}
+
+TEST(HttpBodyChain, View) {
+  const std::string data(BodyChain::kChunkSize * 2 + 100, '$');
+
+  BodyChain presized;
+  presized.Reserve(data.size());
+  presized.Append(data);
+  EXPECT_EQ(presized.View().data(), presized.GetBuffers().front().data());
+
+  BodyChain chain;
+  chain.Append(data);
+  const auto view = chain.View();
+  EXPECT_EQ(view, data);
+  EXPECT_EQ(chain.View().data(), view.data());
+  EXPECT_GE(chain.GetBuffers().size(), 3);
+
+  EXPECT_EQ(chain.Extract(), data);
+  EXPECT_TRUE(chain.View().empty());
+}
+
+UTEST_MT(HttpBodyChain, ConcurrentView, 4) {
+  const std::string data(BodyChain::kChunkSize * 3, '%');
+  BodyChain chain;
+  chain.Append(data);
+
+  std::vector<engine::TaskWithResult<std::string_view>> tasks;
+  for (std::size_t i = 0; i < GetThreadCount(); ++i) {
+    tasks.push_back(engine::AsyncNoSpan([&chain] { return chain.View(); }));
+  }
+  for (auto& task : tasks) {
+    const auto view = task.Get();
+    EXPECT_EQ(view, data);
+    EXPECT_EQ(view.data(), chain.View().data());
+  }
+}
+
+TEST(HttpBodyChain, ReserveOverflow) {
+  BodyChain chain;
+  chain.Reserve(5);
+  chain.Append("12345");
+  chain.Append("67890");
+  EXPECT_EQ(chain.Extract(), "1234567890");
+
+  chain.Append("abc");
+  chain.Reserve(1000);  // ignored, already has data
+  chain.Clear();
+  chain.Reserve(BodyChain::kMaxReserve + 1);  // ignored, too big
+  chain.Append("abc");
+  EXPECT_EQ(Concat(chain.GetBuffers()), "abc");
+}
+
+UTEST(HttpBodyChain, ResponseJson) {
+  const auto json = MakeJsonArray(BodyChain::kChunkSize * 4);
+  const auto expected = formats::json::FromString(json);
+
+  for (const bool with_content_length : {true, false}) {
+    const utest::SimpleServer http_server{
+        JsonCallback{json, with_content_length}};
+    auto http_client_ptr = utest::CreateHttpClient();
+
+    const auto response = http_client_ptr->CreateRequest()
+                              ->get(http_server.GetBaseUrl())
+                              ->timeout(kTimeout)
+                              ->perform();
+    ASSERT_EQ(response->status_code(), clients::http::Status::OK);
+    if (with_content_length) {
+      EXPECT_EQ(response->GetBodyBuffers().size(), 1);
+    } else {
+      EXPECT_GT(response->GetBodyBuffers().size(), 1);
+    }
+    EXPECT_EQ(Concat(response->GetBodyBuffers()), json);
+    EXPECT_EQ(response->GetBodyAsJson(), expected);
+
+    // The received buffers are kept after the body is concatenated
+    const auto buffers_count = response->GetBodyBuffers().size();
+    EXPECT_EQ(response->body_view(), json);
+    EXPECT_EQ(response->body_view().data(), response->body_view().data());
+    EXPECT_EQ(response->GetBodyBuffers().size(), buffers_count);
+    EXPECT_EQ(response->GetBodyAsJson(), expected);
+  }
+}
+
+USERVER_NAMESPACE_END
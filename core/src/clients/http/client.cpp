@@ -1,5 +1,6 @@
 #include <userver/clients/http/client.hpp>
 
+#include <algorithm>
 #include <chrono>
 #include <cstdlib>
 #include <limits>
@@ -11,6 +12,7 @@
 #include <userver/utils/async.hpp>
 
 #include <clients/http/easy_wrapper.hpp>
+#include <clients/http/response_cache.hpp>
 #include <clients/http/testsuite.hpp>
 #include <crypto/openssl.hpp>
 #include <curl-ev/multi.hpp>
@@ -42,6 +44,23 @@ ClientSettings Parse(const yaml_config::YamlConfig& value,
       value["thread-name-prefix"].As<std::string>(settings.thread_name_prefix);
   settings.io_threads = value["threads"].As<size_t>(settings.io_threads);
   settings.defer_events = value["defer-events"].As<bool>(settings.defer_events);
+  settings.response_cache_max_bytes =
+      value["response-cache-max-bytes"].As<size_t>(
+          settings.response_cache_max_bytes);
+  settings.response_cache_max_entries =
+      value["response-cache-max-entries"].As<size_t>(
+          settings.response_cache_max_entries);
+  settings.prewarm_destinations =
+      value["prewarm-destinations"].As<std::vector<std::string>>({});
+  settings.prewarm_connections_per_thread =
+      value["prewarm-connections-per-thread"].As<size_t>(
+          settings.prewarm_connections_per_thread);
+  settings.prewarm_timeout =
+      value["prewarm-timeout"].As<std::chrono::milliseconds>(
+          settings.prewarm_timeout);
+  settings.prewarm_interval =
+      value["prewarm-interval"].As<std::chrono::milliseconds>(
+          settings.prewarm_interval);
 
   return settings;
 }
@@ -54,7 +73,11 @@ Client::Client(ClientSettings settings,
       fs_task_processor_(fs_task_processor),
       user_agent_(utils::GetUserverIdentifier()),
       proxy_(),
-      connect_rate_limiter_(std::make_shared<curl::ConnectRateLimiter>()) {
+      connect_rate_limiter_(std::make_shared<curl::ConnectRateLimiter>()),
+      prewarm_destinations_(std::move(settings.prewarm_destinations)),
+      prewarm_connections_per_thread_(settings.prewarm_connections_per_thread),
+      prewarm_timeout_(settings.prewarm_timeout),
+      prewarm_interval_(settings.prewarm_interval) {
   const auto io_threads = settings.io_threads;
   const auto& thread_name_prefix = settings.thread_name_prefix;
 
@@ -66,6 +89,11 @@ Client::Client(ClientSettings settings,
   ev_config.defer_events = settings.defer_events;
   thread_pool_ = std::make_unique<engine::ev::ThreadPool>(std::move(ev_config));
 
+  if (settings.response_cache_max_bytes > 0) {
+    response_cache_ = std::make_shared<ResponseCache>(
+        settings.response_cache_max_bytes, settings.response_cache_max_entries);
+  }
+
   ReinitEasy();
 
   multis_.reserve(io_threads);
@@ -77,6 +105,7 @@ Client::Client(ClientSettings settings,
     for (auto* thread_control_ptr : thread_pool_->NextThreads(io_threads)) {
       multis_.push_back(std::make_unique<curl::multi>(*thread_control_ptr,
                                                       connect_rate_limiter_));
+      multis_.back()->SetTrackedUrls(prewarm_destinations_);
     }
   }).Get();
 
@@ -90,6 +119,7 @@ Client::Client(ClientSettings settings,
 }
 
 Client::~Client() {
+  prewarm_task_.Stop();
   easy_reinit_task_.Stop();
 
   // We have to destroy *this only when all the requests are finished, because
@@ -120,45 +150,155 @@ std::shared_ptr<Request> Client::CreateRequest() {
   if (easy) {
     auto idx = FindMultiIndex(easy->GetMulti());
     auto wrapper = std::make_shared<impl::EasyWrapper>(std::move(easy), *this);
-    request = std::make_shared<Request>(std::move(wrapper),
-                                        statistics_[idx].CreateRequestStats(),
-                                        destination_statistics_, resolver_);
+    request = std::make_shared<Request>(
+        std::move(wrapper), statistics_[idx].CreateRequestStats(),
+        destination_statistics_, resolver_, response_cache_);
+    SetupRequest(*request);
   } else {
     thread_local unsigned int rand_state = 0;
-    auto i = rand_r(&rand_state) % multis_.size();
-    auto& multi = multis_[i];
+    request = CreateRequestForMulti(rand_r(&rand_state) % multis_.size());
+  }
 
-    try {
-      request = engine::AsyncNoSpan(fs_task_processor_, [this, &multi, &i] {
-                  // GetBound() calls blocking Curl_resolver_init()
-                  auto wrapper = std::make_shared<impl::EasyWrapper>(
-                      easy_.Get()->GetBoundBlocking(*multi), *this);
-                  return std::make_shared<Request>(
-                      std::move(wrapper), statistics_[i].CreateRequestStats(),
-                      destination_statistics_, resolver_);
-                }).Get();
-    } catch (engine::WaitInterruptedException&) {
-      throw clients::http::CancelException();
-    }
+  return request;
+}
+
+std::shared_ptr<Request> Client::CreateRequestForMulti(size_t multi_index) {
+  UASSERT(multi_index < multis_.size());
+  auto& multi = multis_[multi_index];
+
+  std::shared_ptr<Request> request;
+  try {
+    request =
+        engine::AsyncNoSpan(fs_task_processor_, [this, &multi, multi_index] {
+          // GetBound() calls blocking Curl_resolver_init()
+          auto wrapper = std::make_shared<impl::EasyWrapper>(
+              easy_.Get()->GetBoundBlocking(*multi), *this);
+          return std::make_shared<Request>(
+              std::move(wrapper), statistics_[multi_index].CreateRequestStats(),
+              destination_statistics_, resolver_, response_cache_);
+        }).Get();
+  } catch (engine::WaitInterruptedException&) {
+    throw clients::http::CancelException();
   }
 
+  SetupRequest(*request);
+  return request;
+}
+
+void Client::SetupRequest(Request& request) {
   if (testsuite_config_) {
-    request->SetTestsuiteConfig(testsuite_config_);
+    request.SetTestsuiteConfig(testsuite_config_);
   }
 
   if (user_agent_) {
-    request->user_agent(*user_agent_);
+    request.user_agent(*user_agent_);
   }
 
   {
     // Even if proxy is an empty string we should set it, because empty proxy
     // for CURL disables the use of *_proxy env variables.
     auto proxy_value = proxy_.Read();
-    request->proxy(*proxy_value);
+    request.proxy(*proxy_value);
   }
-  request->SetEnforceTaskDeadline(enforce_task_deadline_.ReadCopy());
+  request.SetEnforceTaskDeadline(enforce_task_deadline_.ReadCopy());
+}
 
-  return request;
+void Client::Prewarm() {
+  if (prewarm_destinations_.empty()) return;
+
+  SendPrewarmRequests(std::vector<std::vector<size_t>>(
+      prewarm_destinations_.size(),
+      std::vector<size_t>(multis_.size(), prewarm_connections_per_thread_)));
+
+  if (prewarm_interval_ > std::chrono::milliseconds::zero() &&
+      !prewarm_task_.IsRunning()) {
+    prewarm_task_.Start("http_prewarm_top_up",
+                        utils::PeriodicTask::Settings(prewarm_interval_),
+                        [this] { TopUpPrewarmedConnections(); });
+  }
+}
+
+void Client::TopUpPrewarmedConnections() {
+  // Every thread counts its open connections to each of the destinations.
+  // In-flight connections are counted too, as they return to the pool once
+  // the request is done.
+  std::vector<std::vector<size_t>> connections(
+      prewarm_destinations_.size(), std::vector<size_t>(multis_.size(), 0));
+  bool has_deficit = false;
+  for (size_t d = 0; d < prewarm_destinations_.size(); ++d) {
+    for (size_t i = 0; i < multis_.size(); ++i) {
+      const auto open = multis_[i]->GetTrackedSocketsCount(d);
+      if (open >= prewarm_connections_per_thread_) continue;
+
+      connections[d][i] = prewarm_connections_per_thread_ - open;
+      has_deficit = true;
+    }
+  }
+
+  if (has_deficit) SendPrewarmRequests(connections);
+}
+
+void Client::SendPrewarmRequests(
+    const std::vector<std::vector<size_t>>& connections) {
+  UASSERT(connections.size() == prewarm_destinations_.size());
+  const auto start = std::chrono::steady_clock::now();
+
+  // Concurrent requests from the same thread do not reuse each other's
+  // connections, so each of them establishes a new one
+  std::vector<ResponseFuture> futures;
+  for (size_t d = 0; d < prewarm_destinations_.size(); ++d) {
+    const auto& url = prewarm_destinations_[d];
+    UASSERT(connections[d].size() == multis_.size());
+    for (size_t i = 0; i < multis_.size(); ++i) {
+      for (size_t j = 0; j < connections[d][i]; ++j) {
+        ++prewarm_attempts_;
+        try {
+          futures.push_back(CreateRequestForMulti(i)
+                                ->head(url)
+                                ->timeout(prewarm_timeout_.count())
+                                ->retry(1)
+                                ->async_perform());
+        } catch (const CancelException&) {
+          throw;
+        } catch (const std::exception& e) {
+          ++prewarm_failures_;
+          LOG_WARNING() << "Failed to start prewarm request to " << url << ": "
+                        << e;
+        }
+      }
+    }
+  }
+
+  size_t failures = 0;
+  for (auto& future : futures) {
+    try {
+      future.Get();
+      ++prewarm_established_;
+    } catch (const CancelException&) {
+      throw;
+    } catch (const std::exception& e) {
+      ++prewarm_failures_;
+      ++failures;
+      LOG_DEBUG() << "Prewarm request failed: " << e;
+    }
+  }
+
+  const auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::steady_clock::now() - start);
+  prewarm_last_duration_ = duration;
+  LOG_INFO() << "Prewarmed HTTP connections in " << duration.count()
+             << "ms, failed requests: " << failures << "/" << futures.size();
+}
+
+std::optional<PrewarmStatistics> Client::GetPrewarmStatistics() const {
+  if (prewarm_destinations_.empty()) return std::nullopt;
+
+  PrewarmStatistics stats;
+  stats.attempts = prewarm_attempts_.load();
+  stats.established = prewarm_established_.load();
+  stats.failures = prewarm_failures_.load();
+  stats.last_duration = prewarm_last_duration_.load();
+  return stats;
 }
 
 void Client::SetMultiplexingEnabled(bool enabled) {
@@ -226,6 +366,12 @@ const DestinationStatistics& Client::GetDestinationStatistics() const {
   return *destination_statistics_;
 }
 
+std::optional<ResponseCacheStatistics> Client::GetResponseCacheStatistics()
+    const {
+  if (!response_cache_) return std::nullopt;
+  return response_cache_->GetStatistics();
+}
+
 void Client::PushIdleEasy(std::shared_ptr<curl::easy>&& easy) noexcept {
   try {
     easy->reset();
@@ -0,0 +1,139 @@
+#include <userver/clients/http/client.hpp>
+
+#include <atomic>
+#include <vector>
+
+#include <userver/engine/sleep.hpp>
+#include <userver/engine/task/task.hpp>
+#include <userver/utest/simple_server.hpp>
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using HttpResponse = utest::SimpleServer::Response;
+using HttpRequest = utest::SimpleServer::Request;
+
+constexpr size_t kIoThreads = 2;
+
+struct HeadCounter {
+  std::shared_ptr<std::atomic<int>> heads =
+      std::make_shared<std::atomic<int>>(0);
+  bool keep_alive{false};
+
+  HttpResponse operator()(const HttpRequest& request) const {
+    if (request.rfind("HEAD ", 0) == 0) ++*heads;
+    if (keep_alive) {
+      return {"HTTP/1.1 200 OK\r\nContent-Length: 0\r\n\r\n",
+              HttpResponse::kWriteAndContinue};
+    }
+    return {"HTTP/1.1 200 OK\r\nConnection: close\r\nContent-Length: 0\r\n\r\n",
+            HttpResponse::kWriteAndClose};
+  }
+};
+
+std::shared_ptr<clients::http::Client> CreatePrewarmingClient(
+    std::vector<std::string> destinations,
+    std::chrono::milliseconds interval = std::chrono::milliseconds::zero()) {
+  clients::http::ClientSettings settings;
+  settings.io_threads = kIoThreads;
+  settings.prewarm_destinations = std::move(destinations);
+  settings.prewarm_connections_per_thread = 2;
+  settings.prewarm_interval = interval;
+  return std::make_shared<clients::http::Client>(
+      settings, engine::current_task::GetTaskProcessor());
+}
+
+}  // namespace
+
+UTEST(HttpClientPrewarm, Destinations) {
+  const HeadCounter callback;
+  const utest::SimpleServer http_server{callback};
+  auto client = CreatePrewarmingClient({http_server.GetBaseUrl()});
+
+  client->Prewarm();
+  EXPECT_EQ(*callback.heads, kIoThreads * 2);
+
+  const auto stats = client->GetPrewarmStatistics();
+  ASSERT_TRUE(stats);
+  EXPECT_EQ(stats->attempts, kIoThreads * 2);
+  EXPECT_EQ(stats->established, kIoThreads * 2);
+  EXPECT_EQ(stats->failures, 0);
+}
+
+UTEST(HttpClientPrewarm, TopUpSkipsWarmThreads) {
+  constexpr std::chrono::milliseconds kInterval{20};
+  const HeadCounter callback{std::make_shared<std::atomic<int>>(0), true};
+  const utest::SimpleServer http_server{callback};
+  auto client = CreatePrewarmingClient({http_server.GetBaseUrl()}, kInterval);
+
+  client->Prewarm();
+  EXPECT_EQ(*callback.heads, kIoThreads * 2);
+
+  // Connections are kept alive, so the top-up sends nothing
+  engine::SleepFor(kInterval * 5);
+  EXPECT_EQ(*callback.heads, kIoThreads * 2);
+}
+
+UTEST(HttpClientPrewarm, TopUpClosedConnections) {
+  constexpr std::chrono::milliseconds kInterval{20};
+  const HeadCounter callback;
+  const utest::SimpleServer http_server{callback};
+  auto client = CreatePrewarmingClient({http_server.GetBaseUrl()}, kInterval);
+
+  client->Prewarm();
+  EXPECT_EQ(*callback.heads, kIoThreads * 2);
+
+  // The server closes the connections, they are re-established
+  while (*callback.heads <= static_cast<int>(kIoThreads * 2)) {
+    engine::SleepFor(kInterval);
+  }
+}
+
+UTEST(HttpClientPrewarm, TopUpIgnoresOtherHosts) {
+  constexpr std::chrono::milliseconds kInterval{20};
+  const HeadCounter callback;
+  const utest::SimpleServer http_server{callback};
+  const HeadCounter other_callback{std::make_shared<std::atomic<int>>(0), true};
+  const utest::SimpleServer other_server{other_callback};
+  auto client = CreatePrewarmingClient({http_server.GetBaseUrl()}, kInterval);
+
+  // Keep-alive connections to another host in every thread
+  std::vector<clients::http::ResponseFuture> futures;
+  for (size_t i = 0; i < kIoThreads * 8; ++i) {
+    futures.push_back(client->CreateRequest()
+                          ->get(other_server.GetBaseUrl())
+                          ->timeout(1000)
+                          ->async_perform());
+  }
+  for (auto& future : futures) future.Get();
+
+  client->Prewarm();
+  EXPECT_EQ(*callback.heads, kIoThreads * 2);
+
+  // The server closes the prewarmed connections, they are re-established
+  // despite the open connections to the other host
+  while (*callback.heads <= static_cast<int>(kIoThreads * 2)) {
+    engine::SleepFor(kInterval);
+  }
+}
+
+UTEST(HttpClientPrewarm, Unreachable) {
+  // Nothing listens on the port 1
+  auto client = CreatePrewarmingClient({"http://127.0.0.1:1/"});
+
+  client->Prewarm();
+  const auto stats = client->GetPrewarmStatistics();
+  ASSERT_TRUE(stats);
+  EXPECT_EQ(stats->established, 0);
+  EXPECT_EQ(stats->failures, kIoThreads * 2);
+}
+
+UTEST(HttpClientPrewarm, Disabled) {
+  auto client = CreatePrewarmingClient({});
+  client->Prewarm();
+  EXPECT_FALSE(client->GetPrewarmStatistics());
+}
+
+USERVER_NAMESPACE_END
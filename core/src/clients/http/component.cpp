@@ -66,6 +66,9 @@ HttpClient::HttpClient(const ComponentConfig& component_config,
       component_config["bootstrap-http-proxy"].As<std::string>({});
   http_client_.SetConfig(bootstrap_config);
 
+  // Connections are established before the service starts accepting requests
+  http_client_.Prewarm();
+
   auto& config_component = context.FindComponent<components::DynamicConfig>();
   subscriber_scope_ =
       components::DynamicConfig::NoblockSubscriber{config_component}
@@ -108,6 +111,17 @@ formats::json::Value HttpClient::ExtendStatistics() {
   utils::statistics::SolomonChildrenAreLabelValues(json["destinations"],
                                                    "http_destination");
   utils::statistics::SolomonSkip(json["destinations"]);
+
+  const auto response_cache_stats = http_client_.GetResponseCacheStatistics();
+  if (response_cache_stats) {
+    json["response-cache"] =
+        clients::http::ResponseCacheStatisticsToJson(*response_cache_stats);
+  }
+
+  const auto prewarm_stats = http_client_.GetPrewarmStatistics();
+  if (prewarm_stats) {
+    json["prewarm"] = clients::http::PrewarmStatisticsToJson(*prewarm_stats);
+  }
   return json.ExtractValue();
 }
 
@@ -161,6 +175,32 @@ properties:
         items:
             type: string
             description: URL prefix
+    response-cache-max-bytes:
+        type: integer
+        description: max total size of the in-process cache of GET responses that honours Cache-Control, ETag and Last-Modified; 0 disables the cache
+        defaultDescription: 0
+    response-cache-max-entries:
+        type: integer
+        description: max number of responses in the in-process response cache
+        defaultDescription: 10000
+    prewarm-destinations:
+        type: array
+        description: URLs to send HEAD requests to at start to establish connections to the upstreams in advance
+        items:
+            type: string
+            description: URL
+    prewarm-connections-per-thread:
+        type: integer
+        description: number of connections to establish to each of the prewarm-destinations from each of the threads
+        defaultDescription: 1
+    prewarm-timeout:
+        type: string
+        description: timeout of a prewarm request
+        defaultDescription: 1s
+    prewarm-interval:
+        type: string
+        description: period of the check that re-establishes connections for the threads that have fewer open connections to a destination than were prewarmed, 0 to prewarm only at start; DNS changes do not trigger prewarming
+        defaultDescription: 0
     dns_resolver:
         type: string
         description: server hostname resolver type (getaddrinfo or async)
@@ -20,6 +20,7 @@
 #include <userver/http/url.hpp>
 #include <userver/tracing/span.hpp>
 #include <userver/tracing/tags.hpp>
+#include <userver/utils/assert.hpp>
 #include <userver/utils/str_icase.hpp>
 #include <utils/impl/assert_extra.hpp>
 
@@ -174,9 +175,11 @@ ProxyAuthType ProxyAuthTypeFromString(const std::string& auth_name) {
 Request::Request(std::shared_ptr<impl::EasyWrapper>&& wrapper,
                  std::shared_ptr<RequestStats>&& req_stats,
                  const std::shared_ptr<DestinationStatistics>& dest_stats,
-                 clients::dns::Resolver* resolver)
+                 clients::dns::Resolver* resolver,
+                 std::shared_ptr<ResponseCache> response_cache)
     : pimpl_(std::make_shared<RequestState>(
-          std::move(wrapper), std::move(req_stats), dest_stats, resolver)) {
+          std::move(wrapper), std::move(req_stats), dest_stats, resolver,
+          std::move(response_cache))) {
   LOG_DEBUG() << "Request::Request()";
   // default behavior follow redirects and verify ssl
   pimpl_->follow_redirects(true);
@@ -197,6 +200,24 @@ ResponseFuture Request::async_perform() {
 
 std::shared_ptr<Response> Request::perform() { return async_perform().Get(); }
 
+StreamedResponse Request::async_perform_stream_body(
+    std::size_t max_queued_chunks) {
+  UINVARIANT(max_queued_chunks > 0, "Streamed body queue must not be empty");
+
+  auto queue = StreamedBodyQueue::Create(max_queued_chunks);
+  engine::Promise<std::shared_ptr<Response>> headers_promise;
+  auto headers_future = headers_promise.get_future();
+
+  auto future = pimpl_->async_perform_stream_body(queue->GetProducer(),
+                                                  std::move(headers_promise));
+  return StreamedResponse(
+      ResponseFuture(std::move(future),
+                     std::chrono::milliseconds(complete_timeout(
+                         pimpl_->timeout(), /*retries*/ 1)),
+                     pimpl_),
+      std::move(headers_future), queue->GetConsumer(), pimpl_);
+}
+
 std::shared_ptr<Request> Request::url(const std::string& url) {
   std::error_code ec;
   pimpl_->easy().set_url(url, ec);
@@ -316,6 +337,7 @@ std::shared_ptr<Request> Request::cookies(const Cookies& cookies) {
 }
 
 std::shared_ptr<Request> Request::method(HttpMethod method) {
+  pimpl_->SetCacheableMethod(method == HttpMethod::kGet);
   switch (method) {
     case HttpMethod::kDelete:
     case HttpMethod::kOptions:
@@ -414,6 +436,11 @@ std::shared_ptr<Request> Request::DisableReplyDecoding() {
   return shared_from_this();
 }
 
+std::shared_ptr<Request> Request::DisableResponseCache() {
+  pimpl_->DisableResponseCache();
+  return shared_from_this();
+}
+
 std::shared_ptr<Request> Request::EnableAddClientTimeoutHeader() {
   pimpl_->EnableAddClientTimeoutHeader();
   return shared_from_this();
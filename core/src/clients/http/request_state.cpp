@@ -1,6 +1,7 @@
 #include <clients/http/request_state.hpp>
 
 #include <algorithm>
+#include <charconv>
 #include <chrono>
 #include <map>
 #include <string_view>
@@ -40,6 +41,15 @@ constexpr Status kFakeHttpErrorCode{599};
 
 const std::string kTracingClientName = "external";
 
+constexpr std::string_view kIfNoneMatch = "If-None-Match";
+constexpr std::string_view kIfModifiedSince = "If-Modified-Since";
+constexpr std::string_view kAuthorization = "Authorization";
+constexpr std::string_view kAcceptEncoding = "Accept-Encoding";
+constexpr std::string_view kLocation = "Location";
+constexpr Status kNotModified{304};
+
+constexpr std::string_view kContentLength = "Content-Length";
+
 const std::map<std::string, std::error_code> kTestsuiteActions = {
     {"timeout", {curl::errc::EasyErrorCode::kOperationTimedout}},
     {"network", {curl::errc::EasyErrorCode::kCouldNotConnect}}};
@@ -100,7 +110,8 @@ RequestState::RequestState(
     std::shared_ptr<impl::EasyWrapper>&& wrapper,
     std::shared_ptr<RequestStats>&& req_stats,
     const std::shared_ptr<DestinationStatistics>& dest_stats,
-    clients::dns::Resolver* resolver)
+    clients::dns::Resolver* resolver,
+    std::shared_ptr<ResponseCache> response_cache)
     : easy_(std::move(wrapper)),
       stats_(std::move(req_stats)),
       dest_stats_(dest_stats),
@@ -109,7 +120,8 @@ RequestState::RequestState(
       deadline_(GetTaskDeadline()),
       is_cancelled_(false),
       errorbuffer_(),
-      resolver_{resolver} {
+      resolver_{resolver},
+      response_cache_(std::move(response_cache)) {
   // Libcurl calls sigaction(2)  way too frequently unless this option is used.
   easy().set_no_signal(true);
   easy().set_error_buffer(errorbuffer_.data());
@@ -129,6 +141,7 @@ RequestState::~RequestState() {
 }
 
 void RequestState::follow_redirects(bool follow) {
+  follow_redirects_ = follow;
   easy().set_follow_location(follow);
   easy().set_post_redir(static_cast<long>(follow));
   if (follow) easy().set_max_redirs(kMaxRedirectCount);
@@ -242,6 +255,8 @@ void RequestState::SetTestsuiteConfig(
 
 void RequestState::DisableReplyDecoding() {
   easy().set_accept_encoding(nullptr);
+  // The cached bodies are decoded, the raw ones must not be mixed with them
+  reply_decoding_disabled_ = true;
 }
 
 void RequestState::EnableAddClientTimeoutHeader() {
@@ -310,6 +325,10 @@ void RequestState::on_completed(
   auto& span = holder->span_storage_->Get();
   auto& easy = holder->easy();
   LOG_TRACE() << "Request::RequestImpl::on_completed(1)" << span;
+
+  // Signals the end of the body to the StreamedResponse
+  holder->stream_producer_.reset();
+
   const auto status_code = static_cast<Status>(easy.get_response_code());
 
   if (holder->testsuite_config_ && !err) {
@@ -347,8 +366,12 @@ void RequestState::on_completed(
     holder->promise_.set_exception(PrepareException(
         err, easy.get_effective_url(), easy.get_local_stats()));
   } else {
-    span.AddTag(tracing::kHttpStatusCode, status_code);
-    holder->response()->SetStatusCode(status_code);
+    const auto result_status_code = holder->UpdateResponseCache(status_code);
+    span.AddTag(tracing::kHttpStatusCode, result_status_code);
+    // For streamed bodies the status code is set before the first chunk
+    if (!holder->stream_headers_sent_) {
+      holder->response()->SetStatusCode(result_status_code);
+    }
     holder->response()->SetStats(easy.get_local_stats());
 
     if (!holder->response()->IsOk()) span.AddTag(tracing::kErrorFlag, true);
@@ -435,10 +458,17 @@ void RequestState::on_retry_timer(std::error_code err) {
 }
 
 void RequestState::parse_header(char* ptr, size_t size) {
+  // Headers are already passed to the StreamedResponse, trailers are ignored
+  if (stream_headers_sent_) return;
+
   /* It is a fast path in curl's thread (io thread).  Creation of tmp
    * std::string, boost::trim_right_if(), etc. is too expensive. */
   auto* end = rfind_not_space(ptr, size);
-  if (ptr == end) return;
+  if (ptr == end) {
+    // Empty line ends the headers of a response
+    if (stream_headers_promise_) OnStreamHeadersEnd();
+    return;
+  }
   *end = '\0';
 
   const char* col_pos = static_cast<const char*>(memchr(ptr, ':', size));
@@ -465,6 +495,13 @@ void RequestState::parse_header(char* ptr, size_t size) {
   }
 
   std::string value(col_pos, end - col_pos);
+  if (key.size() == kContentLength.size() &&
+      utils::StrIcaseEqual{}(key, kContentLength)) {
+    std::size_t content_length = 0;
+    const auto [ptr_end, ec] = std::from_chars(
+        value.data(), value.data() + value.size(), content_length);
+    if (ec == std::errc{}) response_->sink_chain().Reserve(content_length);
+  }
   response_->headers().emplace(std::move(key), std::move(value));
 }
 
@@ -474,6 +511,8 @@ engine::Future<std::shared_ptr<Response>> RequestState::async_perform() {
   StartNewSpan();
 
   auto future = StartNewPromise();
+  if (TryRespondFromCache()) return future;
+
   ApplyTestsuiteConfig();
   StartStats();
 
@@ -491,11 +530,91 @@ engine::Future<std::shared_ptr<Response>> RequestState::async_perform() {
   return future;
 }
 
+engine::Future<std::shared_ptr<Response>>
+RequestState::async_perform_stream_body(
+    StreamedBodyQueue::Producer&& producer,
+    engine::Promise<std::shared_ptr<Response>>&& headers_promise) {
+  StartNewSpan();
+
+  auto future = StartNewPromise();
+  stream_producer_.emplace(std::move(producer));
+  stream_headers_promise_.emplace(std::move(headers_promise));
+  easy().set_write_callback(
+      [this](std::string_view data) { return OnStreamData(data); });
+
+  // Streamed bodies are neither cached nor served from cache
+  response_cache_.reset();
+
+  ApplyTestsuiteConfig();
+  StartStats();
+
+  // Already consumed chunks could not be received again, so the request is
+  // never retried
+  perform_request([holder = shared_from_this()](std::error_code err) mutable {
+    RequestState::on_completed(std::move(holder), err);
+  });
+
+  return future;
+}
+
+void RequestState::OnStreamChunkConsumed() {
+  if (!stream_paused_.exchange(false)) return;
+
+  easy().GetThreadControl().RunInEvLoopAsync(
+      [holder = shared_from_this()] { holder->easy().unpause(); });
+}
+
+std::size_t RequestState::OnStreamData(std::string_view data) {
+  UASSERT(stream_producer_);
+  UASSERT(stream_headers_promise_);
+
+  // Headers are normally sent on the empty line that ends them
+  if (!stream_headers_sent_) SendStreamHeaders();
+
+  std::string chunk{data};
+  if (stream_producer_->PushNoblock(std::move(chunk))) return data.size();
+
+  // The consumer might have popped a chunk before noticing the flag, so
+  // retrying after setting it
+  stream_paused_ = true;
+  if (stream_producer_->PushNoblock(std::move(chunk))) {
+    stream_paused_ = false;
+    return data.size();
+  }
+
+  LOG_TRACE() << "Streamed body queue is full, pausing the transfer";
+  return CURL_WRITEFUNC_PAUSE;
+}
+
+void RequestState::OnStreamHeadersEnd() {
+  const auto status_code = easy().get_response_code();
+
+  // Headers of the informational and of the followed redirect responses are
+  // not the headers of the final response
+  if (status_code >= 100 && status_code < 200) return;
+  if (follow_redirects_ && status_code >= 300 && status_code < 400 &&
+      response_->headers().count(std::string{kLocation})) {
+    return;
+  }
+
+  SendStreamHeaders();
+}
+
+void RequestState::SendStreamHeaders() {
+  UASSERT(stream_headers_promise_);
+  UASSERT(!stream_headers_sent_);
+
+  response_->SetStatusCode(static_cast<Status>(easy().get_response_code()));
+  stream_headers_sent_ = true;
+  stream_headers_promise_->set_value(response_);
+}
+
 void RequestState::perform_request(curl::easy::handler_type handler) {
   UASSERT_MSG(!cert_ || pkey_,
               "Setting certificate is useless without setting private key");
 
   UASSERT(response_);
+  response_->sink_chain().Clear();
   response_->sink_string().clear();
   response_->headers().clear();
 
@@ -567,7 +686,12 @@ engine::Future<std::shared_ptr<Response>> RequestState::StartNewPromise() {
   promise_ = {};
 
   response_ = std::make_shared<Response>();
-  easy().set_sink(&(response_->sink_string()));  // set place for response body
+  easy().set_sink(&(response_->sink_chain()));  // set place for response body
+
+  stream_producer_.reset();
+  stream_headers_promise_.reset();
+  stream_headers_sent_ = false;
+  stream_paused_ = false;
 
   is_cancelled_ = false;
   retry_.current = 1;
@@ -612,6 +736,8 @@ void RequestState::StartNewSpan() {
                     span.GetSpanId());
   easy().add_header(USERVER_NAMESPACE::http::headers::kXYaTraceId,
                     span.GetTraceId());
+  easy().add_header(USERVER_NAMESPACE::http::headers::kXYaTraceSampled,
+                    span.IsSampled() ? "1" : "0");
   easy().add_header(USERVER_NAMESPACE::http::headers::kXYaRequestId,
                     span.GetLink());
 
@@ -655,6 +781,98 @@ void RequestState::ResolveTargetAddress(clients::dns::Resolver& resolver) {
                      fmt::to_string(fmt::join(addrs, ",")));
 }
 
+bool RequestState::IsResponseCacheUsable() const {
+  // The cache is keyed by URL only, so it serves the requests with the default
+  // Accept-Encoding and reply decoding
+  return response_cache_ && cacheable_method_ && !easy().has_post_data() &&
+         !reply_decoding_disabled_ &&
+         !easy().FindHeaderByName(kAcceptEncoding).has_value();
+}
+
+bool RequestState::TryRespondFromCache() {
+  revalidated_entry_.reset();
+  ResetConditionalHeaders();
+  if (!IsResponseCacheUsable()) return false;
+
+  const auto has_header = [this](std::string_view name) {
+    const auto value = easy().FindHeaderByName(name);
+    return value && !value->empty();
+  };
+
+  // Conditional request of the user must reach the server and its reply
+  // must not touch the cache
+  is_user_conditional_request_ =
+      has_header(kIfNoneMatch) || has_header(kIfModifiedSince);
+  if (is_user_conditional_request_) return false;
+
+  is_authorized_request_ = has_header(kAuthorization);
+
+  auto entry = response_cache_->Find(easy().get_original_url());
+  if (entry && is_authorized_request_ && !entry->is_shared_with_authorized) {
+    entry.reset();
+  }
+  if (entry && entry->IsFresh(utils::datetime::SteadyNow())) {
+    response_cache_->AccountHit();
+    entry->FillResponse(*response_);
+
+    auto& span = span_storage_->Get();
+    span.AddTag(tracing::kHttpStatusCode, entry->status_code);
+    span_storage_.reset();
+    promise_.set_value(response_move());
+    return true;
+  }
+
+  response_cache_->AccountMiss();
+  if (!entry || !entry->HasValidators()) return false;
+
+  if (!entry->etag.empty()) {
+    easy().add_header(kIfNoneMatch, entry->etag,
+                      curl::easy::DuplicateHeaderAction::kReplace);
+  }
+  if (!entry->last_modified.empty()) {
+    easy().add_header(kIfModifiedSince, entry->last_modified,
+                      curl::easy::DuplicateHeaderAction::kReplace);
+  }
+  conditional_headers_set_ = true;
+  revalidated_entry_ = std::move(entry);
+  return false;
+}
+
+void RequestState::ResetConditionalHeaders() {
+  if (!conditional_headers_set_) return;
+
+  // Headers without a value are not sent by cURL
+  for (const auto header : {kIfNoneMatch, kIfModifiedSince}) {
+    easy().add_header(header, {}, curl::easy::EmptyHeaderAction::kDoNotSend,
+                      curl::easy::DuplicateHeaderAction::kReplace);
+  }
+  conditional_headers_set_ = false;
+}
+
+Status RequestState::UpdateResponseCache(Status status_code) {
+  if (!IsResponseCacheUsable()) return status_code;
+
+  if (revalidated_entry_ && status_code == kNotModified) {
+    const auto entry = response_cache_->Revalidate(revalidated_entry_,
+                                                   response_->headers());
+    revalidated_entry_.reset();
+    entry->FillResponse(*response_);
+    return entry->status_code;
+  }
+
+  revalidated_entry_.reset();
+  // 304 to a request that we did not make conditional says nothing about
+  // the stored entry
+  if (is_user_conditional_request_ || status_code == kNotModified) {
+    return status_code;
+  }
+
+  response_->SetStatusCode(status_code);
+  response_cache_->Store(easy().get_original_url(), *response_,
+                         is_authorized_request_);
+  return status_code;
+}
+
 }  // namespace clients::http
 
 USERVER_NAMESPACE_END
@@ -13,6 +13,7 @@
 #include <userver/clients/http/form.hpp>
 #include <userver/clients/http/response_future.hpp>
 #include <userver/clients/http/statistics.hpp>
+#include <userver/clients/http/streamed_response.hpp>
 #include <userver/crypto/certificate.hpp>
 #include <userver/crypto/private_key.hpp>
 #include <userver/engine/deadline.hpp>
@@ -24,6 +25,7 @@
 #include <userver/tracing/tags.hpp>
 
 #include <clients/http/easy_wrapper.hpp>
+#include <clients/http/response_cache.hpp>
 #include <clients/http/testsuite.hpp>
 #include <crypto/helpers.hpp>
 #include <engine/ev/watcher/timer_watcher.hpp>
@@ -37,12 +39,24 @@ class RequestState : public std::enable_shared_from_this<RequestState> {
   RequestState(std::shared_ptr<impl::EasyWrapper>&&,
                std::shared_ptr<RequestStats>&& req_stats,
                const std::shared_ptr<DestinationStatistics>& dest_stats,
-               clients::dns::Resolver* resolver);
+               clients::dns::Resolver* resolver,
+               std::shared_ptr<ResponseCache> response_cache);
   ~RequestState();
 
   /// Perform async http request
   engine::Future<std::shared_ptr<Response>> async_perform();
 
+  /// Perform async http request with the body pushed into the queue. The
+  /// response with the status and headers is passed to headers_promise
+  /// on the first received body chunk.
+  engine::Future<std::shared_ptr<Response>> async_perform_stream_body(
+      StreamedBodyQueue::Producer&& producer,
+      engine::Promise<std::shared_ptr<Response>>&& headers_promise);
+
+  /// Resumes receiving of the streamed body if it was paused due to a full
+  /// queue
+  void OnStreamChunkConsumed();
+
   std::string GetUrlForLog() const;
 
   /// set redirect flags
@@ -86,6 +100,9 @@ class RequestState : public std::enable_shared_from_this<RequestState> {
 
   void DisableReplyDecoding();
 
+  void SetCacheableMethod(bool cacheable) { cacheable_method_ = cacheable; }
+  void DisableResponseCache() { response_cache_.reset(); }
+
   void EnableAddClientTimeoutHeader();
   void DisableAddClientTimeoutHeader();
   void SetEnforceTaskDeadline(EnforceTaskDeadlineConfig enforce_task_deadline);
@@ -113,6 +130,13 @@ class RequestState : public std::enable_shared_from_this<RequestState> {
 
   /// parse one header
   void parse_header(char* ptr, size_t size);
+  /// pushes the streamed body data into the queue, pauses the transfer if
+  /// the queue is full
+  std::size_t OnStreamData(std::string_view data);
+  /// sends the headers to the StreamedResponse if they are the headers of
+  /// the final response
+  void OnStreamHeadersEnd();
+  void SendStreamHeaders();
   /// simply run perform_request if there is now errors from timer
   void on_retry_timer(std::error_code err);
   /// run curl async_request
@@ -130,6 +154,15 @@ class RequestState : public std::enable_shared_from_this<RequestState> {
 
   void ResolveTargetAddress(clients::dns::Resolver& resolver);
 
+  bool IsResponseCacheUsable() const;
+  /// fulfills the promise from the response cache if there is a fresh entry,
+  /// otherwise sets up conditional headers for revalidation
+  bool TryRespondFromCache();
+  void ResetConditionalHeaders();
+  /// stores the response or applies the `304 Not Modified` response,
+  /// returns the resulting status code
+  Status UpdateResponseCache(Status status_code);
+
   /// curl handler wrapper
   std::shared_ptr<impl::EasyWrapper> easy_;
   std::shared_ptr<RequestStats> stats_;
@@ -174,6 +207,23 @@ class RequestState : public std::enable_shared_from_this<RequestState> {
 
   clients::dns::Resolver* resolver_{nullptr};
   std::string proxy_url_;
+  bool follow_redirects_{false};
+
+  std::shared_ptr<ResponseCache> response_cache_;
+  /// stale entry that is being revalidated by the current request
+  ResponseCache::EntryPtr revalidated_entry_;
+  bool cacheable_method_{false};
+  bool reply_decoding_disabled_{false};
+  bool conditional_headers_set_{false};
+  bool is_user_conditional_request_{false};
+  bool is_authorized_request_{false};
+
+  /// streamed body state, the producer is reset on completion
+  std::optional<StreamedBodyQueue::Producer> stream_producer_;
+  std::optional<engine::Promise<std::shared_ptr<Response>>>
+      stream_headers_promise_;
+  bool stream_headers_sent_{false};
+  std::atomic<bool> stream_paused_{false};
 };
 
 }  // namespace clients::http
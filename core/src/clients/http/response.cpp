@@ -3,6 +3,9 @@
 #include <ostream>
 
 #include <userver/clients/http/response_future.hpp>
+#include <userver/formats/json/serialize.hpp>
+#include <userver/formats/json/value.hpp>
+#include <userver/utils/assert.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -68,6 +71,39 @@ void Response::raise_for_status() const {
 
 LocalStats Response::GetStats() const { return stats_; }
 
+std::string_view Response::body_view() const {
+  if (body_chain_.IsEmpty()) return response_;
+  UASSERT(response_.empty());
+  return body_chain_.View();
+}
+
+std::vector<std::string_view> Response::GetBodyBuffers() const {
+  if (response_.empty()) return body_chain_.GetBuffers();
+
+  std::vector<std::string_view> result{response_};
+  if (!body_chain_.IsEmpty()) {
+    auto chain_buffers = body_chain_.GetBuffers();
+    result.insert(result.end(), chain_buffers.begin(), chain_buffers.end());
+  }
+  return result;
+}
+
+formats::json::Value Response::GetBodyAsJson() const {
+  return formats::json::FromStringChunks(GetBodyBuffers());
+}
+
+void Response::MaterializeBody() {
+  if (body_chain_.IsEmpty()) return;
+
+  if (response_.empty()) {
+    response_ = body_chain_.Extract();
+  } else {
+    response_.reserve(response_.size() + body_chain_.Size());
+    for (const auto buffer : body_chain_.GetBuffers()) response_ += buffer;
+    body_chain_.Clear();
+  }
+}
+
 }  // namespace clients::http
 
 USERVER_NAMESPACE_END
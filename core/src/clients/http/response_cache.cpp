@@ -0,0 +1,289 @@
+#include <clients/http/response_cache.hpp>
+
+#include <userver/utils/assert.hpp>
+#include <userver/utils/datetime.hpp>
+#include <userver/utils/from_string.hpp>
+#include <userver/utils/str_icase.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace clients::http {
+namespace {
+
+constexpr std::string_view kCacheControl = "Cache-Control";
+constexpr std::string_view kETag = "ETag";
+constexpr std::string_view kLastModified = "Last-Modified";
+constexpr std::string_view kAge = "Age";
+constexpr std::string_view kVary = "Vary";
+
+// Only the requests with the default Accept-Encoding and reply decoding use
+// the cache, so responses that vary only by it are the same for all of them.
+constexpr std::string_view kVaryAcceptEncoding = "Accept-Encoding";
+
+std::string_view Trim(std::string_view value) {
+  while (!value.empty() && (value.front() == ' ' || value.front() == '\t')) {
+    value.remove_prefix(1);
+  }
+  while (!value.empty() && (value.back() == ' ' || value.back() == '\t')) {
+    value.remove_suffix(1);
+  }
+  return value;
+}
+
+std::optional<std::chrono::seconds> ParseSeconds(std::string_view value) {
+  value = Trim(value);
+  if (!value.empty() && value.front() == '"' && value.back() == '"' &&
+      value.size() >= 2) {
+    value = value.substr(1, value.size() - 2);
+  }
+  if (value.empty()) return std::nullopt;
+
+  try {
+    return std::chrono::seconds{
+        utils::FromString<std::int64_t>(std::string{value})};
+  } catch (const std::exception&) {
+    return std::nullopt;
+  }
+}
+
+std::string_view FindHeader(const Headers& headers, std::string_view name) {
+  const auto it = headers.find(std::string{name});
+  if (it == headers.end()) return {};
+  return it->second;
+}
+
+// RFC 7234, section 3.2
+bool IsSharedWithAuthorized(const CacheControl& cache_control) {
+  return cache_control.is_public || cache_control.s_maxage ||
+         cache_control.must_revalidate;
+}
+
+bool IsStorable(Status status_code, const Headers& headers) {
+  if (status_code != Status::OK) return false;
+
+  const auto vary = Trim(FindHeader(headers, kVary));
+  if (!vary.empty() && !utils::StrIcaseEqual{}(vary, kVaryAcceptEncoding)) {
+    return false;
+  }
+
+  const auto cache_control =
+      ParseCacheControl(FindHeader(headers, kCacheControl));
+  return !cache_control.no_store && !cache_control.is_private;
+}
+
+std::chrono::seconds GetFreshnessLifetime(const Headers& headers) {
+  const auto cache_control =
+      ParseCacheControl(FindHeader(headers, kCacheControl));
+  if (cache_control.no_cache) return std::chrono::seconds{0};
+
+  // s-maxage takes precedence for shared caches, RFC 7234 section 4.2.1
+  auto lifetime = cache_control.s_maxage.value_or(
+      cache_control.max_age.value_or(std::chrono::seconds{0}));
+  const auto age = ParseSeconds(FindHeader(headers, kAge));
+  if (age) lifetime -= *age;
+  return lifetime;
+}
+
+std::size_t EstimateSize(const ResponseCache::Entry& entry) {
+  std::size_t result = sizeof(entry) + entry.key.size() + entry.body.size() +
+                       entry.etag.size() + entry.last_modified.size();
+  for (const auto& [name, value] : entry.headers) {
+    result += name.size() + value.size();
+  }
+  return result;
+}
+
+}  // namespace
+
+CacheControl ParseCacheControl(std::string_view value) {
+  CacheControl result;
+
+  while (!value.empty()) {
+    const auto comma_pos = value.find(',');
+    auto directive = Trim(value.substr(0, comma_pos));
+    value = (comma_pos == std::string_view::npos)
+                ? std::string_view{}
+                : value.substr(comma_pos + 1);
+
+    std::string_view argument;
+    const auto eq_pos = directive.find('=');
+    if (eq_pos != std::string_view::npos) {
+      argument = directive.substr(eq_pos + 1);
+      directive = Trim(directive.substr(0, eq_pos));
+    }
+
+    const utils::StrIcaseEqual equal;
+    if (equal(directive, "no-store")) {
+      result.no_store = true;
+    } else if (equal(directive, "no-cache")) {
+      result.no_cache = true;
+    } else if (equal(directive, "private")) {
+      result.is_private = true;
+    } else if (equal(directive, "public")) {
+      result.is_public = true;
+    } else if (equal(directive, "must-revalidate") ||
+               equal(directive, "proxy-revalidate")) {
+      result.must_revalidate = true;
+    } else if (equal(directive, "max-age")) {
+      result.max_age = ParseSeconds(argument);
+    } else if (equal(directive, "s-maxage")) {
+      result.s_maxage = ParseSeconds(argument);
+    }
+  }
+
+  return result;
+}
+
+void ResponseCache::Entry::FillResponse(Response& response) const {
+  response.SetStatusCode(status_code);
+  response.headers() = headers;
+  response.sink_string() = body;
+}
+
+ResponseCache::ResponseCache(std::size_t max_bytes, std::size_t max_entries)
+    : max_bytes_(max_bytes), max_entries_(max_entries), data_(max_entries) {
+  UINVARIANT(max_bytes_ > 0, "Response cache must have a non-zero size");
+  UINVARIANT(max_entries_ > 0, "Response cache must have a non-zero size");
+}
+
+ResponseCache::EntryPtr ResponseCache::Find(const std::string& key) {
+  auto data = data_.UniqueLock();
+  auto* entry = data->lru.Get(key);
+  return entry ? *entry : EntryPtr{};
+}
+
+void ResponseCache::Store(const std::string& key, const Response& response,
+                          bool is_authorized_request) {
+  if (is_authorized_request &&
+      !IsSharedWithAuthorized(ParseCacheControl(
+          FindHeader(response.headers(), kCacheControl)))) {
+    return;
+  }
+
+  // The buffers are copied directly to avoid concatenating a multi-buffer
+  // body inside the response
+  const auto buffers = response.GetBodyBuffers();
+  std::size_t body_size = 0;
+  for (const auto buffer : buffers) body_size += buffer.size();
+
+  std::shared_ptr<Entry> entry;
+  if (body_size < max_bytes_ &&
+      IsStorable(response.status_code(), response.headers())) {
+    std::string body;
+    body.reserve(body_size);
+    for (const auto buffer : buffers) body += buffer;
+    entry = MakeEntry(key, response.status_code(), response.headers(),
+                      std::move(body));
+  }
+  if (!entry) {
+    Erase(key);
+    return;
+  }
+
+  ++stores_;
+  Put(std::move(entry));
+}
+
+ResponseCache::EntryPtr ResponseCache::Revalidate(const EntryPtr& entry,
+                                                  const Headers& not_modified) {
+  UASSERT(entry);
+  ++revalidations_;
+
+  // RFC 7234, section 4.3.4: headers of the 304 response replace the stored
+  // ones, the body is kept as is.
+  auto headers = entry->headers;
+  for (const auto& [name, value] : not_modified) {
+    headers[name] = value;
+  }
+
+  std::shared_ptr<Entry> updated;
+  if (IsStorable(entry->status_code, headers)) {
+    updated = MakeEntry(entry->key, entry->status_code, std::move(headers),
+                        entry->body);
+  }
+  if (!updated) {
+    Erase(entry->key);
+    return entry;
+  }
+
+  EntryPtr result = updated;
+  Put(std::move(updated));
+  return result;
+}
+
+ResponseCacheStatistics ResponseCache::GetStatistics() const {
+  ResponseCacheStatistics stats;
+  stats.hits = hits_.load();
+  stats.misses = misses_.load();
+  stats.revalidations = revalidations_.load();
+  stats.stores = stores_.load();
+  stats.evictions = evictions_.load();
+  stats.max_bytes = max_bytes_;
+
+  auto data = data_.UniqueLock();
+  stats.bytes = data->bytes;
+  stats.entries = data->lru.GetSize();
+  return stats;
+}
+
+std::shared_ptr<ResponseCache::Entry> ResponseCache::MakeEntry(
+    std::string key, Status status_code, Headers headers,
+    std::string body) const {
+  auto entry = std::make_shared<Entry>();
+  entry->key = std::move(key);
+  entry->status_code = status_code;
+  entry->headers = std::move(headers);
+  entry->body = std::move(body);
+  entry->etag = std::string{Trim(FindHeader(entry->headers, kETag))};
+  entry->last_modified =
+      std::string{Trim(FindHeader(entry->headers, kLastModified))};
+  entry->size_bytes = EstimateSize(*entry);
+  entry->is_shared_with_authorized = IsSharedWithAuthorized(
+      ParseCacheControl(FindHeader(entry->headers, kCacheControl)));
+
+  const auto fresh_for = GetFreshnessLifetime(entry->headers);
+  entry->fresh_until = utils::datetime::SteadyNow() + fresh_for;
+  if (fresh_for <= std::chrono::seconds{0} && !entry->HasValidators()) {
+    return {};
+  }
+  if (entry->size_bytes > max_bytes_) return {};
+
+  return entry;
+}
+
+void ResponseCache::Put(EntryPtr entry) {
+  UASSERT(entry);
+  auto data = data_.UniqueLock();
+
+  auto* old = data->lru.Get(entry->key);
+  if (old) {
+    data->bytes -= (*old)->size_bytes;
+    data->lru.Erase(entry->key);
+  }
+
+  // Evicting manually to keep the accounted size in sync with the LRU
+  while (data->lru.GetSize() > 0 &&
+         (data->lru.GetSize() >= max_entries_ ||
+          data->bytes + entry->size_bytes > max_bytes_)) {
+    const auto least_used = *data->lru.GetLeastUsed();
+    data->bytes -= least_used->size_bytes;
+    data->lru.Erase(least_used->key);
+    ++evictions_;
+  }
+
+  data->bytes += entry->size_bytes;
+  auto key = entry->key;
+  data->lru.Put(key, std::move(entry));
+}
+
+void ResponseCache::Erase(const std::string& key) {
+  auto data = data_.UniqueLock();
+  auto* old = data->lru.Get(key);
+  if (!old) return;
+  data->bytes -= (*old)->size_bytes;
+  data->lru.Erase(key);
+}
+
+}  // namespace clients::http
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include <userver/cache/lru_map.hpp>
+#include <userver/clients/http/response.hpp>
+#include <userver/clients/http/statistics.hpp>
+#include <userver/concurrent/variable.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace clients::http {
+
+/// Parsed value of the `Cache-Control` response header, see RFC 7234
+struct CacheControl final {
+  bool no_store{false};
+  bool no_cache{false};
+  bool is_private{false};
+  bool is_public{false};
+  bool must_revalidate{false};
+  std::optional<std::chrono::seconds> max_age;
+  std::optional<std::chrono::seconds> s_maxage;
+};
+
+CacheControl ParseCacheControl(std::string_view value);
+
+/// @brief In-process cache of HTTP responses that follows the caching rules
+/// of a shared HTTP cache (RFC 7234).
+///
+/// Responses are bounded by the total size in bytes and by the number of
+/// entries, least recently used responses are evicted first. Stale responses
+/// with a validator (ETag or Last-Modified) are kept for revalidation.
+///
+/// Thread safe, operations are fast and could be called from the cURL
+/// event loop threads.
+class ResponseCache final {
+ public:
+  using TimePoint = std::chrono::steady_clock::time_point;
+
+  struct Entry final {
+    std::string key;
+    Status status_code{Status::Invalid};
+    Headers headers;
+    std::string body;
+    std::string etag;
+    std::string last_modified;
+    TimePoint fresh_until;
+    std::size_t size_bytes{0};
+    /// Response explicitly allows a shared cache to use it for the requests
+    /// with `Authorization`, RFC 7234 section 3.2
+    bool is_shared_with_authorized{false};
+
+    bool IsFresh(TimePoint now) const { return now < fresh_until; }
+    bool HasValidators() const { return !etag.empty() || !last_modified.empty(); }
+
+    /// Copies status, headers and body into the response
+    void FillResponse(Response& response) const;
+  };
+  using EntryPtr = std::shared_ptr<const Entry>;
+
+  ResponseCache(std::size_t max_bytes, std::size_t max_entries);
+
+  /// Returns the entry for the key if any, does not account statistics
+  EntryPtr Find(const std::string& key);
+
+  /// Stores the response if it is cacheable, removes the stale entry otherwise.
+  /// Responses to the requests with `Authorization` are stored only if they
+  /// explicitly allow it, other entries are left intact in that case.
+  void Store(const std::string& key, const Response& response,
+             bool is_authorized_request = false);
+
+  /// Updates the freshness and the headers of the entry from a
+  /// `304 Not Modified` response. Returns the entry to respond with.
+  EntryPtr Revalidate(const EntryPtr& entry, const Headers& not_modified);
+
+  void AccountHit() noexcept { ++hits_; }
+  void AccountMiss() noexcept { ++misses_; }
+
+  ResponseCacheStatistics GetStatistics() const;
+
+ private:
+  struct Data final {
+    explicit Data(std::size_t max_entries) : lru(max_entries) {}
+
+    cache::LruMap<std::string, EntryPtr> lru;
+    std::size_t bytes{0};
+  };
+
+  std::shared_ptr<Entry> MakeEntry(std::string key, Status status_code,
+                                   Headers headers, std::string body) const;
+  void Put(EntryPtr entry);
+  void Erase(const std::string& key);
+
+  const std::size_t max_bytes_;
+  const std::size_t max_entries_;
+  concurrent::Variable<Data, std::mutex> data_;
+
+  std::atomic<std::uint64_t> hits_{0};
+  std::atomic<std::uint64_t> misses_{0};
+  std::atomic<std::uint64_t> revalidations_{0};
+  std::atomic<std::uint64_t> stores_{0};
+  std::atomic<std::uint64_t> evictions_{0};
+};
+
+}  // namespace clients::http
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,293 @@
+#include <clients/http/response_cache.hpp>
+
+#include <atomic>
+
+#include <userver/clients/http/client.hpp>
+#include <userver/engine/task/task.hpp>
+#include <userver/utest/simple_server.hpp>
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using HttpResponse = utest::SimpleServer::Response;
+using HttpRequest = utest::SimpleServer::Request;
+
+constexpr auto kTimeout = std::chrono::milliseconds{100};
+constexpr char kBody[] = "cached body";
+
+std::shared_ptr<clients::http::Client> CreateCachingClient(
+    size_t max_bytes = 1024 * 1024) {
+  clients::http::ClientSettings settings;
+  settings.io_threads = 1;
+  settings.response_cache_max_bytes = max_bytes;
+  return std::make_shared<clients::http::Client>(
+      settings, engine::current_task::GetTaskProcessor());
+}
+
+struct CountingCallback {
+  std::string headers;
+  std::shared_ptr<std::atomic<int>> requests =
+      std::make_shared<std::atomic<int>>(0);
+  std::shared_ptr<std::atomic<int>> not_modified =
+      std::make_shared<std::atomic<int>>(0);
+
+  HttpResponse operator()(const HttpRequest& request) const {
+    ++*requests;
+    if (request.find("If-None-Match: \"v1\"") != std::string::npos) {
+      ++*not_modified;
+      return {"HTTP/1.1 304 Not Modified\r\nConnection: close\r\n" + headers +
+                  "\r\n",
+              HttpResponse::kWriteAndClose};
+    }
+
+    return {"HTTP/1.1 200 OK\r\nConnection: close\r\nContent-Length: " +
+                std::to_string(sizeof(kBody) - 1) + "\r\n" + headers +
+                "\r\n" + kBody,
+            HttpResponse::kWriteAndClose};
+  }
+};
+
+std::shared_ptr<clients::http::Response> Get(clients::http::Client& client,
+                                             const std::string& url) {
+  return client.CreateRequest()->get(url)->timeout(kTimeout)->perform();
+}
+
+std::shared_ptr<clients::http::Response> Get(
+    clients::http::Client& client, const std::string& url,
+    const clients::http::Headers& headers) {
+  return client.CreateRequest()
+      ->get(url)
+      ->headers(headers)
+      ->timeout(kTimeout)
+      ->perform();
+}
+
+}  // namespace
+
+TEST(HttpResponseCache, ParseCacheControl) {
+  using clients::http::ParseCacheControl;
+
+  auto cc = ParseCacheControl("public, max-age=60, s-maxage=\"30\"");
+  EXPECT_TRUE(cc.is_public);
+  EXPECT_FALSE(cc.no_store);
+  EXPECT_FALSE(cc.no_cache);
+  EXPECT_EQ(cc.max_age, std::chrono::seconds{60});
+  EXPECT_EQ(cc.s_maxage, std::chrono::seconds{30});
+
+  cc = ParseCacheControl("No-Store,private , must-revalidate");
+  EXPECT_TRUE(cc.no_store);
+  EXPECT_TRUE(cc.is_private);
+  EXPECT_TRUE(cc.must_revalidate);
+  EXPECT_FALSE(cc.max_age);
+
+  cc = ParseCacheControl("no-cache, max-age=bad");
+  EXPECT_TRUE(cc.no_cache);
+  EXPECT_FALSE(cc.max_age);
+}
+
+TEST(HttpResponseCache, EvictsByBytes) {
+  clients::http::ResponseCache cache{4096, 100};
+
+  clients::http::Response response;
+  response.SetStatusCode(clients::http::Status::OK);
+  response.headers()["Cache-Control"] = "max-age=60";
+  response.sink_string() = std::string(1500, '@');
+
+  cache.Store("a", response);
+  cache.Store("b", response);
+  EXPECT_TRUE(cache.Find("a"));
+  cache.Store("c", response);
+
+  const auto stats = cache.GetStatistics();
+  EXPECT_EQ(stats.entries, 2);
+  EXPECT_EQ(stats.evictions, 1);
+  EXPECT_LE(stats.bytes, 4096);
+  EXPECT_TRUE(cache.Find("a"));
+  EXPECT_FALSE(cache.Find("b"));
+  EXPECT_TRUE(cache.Find("c"));
+}
+
+TEST(HttpResponseCache, NotStorable) {
+  clients::http::ResponseCache cache{4096, 100};
+
+  clients::http::Response response;
+  response.SetStatusCode(clients::http::Status::OK);
+
+  response.headers()["Cache-Control"] = "no-store, max-age=60";
+  cache.Store("no-store", response);
+  response.headers()["Cache-Control"] = "private, max-age=60";
+  cache.Store("private", response);
+  response.headers()["Cache-Control"] = "no-cache";
+  cache.Store("no-validators", response);
+  response.headers()["Cache-Control"] = "max-age=60";
+  response.headers()["Vary"] = "Authorization";
+  cache.Store("vary", response);
+
+  EXPECT_EQ(cache.GetStatistics().entries, 0);
+}
+
+TEST(HttpResponseCache, AuthorizedRequest) {
+  clients::http::ResponseCache cache{4096, 100};
+
+  clients::http::Response response;
+  response.SetStatusCode(clients::http::Status::OK);
+  response.headers()["Cache-Control"] = "max-age=60";
+  cache.Store("anonymous", response);
+  cache.Store("anonymous", response, /*is_authorized_request=*/true);
+  cache.Store("authorized", response, /*is_authorized_request=*/true);
+  ASSERT_TRUE(cache.Find("anonymous"));
+  EXPECT_FALSE(cache.Find("anonymous")->is_shared_with_authorized);
+  EXPECT_FALSE(cache.Find("authorized"));
+
+  for (const auto* cache_control :
+       {"public, max-age=60", "s-maxage=60", "must-revalidate, max-age=60"}) {
+    response.headers()["Cache-Control"] = cache_control;
+    cache.Store(cache_control, response, /*is_authorized_request=*/true);
+    const auto entry = cache.Find(cache_control);
+    ASSERT_TRUE(entry) << cache_control;
+    EXPECT_TRUE(entry->is_shared_with_authorized) << cache_control;
+  }
+}
+
+UTEST(HttpResponseCache, FreshHit) {
+  const CountingCallback callback{"Cache-Control: max-age=60\r\n"};
+  const utest::SimpleServer http_server{callback};
+  auto client = CreateCachingClient();
+  const auto url = http_server.GetBaseUrl();
+
+  for (int i = 0; i < 3; ++i) {
+    const auto response = Get(*client, url);
+    EXPECT_EQ(response->status_code(), clients::http::Status::OK);
+    EXPECT_EQ(response->body(), kBody);
+  }
+  EXPECT_EQ(*callback.requests, 1);
+
+  const auto stats = client->GetResponseCacheStatistics();
+  ASSERT_TRUE(stats);
+  EXPECT_EQ(stats->hits, 2);
+  EXPECT_EQ(stats->misses, 1);
+  EXPECT_EQ(stats->stores, 1);
+}
+
+UTEST(HttpResponseCache, Revalidation) {
+  const CountingCallback callback{"Cache-Control: no-cache\r\nETag: \"v1\"\r\n"};
+  const utest::SimpleServer http_server{callback};
+  auto client = CreateCachingClient();
+  const auto url = http_server.GetBaseUrl();
+
+  for (int i = 0; i < 3; ++i) {
+    const auto response = Get(*client, url);
+    EXPECT_EQ(response->status_code(), clients::http::Status::OK);
+    EXPECT_EQ(response->body(), kBody);
+  }
+  EXPECT_EQ(*callback.requests, 3);
+  EXPECT_EQ(*callback.not_modified, 2);
+  EXPECT_EQ(client->GetResponseCacheStatistics()->revalidations, 2);
+}
+
+UTEST(HttpResponseCache, AuthorizedNotShared) {
+  const CountingCallback callback{"Cache-Control: max-age=60\r\n"};
+  const utest::SimpleServer http_server{callback};
+  auto client = CreateCachingClient();
+  const auto url = http_server.GetBaseUrl();
+  const clients::http::Headers authorized{{"Authorization", "Bearer secret"}};
+
+  // Response to the authorized request is not stored...
+  EXPECT_EQ(Get(*client, url, authorized)->body(), kBody);
+  EXPECT_EQ(client->GetResponseCacheStatistics()->entries, 0);
+  EXPECT_EQ(Get(*client, url)->body(), kBody);
+  EXPECT_EQ(*callback.requests, 2);
+
+  // ...and the stored one is not used for it
+  EXPECT_EQ(Get(*client, url, authorized)->body(), kBody);
+  EXPECT_EQ(*callback.requests, 3);
+  EXPECT_EQ(Get(*client, url)->body(), kBody);
+  EXPECT_EQ(*callback.requests, 3);
+}
+
+UTEST(HttpResponseCache, AuthorizedPublic) {
+  const CountingCallback callback{"Cache-Control: public, max-age=60\r\n"};
+  const utest::SimpleServer http_server{callback};
+  auto client = CreateCachingClient();
+  const auto url = http_server.GetBaseUrl();
+  const clients::http::Headers authorized{{"Authorization", "Bearer secret"}};
+
+  EXPECT_EQ(Get(*client, url, authorized)->body(), kBody);
+  EXPECT_EQ(Get(*client, url, authorized)->body(), kBody);
+  EXPECT_EQ(Get(*client, url)->body(), kBody);
+  EXPECT_EQ(*callback.requests, 1);
+}
+
+UTEST(HttpResponseCache, UserConditionalKeepsEntry) {
+  const CountingCallback callback{
+      "Cache-Control: max-age=60\r\nETag: \"v1\"\r\n"};
+  const utest::SimpleServer http_server{callback};
+  auto client = CreateCachingClient();
+  const auto url = http_server.GetBaseUrl();
+
+  EXPECT_EQ(Get(*client, url)->body(), kBody);
+
+  const auto response = Get(*client, url, {{"If-None-Match", "\"v1\""}});
+  EXPECT_EQ(response->status_code(), 304);
+  EXPECT_EQ(*callback.requests, 2);
+
+  // The fresh entry survives the 304 to the conditional request of the user
+  EXPECT_EQ(Get(*client, url)->body(), kBody);
+  EXPECT_EQ(*callback.requests, 2);
+  EXPECT_EQ(client->GetResponseCacheStatistics()->entries, 1);
+}
+
+UTEST(HttpResponseCache, Bypass) {
+  const CountingCallback callback{"Cache-Control: max-age=60\r\n"};
+  const utest::SimpleServer http_server{callback};
+  auto client = CreateCachingClient();
+  const auto url = http_server.GetBaseUrl();
+
+  for (int i = 0; i < 2; ++i) {
+    const auto response = client->CreateRequest()
+                              ->get(url)
+                              ->DisableResponseCache()
+                              ->timeout(kTimeout)
+                              ->perform();
+    EXPECT_EQ(response->body(), kBody);
+  }
+  EXPECT_EQ(*callback.requests, 2);
+  EXPECT_EQ(client->GetResponseCacheStatistics()->entries, 0);
+}
+
+UTEST(HttpResponseCache, NonDefaultEncodingBypass) {
+  const CountingCallback callback{
+      "Cache-Control: max-age=60\r\nVary: Accept-Encoding\r\n"};
+  const utest::SimpleServer http_server{callback};
+  auto client = CreateCachingClient();
+  const auto url = http_server.GetBaseUrl();
+
+  EXPECT_EQ(Get(*client, url)->body(), kBody);
+  EXPECT_EQ(*callback.requests, 1);
+
+  // Raw replies are neither served from the cache nor stored into it
+  const auto raw = client->CreateRequest()
+                       ->get(url)
+                       ->DisableReplyDecoding()
+                       ->timeout(kTimeout)
+                       ->perform();
+  EXPECT_EQ(raw->body(), kBody);
+  EXPECT_EQ(*callback.requests, 2);
+
+  EXPECT_EQ(Get(*client, url, {{"Accept-Encoding", "identity"}})->body(),
+            kBody);
+  EXPECT_EQ(*callback.requests, 3);
+
+  EXPECT_EQ(Get(*client, url)->body(), kBody);
+  EXPECT_EQ(*callback.requests, 3);
+  EXPECT_EQ(client->GetResponseCacheStatistics()->stores, 1);
+}
+
+UTEST(HttpResponseCache, Disabled) {
+  auto client = CreateCachingClient(0);
+  EXPECT_FALSE(client->GetResponseCacheStatistics());
+}
+
+USERVER_NAMESPACE_END
@@ -183,6 +183,30 @@ formats::json::ValueBuilder PoolStatisticsToJson(const PoolStatistics& stats) {
   return json;
 }
 
+formats::json::ValueBuilder ResponseCacheStatisticsToJson(
+    const ResponseCacheStatistics& stats) {
+  formats::json::ValueBuilder json;
+  json["hits"] = stats.hits;
+  json["misses"] = stats.misses;
+  json["revalidations"] = stats.revalidations;
+  json["stores"] = stats.stores;
+  json["evictions"] = stats.evictions;
+  json["entries"] = stats.entries;
+  json["bytes"]["current"] = stats.bytes;
+  json["bytes"]["max"] = stats.max_bytes;
+  return json;
+}
+
+formats::json::ValueBuilder PrewarmStatisticsToJson(
+    const PrewarmStatistics& stats) {
+  formats::json::ValueBuilder json;
+  json["attempts"] = stats.attempts;
+  json["established"] = stats.established;
+  json["failures"] = stats.failures;
+  json["last-duration-ms"] = stats.last_duration.count();
+  return json;
+}
+
 InstanceStatistics::InstanceStatistics(const Statistics& other)
     : easy_handles(other.easy_handles.load()),
       last_time_to_start_us(other.last_time_to_start_us.load()),
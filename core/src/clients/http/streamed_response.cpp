@@ -0,0 +1,67 @@
+#include <userver/clients/http/streamed_response.hpp>
+
+#include <userver/engine/wait_any.hpp>
+#include <userver/utils/assert.hpp>
+
+#include <clients/http/request_state.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace clients::http {
+
+StreamedResponse::StreamedResponse(
+    ResponseFuture&& response_future,
+    engine::Future<std::shared_ptr<Response>>&& headers_future,
+    StreamedBodyQueue::Consumer&& consumer,
+    std::shared_ptr<RequestState> request_state)
+    : response_future_(std::move(response_future)),
+      headers_future_(std::move(headers_future)),
+      consumer_(std::move(consumer)),
+      request_state_(std::move(request_state)) {}
+
+StreamedResponse::~StreamedResponse() = default;
+
+Status StreamedResponse::StatusCode() {
+  WaitForHeaders();
+  return response_->status_code();
+}
+
+const Headers& StreamedResponse::GetHeaders() {
+  WaitForHeaders();
+  return response_->headers();
+}
+
+bool StreamedResponse::ReadChunk(std::string& output) {
+  WaitForHeaders();
+  if (is_finished_) return false;
+
+  if (consumer_.Pop(output)) {
+    request_state_->OnStreamChunkConsumed();
+    return true;
+  }
+
+  // The request is completed or the task is cancelled, rethrow the error
+  // if any
+  is_finished_ = true;
+  response_future_.Get();
+  return false;
+}
+
+void StreamedResponse::WaitForHeaders() {
+  if (response_) return;
+
+  const auto ready = engine::WaitAny(headers_future_, response_future_);
+  if (ready == 0) {
+    response_ = headers_future_.get();
+  } else {
+    // The request is completed without a body, failed or the task is
+    // cancelled. Get() rethrows in the latter cases.
+    response_ = response_future_.Get();
+    is_finished_ = true;
+  }
+  UASSERT(response_);
+}
+
+}  // namespace clients::http
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,167 @@
+#include <userver/clients/http/streamed_response.hpp>
+
+#include <userver/clients/http/client.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/utest/http_client.hpp>
+#include <userver/utest/simple_server.hpp>
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using HttpResponse = utest::SimpleServer::Response;
+using HttpRequest = utest::SimpleServer::Request;
+
+constexpr auto kTimeout = std::chrono::seconds{10};
+
+std::string MakeBody(std::size_t size) {
+  std::string result;
+  result.reserve(size);
+  for (std::size_t i = 0; i < size; ++i) {
+    result += static_cast<char>('a' + i % 26);
+  }
+  return result;
+}
+
+struct BodyCallback {
+  std::string body;
+  std::string status_line = "HTTP/1.1 200 OK";
+  std::optional<std::size_t> content_length{};
+
+  HttpResponse operator()(const HttpRequest&) const {
+    return {status_line +
+                "\r\nConnection: close\r\nX-Test: value\r\nContent-Length: " +
+                std::to_string(content_length.value_or(body.size())) +
+                "\r\n\r\n" + body,
+            HttpResponse::kWriteAndClose};
+  }
+};
+
+clients::http::StreamedResponse StreamGet(clients::http::Client& client,
+                                          const std::string& url,
+                                          std::size_t max_queued_chunks) {
+  return client.CreateRequest()
+      ->get(url)
+      ->timeout(kTimeout)
+      ->async_perform_stream_body(max_queued_chunks);
+}
+
+}  // namespace
+
+UTEST(HttpStreamedResponse, Body) {
+  const auto body = MakeBody(4 * 1024 * 1024);
+  const utest::SimpleServer http_server{BodyCallback{body}};
+  auto http_client_ptr = utest::CreateHttpClient();
+
+  auto response = StreamGet(*http_client_ptr, http_server.GetBaseUrl(), 2);
+  EXPECT_EQ(response.StatusCode(), clients::http::Status::OK);
+  EXPECT_EQ(response.GetHeaders().at("X-Test"), "value");
+
+  std::string received;
+  std::string chunk;
+  std::size_t chunks_count = 0;
+  while (response.ReadChunk(chunk)) {
+    received += chunk;
+    // slow reader, the transfer should be paused and resumed
+    if (++chunks_count % 16 == 0) engine::Yield();
+  }
+  EXPECT_EQ(received, body);
+  EXPECT_FALSE(response.ReadChunk(chunk));
+}
+
+UTEST(HttpStreamedResponse, EmptyBody) {
+  const utest::SimpleServer http_server{
+      BodyCallback{"", "HTTP/1.1 404 Not Found"}};
+  auto http_client_ptr = utest::CreateHttpClient();
+
+  auto response = StreamGet(*http_client_ptr, http_server.GetBaseUrl(), 2);
+  EXPECT_EQ(response.StatusCode(), clients::http::Status::NotFound);
+  EXPECT_EQ(response.GetHeaders().at("X-Test"), "value");
+
+  std::string chunk;
+  EXPECT_FALSE(response.ReadChunk(chunk));
+}
+
+UTEST(HttpStreamedResponse, HeadersBeforeBody) {
+  // The body never arrives, as with long-poll upstreams
+  const utest::SimpleServer http_server{[](const HttpRequest&) {
+    return HttpResponse{
+        "HTTP/1.1 200 OK\r\nX-Test: value\r\nContent-Length: 10\r\n\r\n",
+        HttpResponse::kWriteAndContinue};
+  }};
+  auto http_client_ptr = utest::CreateHttpClient();
+
+  auto response = http_client_ptr->CreateRequest()
+                      ->get(http_server.GetBaseUrl())
+                      ->timeout(std::chrono::milliseconds{500})
+                      ->async_perform_stream_body(2);
+  EXPECT_EQ(response.StatusCode(), clients::http::Status::OK);
+  EXPECT_EQ(response.GetHeaders().at("X-Test"), "value");
+
+  std::string chunk;
+  EXPECT_THROW(response.ReadChunk(chunk), clients::http::BaseException);
+}
+
+UTEST(HttpStreamedResponse, Redirect) {
+  const auto body = MakeBody(1024);
+  const utest::SimpleServer http_server{[&body](const HttpRequest& request) {
+    if (request.find("GET /final ") == std::string::npos) {
+      return HttpResponse{
+          "HTTP/1.1 302 Found\r\nConnection: close\r\nLocation: /final\r\n"
+          "X-Redirect: value\r\nContent-Length: 0\r\n\r\n",
+          HttpResponse::kWriteAndClose};
+    }
+    return BodyCallback{body}(request);
+  }};
+  auto http_client_ptr = utest::CreateHttpClient();
+
+  auto response = StreamGet(*http_client_ptr, http_server.GetBaseUrl(), 2);
+  EXPECT_EQ(response.StatusCode(), clients::http::Status::OK);
+  EXPECT_EQ(response.GetHeaders().at("X-Test"), "value");
+  EXPECT_EQ(response.GetHeaders().count("X-Redirect"), 0);
+
+  std::string received;
+  std::string chunk;
+  while (response.ReadChunk(chunk)) received += chunk;
+  EXPECT_EQ(received, body);
+}
+
+UTEST(HttpStreamedResponse, Truncated) {
+  const auto body = MakeBody(1024);
+  const utest::SimpleServer http_server{
+      BodyCallback{body, "HTTP/1.1 200 OK", body.size() * 2}};
+  auto http_client_ptr = utest::CreateHttpClient();
+
+  auto response = StreamGet(*http_client_ptr, http_server.GetBaseUrl(), 2);
+  EXPECT_EQ(response.StatusCode(), clients::http::Status::OK);
+
+  std::string chunk;
+  EXPECT_THROW(
+      {
+        while (response.ReadChunk(chunk)) {
+        }
+      },
+      clients::http::BaseException);
+}
+
+UTEST(HttpStreamedResponse, AbandonedReader) {
+  const auto body = MakeBody(4 * 1024 * 1024);
+  const utest::SimpleServer http_server{BodyCallback{body}};
+  auto http_client_ptr = utest::CreateHttpClient();
+
+  {
+    auto response = StreamGet(*http_client_ptr, http_server.GetBaseUrl(), 1);
+    std::string chunk;
+    EXPECT_TRUE(response.ReadChunk(chunk));
+  }
+
+  // The client is still usable
+  auto response = StreamGet(*http_client_ptr, http_server.GetBaseUrl(), 4);
+  std::string received;
+  std::string chunk;
+  while (response.ReadChunk(chunk)) received += chunk;
+  EXPECT_EQ(received, body);
+}
+
+USERVER_NAMESPACE_END
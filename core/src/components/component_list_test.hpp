@@ -19,6 +19,7 @@ inline constexpr std::string_view kRuntimeConfig = R"~({
   "USERVER_CANCEL_HANDLE_REQUEST_BY_DEADLINE": false,
   "USERVER_HTTP_PROXY": "",
   "USERVER_NO_LOG_SPANS":{"names":[], "prefixes":[]},
+  "USERVER_SPAN_SAMPLING":{"probability":1.0},
   "USERVER_TASK_PROCESSOR_QOS": {
     "default-service": {
       "default-task-processor": {
@@ -1,9 +1,12 @@
 #include <userver/components/logging_configurator.hpp>
 
 #include <tracing/no_log_spans.hpp>
+#include <tracing/span_sampling.hpp>
 #include <userver/components/component.hpp>
+#include <userver/components/statistics_storage.hpp>
 #include <userver/dynamic_config/storage/component.hpp>
 #include <userver/dynamic_config/value.hpp>
+#include <userver/logging/component.hpp>
 #include <userver/tracing/tracer.hpp>
 #include <userver/yaml_config/merge_schemas.hpp>
 
@@ -23,6 +26,13 @@ tracing::NoLogSpans ParseNoLogSpans(const dynamic_config::DocsMap& docs_map) {
 constexpr dynamic_config::Key<ParseNoLogSpans> kNoLogSpans{};
 /// [key]
 
+tracing::SpanSampling ParseSpanSampling(
+    const dynamic_config::DocsMap& docs_map) {
+  return docs_map.Get("USERVER_SPAN_SAMPLING").As<tracing::SpanSampling>();
+}
+
+constexpr dynamic_config::Key<ParseSpanSampling> kSpanSampling{};
+
 }  // namespace
 
 LoggingConfigurator::LoggingConfigurator(const ComponentConfig& config,
@@ -32,6 +42,14 @@ LoggingConfigurator::LoggingConfigurator(const ComponentConfig& config,
   logging::impl::SetLogLimitedInterval(
       config["limited-logging-interval"].As<std::chrono::milliseconds>());
 
+  auto& logging_component = context.FindComponent<components::Logging>();
+  statistics_holder_ =
+      context.FindComponent<components::StatisticsStorage>()
+          .GetStorage()
+          .RegisterWriter("logger", [&logging_component](auto& writer) {
+            logging_component.WriteStatistics(writer);
+          });
+
   config_subscription_ =
       context.FindComponent<components::DynamicConfig>()
           .GetSource()
@@ -40,12 +58,15 @@ LoggingConfigurator::LoggingConfigurator(const ComponentConfig& config,
 
 LoggingConfigurator::~LoggingConfigurator() {
   config_subscription_.Unsubscribe();
+  statistics_holder_.Unregister();
 }
 
 void LoggingConfigurator::OnConfigUpdate(
     const dynamic_config::Snapshot& config) {
   (void)this;  // silence clang-tidy
   tracing::Tracer::SetNoLogSpans(tracing::NoLogSpans{config[kNoLogSpans]});
+  tracing::Tracer::SetSpanSampling(
+      tracing::SpanSampling{config[kSpanSampling]});
 }
 
 yaml_config::Schema LoggingConfigurator::GetStaticConfigSchema() {
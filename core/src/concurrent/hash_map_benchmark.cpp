@@ -0,0 +1,85 @@
+#include <userver/concurrent/hash_map.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <userver/engine/async.hpp>
+#include <userver/engine/run_standalone.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+#include <userver/rcu/rcu_map.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr std::uint64_t kKeysCount = 1'000;
+
+// Every task runs the same operation mix over its own part of the keys
+template <typename Map>
+void RunMix(Map& map, std::uint64_t& i, std::uint64_t base,
+            std::int64_t lookups_per_update) {
+  const auto key = base + i++ % kKeysCount;
+  if (static_cast<std::int64_t>(i % (lookups_per_update + 1)) !=
+      lookups_per_update) {
+    benchmark::DoNotOptimize(map.Get(key));
+  } else if (i / (lookups_per_update + 1) % 2) {
+    map.Emplace(key, key);
+  } else {
+    map.Erase(key);
+  }
+}
+
+template <typename Map>
+void hash_map_mix(benchmark::State& state) {
+  const std::size_t tasks_count = state.range(0);
+  const auto lookups_per_update = state.range(1);
+
+  engine::RunStandalone(tasks_count, [&] {
+    Map map;
+    for (std::uint64_t key = 0; key < kKeysCount * tasks_count; key += 2) {
+      map.Emplace(key, key);
+    }
+
+    std::atomic<bool> keep_running{true};
+    std::vector<engine::TaskWithResult<void>> tasks;
+    tasks.reserve(tasks_count - 1);
+    for (std::size_t task_id = 1; task_id < tasks_count; ++task_id) {
+      tasks.push_back(engine::AsyncNoSpan([&, task_id] {
+        std::uint64_t i = 0;
+        while (keep_running) {
+          RunMix(map, i, task_id * kKeysCount, lookups_per_update);
+        }
+      }));
+    }
+
+    std::uint64_t i = 0;
+    for (auto _ : state) {
+      RunMix(map, i, 0, lookups_per_update);
+    }
+
+    keep_running = false;
+    for (auto& task : tasks) task.Get();
+  });
+}
+
+void MixArgs(benchmark::internal::Benchmark* b) {
+  for (const auto tasks : {1, 8, 32}) {
+    // lookups per insert or erase
+    for (const auto lookups : {0, 10, 100}) b->Args({tasks, lookups});
+  }
+}
+
+}  // namespace
+
+BENCHMARK_TEMPLATE(hash_map_mix,
+                   concurrent::HashMap<std::uint64_t, std::uint64_t>)
+    ->Apply(MixArgs);
+
+// copies the whole keyset on every update, the baseline for the above
+BENCHMARK_TEMPLATE(hash_map_mix, rcu::RcuMap<std::uint64_t, std::uint64_t>)
+    ->Apply(MixArgs);
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,254 @@
+#include <userver/concurrent/hash_map.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <userver/engine/sleep.hpp>
+#include <userver/utest/utest.hpp>
+#include <userver/utils/async.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+UTEST(ConcurrentHashMap, Empty) {
+  concurrent::HashMap<std::string, int> map;
+  const auto& cmap = map;
+
+  EXPECT_EQ(0, map.SizeApprox());
+  EXPECT_EQ(map.begin(), map.end());
+  EXPECT_EQ(cmap.begin(), cmap.end());
+  auto snap = map.GetSnapshot();
+  map.Clear();
+  EXPECT_EQ(snap, map.GetSnapshot());
+}
+
+UTEST(ConcurrentHashMap, Modify) {
+  concurrent::HashMap<std::string, int> map;
+  const auto& cmap = map;
+
+  UEXPECT_THROW(cmap["any"], rcu::MissingKeyException);
+  EXPECT_FALSE(map.Get("any"));
+  EXPECT_FALSE(map.Erase("any"));
+  EXPECT_FALSE(map.Pop("any"));
+
+  UEXPECT_NO_THROW(*map["any"] = 1);
+  EXPECT_EQ(1, *cmap["any"]);
+  EXPECT_EQ(1, *cmap.Get("any"));
+  EXPECT_TRUE(map.Erase("any"));
+  EXPECT_FALSE(map.Erase("any"));
+
+  EXPECT_TRUE(map.Insert("any", std::make_shared<int>(3)).inserted);
+  EXPECT_FALSE(map.Insert("any", std::make_shared<int>(0)).inserted);
+  EXPECT_EQ(*map.Insert("any", std::make_shared<int>(0)).value, 3);
+  EXPECT_EQ(*map.Pop("any"), 3);
+
+  EXPECT_TRUE(map.Emplace("any", 4).inserted);
+  EXPECT_FALSE(map.Emplace("any", 0).inserted);
+  EXPECT_EQ(*map.Pop("any"), 4);
+
+  EXPECT_TRUE(map.TryEmplace("any", 5).inserted);
+  EXPECT_FALSE(map.TryEmplace("any", 0).inserted);
+  EXPECT_EQ(*map.TryEmplace("any", 0).value, 5);
+
+  map.InsertOrAssign("any", std::make_shared<int>(6));
+  EXPECT_EQ(*cmap["any"], 6);
+  EXPECT_EQ(1, map.SizeApprox());
+
+  UEXPECT_NO_THROW(
+      map.Assign(std::unordered_map<std::string, std::shared_ptr<int>>{
+          {"any", std::make_shared<int>(7)},
+          {"other", std::make_shared<int>(8)}}));
+  EXPECT_EQ(*cmap["any"], 7);
+  EXPECT_EQ(*cmap["other"], 8);
+  EXPECT_EQ(2, map.SizeApprox());
+
+  map.Clear();
+  EXPECT_FALSE(map.Get("any"));
+  EXPECT_EQ(0, map.SizeApprox());
+}
+
+UTEST(ConcurrentHashMap, Grow) {
+  constexpr int kKeys = 10000;
+  concurrent::HashMap<int, int> map;
+
+  for (int i = 0; i < kKeys; ++i) {
+    ASSERT_TRUE(map.Emplace(i, i).inserted);
+  }
+  EXPECT_EQ(kKeys, map.SizeApprox());
+
+  for (int i = 0; i < kKeys; ++i) {
+    ASSERT_EQ(i, *map[i]);
+  }
+
+  std::vector<bool> seen(kKeys);
+  for (const auto& [key, value] : map) {
+    ASSERT_EQ(key, *value);
+    EXPECT_FALSE(seen[key]);
+    seen[key] = true;
+  }
+  EXPECT_EQ(map.GetSnapshot().size(), kKeys);
+
+  for (int i = 0; i < kKeys; i += 2) {
+    ASSERT_TRUE(map.Erase(i));
+  }
+  EXPECT_EQ(kKeys / 2, map.SizeApprox());
+  EXPECT_FALSE(map.Get(0));
+  EXPECT_TRUE(map.Get(1));
+}
+
+UTEST(ConcurrentHashMap, GrowReclaimsOldTables) {
+  constexpr int kKeys = 1000;
+  concurrent::HashMap<std::shared_ptr<int>, int> map;
+
+  // Each table keeps its own copies of the keys
+  std::vector<std::shared_ptr<int>> keys;
+  for (int i = 0; i < kKeys; ++i) {
+    keys.push_back(std::make_shared<int>(i));
+    ASSERT_TRUE(map.Emplace(keys.back(), i).inserted);
+  }
+
+  for (const auto& key : keys) {
+    ASSERT_EQ(key.use_count(), 2) << "Key " << *key << " is held by old tables";
+  }
+}
+
+UTEST(ConcurrentHashMap, GrowWithSkewedHash) {
+  constexpr int kKeys = 1000;
+
+  // The identity std::hash<int> puts all the multiples of 64 into the same
+  // low bits
+  concurrent::HashMap<int, int> map;
+  for (int i = 0; i < kKeys; ++i) {
+    ASSERT_TRUE(map.Emplace(i * 64, i).inserted);
+  }
+  EXPECT_LE(map.GetBucketsCount(), 2 * kKeys);
+  for (int i = 0; i < kKeys; ++i) {
+    ASSERT_EQ(i, *map[i * 64]);
+  }
+
+  struct ConstantHash {
+    std::size_t operator()(int) const { return 42; }
+  };
+  concurrent::HashMap<int, int, ConstantHash> constant_map;
+  for (int i = 0; i < kKeys / 4; ++i) {
+    ASSERT_TRUE(constant_map.Emplace(i, i).inserted);
+  }
+  EXPECT_LE(constant_map.GetBucketsCount(), kKeys / 2);
+  EXPECT_EQ(kKeys / 4, constant_map.SizeApprox());
+}
+
+UTEST(ConcurrentHashMap, IterStability) {
+  concurrent::HashMap<int, int> map;
+  for (int i = 0; i < 10; ++i) *map[i] = i;
+
+  auto it = map.begin();
+  auto copy = it;
+
+  // erased and reallocated nodes are kept alive by the iterators
+  map.Clear();
+  for (int i = 100; i < 1000; ++i) *map[i] = i;
+
+  std::array<bool, 10> seen{};
+  for (; it != map.end(); ++it) {
+    ASSERT_TRUE(it->first >= 0 && it->first < static_cast<int>(seen.size()));
+    EXPECT_FALSE(std::exchange(seen[it->first], true));
+    EXPECT_EQ(it->first, *it->second);
+  }
+  EXPECT_EQ(seen, (std::array<bool, 10>{true, true, true, true, true, true,
+                                        true, true, true, true}));
+  EXPECT_EQ(copy->first, *copy->second);
+}
+
+UTEST_MT(ConcurrentHashMap, ConcurrentUpdates, 4) {
+  concurrent::HashMap<int, std::atomic<std::uint32_t>> map;
+  std::vector<engine::TaskWithResult<void>> tasks;
+  std::atomic<bool> stop_flag{false};
+
+  for (int i = 0; i < 3; ++i) {
+    tasks.push_back(utils::Async("writer", [i, &map, &stop_flag] {
+      const int base = i * 1000;
+      while (!stop_flag) {
+        for (int key = base; key < base + 1000; ++key) {
+          map.Emplace(key, key);
+        }
+        for (int key = base; key < base + 1000; ++key) {
+          ASSERT_EQ(key, map.Pop(key)->load());
+        }
+      }
+    }));
+  }
+  tasks.push_back(utils::Async("reader", [&map, &stop_flag] {
+    while (!stop_flag) {
+      for (int key = 0; key < 3000; ++key) {
+        const auto value = map.Get(key);
+        if (value) {
+          ASSERT_EQ(key, value->load());
+        }
+      }
+      for (const auto& [key, value] : map) {
+        ASSERT_EQ(key, value->load());
+      }
+    }
+  }));
+
+  engine::SleepFor(std::chrono::milliseconds(100));
+  stop_flag = true;
+  for (auto& task : tasks) task.Get();
+
+  EXPECT_EQ(0, map.SizeApprox());
+  EXPECT_EQ(map.begin(), map.end());
+}
+
+UTEST_MT(ConcurrentHashMap, ConcurrentTryEmplace, 16) {
+  const size_t kReps = 100;
+
+  for (size_t rep = 0; rep < kReps; rep++) {
+    concurrent::HashMap<std::string, int> map;
+
+    const size_t kTasks = 16;
+    std::atomic<size_t> insertions = 0;
+
+    std::vector<engine::TaskWithResult<void>> tasks;
+    for (size_t i = 0; i < kTasks; i++) {
+      tasks.push_back(engine::AsyncNoSpan([&map, &insertions, i] {
+        auto key = std::string(20 + i / 2, 'x');
+        auto res = map.TryEmplace(key, i);
+        if (res.inserted) ++insertions;
+        EXPECT_EQ(*res.value / 2, i / 2);
+      }));
+    }
+    for (auto& task : tasks) {
+      task.Get();
+    }
+    EXPECT_EQ(insertions, kTasks / 2);
+  }
+}
+
+UTEST(ConcurrentHashMap, Sample) {
+  /// [Sample concurrent::HashMap usage]
+  struct Data {
+    // Access to HashMap content must be synchronized via std::atomic
+    // or other synchronization primitives
+    std::atomic<int> x{0};
+    std::atomic<bool> flag{false};
+  };
+  concurrent::HashMap<std::string, Data> map;
+
+  // If the key is not in the dictionary,
+  // then a default object will be created
+  map["123"]->x++;
+  map["other_data"]->flag = true;
+  ASSERT_EQ(map["123"]->x.load(), 1);
+  ASSERT_EQ(map["123"]->flag.load(), false);
+  ASSERT_EQ(map["other_data"]->x.load(), 0);
+  ASSERT_EQ(map["other_data"]->flag.load(), true);
+
+  // Unlike rcu::RcuMap, erasing a key does not copy the map
+  EXPECT_TRUE(map.Erase("123"));
+  /// [Sample concurrent::HashMap usage]
+}
+
+USERVER_NAMESPACE_END
@@ -190,6 +190,7 @@ void easy::reset() {
   retries_count_ = 0;
   sockets_opened_ = 0;
   rate_limit_error_.clear();
+  write_callback_ = {};
 
   set_custom_request(nullptr);
   set_no_body(false);
@@ -233,7 +234,7 @@ void easy::set_source(std::shared_ptr<std::istream> source,
   if (!ec) set_seek_data(this, ec);
 }
 
-void easy::set_sink(std::string* sink) {
+void easy::set_sink(clients::http::impl::BodyChain* sink) {
   std::error_code ec;
   set_sink(sink, ec);
   throw_error(ec, "set_sink");
@@ -243,12 +244,27 @@ size_t easy::header_function(void*, size_t size, size_t nmemb, void*) {
   return size * nmemb;
 }
 
-void easy::set_sink(std::string* sink, std::error_code& ec) {
+void easy::set_sink(clients::http::impl::BodyChain* sink,
+                    std::error_code& ec) {
   sink_ = sink;
+  write_callback_ = {};
   set_write_function(&easy::write_function);
   if (!ec) set_write_data(this);
 }
 
+void easy::set_write_callback(write_callback_t write_callback) {
+  write_callback_ = std::move(write_callback);
+  sink_ = nullptr;
+  set_write_function(&easy::write_function);
+  set_write_data(this);
+}
+
+void easy::unpause() {
+  if (!multi_registered_) return;
+  // The transfer may be already finished, nothing to do in that case
+  native::curl_easy_pause(handle_, CURLPAUSE_CONT);
+}
+
 void easy::unset_progress_callback() {
   set_no_progress(true);
   set_xferinfo_function(nullptr);
@@ -605,7 +621,10 @@ size_t easy::write_function(char* ptr, size_t size, size_t nmemb,
   }
 
   try {
-    self->sink_->append(ptr, actual_size);
+    if (self->write_callback_) {
+      return self->write_callback_({ptr, actual_size});
+    }
+    self->sink_->Append({ptr, actual_size});
   } catch (const std::exception&) {
     // out of memory
     return 0;
@@ -721,6 +740,10 @@ native::curl_socket_t easy::opensocket(
           if (s != -1 && multi_handle) {
             multi_handle->Statistics().mark_open_socket();
             self->mark_open_socket();
+
+            std::error_code ec;
+            const auto url = self->get_effective_url(ec);
+            if (!ec) multi_handle->TrackOpenSocket(s, url);
           }
           return s;
 
@@ -745,6 +768,7 @@ native::curl_socket_t easy::opensocket(
 int easy::closesocket(void* clientp, native::curl_socket_t item) noexcept {
   auto* multi_handle = static_cast<multi*>(clientp);
   multi_handle->UnbindEasySocket(item);
+  multi_handle->UntrackSocket(item);
 
   int ret = close(item);
   if (ret == -1) {
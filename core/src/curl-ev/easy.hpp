@@ -22,6 +22,7 @@
 #include <curl-ev/ratelimit.hpp>
 #include <curl-ev/url.hpp>
 
+#include <userver/clients/http/impl/body_chain.hpp>
 #include <userver/clients/http/local_stats.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -180,8 +181,16 @@ class easy final : public std::enable_shared_from_this<easy> {
   void reset();
   void set_source(std::shared_ptr<std::istream> source);
   void set_source(std::shared_ptr<std::istream> source, std::error_code& ec);
-  void set_sink(std::string* sink);
-  void set_sink(std::string* sink, std::error_code& ec);
+  void set_sink(clients::http::impl::BodyChain* sink);
+  void set_sink(clients::http::impl::BodyChain* sink, std::error_code& ec);
+
+  /// Receives the response body data instead of the sink. May return
+  /// CURL_WRITEFUNC_PAUSE to pause receiving until unpause() is called.
+  using write_callback_t = std::function<std::size_t(std::string_view data)>;
+  void set_write_callback(write_callback_t write_callback);
+  /// Resumes the transfer paused by the write callback, must be called from
+  /// the libev thread
+  void unpause();
 
   using progress_callback_t =
       std::function<bool(native::curl_off_t dltotal, native::curl_off_t dlnow,
@@ -767,7 +776,8 @@ class easy final : public std::enable_shared_from_this<easy> {
   url url_;
   handler_type handler_;
   std::shared_ptr<std::istream> source_;
-  std::string* sink_{nullptr};
+  clients::http::impl::BodyChain* sink_{nullptr};
+  write_callback_t write_callback_;
   std::string post_fields_;
   std::shared_ptr<form> form_;
   std::shared_ptr<string_list> headers_;
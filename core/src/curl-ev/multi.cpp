@@ -6,6 +6,7 @@
         Integration of libcurl's multi interface with Boost.Asio
 */
 
+#include <algorithm>
 #include <cstring>
 #include <string_view>
 #include <system_error>
@@ -139,6 +140,59 @@ void multi::CheckRateLimit(const char* url_str, std::error_code& ec) {
   connect_rate_limiter_->Check(url_str, ec);
 }
 
+namespace {
+
+std::string_view ExtractOrigin(std::string_view url) {
+  constexpr std::string_view kSchemeSeparator = "://";
+  const auto authority_pos = url.find(kSchemeSeparator);
+  if (authority_pos == std::string_view::npos) return url;
+  return url.substr(0, url.find_first_of("/?#", authority_pos +
+                                                     kSchemeSeparator.size()));
+}
+
+}  // namespace
+
+void multi::SetTrackedUrls(const std::vector<std::string>& urls) {
+  tracked_origins_.clear();
+  tracked_origin_indexes_.clear();
+  for (const auto& url : urls) {
+    const auto origin = ExtractOrigin(url);
+    const auto it =
+        std::find(tracked_origins_.begin(), tracked_origins_.end(), origin);
+    tracked_origin_indexes_.push_back(it - tracked_origins_.begin());
+    tracked_origins_.emplace_back(origin);
+  }
+  tracked_sockets_ = std::make_unique<std::atomic<size_t>[]>(urls.size());
+}
+
+size_t multi::GetTrackedSocketsCount(size_t url_index) const {
+  UASSERT(url_index < tracked_origin_indexes_.size());
+  return tracked_sockets_[tracked_origin_indexes_[url_index]].load(
+      std::memory_order_relaxed);
+}
+
+void multi::TrackOpenSocket(native::curl_socket_t s, std::string_view url) {
+  if (tracked_origins_.empty()) return;
+
+  // The first URL of the origin is found, it is the one that is counted
+  const auto it = std::find(tracked_origins_.begin(), tracked_origins_.end(),
+                            ExtractOrigin(url));
+  if (it == tracked_origins_.end()) return;
+
+  const auto index = static_cast<size_t>(it - tracked_origins_.begin());
+  GetSocketInfo(s)->tracked_origin_index = index;
+  tracked_sockets_[index].fetch_add(1, std::memory_order_relaxed);
+}
+
+void multi::UntrackSocket(native::curl_socket_t s) {
+  if (tracked_origins_.empty()) return;
+
+  auto& index = GetSocketInfo(s)->tracked_origin_index;
+  if (!index) return;
+  tracked_sockets_[*index].fetch_sub(1, std::memory_order_relaxed);
+  index.reset();
+}
+
 void multi::SetMultiplexingEnabled(bool value) {
   SetOptionAsync(native::CURLMOPT_PIPELINING, value ? 1 : 0);
 }
@@ -8,10 +8,14 @@
 
 #pragma once
 
+#include <atomic>
 #include <functional>
 #include <map>
 #include <memory>
 #include <set>
+#include <string>
+#include <string_view>
+#include <vector>
 
 #include <curl-ev/error_code.hpp>
 #include <curl-ev/multi_statistics.hpp>
@@ -54,6 +58,14 @@ class multi final {
 
   void CheckRateLimit(const char* url_str, std::error_code& ec);
 
+  /// Starts counting the open sockets to the origins ("scheme://host:port")
+  /// of `urls`, must be called before the first request
+  void SetTrackedUrls(const std::vector<std::string>& urls);
+  /// Number of open sockets to the origin of the tracked URL with the index
+  size_t GetTrackedSocketsCount(size_t url_index) const;
+  void TrackOpenSocket(native::curl_socket_t s, std::string_view url);
+  void UntrackSocket(native::curl_socket_t s);
+
   void SetMultiplexingEnabled(bool);
   void SetMaxHostConnections(long);
   void SetConnectionCacheSize(long);
@@ -103,6 +115,11 @@ class multi final {
   engine::ev::ThreadControl& thread_control_;
   MultiStatistics statistics_;
   std::shared_ptr<ConnectRateLimiter> connect_rate_limiter_;
+
+  std::vector<std::string> tracked_origins_;
+  // index of the first tracked URL with the same origin
+  std::vector<size_t> tracked_origin_indexes_;
+  std::unique_ptr<std::atomic<size_t>[]> tracked_sockets_;
 };
 }  // namespace curl
 
@@ -6,6 +6,9 @@
 
 #pragma once
 
+#include <cstddef>
+#include <optional>
+
 #include <engine/ev/thread_control.hpp>
 #include <engine/ev/watcher/io_watcher.hpp>
 #include <userver/utils/assert.hpp>
@@ -30,6 +33,8 @@ struct socket_info {
   bool pending_write_op{false};
   bool monitor_read{false};
   bool monitor_write{false};
+  // see multi::TrackOpenSocket
+  std::optional<std::size_t> tracked_origin_index;
 };
 }  // namespace curl
 
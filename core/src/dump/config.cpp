@@ -19,6 +19,8 @@ constexpr std::string_view kDumpFormatVersion = "format-version";
 constexpr std::string_view kMaxDumpCount = "max-count";
 constexpr std::string_view kWorldReadable = "world-readable";
 constexpr std::string_view kEncrypted = "encrypted";
+constexpr std::string_view kCompression = "compression";
+constexpr std::string_view kMaxDeltaCount = "max-delta-count";
 
 constexpr auto kDefaultFsTaskProcessor = std::string_view{"fs-task-processor"};
 constexpr auto kDefaultMaxDumpCount = uint64_t{1};
@@ -44,6 +46,17 @@ std::chrono::milliseconds ParseMs(
 constexpr std::string_view kDump = "dump";
 constexpr std::string_view kMaxDumpAge = "max-age";
 
+CompressionType Parse(const yaml_config::YamlConfig& value,
+                      formats::parse::To<CompressionType>) {
+  const auto as_string = value.As<std::string>();
+
+  if (as_string == "none") return CompressionType::kNone;
+  if (as_string == "zlib") return CompressionType::kZlib;
+
+  throw yaml_config::ParseException(fmt::format(
+      "Invalid dump compression '{}' at '{}'", as_string, value.GetPath()));
+}
+
 ConfigPatch Parse(const formats::json::Value& value,
                   formats::parse::To<ConfigPatch>) {
   const auto min_dump_interval = value["min-dump-interval-ms"];
@@ -67,6 +80,9 @@ Config::Config(std::string name, const yaml_config::YamlConfig& config,
           config[kMaxDumpAge].As<std::optional<std::chrono::milliseconds>>()),
       max_dump_age_set(config.HasMember(kMaxDumpAge)),
       dump_is_encrypted(config[kEncrypted].As<bool>(false)),
+      compression(config[kCompression].As<CompressionType>(
+          CompressionType::kNone)),
+      max_delta_count(config[kMaxDeltaCount].As<uint64_t>(0)),
       dumps_enabled(config[kDumpsEnabled].As<bool>()),
       min_dump_interval(
           config[kMinDumpInterval].As<std::chrono::milliseconds>(0)) {
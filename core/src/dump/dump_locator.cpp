@@ -27,10 +27,15 @@ DumpLocator::DumpLocator()
     : filename_regex_(GenerateFilenameRegex(FileFormatType::kNormal)),
       tmp_filename_regex_(GenerateFilenameRegex(FileFormatType::kTmp)) {}
 
+TimePoint DumpChain::GetUpdateTime() const {
+  return deltas.empty() ? base.update_time : deltas.back().update_time;
+}
+
 DumpFileStats DumpLocator::RegisterNewDump(TimePoint update_time,
-                                           const Config& config) {
+                                           const Config& config,
+                                           DumpKind kind) {
   (void)this;  // silence tidy
-  std::string dump_path = GenerateDumpPath(update_time, config);
+  std::string dump_path = GenerateDumpPath(update_time, config, kind);
 
   if (boost::filesystem::exists(dump_path)) {
     throw std::runtime_error(fmt::format(
@@ -46,33 +51,69 @@ DumpFileStats DumpLocator::RegisterNewDump(TimePoint update_time,
                     config.name, dump_path, ex.what()));
   }
 
-  return {update_time, std::move(dump_path), config.dump_format_version};
+  return {update_time, std::move(dump_path), config.dump_format_version, kind};
 }
 
 std::optional<DumpFileStats> DumpLocator::GetLatestDump(
     const Config& config) const {
-  try {
-    std::optional<DumpFileStats> stats = GetLatestDumpImpl(config);
-    if (!stats) {
-      LOG_INFO() << config.name << ": no usable dumps found";
-      return std::nullopt;
+  const auto min_update_time = MinAcceptableUpdateTime(config);
+
+  for (auto& dump : ListDumps(config)) {
+    if (dump.kind != DumpKind::kFull) continue;
+
+    if (dump.update_time < min_update_time && config.max_dump_age) {
+      LOG_DEBUG() << "Ignoring dump \"" << dump.full_path
+                  << "\", because its age is greater than the maximum "
+                     "allowed dump age ("
+                  << config.max_dump_age->count() << "ms)";
+      break;
     }
 
     LOG_DEBUG() << config.name << ": a usable dump found, path=\""
-                << stats->full_path << "\"";
+                << dump.full_path << "\"";
+    return std::move(dump);
+  }
 
-    return *std::move(stats);
-  } catch (const std::exception& ex) {
-    LOG_ERROR() << config.name
-                << ": error while trying to read the contents of dump. Cause: "
-                << ex;
-    return std::nullopt;
+  LOG_INFO() << config.name << ": no usable dumps found";
+  return std::nullopt;
+}
+
+std::optional<DumpChain> DumpLocator::GetLatestDumpChain(
+    const Config& config) const {
+  auto dumps = ListDumps(config);
+
+  std::vector<DumpFileStats> deltas;
+  for (auto& dump : dumps) {
+    if (dump.kind == DumpKind::kDelta) {
+      deltas.push_back(std::move(dump));
+      continue;
+    }
+
+    std::reverse(deltas.begin(), deltas.end());
+    DumpChain chain{std::move(dump), std::move(deltas)};
+
+    if (chain.GetUpdateTime() < MinAcceptableUpdateTime(config) &&
+        config.max_dump_age) {
+      LOG_DEBUG() << "Ignoring dump \"" << chain.base.full_path
+                  << "\", because its age is greater than the maximum "
+                     "allowed dump age ("
+                  << config.max_dump_age->count() << "ms)";
+      break;
+    }
+
+    LOG_DEBUG() << config.name << ": a usable dump found, path=\""
+                << chain.base.full_path
+                << "\", delta-count=" << chain.deltas.size();
+    return chain;
   }
+
+  LOG_INFO() << config.name << ": no usable dumps found";
+  return std::nullopt;
 }
 
 bool DumpLocator::BumpDumpTime(TimePoint old_update_time,
-                               TimePoint new_update_time,
-                               const Config& config) {
+                               TimePoint new_update_time, const Config& config,
+                               DumpKind kind) {
   (void)this;  // silence tidy
   if (new_update_time < old_update_time) {
     LOG_WARNING() << config.name << ": new_update_time < old_update_time, new="
@@ -83,8 +124,10 @@ bool DumpLocator::BumpDumpTime(TimePoint old_update_time,
                                                  kFilenameDateFormat);
   }
 
-  const std::string old_name = GenerateDumpPath({old_update_time}, config);
-  const std::string new_name = GenerateDumpPath({new_update_time}, config);
+  const std::string old_name =
+      GenerateDumpPath({old_update_time}, config, kind);
+  const std::string new_name =
+      GenerateDumpPath({new_update_time}, config, kind);
 
   try {
     if (!boost::filesystem::is_regular_file(old_name)) {
@@ -139,7 +182,8 @@ void DumpLocator::Cleanup(const Config& config) {
       }
 
       if (dump->format_version < config.dump_format_version ||
-          dump->update_time < min_update_time) {
+          (dump->format_version > config.dump_format_version &&
+           dump->update_time < min_update_time)) {
         LOG_DEBUG() << config.name << ": removing an expired dump, path=\""
                     << file.path().string() << "\"";
         boost::filesystem::remove(file);
@@ -156,10 +200,27 @@ void DumpLocator::Cleanup(const Config& config) {
                 return a.update_time > b.update_time;
               });
 
-    for (size_t i = config.max_dump_count; i < dumps.size(); ++i) {
-      LOG_DEBUG() << config.name << ": removing an excessive dump \""
-                  << dumps[i].full_path << "\"";
-      boost::filesystem::remove(dumps[i].full_path);
+    // The newest dump of a chain comes first, and the full dump ends it
+    std::size_t chain_index = 0;
+    std::optional<TimePoint> chain_update_time;
+    for (const auto& dump : dumps) {
+      if (!chain_update_time) chain_update_time = dump.update_time;
+      const bool is_expired = *chain_update_time < min_update_time;
+      const bool is_excessive = chain_index >= config.max_dump_count;
+      if (dump.kind == DumpKind::kFull) {
+        ++chain_index;
+        chain_update_time.reset();
+      }
+
+      if (is_expired) {
+        LOG_DEBUG() << config.name << ": removing an expired dump, path=\""
+                    << dump.full_path << "\"";
+        boost::filesystem::remove(dump.full_path);
+      } else if (is_excessive) {
+        LOG_DEBUG() << config.name << ": removing an excessive dump \""
+                    << dump.full_path << "\"";
+        boost::filesystem::remove(dump.full_path);
+      }
     }
   } catch (const std::exception& ex) {
     LOG_ERROR() << config.name
@@ -173,7 +234,7 @@ std::optional<DumpFileStats> DumpLocator::ParseDumpName(
 
   boost::smatch regex;
   if (boost::regex_match(filename, regex, filename_regex_)) {
-    UASSERT_MSG(regex.size() == 3,
+    UASSERT_MSG(regex.size() == 4,
                 fmt::format("Incorrect sub-match count: {} for filename {}",
                             regex.size(), filename));
 
@@ -185,7 +246,9 @@ std::optional<DumpFileStats> DumpLocator::ParseDumpName(
       const auto date =
           utils::datetime::Stringtime(date_string, kTimeZone, date_format);
       const auto version = utils::FromString<uint64_t>(regex[2].str());
-      return DumpFileStats{{Round(date)}, std::move(full_path), version};
+      const auto kind =
+          regex[3].matched ? DumpKind::kDelta : DumpKind::kFull;
+      return DumpFileStats{{Round(date)}, std::move(full_path), version, kind};
     } catch (const std::exception& ex) {
       LOG_WARNING() << "A filename looks like a dump, but it is not, path=\""
                     << filename << "\". Reason: " << ex;
@@ -195,10 +258,8 @@ std::optional<DumpFileStats> DumpLocator::ParseDumpName(
   return std::nullopt;
 }
 
-std::optional<DumpFileStats> DumpLocator::GetLatestDumpImpl(
-    const Config& config) const {
-  const auto min_update_time = MinAcceptableUpdateTime(config);
-  std::optional<DumpFileStats> best_dump;
+std::vector<DumpFileStats> DumpLocator::ListDumps(const Config& config) const {
+  std::vector<DumpFileStats> dumps;
 
   try {
     if (!boost::filesystem::exists(config.dump_directory)) {
@@ -234,38 +295,33 @@ std::optional<DumpFileStats> DumpLocator::GetLatestDumpImpl(
         continue;
       }
 
-      if (curr_dump->update_time < min_update_time && config.max_dump_age) {
-        LOG_DEBUG() << "Ignoring dump \"" << curr_dump->full_path
-                    << "\", because its age is greater than the maximum "
-                       "allowed dump age ("
-                    << config.max_dump_age->count() << "ms)";
-        continue;
-      }
-
-      if (!best_dump || curr_dump->update_time > best_dump->update_time) {
-        best_dump = std::move(curr_dump);
-      }
+      dumps.push_back(std::move(*curr_dump));
     }
   } catch (const std::exception& ex) {
     LOG_ERROR() << config.name
                 << ": error while trying to fetch dumps. Cause: " << ex;
-    // proceed to return best_dump
+    // proceed to return the dumps found so far
   }
 
-  return best_dump ? std::optional{std::move(best_dump)} : std::nullopt;
+  std::sort(dumps.begin(), dumps.end(),
+            [](const DumpFileStats& a, const DumpFileStats& b) {
+              return a.update_time > b.update_time;
+            });
+  return dumps;
 }
 
 std::string DumpLocator::GenerateDumpPath(TimePoint update_time,
-                                          const Config& config) {
+                                          const Config& config,
+                                          DumpKind kind) {
   return fmt::format(
-      FMT_COMPILE("{}/{}-v{}"), config.dump_directory,
+      FMT_COMPILE("{}/{}-v{}{}"), config.dump_directory,
       utils::datetime::Timestring(update_time, kTimeZone, kFilenameDateFormat),
-      config.dump_format_version);
+      config.dump_format_version, kind == DumpKind::kDelta ? ".delta" : "");
 }
 
 std::string DumpLocator::GenerateFilenameRegex(FileFormatType type) {
   return std::string{
-             R"(^(\d{4}-\d{2}-\d{2}T\d{2}:?\d{2}:?\d{2}\.\d{6}Z?)-v(\d+))"} +
+             R"(^(\d{4}-\d{2}-\d{2}T\d{2}:?\d{2}:?\d{2}\.\d{6}Z?)-v(\d+)(\.delta)?)"} +
          (type == FileFormatType::kTmp ? "\\.tmp$" : "$");
 }
 
@@ -4,6 +4,7 @@
 #include <optional>
 #include <string>
 #include <string_view>
+#include <vector>
 
 #include <boost/regex.hpp>
 
@@ -17,10 +18,23 @@ namespace dump {
 const std::string kFilenameDateFormat = "%Y-%m-%dT%H%M%E6SZ";
 const std::string kLegacyFilenameDateFormat = "%Y-%m-%dT%H:%M:%E6S";
 
+/// A full dump contains all the data, a delta dump contains the changes made
+/// since the previous dump of the same chain
+enum class DumpKind { kFull, kDelta };
+
 struct DumpFileStats final {
   TimePoint update_time;
   std::string full_path;
   uint64_t format_version;
+  DumpKind kind{DumpKind::kFull};
+};
+
+/// A full dump and the deltas written on top of it, ordered by `update_time`
+struct DumpChain final {
+  TimePoint GetUpdateTime() const;
+
+  DumpFileStats base;
+  std::vector<DumpFileStats> deltas;
 };
 
 /// @brief Manages dump files on disk. Encapsulates file paths and naming scheme
@@ -34,21 +48,30 @@ class DumpLocator final {
   /// @note The operation is blocking, and should run in FS TaskProcessor
   /// @note The actual creation of the file is a caller's responsibility
   /// @throws On a filesystem error
-  DumpFileStats RegisterNewDump(TimePoint update_time, const Config& config);
+  DumpFileStats RegisterNewDump(TimePoint update_time, const Config& config,
+                                DumpKind kind = DumpKind::kFull);
 
-  /// @brief Finds the latest suitable dump
+  /// @brief Finds the latest suitable full dump, ignoring the deltas
   /// @note The operation is blocking, and should run in FS TaskProcessor
   /// @returns The full path of the dump if available and fresh enough,
   /// or `nullopt` otherwise
   std::optional<DumpFileStats> GetLatestDump(const Config& config) const;
 
+  /// @brief Finds the latest full dump together with the deltas written
+  /// on top of it
+  /// @note The operation is blocking, and should run in FS TaskProcessor
+  /// @returns The chain if available and its last dump is fresh enough,
+  /// or `nullopt` otherwise
+  std::optional<DumpChain> GetLatestDumpChain(const Config& config) const;
+
   /// @brief Modifies the update time for a dump
   /// @note The operation is blocking, and should run in FS TaskProcessor
   /// @return `true` on success, `false` if the dump is not available
   bool BumpDumpTime(TimePoint old_update_time, TimePoint new_update_time,
-                    const Config& config);
+                    const Config& config, DumpKind kind = DumpKind::kFull);
 
-  /// @brief Removes old dumps and tmp files
+  /// @brief Removes old dumps and tmp files. A chain is expired or removed
+  /// as a whole, `max-count` limits the number of chains.
   /// @note The operation is blocking, and should run in FS TaskProcessor
   /// @warning Must not be called concurrently with `RegisterNewDump`
   void Cleanup(const Config& config);
@@ -58,10 +81,12 @@ class DumpLocator final {
 
   std::optional<DumpFileStats> ParseDumpName(std::string full_path) const;
 
-  std::optional<DumpFileStats> GetLatestDumpImpl(const Config& config) const;
+  /// @returns the usable dumps of the current format version, newest first
+  std::vector<DumpFileStats> ListDumps(const Config& config) const;
 
   static std::string GenerateDumpPath(TimePoint update_time,
-                                      const Config& config);
+                                      const Config& config,
+                                      DumpKind kind = DumpKind::kFull);
 
   static std::string GenerateFilenameRegex(FileFormatType type);
 
@@ -268,4 +268,64 @@ max-age: 30m
   }
 }
 
+UTEST(DumpLocator, DeltaChains) {
+  using namespace std::chrono_literals;
+
+  const std::string kConfig = R"(
+enable: true
+world-readable: false
+format-version: 5
+max-count: 1
+max-age: 2500ms
+)";
+  const auto dir = fs::blocking::TempDirectory::Create();
+
+  dump::CreateDumps(
+      {
+          "2015-03-22T085900.000000Z-v5",
+          "2015-03-22T085901.000000Z-v5.delta",
+          "2015-03-22T090000.000000Z-v5",
+          "2015-03-22T090001.000000Z-v5.delta",
+          "2015-03-22T090002.000000Z-v5",
+          "2015-03-22T090003.000000Z-v5.delta",
+          "2015-03-22T090004.000000Z-v5.delta",
+          "2015-03-22T090005.000000Z-v5.delta.tmp",
+      },
+      dir, kDumperName);
+
+  utils::datetime::MockNowSet(BaseTime() + 6s);
+
+  const dump::Config config{dump::ConfigFromYaml(kConfig, dir, kDumperName)};
+  dump::DumpLocator locator;
+
+  {
+    // The base is older than max-age, but the chain is fresh
+    const auto chain = locator.GetLatestDumpChain(config);
+    ASSERT_TRUE(chain);
+    EXPECT_EQ(Filename(chain->base.full_path), "2015-03-22T090002.000000Z-v5");
+    ASSERT_EQ(chain->deltas.size(), 2);
+    EXPECT_EQ(Filename(chain->deltas[0].full_path),
+              "2015-03-22T090003.000000Z-v5.delta");
+    EXPECT_EQ(chain->deltas[1].kind, dump::DumpKind::kDelta);
+    EXPECT_EQ(chain->GetUpdateTime(), BaseTime() + 4s);
+  }
+
+  // Chains are removed as a whole
+  locator.Cleanup(config);
+  EXPECT_EQ(dump::FilenamesInDirectory(dir, kDumperName),
+            (std::set<std::string>{"2015-03-22T090002.000000Z-v5",
+                                   "2015-03-22T090003.000000Z-v5.delta",
+                                   "2015-03-22T090004.000000Z-v5.delta"}));
+
+  // Only the last dump of a chain may be bumped
+  EXPECT_TRUE(locator.BumpDumpTime(BaseTime() + 4s, BaseTime() + 5s, config,
+                                   dump::DumpKind::kDelta));
+  const auto chain = locator.GetLatestDumpChain(config);
+  ASSERT_TRUE(chain);
+  EXPECT_EQ(chain->GetUpdateTime(), BaseTime() + 5s);
+
+  utils::datetime::MockSleep(10s);
+  EXPECT_FALSE(locator.GetLatestDumpChain(config));
+}
+
 USERVER_NAMESPACE_END
@@ -1,5 +1,8 @@
 #include <userver/dump/dumper.hpp>
 
+#include <utility>
+#include <vector>
+
 #include <fmt/format.h>
 #include <boost/filesystem/operations.hpp>
 
@@ -31,6 +34,7 @@
 #include <userver/components/dump_configurator.hpp>
 #include <userver/dump/config.hpp>
 #include <userver/dump/factory.hpp>
+#include <userver/dump/unsafe.hpp>
 #include <userver/testsuite/dump_control.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -45,13 +49,49 @@ void ThrowDumpUnimplemented(const std::string& name) {
 
 DumpableEntity::~DumpableEntity() = default;
 
+bool DumpableEntity::GetAndWriteDelta(Writer&) const { return false; }
+
+void DumpableEntity::ReadAndSetWithDeltas(
+    Reader& reader, const std::vector<std::unique_ptr<Reader>>& deltas) {
+  if (!deltas.empty()) {
+    throw Error("Delta dumps are not supported by this DumpableEntity");
+  }
+  ReadAndSet(reader);
+}
+
 namespace {
 
+// Counts the bytes before compression and encryption
+class CountingWriter final : public Writer {
+ public:
+  explicit CountingWriter(Writer& inner) : inner_(inner) {}
+
+  void Finish() override { inner_.Finish(); }
+
+  std::uint64_t GetSize() const { return size_; }
+
+ private:
+  void WriteRaw(std::string_view data) override {
+    size_ += data.size();
+    WriteStringViewUnsafe(inner_, data);
+  }
+
+  Writer& inner_;
+  std::uint64_t size_{0};
+};
+
 struct UpdateTime final {
   TimePoint last_update;
   TimePoint last_modifying_update;
 };
 
+// The latest full dump and the deltas written on top of it
+struct DumpChainState final {
+  std::size_t delta_count{0};
+  std::uint64_t base_size{0};
+  std::uint64_t deltas_size{0};
+};
+
 struct DumpData {
   DumpData(std::unique_ptr<OperationsFactory> rw_factory,
            DumpableEntity& dumpable)
@@ -63,6 +103,9 @@ struct DumpData {
   DumpableEntity& dumpable;
   DumpLocator locator;
   std::optional<UpdateTime> dumped_update_time;
+  DumpKind dumped_kind{DumpKind::kFull};
+  // null if the next dump must be a full one
+  std::optional<DumpChainState> chain;
 };
 
 struct DumpTaskData {
@@ -118,6 +161,8 @@ class Dumper::Impl {
   bool ShouldDump(DumpType type, std::optional<UpdateTime> update_time,
                   DumpTaskData& dump_task_data, const Config& config);
 
+  bool ShouldWriteDelta(const DumpData& dump_data, const Config& config) const;
+
   /// @throws On dump failure
   void DoDump(TimePoint update_time, tracing::ScopeTime& scope,
               DumpData& dump_data, const Config& config);
@@ -305,26 +350,87 @@ bool Dumper::Impl::ShouldDump(DumpType type,
   return true;
 }
 
+bool Dumper::Impl::ShouldWriteDelta(const DumpData& dump_data,
+                                    const Config& config) const {
+  const auto& chain = dump_data.chain;
+  if (config.max_delta_count == 0 || !chain) return false;
+
+  // Compact the chain into a new full dump, so that it does not take too long
+  // to replay it and the disk space is reclaimed by Cleanup
+  if (chain->delta_count >= config.max_delta_count ||
+      chain->deltas_size >= chain->base_size) {
+    LOG_INFO() << Name() << ": compacting " << chain->delta_count
+               << " delta dumps into a full dump";
+    return false;
+  }
+  return true;
+}
+
 void Dumper::Impl::DoDump(TimePoint update_time, tracing::ScopeTime& scope,
                           DumpData& dump_data, const Config& config) {
   const auto dump_start = std::chrono::steady_clock::now();
 
   std::uint64_t dump_size = 0;
-  try {
-    auto dump_stats = dump_data.locator.RegisterNewDump(update_time, config);
+  std::uint64_t raw_size = 0;
+  auto kind =
+      ShouldWriteDelta(dump_data, config) ? DumpKind::kDelta : DumpKind::kFull;
+  // The changes are consumed by GetAndWriteDelta, so if the dump fails, only a
+  // full dump can be written next
+  auto chain = std::exchange(dump_data.chain, std::nullopt);
+
+  const auto write_dump = [&](DumpKind dump_kind,
+                              const auto& write_contents) {
+    auto dump_stats =
+        dump_data.locator.RegisterNewDump(update_time, config, dump_kind);
     const auto& dump_path = dump_stats.full_path;
     auto writer = dump_data.rw_factory->CreateWriter(dump_path, scope);
-    dump_data.dumpable.GetAndWrite(*writer);
-    writer->Finish();
+    CountingWriter counting_writer(*writer);
+    // An unfinished tmp file is removed on the next Cleanup
+    if (!write_contents(counting_writer)) return false;
+    counting_writer.Finish();
     dump_size = boost::filesystem::file_size(dump_path);
+    raw_size = counting_writer.GetSize();
+    return true;
+  };
+
+  try {
+    if (kind == DumpKind::kDelta &&
+        !write_dump(kind, [&](Writer& writer) {
+          return dump_data.dumpable.GetAndWriteDelta(writer);
+        })) {
+      LOG_INFO() << Name() << ": the changes since the previous dump are "
+                              "unknown, writing a full dump";
+      kind = DumpKind::kFull;
+    }
+
+    if (kind == DumpKind::kFull) {
+      write_dump(kind, [&](Writer& writer) {
+        dump_data.dumpable.GetAndWrite(writer);
+        return true;
+      });
+    }
   } catch (const std::exception& ex) {
     LOG_ERROR() << Name() << ": error while writing a dump. Reason: " << ex;
     throw;
   }
 
-  LOG_INFO() << Name() << ": a new dump has been written";
+  if (kind == DumpKind::kFull) {
+    chain = DumpChainState{0, dump_size, 0};
+  } else {
+    ++chain->delta_count;
+    chain->deltas_size += dump_size;
+  }
+  dump_data.chain = chain;
+  dump_data.dumped_kind = kind;
+
+  LOG_INFO() << Name() << ": a new "
+             << (kind == DumpKind::kFull ? "full" : "delta")
+             << " dump has been written";
 
   statistics_.last_written_size = dump_size;
+  statistics_.last_written_raw_size = raw_size;
+  statistics_.last_written_is_delta = kind == DumpKind::kDelta;
+  statistics_.delta_chain_length = chain->delta_count;
   statistics_.last_nontrivial_write_duration =
       std::chrono::duration_cast<std::chrono::milliseconds>(
           std::chrono::steady_clock::now() - dump_start);
@@ -368,7 +474,8 @@ void Dumper::Impl::DumpAsync(DumpOperation operation_type,
               const auto dumped_update_time =
                   dump_data->dumped_update_time->last_update;
               if (!dump_data->locator.BumpDumpTime(
-                      dumped_update_time, update_time.last_update, *config)) {
+                      dumped_update_time, update_time.last_update, *config,
+                      dump_data->dumped_kind)) {
                 DoDump(update_time.last_update, scope_time, *dump_data,
                        *config);
               }
@@ -434,18 +541,37 @@ std::optional<TimePoint> Dumper::Impl::LoadFromDump(DumpData& dump_data,
     return {};
   }
 
+  // The data is replaced even if the read fails midway
+  dump_data.chain.reset();
+
   const std::optional<TimePoint> update_time =
       utils::Async(fs_task_processor_, "read-dump", [&] {
         try {
-          auto dump_stats = dump_data.locator.GetLatestDump(config);
-          if (!dump_stats) return std::optional<TimePoint>{};
+          auto chain = dump_data.locator.GetLatestDumpChain(config);
+          if (!chain) return std::optional<TimePoint>{};
 
           auto reader =
-              dump_data.rw_factory->CreateReader(dump_stats->full_path);
-          dump_data.dumpable.ReadAndSet(*reader);
+              dump_data.rw_factory->CreateReader(chain->base.full_path);
+          std::vector<std::unique_ptr<Reader>> delta_readers;
+          DumpChainState chain_state{
+              chain->deltas.size(),
+              boost::filesystem::file_size(chain->base.full_path), 0};
+          for (const auto& delta : chain->deltas) {
+            delta_readers.push_back(
+                dump_data.rw_factory->CreateReader(delta.full_path));
+            chain_state.deltas_size +=
+                boost::filesystem::file_size(delta.full_path);
+          }
+
+          dump_data.dumpable.ReadAndSetWithDeltas(*reader, delta_readers);
           reader->Finish();
+          for (auto& delta_reader : delta_readers) delta_reader->Finish();
 
-          return std::optional{dump_stats->update_time};
+          dump_data.chain = chain_state;
+          dump_data.dumped_kind =
+              chain->deltas.empty() ? DumpKind::kFull : DumpKind::kDelta;
+          statistics_.delta_chain_length = chain_state.delta_count;
+          return std::optional{chain->GetUpdateTime()};
         } catch (const std::exception& ex) {
           LOG_ERROR() << Name()
                       << ": error while reading a dump. Reason: " << ex;
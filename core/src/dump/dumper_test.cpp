@@ -263,6 +263,109 @@ UTEST_F(DumperFixture, DontWriteBackTheDumpAfterReading) {
 
 namespace {
 
+// Appends values, the delta dumps contain the appended values
+struct AppendOnlyEntity final : public dump::DumpableEntity {
+  static constexpr auto kName = "append-only";
+
+  void GetAndWrite(dump::Writer& writer) const override {
+    writer.Write(values);
+    changes.clear();
+    ++full_write_count;
+  }
+
+  void ReadAndSet(dump::Reader& reader) override {
+    values = reader.Read<std::vector<int>>();
+    changes.clear();
+  }
+
+  bool GetAndWriteDelta(dump::Writer& writer) const override {
+    writer.Write(changes);
+    changes.clear();
+    ++delta_write_count;
+    return true;
+  }
+
+  void ReadAndSetWithDeltas(
+      dump::Reader& reader,
+      const std::vector<std::unique_ptr<dump::Reader>>& deltas) override {
+    ReadAndSet(reader);
+    for (const auto& delta : deltas) {
+      for (const auto value : delta->Read<std::vector<int>>()) {
+        values.push_back(value);
+      }
+    }
+  }
+
+  void Append(int value) {
+    values.push_back(value);
+    changes.push_back(value);
+  }
+
+  std::vector<int> values;
+  mutable std::vector<int> changes;
+  mutable int full_write_count{0};
+  mutable int delta_write_count{0};
+};
+
+}  // namespace
+
+UTEST(Dumper, DeltaDumps) {
+  using namespace std::chrono_literals;
+
+  const auto root = fs::blocking::TempDirectory::Create();
+  const auto config = dump::ConfigFromYaml(kConfig + "max-delta-count: 2\n",
+                                           root, AppendOnlyEntity::kName);
+  testsuite::DumpControl control;
+  utils::statistics::Storage statistics_storage;
+  dynamic_config::StorageMock config_storage{{dump::kConfigSet, {}}};
+
+  const auto make_dumper = [&](dump::DumpableEntity& dumpable) {
+    return dump::Dumper{config,
+                        dump::CreateDefaultOperationsFactory(config),
+                        engine::current_task::GetTaskProcessor(),
+                        config_storage.GetSource(),
+                        statistics_storage,
+                        control,
+                        dumpable};
+  };
+
+  utils::datetime::MockNowSet({});
+  AppendOnlyEntity entity;
+  {
+    auto dumper = make_dumper(entity);
+    // The base must be bigger than the deltas to avoid an early compaction
+    for (int i = 0; i < 100; ++i) entity.Append(i);
+
+    for (int i = 100; i < 104; ++i) {
+      entity.Append(i);
+      dumper.OnUpdateCompleted(Now(), dump::UpdateType::kModified);
+      dumper.WriteDumpSyncDebug();
+      utils::datetime::MockSleep(1s);
+    }
+    // full, delta, delta, then the chain is compacted into a new full dump
+    EXPECT_EQ(entity.full_write_count, 2);
+    EXPECT_EQ(entity.delta_write_count, 2);
+
+    entity.Append(104);
+    dumper.OnUpdateCompleted(Now(), dump::UpdateType::kModified);
+    dumper.WriteDumpSyncDebug();
+    EXPECT_EQ(entity.delta_write_count, 3);
+
+    // The last delta is renamed
+    utils::datetime::MockSleep(1s);
+    dumper.OnUpdateCompleted(Now(), dump::UpdateType::kAlreadyUpToDate);
+    dumper.WriteDumpSyncDebug();
+    EXPECT_EQ(entity.delta_write_count, 3);
+  }
+
+  AppendOnlyEntity restored;
+  auto dumper = make_dumper(restored);
+  dumper.ReadDumpDebug();
+  EXPECT_EQ(restored.values, entity.values);
+}
+
+namespace {
+
 /// [Sample Dumper usage]
 class SampleComponentWithDumps final : public components::LoggableComponentBase,
                                        private dump::DumpableEntity {
@@ -1,6 +1,7 @@
 #include <userver/dump/factory.hpp>
 
 #include <dump/secdist.hpp>
+#include <userver/dump/operations_compressed.hpp>
 #include <userver/dump/operations_encrypted.hpp>
 #include <userver/dump/operations_file.hpp>
 #include <userver/storages/secdist/component.hpp>
@@ -19,6 +20,14 @@ boost::filesystem::perms GetPerms(const Config& config) {
     return perms::owner_read;
 }
 
+std::unique_ptr<dump::OperationsFactory> WithCompression(
+    std::unique_ptr<dump::OperationsFactory> factory, const Config& config) {
+  if (config.compression == CompressionType::kNone) return factory;
+  // compressed data is encrypted, not vice versa
+  return std::make_unique<dump::CompressedOperationsFactory>(
+      std::move(factory), config.compression);
+}
+
 }  // namespace
 
 std::unique_ptr<dump::OperationsFactory> CreateOperationsFactory(
@@ -28,17 +37,20 @@ std::unique_ptr<dump::OperationsFactory> CreateOperationsFactory(
   if (config.dump_is_encrypted) {
     const auto& secdist = context.FindComponent<components::Secdist>().Get();
     auto secret_key = secdist.Get<dump::Secdist>().GetSecretKey(config.name);
-    return std::make_unique<dump::EncryptedOperationsFactory>(
-        std::move(secret_key), dump_perms);
+    return WithCompression(std::make_unique<dump::EncryptedOperationsFactory>(
+                               std::move(secret_key), dump_perms),
+                           config);
   } else {
-    return std::make_unique<dump::FileOperationsFactory>(dump_perms);
+    return WithCompression(
+        std::make_unique<dump::FileOperationsFactory>(dump_perms), config);
   }
 }
 
 std::unique_ptr<dump::OperationsFactory> CreateDefaultOperationsFactory(
     const Config& config) {
   auto dump_perms = GetPerms(config);
-  return std::make_unique<dump::FileOperationsFactory>(dump_perms);
+  return WithCompression(
+      std::make_unique<dump::FileOperationsFactory>(dump_perms), config);
 }
 
 }  // namespace dump
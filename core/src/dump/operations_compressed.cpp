@@ -0,0 +1,212 @@
+#include <userver/dump/operations_compressed.hpp>
+
+#include <algorithm>
+#include <utility>
+
+#include <fmt/format.h>
+#include <zlib.h>
+
+#include <userver/dump/common.hpp>
+#include <userver/dump/unsafe.hpp>
+#include <userver/utils/assert.hpp>
+#include <userver/utils/async.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace dump {
+
+namespace {
+
+// big enough for a good compression ratio, small enough to parallelize
+constexpr std::size_t kBlockSize = 1 << 20;
+constexpr std::size_t kMaxBlocksInFlight = 8;
+// dumps are written after each update, prefer speed over the ratio
+constexpr int kZlibLevel = 1;
+
+std::string Compress(std::string_view data, CompressionType compression) {
+  switch (compression) {
+    case CompressionType::kNone:
+      return std::string{data};
+    case CompressionType::kZlib: {
+      auto size = compressBound(data.size());
+      std::string result(size, '\0');
+      const auto status =
+          compress2(reinterpret_cast<Bytef*>(result.data()), &size,
+                    reinterpret_cast<const Bytef*>(data.data()), data.size(),
+                    kZlibLevel);
+      if (status != Z_OK) {
+        throw Error(
+            fmt::format("Failed to compress a dump block: status={}", status));
+      }
+      result.resize(size);
+      return result;
+    }
+  }
+
+  UINVARIANT(false, "Unexpected compression type");
+}
+
+std::string Decompress(std::string_view data, std::size_t raw_size,
+                       CompressionType compression) {
+  switch (compression) {
+    case CompressionType::kNone:
+      if (data.size() != raw_size) {
+        throw Error("Unexpected dump block size");
+      }
+      return std::string{data};
+    case CompressionType::kZlib: {
+      std::string result(raw_size, '\0');
+      uLongf size = raw_size;
+      const auto status =
+          uncompress(reinterpret_cast<Bytef*>(result.data()), &size,
+                     reinterpret_cast<const Bytef*>(data.data()), data.size());
+      if (status != Z_OK || size != raw_size) {
+        throw Error(fmt::format(
+            "Failed to decompress a dump block: status={}, size={}, "
+            "expected-size={}",
+            status, size, raw_size));
+      }
+      return result;
+    }
+  }
+
+  UINVARIANT(false, "Unexpected compression type");
+}
+
+}  // namespace
+
+CompressedWriter::CompressedWriter(std::unique_ptr<Writer> inner,
+                                   CompressionType compression)
+    : inner_(std::move(inner)), compression_(compression) {
+  UASSERT(inner_);
+  buffer_.reserve(kBlockSize);
+}
+
+CompressedWriter::~CompressedWriter() = default;
+
+void CompressedWriter::WriteRaw(std::string_view data) {
+  while (!data.empty()) {
+    const auto size = std::min(data.size(), kBlockSize - buffer_.size());
+    buffer_.append(data.substr(0, size));
+    data.remove_prefix(size);
+    if (buffer_.size() == kBlockSize) SubmitBlock();
+  }
+}
+
+void CompressedWriter::Finish() {
+  if (!buffer_.empty()) SubmitBlock();
+  for (auto& task : pending_) WriteBlock(task.Get());
+  pending_.clear();
+
+  // end-of-data marker
+  inner_->Write(std::size_t{0});
+  inner_->Finish();
+}
+
+void CompressedWriter::SubmitBlock() {
+  if (pending_.size() >= kMaxBlocksInFlight) {
+    WriteBlock(pending_.front().Get());
+    pending_.pop_front();
+  }
+
+  pending_.push_back(utils::Async(
+      "compress-dump-block",
+      [compression = compression_, raw = std::move(buffer_)] {
+        return Block{raw.size(), Compress(raw, compression)};
+      }));
+
+  buffer_ = std::string{};
+  buffer_.reserve(kBlockSize);
+}
+
+void CompressedWriter::WriteBlock(const Block& block) {
+  inner_->Write(block.raw_size);
+  inner_->Write(std::string_view{block.data});
+}
+
+CompressedReader::CompressedReader(std::unique_ptr<Reader> inner,
+                                   CompressionType compression)
+    : inner_(std::move(inner)), compression_(compression) {
+  UASSERT(inner_);
+}
+
+CompressedReader::~CompressedReader() = default;
+
+std::string_view CompressedReader::ReadRaw(std::size_t max_size) {
+  if (block_.size() - position_ >= max_size) {
+    const auto result = std::string_view{block_}.substr(position_, max_size);
+    position_ += max_size;
+    return result;
+  }
+
+  buffer_.clear();
+  while (buffer_.size() < max_size) {
+    if (position_ == block_.size() && !NextBlock()) break;
+    const auto chunk = std::string_view{block_}.substr(
+        position_, max_size - buffer_.size());
+    buffer_.append(chunk);
+    position_ += chunk.size();
+  }
+  return buffer_;
+}
+
+void CompressedReader::Finish() {
+  if (position_ != block_.size() || NextBlock()) {
+    throw Error("Unexpected extra data at the end of the compressed dump");
+  }
+  inner_->Finish();
+}
+
+void CompressedReader::ReadAhead() {
+  while (!inner_finished_ && pending_.size() < kMaxBlocksInFlight) {
+    const auto raw_size = inner_->Read<std::size_t>();
+    if (raw_size == 0) {
+      inner_finished_ = true;
+      break;
+    }
+    if (raw_size > kBlockSize) {
+      throw Error(fmt::format("Invalid dump block size {}", raw_size));
+    }
+
+    pending_.push_back(utils::Async(
+        "decompress-dump-block",
+        [compression = compression_, raw_size,
+         data = std::string{ReadStringViewUnsafe(*inner_)}] {
+          return Decompress(data, raw_size, compression);
+        }));
+  }
+}
+
+bool CompressedReader::NextBlock() {
+  ReadAhead();
+  if (pending_.empty()) return false;
+
+  block_ = pending_.front().Get();
+  pending_.pop_front();
+  position_ = 0;
+  // keep the decompression going while the block is being consumed
+  ReadAhead();
+  return true;
+}
+
+CompressedOperationsFactory::CompressedOperationsFactory(
+    std::unique_ptr<OperationsFactory> inner, CompressionType compression)
+    : inner_(std::move(inner)), compression_(compression) {
+  UASSERT(inner_);
+}
+
+std::unique_ptr<Reader> CompressedOperationsFactory::CreateReader(
+    std::string full_path) {
+  return std::make_unique<CompressedReader>(
+      inner_->CreateReader(std::move(full_path)), compression_);
+}
+
+std::unique_ptr<Writer> CompressedOperationsFactory::CreateWriter(
+    std::string full_path, tracing::ScopeTime& scope) {
+  return std::make_unique<CompressedWriter>(
+      inner_->CreateWriter(std::move(full_path), scope), compression_);
+}
+
+}  // namespace dump
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,110 @@
+#include <userver/utest/utest.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include <boost/filesystem/operations.hpp>
+
+#include <userver/dump/common.hpp>
+#include <userver/dump/operations_compressed.hpp>
+#include <userver/dump/operations_file.hpp>
+#include <userver/fs/blocking/temp_directory.hpp>
+#include <userver/tracing/span.hpp>
+
+USERVER_NAMESPACE_BEGIN
+using namespace dump;
+
+namespace {
+
+constexpr auto kPerms = boost::filesystem::perms::owner_read;
+
+std::string MakeValue(int i) {
+  // compressible, but not trivially
+  return std::string(i % 1000, static_cast<char>('a' + i % 26)) +
+         std::to_string(i);
+}
+
+}  // namespace
+
+UTEST_MT(DumpCompressed, WriteRead, 4) {
+  const auto dir = fs::blocking::TempDirectory::Create();
+  const auto path = dir.GetPath() + "/file";
+  constexpr int kCount = 20000;  // ~10 MB, spans multiple blocks
+
+  std::uint64_t raw_size = 0;
+  {
+    auto scope_time = tracing::Span::CurrentSpan().CreateScopeTime("dump");
+    CompressedWriter writer(
+        std::make_unique<FileWriter>(path, kPerms, scope_time),
+        CompressionType::kZlib);
+    for (int i = 0; i < kCount; ++i) {
+      const auto value = MakeValue(i);
+      raw_size += value.size();
+      writer.Write(value);
+    }
+    UEXPECT_NO_THROW(writer.Finish());
+  }
+  EXPECT_LT(boost::filesystem::file_size(path), raw_size / 10);
+
+  CompressedReader reader(std::make_unique<FileReader>(path),
+                          CompressionType::kZlib);
+  for (int i = 0; i < kCount; ++i) {
+    ASSERT_EQ(reader.Read<std::string>(), MakeValue(i));
+  }
+  UEXPECT_NO_THROW(reader.Finish());
+}
+
+UTEST(DumpCompressed, Empty) {
+  const auto dir = fs::blocking::TempDirectory::Create();
+  const auto path = dir.GetPath() + "/file";
+
+  auto scope_time = tracing::Span::CurrentSpan().CreateScopeTime("dump");
+  CompressedWriter writer(
+      std::make_unique<FileWriter>(path, kPerms, scope_time),
+      CompressionType::kZlib);
+  UEXPECT_NO_THROW(writer.Finish());
+
+  CompressedReader reader(std::make_unique<FileReader>(path),
+                          CompressionType::kZlib);
+  UEXPECT_THROW(reader.Read<int>(), Error);
+  UEXPECT_NO_THROW(reader.Finish());
+}
+
+UTEST(DumpCompressed, UnreadData) {
+  const auto dir = fs::blocking::TempDirectory::Create();
+  const auto path = dir.GetPath() + "/file";
+
+  auto scope_time = tracing::Span::CurrentSpan().CreateScopeTime("dump");
+  CompressedWriter writer(
+      std::make_unique<FileWriter>(path, kPerms, scope_time),
+      CompressionType::kZlib);
+  writer.Write(1);
+  writer.Write(2);
+  UEXPECT_NO_THROW(writer.Finish());
+
+  CompressedReader reader(std::make_unique<FileReader>(path),
+                          CompressionType::kZlib);
+  EXPECT_EQ(reader.Read<int>(), 1);
+  UEXPECT_THROW(reader.Finish(), Error);
+}
+
+UTEST(DumpCompressed, Corrupted) {
+  const auto dir = fs::blocking::TempDirectory::Create();
+  const auto path = dir.GetPath() + "/file";
+
+  {
+    auto scope_time = tracing::Span::CurrentSpan().CreateScopeTime("dump");
+    CompressedWriter writer(
+        std::make_unique<FileWriter>(path, kPerms, scope_time),
+        CompressionType::kNone);
+    writer.Write(std::string(100, 'a'));
+    UEXPECT_NO_THROW(writer.Finish());
+  }
+
+  CompressedReader reader(std::make_unique<FileReader>(path),
+                          CompressionType::kZlib);
+  UEXPECT_THROW(reader.Read<std::string>(), Error);
+}
+
+USERVER_NAMESPACE_END
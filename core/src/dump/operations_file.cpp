@@ -1,21 +1,48 @@
 #include <userver/dump/operations_file.hpp>
 
+#include <sys/mman.h>
+
 #include <algorithm>
 #include <stdexcept>
 #include <utility>
 
 #include <fmt/format.h>
 
+#include <userver/fs/blocking/file_descriptor.hpp>
 #include <userver/fs/blocking/write.hpp>
 
+#include <utils/check_syscall.hpp>
+
 USERVER_NAMESPACE_BEGIN
 
 namespace dump {
 
 namespace {
+
 constexpr std::size_t kCheckTimeAfterBytes{1 << 15};
+
+std::shared_ptr<const void> MapFile(const std::string& path,
+                                    std::size_t& size) {
+  const auto file =
+      fs::blocking::FileDescriptor::Open(path, fs::blocking::OpenFlag::kRead);
+  size = file.GetSize();
+  // mmap does not support empty mappings
+  if (size == 0) return nullptr;
+
+  void* data = utils::CheckSyscallNotEquals(
+      ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file.GetNative(), 0),
+      MAP_FAILED, "mapping the dump file");
+  // dumps are read sequentially, ask the kernel for aggressive read-ahead,
+  // FileReader::Finish resets the advice if the data stays in use
+  ::madvise(data, size, MADV_SEQUENTIAL);
+
+  // the mapping stays valid after the file is closed
+  return std::shared_ptr<const void>(
+      data, [size](const void* ptr) { ::munmap(const_cast<void*>(ptr), size); });
 }
 
+}  // namespace
+
 FileWriter::FileWriter(std::string path, boost::filesystem::perms perms,
                        tracing::ScopeTime& scope)
     : final_path_(std::move(path)),
@@ -60,7 +87,9 @@ void FileWriter::Finish() {
 
 FileReader::FileReader(std::string path) : path_(std::move(path)) {
   try {
-    file_ = fs::blocking::CFile(path_, fs::blocking::OpenFlag::kRead);
+    std::size_t size = 0;
+    mapping_ = MapFile(path_, size);
+    contents_ = std::string_view(static_cast<const char*>(mapping_.get()), size);
   } catch (const std::exception& ex) {
     throw Error(fmt::format(
         "Failed to open the dump file for reading \"{}\". Reason: {}", path_,
@@ -69,50 +98,33 @@ FileReader::FileReader(std::string path) : path_(std::move(path)) {
 }
 
 std::string_view FileReader::ReadRaw(std::size_t max_size) {
-  // the storage of curr_chunk_ is reused between ReadRaw calls. It acts
-  // as a buffer, with its size being the capacity of the buffer.
-  if (curr_chunk_.size() < max_size) {
-    curr_chunk_.resize(
-        std::max(max_size, static_cast<std::size_t>(curr_chunk_.size() * 1.5)));
-  }
-
-  std::size_t bytes_read = 0;
-  try {
-    bytes_read = file_.Read(curr_chunk_.data(), max_size);
-  } catch (const std::exception& ex) {
-    throw Error(fmt::format("Failed to read from the dump file \"{}\": {}",
-                            path_, ex.what()));
-  }
+  const auto result = contents_.substr(position_, max_size);
+  position_ += result.size();
+  return result;
+}
 
-  return std::string_view(curr_chunk_.data(), bytes_read);
+std::shared_ptr<const void> FileReader::GetRawMemoryOwner() const {
+  return mapping_;
 }
 
 void FileReader::Finish() {
-  std::size_t bytes_read = 0;
-
-  try {
-    char extra_byte = 0;
-    bytes_read = file_.Read(&extra_byte, 1);
-  } catch (const std::exception& ex) {
-    throw Error(fmt::format("Failed to read from the dump file \"{}\": {}",
-                            path_, ex.what()));
-  }
-
-  if (bytes_read != 0) {
-    const auto file_size = file_.GetSize();
-    const auto position = file_.GetPosition() - bytes_read;
+  if (position_ != contents_.size()) {
     throw Error(
         fmt::format("Unexpected extra data at the end of the dump file \"{}\": "
                     "file-size={}, position={}, unread-size={}",
-                    path_, file_size, position, file_size - position));
+                    path_, contents_.size(), position_,
+                    contents_.size() - position_));
   }
 
-  try {
-    std::move(file_).Close();
-  } catch (const std::exception& ex) {
-    throw Error(fmt::format("Failed to finalize dump file \"{}\". Reason: {}",
-                            path_, ex.what()));
+  // the data kept by the readers (e.g. FlatMap) is looked up randomly, stop
+  // the read-ahead and the early eviction of the pages behind the reads
+  if (mapping_.use_count() > 1) {
+    ::madvise(const_cast<void*>(mapping_.get()), contents_.size(),
+              MADV_RANDOM);
   }
+
+  contents_ = {};
+  mapping_.reset();
 }
 
 FileOperationsFactory::FileOperationsFactory(boost::filesystem::perms perms)
@@ -16,6 +16,7 @@ formats::json::Value Serialize(const Statistics& stats,
     result["load-duration-ms"] = stats.load_duration.load().count();
   }
   result["is-current-from-dump"] = stats.is_current_from_dump.load() ? 1 : 0;
+  result["delta-chain-length"] = stats.delta_chain_length.load();
 
   const bool dump_written = stats.last_nontrivial_write_start_time.load() !=
                             std::chrono::steady_clock::time_point{};
@@ -26,8 +27,19 @@ formats::json::Value Serialize(const Statistics& stats,
             std::chrono::steady_clock::now() -
             stats.last_nontrivial_write_start_time.load())
             .count();
-    write["duration-ms"] = stats.last_nontrivial_write_duration.load().count();
-    write["size-kb"] = stats.last_written_size.load() / 1024;
+    const auto duration = stats.last_nontrivial_write_duration.load();
+    const auto size = stats.last_written_size.load();
+    const auto raw_size = stats.last_written_raw_size.load();
+    write["duration-ms"] = duration.count();
+    write["size-kb"] = size / 1024;
+    write["raw-size-kb"] = raw_size / 1024;
+    write["is-delta"] = stats.last_written_is_delta.load() ? 1 : 0;
+    if (size != 0) {
+      write["compression-ratio"] = static_cast<double>(raw_size) / size;
+    }
+    if (duration.count() != 0) {
+      write["throughput-kb-per-sec"] = raw_size / 1024 * 1000 / duration.count();
+    }
     result["last-nontrivial-write"] = write.ExtractValue();
   }
 
@@ -20,6 +20,11 @@ struct Statistics {
       last_nontrivial_write_start_time{{}};
   std::atomic<std::chrono::milliseconds> last_nontrivial_write_duration{{}};
   std::atomic<std::size_t> last_written_size{0};
+  // before compression and encryption
+  std::atomic<std::size_t> last_written_raw_size{0};
+  std::atomic<bool> last_written_is_delta{false};
+  // the number of deltas on top of the latest full dump
+  std::atomic<std::size_t> delta_chain_length{0};
 };
 
 formats::json::Value Serialize(const Statistics& stats,
@@ -1,5 +1,7 @@
 #include <userver/dump/unsafe.hpp>
 
+#include <string>
+
 #include <fmt/format.h>
 
 #include <userver/dump/common.hpp>
@@ -37,6 +39,15 @@ std::string_view ReadUnsafeAtMost(Reader& reader, std::size_t max_size) {
   return result;
 }
 
+SharedStringView ReadSharedUnsafe(Reader& reader, std::size_t size) {
+  const auto data = ReadStringViewUnsafe(reader, size);
+  auto owner = reader.GetRawMemoryOwner();
+  if (owner) return {data, std::move(owner)};
+
+  auto copy = std::make_shared<const std::string>(data);
+  return {*copy, std::move(copy)};
+}
+
 }  // namespace dump
 
 USERVER_NAMESPACE_END
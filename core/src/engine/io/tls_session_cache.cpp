@@ -0,0 +1,262 @@
+#include <engine/io/tls_session_cache_impl.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+#include <fmt/format.h>
+#include <openssl/rand.h>
+#if OPENSSL_VERSION_NUMBER >= 0x030000000L
+#include <openssl/core_names.h>
+#include <openssl/params.h>
+#endif
+
+#include <crypto/helpers.hpp>
+#include <userver/crypto/base64.hpp>
+#include <userver/engine/io/exception.hpp>
+#include <userver/formats/json/value.hpp>
+#include <userver/formats/json/value_builder.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::io {
+namespace {
+
+constexpr unsigned char kSessionIdContext[] = "userver";
+
+int NewClientSessionCallback(SSL* ssl, SSL_SESSION* session) noexcept {
+  auto* ref = static_cast<TlsSessionCache::Impl::ClientSessionRef*>(
+      SSL_get_app_data(ssl));
+  if (!ref) return 0;
+#if OPENSSL_VERSION_NUMBER >= 0x010101000L
+  if (!SSL_SESSION_is_resumable(session)) return 0;
+#endif
+
+  try {
+    ref->cache.StoreSession(ref->key, session);
+  } catch (const std::exception& ex) {
+    LOG_LIMITED_WARNING() << "Failed to store TLS session: " << ex;
+    return 0;
+  }
+  // the session is owned by the cache now
+  return 1;
+}
+
+int TicketKeyCallback(SSL* ssl, unsigned char* key_name, unsigned char* iv,
+                      EVP_CIPHER_CTX* cipher_ctx, TicketMacCtx* mac_ctx,
+                      int enc) noexcept {
+  auto* cache = static_cast<TlsSessionCache::Impl*>(
+      SSL_CTX_get_app_data(SSL_get_SSL_CTX(ssl)));
+  if (!cache) return -1;
+  return cache->ProcessTicket(key_name, iv, cipher_ctx, mac_ctx, enc);
+}
+
+}  // namespace
+
+TlsSessionCache::Impl::Impl(std::size_t max_sessions)
+    : sessions_(max_sessions) {
+  std::string random_key(kTicketKeySize, '\0');
+  if (1 != RAND_bytes(reinterpret_cast<unsigned char*>(random_key.data()),
+                      random_key.size())) {
+    throw TlsException(crypto::FormatSslError(
+        "Failed to generate TLS session ticket key: RAND_bytes"));
+  }
+  SetTicketKeys({random_key});
+}
+
+void TlsSessionCache::Impl::SetUpClientContext(SSL_CTX* ssl_ctx) {
+  SSL_CTX_set_session_cache_mode(
+      ssl_ctx, SSL_SESS_CACHE_CLIENT | SSL_SESS_CACHE_NO_INTERNAL_STORE);
+  SSL_CTX_sess_set_new_cb(ssl_ctx, &NewClientSessionCallback);
+}
+
+void TlsSessionCache::Impl::SetUpServerContext(SSL_CTX* ssl_ctx) {
+  SSL_CTX_set_app_data(ssl_ctx, this);
+  if (1 != SSL_CTX_set_session_id_context(ssl_ctx, kSessionIdContext,
+                                          sizeof(kSessionIdContext) - 1)) {
+    throw TlsException(crypto::FormatSslError(
+        "Failed to set up TLS session cache: "
+        "SSL_CTX_set_session_id_context"));
+  }
+#if OPENSSL_VERSION_NUMBER >= 0x030000000L
+  const auto ret =
+      SSL_CTX_set_tlsext_ticket_key_evp_cb(ssl_ctx, &TicketKeyCallback);
+#else
+  // cast in openssl macro expansion
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-cstyle-cast)
+  const auto ret =
+      SSL_CTX_set_tlsext_ticket_key_cb(ssl_ctx, &TicketKeyCallback);
+#endif
+  if (1 != ret) {
+    throw TlsException(crypto::FormatSslError(
+        "Failed to set up TLS session cache: ticket key callback"));
+  }
+}
+
+void TlsSessionCache::Impl::SetTicketKeys(
+    const std::vector<std::string>& keys) {
+  if (keys.empty()) {
+    throw TlsException("No TLS session ticket keys provided");
+  }
+
+  std::vector<TicketKey> parsed_keys;
+  parsed_keys.reserve(keys.size());
+  for (const auto& key : keys) parsed_keys.push_back(ParseTicketKey(key));
+  ticket_keys_.Assign(std::move(parsed_keys));
+}
+
+void TlsSessionCache::Impl::Clear() {
+  auto sessions = sessions_.Lock();
+  sessions->Clear();
+}
+
+TlsSessionCache::Statistics TlsSessionCache::Impl::GetStatistics() const {
+  Statistics stats;
+  stats.client_full_handshakes = client_full_handshakes_.load();
+  stats.client_resumed_handshakes = client_resumed_handshakes_.load();
+  stats.server_full_handshakes = server_full_handshakes_.load();
+  stats.server_resumed_handshakes = server_resumed_handshakes_.load();
+  {
+    auto sessions = sessions_.Lock();
+    stats.cached_sessions = sessions->GetSize();
+  }
+  return stats;
+}
+
+SslSession TlsSessionCache::Impl::FindSession(const std::string& key) {
+  auto sessions = sessions_.Lock();
+  auto* session = sessions->Get(key);
+  return session ? *session : SslSession{};
+}
+
+void TlsSessionCache::Impl::StoreSession(const std::string& key,
+                                         SSL_SESSION* session) {
+  SslSession session_ptr{session, SslSessionDeleter{}};
+  auto sessions = sessions_.Lock();
+  sessions->Put(key, std::move(session_ptr));
+}
+
+int TlsSessionCache::Impl::ProcessTicket(unsigned char* key_name,
+                                         unsigned char* iv,
+                                         EVP_CIPHER_CTX* cipher_ctx,
+                                         TicketMacCtx* mac_ctx, int enc) {
+  const auto keys = ticket_keys_.Read();
+  UASSERT(!keys->empty());
+
+  const TicketKey* key = nullptr;
+  bool is_current_key = true;
+  if (enc) {
+    key = &keys->front();
+    std::memcpy(key_name, key->name.data(), key->name.size());
+    if (1 != RAND_bytes(iv, EVP_CIPHER_iv_length(EVP_aes_256_cbc()))) {
+      return -1;
+    }
+  } else {
+    const auto it =
+        std::find_if(keys->begin(), keys->end(), [key_name](const auto& key) {
+          return 0 == std::memcmp(key_name, key.name.data(), key.name.size());
+        });
+    // unknown or rotated out key, full handshake
+    if (it == keys->end()) return 0;
+    key = &*it;
+    is_current_key = (it == keys->begin());
+  }
+
+  if (1 != EVP_CipherInit_ex(cipher_ctx, EVP_aes_256_cbc(), nullptr,
+                             key->aes_key.data(), iv, enc)) {
+    return -1;
+  }
+
+#if OPENSSL_VERSION_NUMBER >= 0x030000000L
+  auto hmac_secret = key->hmac_secret;
+  char digest_name[] = "SHA256";
+  const OSSL_PARAM params[] = {
+      OSSL_PARAM_construct_octet_string(
+          OSSL_MAC_PARAM_KEY, hmac_secret.data(), hmac_secret.size()),
+      OSSL_PARAM_construct_utf8_string(OSSL_MAC_PARAM_DIGEST, digest_name, 0),
+      OSSL_PARAM_construct_end(),
+  };
+  if (1 != EVP_MAC_CTX_set_params(mac_ctx, params)) return -1;
+#else
+  if (1 != HMAC_Init_ex(mac_ctx, key->hmac_secret.data(),
+                        key->hmac_secret.size(), EVP_sha256(), nullptr)) {
+    return -1;
+  }
+#endif
+
+  // ask to renew the tickets encrypted with the previous keys
+  return is_current_key ? 1 : 2;
+}
+
+void TlsSessionCache::Impl::AccountHandshake(bool is_server, bool is_resumed) {
+  if (is_server) {
+    ++(is_resumed ? server_resumed_handshakes_ : server_full_handshakes_);
+  } else {
+    ++(is_resumed ? client_resumed_handshakes_ : client_full_handshakes_);
+  }
+}
+
+TlsSessionCache::Impl::TicketKey TlsSessionCache::Impl::ParseTicketKey(
+    const std::string& raw_key) {
+  if (raw_key.size() != kTicketKeySize) {
+    throw TlsException(
+        fmt::format("Invalid TLS session ticket key size {}, expected {}",
+                    raw_key.size(), kTicketKeySize));
+  }
+
+  TicketKey key;
+  const auto* pos = reinterpret_cast<const unsigned char*>(raw_key.data());
+  std::memcpy(key.name.data(), pos, key.name.size());
+  pos += key.name.size();
+  std::memcpy(key.hmac_secret.data(), pos, key.hmac_secret.size());
+  pos += key.hmac_secret.size();
+  std::memcpy(key.aes_key.data(), pos, key.aes_key.size());
+  return key;
+}
+
+TlsSessionCache::TlsSessionCache(std::size_t max_sessions)
+    : impl_(max_sessions) {}
+
+TlsSessionCache::~TlsSessionCache() = default;
+
+void TlsSessionCache::SetTicketKeys(const std::vector<std::string>& keys) {
+  impl_->SetTicketKeys(keys);
+}
+
+void TlsSessionCache::Clear() { impl_->Clear(); }
+
+TlsSessionCache::Statistics TlsSessionCache::GetStatistics() const {
+  return impl_->GetStatistics();
+}
+
+formats::json::Value Serialize(const TlsSessionCache::Statistics& stats,
+                               formats::serialize::To<formats::json::Value>) {
+  formats::json::ValueBuilder result(formats::json::Type::kObject);
+
+  formats::json::ValueBuilder client(formats::json::Type::kObject);
+  client["full-handshakes"] = stats.client_full_handshakes;
+  client["resumed-handshakes"] = stats.client_resumed_handshakes;
+  result["client"] = client.ExtractValue();
+
+  formats::json::ValueBuilder server(formats::json::Type::kObject);
+  server["full-handshakes"] = stats.server_full_handshakes;
+  server["resumed-handshakes"] = stats.server_resumed_handshakes;
+  result["server"] = server.ExtractValue();
+
+  result["cached-sessions"] = stats.cached_sessions;
+  return result.ExtractValue();
+}
+
+TlsTicketKeys::TlsTicketKeys(const formats::json::Value& secdist_doc) {
+  const auto& section = secdist_doc["tls_session_ticket_keys"];
+  if (section.IsMissing()) return;
+
+  for (const auto& key : section) {
+    keys.push_back(crypto::base64::Base64Decode(key.As<std::string>()));
+  }
+}
+
+}  // namespace engine::io
+
+USERVER_NAMESPACE_END
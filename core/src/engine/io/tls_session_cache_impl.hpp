@@ -0,0 +1,93 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <openssl/evp.h>
+#include <openssl/hmac.h>
+#include <openssl/ssl.h>
+
+#include <userver/cache/lru_map.hpp>
+#include <userver/concurrent/variable.hpp>
+#include <userver/engine/io/tls_session_cache.hpp>
+#include <userver/rcu/rcu.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::io {
+
+#if OPENSSL_VERSION_NUMBER >= 0x030000000L
+using TicketMacCtx = EVP_MAC_CTX;
+#else
+using TicketMacCtx = HMAC_CTX;
+#endif
+
+struct SslSessionDeleter {
+  void operator()(SSL_SESSION* session) const noexcept {
+    SSL_SESSION_free(session);
+  }
+};
+using SslSession = std::shared_ptr<SSL_SESSION>;
+
+class TlsSessionCache::Impl {
+ public:
+  /// Client connection binding, attached to SSL as app data
+  struct ClientSessionRef {
+    Impl& cache;
+    std::string key;
+  };
+
+  explicit Impl(std::size_t max_sessions);
+
+  /// Installs the session callbacks, SSL objects created from the context
+  /// must have ClientSessionRef as app data
+  void SetUpClientContext(SSL_CTX* ssl_ctx);
+
+  /// Installs the ticket key callback
+  void SetUpServerContext(SSL_CTX* ssl_ctx);
+
+  void SetTicketKeys(const std::vector<std::string>& keys);
+  void Clear();
+  Statistics GetStatistics() const;
+
+  /// Client side, returns nullptr if there is no session for the key
+  SslSession FindSession(const std::string& key);
+
+  /// Client side, takes the ownership of the session
+  void StoreSession(const std::string& key, SSL_SESSION* session);
+
+  /// Server side, OpenSSL ticket key callback implementation
+  int ProcessTicket(unsigned char* key_name, unsigned char* iv,
+                    EVP_CIPHER_CTX* cipher_ctx, TicketMacCtx* mac_ctx,
+                    int enc);
+
+  void AccountHandshake(bool is_server, bool is_resumed);
+
+ private:
+  struct TicketKey {
+    std::array<unsigned char, 16> name{};
+    std::array<unsigned char, 32> hmac_secret{};
+    std::array<unsigned char, 32> aes_key{};
+  };
+
+  static TicketKey ParseTicketKey(const std::string& raw_key);
+
+  mutable concurrent::Variable<cache::LruMap<std::string, SslSession>,
+                               std::mutex>
+      sessions_;
+  // first key is the current one
+  rcu::Variable<std::vector<TicketKey>> ticket_keys_;
+
+  std::atomic<std::size_t> client_full_handshakes_{0};
+  std::atomic<std::size_t> client_resumed_handshakes_{0};
+  std::atomic<std::size_t> server_full_handshakes_{0};
+  std::atomic<std::size_t> server_resumed_handshakes_{0};
+};
+
+}  // namespace engine::io
+
+USERVER_NAMESPACE_END
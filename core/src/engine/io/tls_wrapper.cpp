@@ -1,7 +1,14 @@
 #include <userver/engine/io/tls_wrapper.hpp>
 
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
 #include <exception>
+#include <functional>
 #include <memory>
+#include <string>
 
 #include <fmt/format.h>
 #include <openssl/bio.h>
@@ -10,7 +17,11 @@
 #include <crypto/helpers.hpp>
 #include <crypto/openssl.hpp>
 #include <engine/io/fd_control.hpp>
+#include <engine/io/tls_session_cache_impl.hpp>
+#include <userver/engine/async.hpp>
 #include <userver/engine/io/exception.hpp>
+#include <userver/engine/task/cancel.hpp>
+#include <userver/engine/task/task_with_result.hpp>
 #include <userver/logging/log.hpp>
 #include <userver/utils/assert.hpp>
 
@@ -199,7 +210,7 @@ int SSL_write_ex(SSL* ssl, const void* data, size_t len,
 }
 #endif
 
-SslCtx MakeSslCtx() {
+SslCtx MakeSslCtx(const TlsHandshakeOptions& options) {
   crypto::impl::Openssl::Init();
 
   SslCtx ssl_ctx{SSL_CTX_new(SSLv23_method())};
@@ -214,13 +225,21 @@ SslCtx MakeSslCtx() {
   }
 #endif
 
-  constexpr auto options = SSL_OP_ALL | SSL_OP_NO_SSLv2 | SSL_OP_NO_SSLv3 |
+  constexpr auto ssl_options = SSL_OP_ALL | SSL_OP_NO_SSLv2 | SSL_OP_NO_SSLv3 |
                            SSL_OP_NO_COMPRESSION
 #if OPENSSL_VERSION_NUMBER >= 0x010100000L
                            | SSL_OP_NO_RENEGOTIATION
 #endif
       ;
-  SSL_CTX_set_options(ssl_ctx.get(), options);
+  SSL_CTX_set_options(ssl_ctx.get(), ssl_options);
+  if (options.enable_kernel_tls) {
+#if OPENSSL_VERSION_NUMBER >= 0x030000000L
+    SSL_CTX_set_options(ssl_ctx.get(), SSL_OP_ENABLE_KTLS);
+#else
+    LOG_LIMITED_WARNING()
+        << "Kernel TLS requires OpenSSL 3.0+, using userspace encryption";
+#endif
+  }
   SSL_CTX_set_mode(ssl_ctx.get(), SSL_MODE_ENABLE_PARTIAL_WRITE);
   SSL_CTX_clear_mode(ssl_ctx.get(), SSL_MODE_AUTO_RETRY);
   if (1 != SSL_CTX_set_default_verify_paths(ssl_ctx.get())) {
@@ -235,22 +254,50 @@ enum InterruptAction {
   kFail,
 };
 
+constexpr size_t kSendFileChunkSize = 64 * 1024;
+
+// Blocking, to be called on the fs task processor
+void ReadFileChunk(int fd, off_t offset, size_t size, std::string& buffer) {
+  buffer.resize(size);
+  while (true) {
+    const auto ret = ::pread(fd, buffer.data(), size, offset);
+    if (ret >= 0) {
+      buffer.resize(ret);
+      return;
+    }
+    if (errno != EINTR) throw IoSystemError(errno, "SendFile pread");
+  }
+}
+
 }  // namespace
 
 class TlsWrapper::Impl {
  public:
   explicit Impl(Socket&& socket) : bio_data(std::move(socket)) {}
 
-  void SetUp(SslCtx&& ssl_ctx) {
-    Bio socket_bio{BIO_new(GetSocketBioMethod())};
-    if (!socket_bio) {
-      throw TlsException(
-          crypto::FormatSslError("Failed to set up TLS wrapper: BIO_new"));
-    }
-    BIO_set_shutdown(socket_bio.get(), 0);
-    if (1 != BIO_ctrl(socket_bio.get(), kSetSocketBioDataCtrl, 0, &bio_data)) {
-      throw TlsException(crypto::FormatSslError(
-          "Failed to set up TLS wrapper: bind socket to BIO"));
+  void SetUp(SslCtx&& ssl_ctx, const TlsHandshakeOptions& options) {
+    Bio socket_bio;
+    if (options.enable_kernel_tls) {
+      // OpenSSL installs the keys into the kernel only for its own socket
+      // BIO, which is non-blocking here and is waited for in WaitSocket
+      is_kernel_tls_mode = true;
+      socket_bio.reset(BIO_new_socket(bio_data.socket.Fd(), BIO_NOCLOSE));
+      if (!socket_bio) {
+        throw TlsException(crypto::FormatSslError(
+            "Failed to set up TLS wrapper: BIO_new_socket"));
+      }
+    } else {
+      socket_bio.reset(BIO_new(GetSocketBioMethod()));
+      if (!socket_bio) {
+        throw TlsException(
+            crypto::FormatSslError("Failed to set up TLS wrapper: BIO_new"));
+      }
+      BIO_set_shutdown(socket_bio.get(), 0);
+      if (1 !=
+          BIO_ctrl(socket_bio.get(), kSetSocketBioDataCtrl, 0, &bio_data)) {
+        throw TlsException(crypto::FormatSslError(
+            "Failed to set up TLS wrapper: bind socket to BIO"));
+      }
     }
 
     ssl.reset(SSL_new(ssl_ctx.get()));
@@ -273,6 +320,7 @@ class TlsWrapper::Impl {
     if (!len) return 0;
 
     bio_data.current_deadline = deadline;
+    if (is_kernel_tls_mode) bio_data.last_exception = {};
 
     char* const begin = static_cast<char*>(buf);
     char* const end = begin + len;
@@ -306,6 +354,7 @@ class TlsWrapper::Impl {
             UINVARIANT(false,
                        fmt::format("Unexpected SSL_ERROR: {}", ssl_error));
         }
+        WaitSocket(ssl_error, pos - begin);
         if (bio_data.last_exception) {
           if (interrupt_action == InterruptAction::kFail) {
             // Sometimes (when writing) we must either retry the io_func with
@@ -324,6 +373,107 @@ class TlsWrapper::Impl {
     return pos - begin;
   }
 
+  void SetUpClientSession(TlsSessionCache::Impl& cache,
+                          const std::string& server_name) {
+    UASSERT(ssl);
+    session_cache = &cache;
+    client_session_ref =
+        std::make_unique<TlsSessionCache::Impl::ClientSessionRef>(
+            TlsSessionCache::Impl::ClientSessionRef{
+                cache, fmt::format("{}@{}", server_name,
+                                   bio_data.socket.Getpeername())});
+    SSL_set_app_data(ssl.get(), client_session_ref.get());
+
+    if (const auto session = cache.FindSession(client_session_ref->key)) {
+      if (1 != SSL_set_session(ssl.get(), session.get())) {
+        LOG_LIMITED_WARNING() << crypto::FormatSslError(
+            "Failed to resume TLS session: SSL_set_session");
+      }
+    }
+  }
+
+  void Handshake(bool is_server, Deadline deadline,
+                 TaskProcessor* task_processor) {
+    UASSERT(ssl);
+    bio_data.current_deadline = deadline;
+
+    const auto do_handshake = [this, is_server] {
+      while (true) {
+        const auto ret =
+            is_server ? SSL_accept(ssl.get()) : SSL_connect(ssl.get());
+        if (1 == ret) return;
+
+        const auto ssl_error = SSL_get_error(ssl.get(), ret);
+        const bool should_retry = WaitSocket(ssl_error, 0);
+        if (bio_data.last_exception) {
+          std::rethrow_exception(bio_data.last_exception);
+        }
+        if (should_retry) continue;
+
+        throw TlsException(crypto::FormatSslError(
+            fmt::format("Failed to set up {} TLS wrapper ({})",
+                        is_server ? "server" : "client", ssl_error)));
+      }
+    };
+
+    if (task_processor) {
+      // the socket is usable from any task processor
+      engine::CriticalAsyncNoSpan(*task_processor, do_handshake).Get();
+    } else {
+      do_handshake();
+    }
+
+    if (session_cache) {
+      session_cache->AccountHandshake(is_server,
+                                      SSL_session_reused(ssl.get()) == 1);
+    }
+  }
+
+  // In the kernel TLS mode the SSL I/O is non-blocking, waits for the socket
+  // to become ready if it was requested. Waiting errors are reported via
+  // bio_data.last_exception, the same way as the socket BIO does.
+  bool WaitSocket(int ssl_error, size_t bytes_transferred) {
+    if (!is_kernel_tls_mode) return false;
+
+    bool is_ready = false;
+    if (ssl_error == SSL_ERROR_WANT_READ) {
+      is_ready = bio_data.socket.WaitReadable(bio_data.current_deadline);
+    } else if (ssl_error == SSL_ERROR_WANT_WRITE) {
+      is_ready = bio_data.socket.WaitWriteable(bio_data.current_deadline);
+    } else {
+      return false;
+    }
+
+    bio_data.last_exception = {};
+    if (!is_ready) {
+      try {
+        if (current_task::ShouldCancel()) {
+          throw IoCancelled(bytes_transferred);
+        }
+        throw IoTimeout(bytes_transferred);
+      } catch (const IoInterrupted&) {
+        bio_data.last_exception = std::current_exception();
+      }
+    }
+    return is_ready;
+  }
+
+  bool IsKernelTlsSendEnabled() const {
+#if OPENSSL_VERSION_NUMBER >= 0x030000000L
+    return ssl && BIO_get_ktls_send(SSL_get_wbio(ssl.get()));
+#else
+    return false;
+#endif
+  }
+
+  bool IsKernelTlsRecvEnabled() const {
+#if OPENSSL_VERSION_NUMBER >= 0x030000000L
+    return ssl && BIO_get_ktls_recv(SSL_get_rbio(ssl.get()));
+#else
+    return false;
+#endif
+  }
+
   void CheckAlive() const {
     if (!ssl) {
       throw TlsException("SSL connection is broken");
@@ -333,14 +483,22 @@ class TlsWrapper::Impl {
   SocketBioData bio_data;
   Ssl ssl;
   bool is_in_shutdown{false};
+  bool is_kernel_tls_mode{false};
+  TlsSessionCache::Impl* session_cache{nullptr};
+  // stable address for the SSL app data
+  std::unique_ptr<TlsSessionCache::Impl::ClientSessionRef> client_session_ref;
 };
 
 TlsWrapper::TlsWrapper(Socket&& socket) : impl_(std::move(socket)) {}
 
 TlsWrapper TlsWrapper::StartTlsClient(Socket&& socket,
                                       const std::string& server_name,
-                                      Deadline deadline) {
-  auto ssl_ctx = MakeSslCtx();
+                                      Deadline deadline,
+                                      const TlsHandshakeOptions& options) {
+  auto ssl_ctx = MakeSslCtx(options);
+  if (options.session_cache) {
+    options.session_cache->GetImpl().SetUpClientContext(ssl_ctx.get());
+  }
 
   if (!server_name.empty()) {
     X509_VERIFY_PARAM* verify_param = SSL_CTX_get0_param(ssl_ctx.get());
@@ -357,7 +515,7 @@ TlsWrapper TlsWrapper::StartTlsClient(Socket&& socket,
   }
 
   TlsWrapper wrapper{std::move(socket)};
-  wrapper.impl_->SetUp(std::move(ssl_ctx));
+  wrapper.impl_->SetUp(std::move(ssl_ctx), options);
   if (!server_name.empty()) {
     // cast in openssl1.0 macro expansion
     // NOLINTNEXTLINE(cppcoreguidelines-pro-type-cstyle-cast)
@@ -367,27 +525,25 @@ TlsWrapper TlsWrapper::StartTlsClient(Socket&& socket,
           "Failed to set up client TLS wrapper: SSL_set_tlsext_host_name"));
     }
   }
-
-  wrapper.impl_->bio_data.current_deadline = deadline;
-
-  auto ret = SSL_connect(wrapper.impl_->ssl.get());
-  if (1 != ret) {
-    if (wrapper.impl_->bio_data.last_exception) {
-      std::rethrow_exception(wrapper.impl_->bio_data.last_exception);
-    }
-
-    throw TlsException(crypto::FormatSslError(
-        fmt::format("Failed to set up client TLS wrapper ({})",
-                    SSL_get_error(wrapper.impl_->ssl.get(), ret))));
+  if (options.session_cache) {
+    wrapper.impl_->SetUpClientSession(options.session_cache->GetImpl(),
+                                      server_name);
   }
+
+  wrapper.impl_->Handshake(/*is_server=*/false, deadline,
+                           options.handshake_task_processor);
   return wrapper;
 }
 
 TlsWrapper TlsWrapper::StartTlsServer(
     Socket&& socket, const crypto::Certificate& cert,
     const crypto::PrivateKey& key, Deadline deadline,
-    const std::vector<crypto::Certificate>& cert_authorities) {
-  auto ssl_ctx = MakeSslCtx();
+    const std::vector<crypto::Certificate>& cert_authorities,
+    const TlsHandshakeOptions& options) {
+  auto ssl_ctx = MakeSslCtx(options);
+  if (options.session_cache) {
+    options.session_cache->GetImpl().SetUpServerContext(ssl_ctx.get());
+  }
 
   if (!cert_authorities.empty()) {
     auto* store = SSL_CTX_get_cert_store(ssl_ctx.get());
@@ -410,20 +566,13 @@ TlsWrapper TlsWrapper::StartTlsServer(
   }
 
   TlsWrapper wrapper{std::move(socket)};
-  wrapper.impl_->SetUp(std::move(ssl_ctx));
-  wrapper.impl_->bio_data.current_deadline = deadline;
-
-  auto ret = SSL_accept(wrapper.impl_->ssl.get());
-  if (1 != ret) {
-    if (wrapper.impl_->bio_data.last_exception) {
-      std::rethrow_exception(wrapper.impl_->bio_data.last_exception);
-    }
-
-    throw TlsException(crypto::FormatSslError(
-        fmt::format("Failed to set up server TLS wrapper ({})",
-                    SSL_get_error(wrapper.impl_->ssl.get(), ret))));
+  wrapper.impl_->SetUp(std::move(ssl_ctx), options);
+  if (options.session_cache) {
+    wrapper.impl_->session_cache = &options.session_cache->GetImpl();
   }
 
+  wrapper.impl_->Handshake(/*is_server=*/true, deadline,
+                           options.handshake_task_processor);
   return wrapper;
 }
 
@@ -441,6 +590,81 @@ bool TlsWrapper::IsValid() const {
   return impl_->ssl && !impl_->is_in_shutdown;
 }
 
+bool TlsWrapper::IsSessionReused() const {
+  return impl_->ssl && SSL_session_reused(impl_->ssl.get()) == 1;
+}
+
+bool TlsWrapper::IsKernelTlsEnabled() const {
+  return impl_->IsKernelTlsSendEnabled();
+}
+
+size_t TlsWrapper::SendFile(int fd, off_t offset, size_t len,
+                            TaskProcessor& fs_task_processor,
+                            Deadline deadline) {
+  impl_->CheckAlive();
+
+#if OPENSSL_VERSION_NUMBER >= 0x030000000L
+  if (impl_->IsKernelTlsSendEnabled()) {
+    impl_->bio_data.current_deadline = deadline;
+    impl_->bio_data.last_exception = {};
+
+    size_t sent = 0;
+    while (sent < len && impl_->ssl) {
+      const auto ret = SSL_sendfile(impl_->ssl.get(), fd, offset + sent,
+                                    len - sent, /*flags=*/0);
+      if (ret > 0) {
+        sent += ret;
+        continue;
+      }
+
+      const int ssl_error = SSL_get_error(impl_->ssl.get(), ret);
+      if (!impl_->WaitSocket(ssl_error, sent)) {
+        // partially sent record cannot be retried with other arguments
+        impl_->ssl.reset();
+        if (impl_->bio_data.last_exception) {
+          std::rethrow_exception(impl_->bio_data.last_exception);
+        }
+        throw TlsException(crypto::FormatSslError("SendFile"));
+      }
+    }
+    return sent;
+  }
+#endif
+
+  // Userspace encryption, the file data has to be copied anyway. The file is
+  // read on the fs task processor not to block the current thread on disk
+  // I/O, the next chunk is read while the current one is being sent.
+  std::array<std::string, 2> buffers;
+  size_t requested = 0;
+  size_t last_requested_size = 0;
+  engine::TaskWithResult<void> pending_read;
+  const auto start_read = [&](std::string& buffer) {
+    last_requested_size = std::min(kSendFileChunkSize, len - requested);
+    pending_read = engine::AsyncNoSpan(
+        fs_task_processor, &ReadFileChunk, fd,
+        offset + static_cast<off_t>(requested), last_requested_size,
+        std::ref(buffer));
+    requested += last_requested_size;
+  };
+
+  if (len == 0) return 0;
+  start_read(buffers[0]);
+
+  size_t sent = 0;
+  for (size_t current = 0;; current ^= 1) {
+    pending_read.Get();
+    const auto& chunk = buffers[current];
+    const bool is_last =
+        chunk.size() < last_requested_size || requested == len;
+    if (!is_last) start_read(buffers[current ^ 1]);
+
+    const auto chunk_sent = SendAll(chunk.data(), chunk.size(), deadline);
+    sent += chunk_sent;
+    if (is_last || chunk_sent != chunk.size()) break;
+  }
+  return sent;
+}
+
 bool TlsWrapper::WaitReadable(Deadline deadline) {
   impl_->CheckAlive();
   char buf = 0;
@@ -478,6 +702,7 @@ Socket TlsWrapper::StopTls(Deadline deadline) {
   if (impl_->ssl) {
     impl_->is_in_shutdown = true;
     impl_->bio_data.current_deadline = deadline;
+    if (impl_->is_kernel_tls_mode) impl_->bio_data.last_exception = {};
     int shutdown_ret = 0;
     while (shutdown_ret != 1) {
       shutdown_ret = SSL_shutdown(impl_->ssl.get());
@@ -501,11 +726,16 @@ Socket TlsWrapper::StopTls(Deadline deadline) {
             UINVARIANT(false,
                        fmt::format("Unexpected SSL_ERROR: {}", ssl_error));
         }
+        impl_->WaitSocket(ssl_error, 0);
         if (impl_->bio_data.last_exception) {
           std::rethrow_exception(impl_->bio_data.last_exception);
         }
       }
     }
+    if (impl_->IsKernelTlsSendEnabled() || impl_->IsKernelTlsRecvEnabled()) {
+      // the kernel would keep encrypting the plaintext
+      impl_->bio_data.socket.Close();
+    }
     impl_->ssl.reset();
   }
   return std::move(impl_->bio_data.socket);
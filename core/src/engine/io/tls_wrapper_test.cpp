@@ -1,5 +1,6 @@
 #include <userver/utest/utest.hpp>
 
+#include <fcntl.h>
 #include <openssl/opensslv.h>
 
 #include <stdexcept>
@@ -8,9 +9,12 @@
 
 #include <userver/engine/async.hpp>
 #include <userver/engine/io/socket.hpp>
+#include <userver/engine/io/tls_session_cache.hpp>
 #include <userver/engine/io/tls_wrapper.hpp>
 #include <userver/engine/single_consumer_event.hpp>
 #include <userver/engine/sleep.hpp>
+#include <userver/fs/blocking/temp_file.hpp>
+#include <userver/fs/blocking/write.hpp>
 #include <userver/logging/log.hpp>
 #include <userver/utest/net_listener.hpp>
 #include <userver/utils/async.hpp>
@@ -136,6 +140,48 @@ v2R63aFo/UfQSQ4dhC0o2Vy74DyLwnO3pH8wudfBJ8/LX/Uz/A==
 
 constexpr auto kShortTimeout = std::chrono::milliseconds{10};
 
+std::string MakeTicketKey(char fill) {
+  return std::string(io::TlsSessionCache::kTicketKeySize, fill);
+}
+
+// Makes a TLS connection exchanging a byte both ways and returns
+// whether the session was resumed
+bool ConnectWithSessionCache(TcpListener& tcp_listener,
+                             io::TlsSessionCache& server_cache,
+                             io::TlsSessionCache& client_cache,
+                             Deadline deadline) {
+  auto [server, client] = tcp_listener.MakeSocketPair(deadline);
+
+  auto server_task = engine::AsyncNoSpan(
+      [&server_cache, deadline](auto&& server) {
+        io::TlsHandshakeOptions options;
+        options.session_cache = &server_cache;
+        options.handshake_task_processor =
+            &engine::current_task::GetTaskProcessor();
+        auto tls_server = io::TlsWrapper::StartTlsServer(
+            std::move(server), crypto::Certificate::LoadFromString(cert),
+            crypto::PrivateKey::LoadFromString(key), deadline, {}, options);
+        EXPECT_EQ(1, tls_server.SendAll("1", 1, deadline));
+        char c = 0;
+        EXPECT_EQ(1, tls_server.RecvSome(&c, 1, deadline));
+        return tls_server.IsSessionReused();
+      },
+      std::move(server));
+
+  io::TlsHandshakeOptions options;
+  options.session_cache = &client_cache;
+  auto tls_client =
+      io::TlsWrapper::StartTlsClient(std::move(client), {}, deadline, options);
+  // session tickets of TLS 1.3 arrive along with the data
+  char c = 0;
+  EXPECT_EQ(1, tls_client.RecvSome(&c, 1, deadline));
+  EXPECT_EQ(1, tls_client.SendAll("2", 1, deadline));
+
+  const bool is_server_reused = server_task.Get();
+  EXPECT_EQ(is_server_reused, tls_client.IsSessionReused());
+  return tls_client.IsSessionReused();
+}
+
 }  // namespace
 
 UTEST_MT(TlsWrapper, Smoke, 2) {
@@ -422,6 +468,159 @@ UTEST_MT(TlsWrapper, DoubleSmoke, 4) {
   other_client_task.Get();
 }
 
+UTEST_MT(TlsWrapper, SessionResumption, 2) {
+  const auto test_deadline = Deadline::FromDuration(utest::kMaxTestWaitTime);
+
+  TcpListener tcp_listener;
+  io::TlsSessionCache server_cache;
+  io::TlsSessionCache client_cache;
+
+  EXPECT_FALSE(ConnectWithSessionCache(tcp_listener, server_cache,
+                                       client_cache, test_deadline));
+  EXPECT_TRUE(ConnectWithSessionCache(tcp_listener, server_cache, client_cache,
+                                      test_deadline));
+  EXPECT_TRUE(ConnectWithSessionCache(tcp_listener, server_cache, client_cache,
+                                      test_deadline));
+
+  const auto client_stats = client_cache.GetStatistics();
+  EXPECT_EQ(client_stats.client_full_handshakes, 1);
+  EXPECT_EQ(client_stats.client_resumed_handshakes, 2);
+  EXPECT_EQ(client_stats.cached_sessions, 1);
+
+  const auto server_stats = server_cache.GetStatistics();
+  EXPECT_EQ(server_stats.server_full_handshakes, 1);
+  EXPECT_EQ(server_stats.server_resumed_handshakes, 2);
+
+  client_cache.Clear();
+  EXPECT_FALSE(ConnectWithSessionCache(tcp_listener, server_cache,
+                                       client_cache, test_deadline));
+}
+
+UTEST_MT(TlsWrapper, SessionTicketKeysRotation, 2) {
+  const auto test_deadline = Deadline::FromDuration(utest::kMaxTestWaitTime);
+
+  TcpListener tcp_listener;
+  io::TlsSessionCache server_cache;
+  io::TlsSessionCache client_cache;
+
+  server_cache.SetTicketKeys({MakeTicketKey('a')});
+  EXPECT_FALSE(ConnectWithSessionCache(tcp_listener, server_cache,
+                                       client_cache, test_deadline));
+
+  // previous key is still accepted, the ticket is renewed
+  server_cache.SetTicketKeys({MakeTicketKey('b'), MakeTicketKey('a')});
+  EXPECT_TRUE(ConnectWithSessionCache(tcp_listener, server_cache, client_cache,
+                                      test_deadline));
+
+  server_cache.SetTicketKeys({MakeTicketKey('b')});
+  EXPECT_TRUE(ConnectWithSessionCache(tcp_listener, server_cache, client_cache,
+                                      test_deadline));
+
+  server_cache.SetTicketKeys({MakeTicketKey('c')});
+  EXPECT_FALSE(ConnectWithSessionCache(tcp_listener, server_cache,
+                                       client_cache, test_deadline));
+
+  UEXPECT_THROW(server_cache.SetTicketKeys({}), io::TlsException);
+  UEXPECT_THROW(server_cache.SetTicketKeys({"short"}), io::TlsException);
+}
+
+UTEST_MT(TlsWrapper, KernelTls, 2) {
+  const auto test_deadline = Deadline::FromDuration(utest::kMaxTestWaitTime);
+  static constexpr std::string_view kFileData = "file contents";
+
+  const auto file = fs::blocking::TempFile::Create();
+  fs::blocking::RewriteFileContents(file.GetPath(), kFileData);
+
+  TcpListener tcp_listener;
+  auto [server, client] = tcp_listener.MakeSocketPair(test_deadline);
+
+  io::TlsHandshakeOptions options;
+  // falls back to userspace encryption if unsupported
+  options.enable_kernel_tls = true;
+
+  auto server_task = engine::AsyncNoSpan(
+      [&file, &options, test_deadline](auto&& server) {
+        auto tls_server = io::TlsWrapper::StartTlsServer(
+            std::move(server), crypto::Certificate::LoadFromString(cert),
+            crypto::PrivateKey::LoadFromString(key), test_deadline, {},
+            options);
+        EXPECT_EQ(1, tls_server.SendAll("1", 1, test_deadline));
+
+        const int fd = ::open(file.GetPath().c_str(), O_RDONLY);
+        ASSERT_NE(fd, -1);
+        EXPECT_EQ(kFileData.size() - 1,
+                  tls_server.SendFile(fd, 1, kFileData.size() - 1,
+                                      engine::current_task::GetTaskProcessor(),
+                                      test_deadline));
+        ::close(fd);
+
+        char c = 0;
+        EXPECT_EQ(1, tls_server.RecvSome(&c, 1, test_deadline));
+        EXPECT_EQ('2', c);
+      },
+      std::move(server));
+
+  auto tls_client = io::TlsWrapper::StartTlsClient(std::move(client), {},
+                                                   test_deadline, options);
+  std::string data(kFileData.size(), '\0');
+  EXPECT_EQ(data.size(),
+            tls_client.RecvAll(data.data(), data.size(), test_deadline));
+  EXPECT_EQ(data, "1" + std::string{kFileData.substr(1)});
+  EXPECT_EQ(1, tls_client.SendAll("2", 1, test_deadline));
+
+  server_task.Get();
+}
+
+UTEST_MT(TlsWrapper, SendFileChunks, 2) {
+  const auto test_deadline = Deadline::FromDuration(utest::kMaxTestWaitTime);
+  // several chunks of the userspace fallback, the last one is partial
+  std::string file_data(200 * 1024 + 7, '\0');
+  for (size_t i = 0; i < file_data.size(); ++i) {
+    file_data[i] = static_cast<char>('a' + i % 26);
+  }
+
+  const auto file = fs::blocking::TempFile::Create();
+  fs::blocking::RewriteFileContents(file.GetPath(), file_data);
+
+  TcpListener tcp_listener;
+  auto [server, client] = tcp_listener.MakeSocketPair(test_deadline);
+
+  io::TlsHandshakeOptions options;
+  options.enable_kernel_tls = false;
+
+  auto server_task = engine::AsyncNoSpan(
+      [&file, &options, &file_data, test_deadline](auto&& server) {
+        auto tls_server = io::TlsWrapper::StartTlsServer(
+            std::move(server), crypto::Certificate::LoadFromString(cert),
+            crypto::PrivateKey::LoadFromString(key), test_deadline, {},
+            options);
+        EXPECT_EQ(1, tls_server.SendAll("1", 1, test_deadline));
+
+        const int fd = ::open(file.GetPath().c_str(), O_RDONLY);
+        ASSERT_NE(fd, -1);
+        EXPECT_EQ(file_data.size() - 1,
+                  tls_server.SendFile(fd, 1, file_data.size() - 1,
+                                      engine::current_task::GetTaskProcessor(),
+                                      test_deadline));
+        ::close(fd);
+
+        char c = 0;
+        EXPECT_EQ(1, tls_server.RecvSome(&c, 1, test_deadline));
+        EXPECT_EQ('2', c);
+      },
+      std::move(server));
+
+  auto tls_client = io::TlsWrapper::StartTlsClient(std::move(client), {},
+                                                   test_deadline, options);
+  std::string data(file_data.size(), '\0');
+  EXPECT_EQ(data.size(),
+            tls_client.RecvAll(data.data(), data.size(), test_deadline));
+  EXPECT_EQ(data, "1" + file_data.substr(1));
+  EXPECT_EQ(1, tls_client.SendAll("2", 1, test_deadline));
+
+  server_task.Get();
+}
+
 UTEST(TlsWrapper, InvalidSocket) {
   const auto test_deadline = Deadline::FromDuration(utest::kMaxTestWaitTime);
 
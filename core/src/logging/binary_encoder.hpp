@@ -0,0 +1,165 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <string_view>
+#include <type_traits>
+
+#include <userver/logging/binary_format.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace logging::binary::impl {
+
+// The LogHelper payload of the binary loggers starts with this byte. Payloads
+// without it (e.g. the raw text of the access logs) are written as a "text"
+// field.
+inline constexpr char kFieldsMarker = '\0';
+
+inline constexpr std::uint8_t kInlineKey = 0;
+
+// Index + 1 of the key is written instead of these keys. The keys are written
+// as they were logged, the periods are replaced only in the TSKV output.
+// Append only, the order is a part of the format.
+inline constexpr std::string_view kInternedKeys[] = {
+    "module",          "task_id",         "thread_id",
+    "text",            "trace_id",        "span_id",
+    "parent_id",       "link",            "parent_link",
+    "stopwatch_name",  "total_time",      "stopwatch_units",
+    "start_timestamp", "span_ref_type",   "_type",
+    "meta_type",       "meta_code",       "http.url",
+    "method",          "error",           "error_msg",
+    "stacktrace",
+};
+
+inline constexpr std::size_t kInternedKeysCount = std::size(kInternedKeys);
+
+inline constexpr std::size_t kStringSizeBytes = 4;
+inline constexpr std::size_t kRecordSizeBytes = 4;
+
+inline std::uint8_t FindInternedKey(std::string_view key) noexcept {
+  for (std::size_t i = 0; i < kInternedKeysCount; ++i) {
+    if (kInternedKeys[i] == key) return static_cast<std::uint8_t>(i + 1);
+  }
+  return kInlineKey;
+}
+
+template <typename Buffer>
+void AppendRaw(Buffer& buffer, std::string_view data) {
+  buffer.append(data.data(), data.data() + data.size());
+}
+
+template <typename Buffer>
+void AppendByte(Buffer& buffer, std::uint8_t value) {
+  buffer.push_back(static_cast<char>(value));
+}
+
+template <typename Buffer, typename Unsigned>
+void AppendLittleEndian(Buffer& buffer, Unsigned value) {
+  static_assert(std::is_unsigned_v<Unsigned>);
+  char bytes[sizeof(Unsigned)];
+  for (auto& byte : bytes) {
+    byte = static_cast<char>(value & 0xff);
+    value >>= 8;
+  }
+  AppendRaw(buffer, std::string_view{bytes, sizeof(bytes)});
+}
+
+template <typename Buffer>
+void AppendVarint(Buffer& buffer, std::uint64_t value) {
+  while (value >= 0x80) {
+    AppendByte(buffer, static_cast<std::uint8_t>(value | 0x80));
+    value >>= 7;
+  }
+  AppendByte(buffer, static_cast<std::uint8_t>(value));
+}
+
+template <typename Buffer>
+void AppendKey(Buffer& buffer, std::string_view key) {
+  const auto id = FindInternedKey(key);
+  AppendByte(buffer, id);
+  if (id == kInlineKey) {
+    AppendVarint(buffer, key.size());
+    AppendRaw(buffer, key);
+  }
+}
+
+/// Writes the key and the string type, the string itself should be appended
+/// to the buffer and then finished by FinishString(buffer, returned_offset)
+template <typename Buffer>
+std::size_t StartStringField(Buffer& buffer, std::string_view key) {
+  AppendKey(buffer, key);
+  AppendByte(buffer, static_cast<std::uint8_t>(ValueType::kString));
+  const auto offset = buffer.size();
+  buffer.resize(offset + kStringSizeBytes);
+  return offset;
+}
+
+template <typename Buffer>
+void FinishString(Buffer& buffer, std::size_t offset) {
+  auto size =
+      static_cast<std::uint32_t>(buffer.size() - offset - kStringSizeBytes);
+  for (std::size_t i = 0; i < kStringSizeBytes; ++i) {
+    buffer.data()[offset + i] = static_cast<char>(size & 0xff);
+    size >>= 8;
+  }
+}
+
+template <typename Buffer>
+void AppendField(Buffer& buffer, std::string_view key, std::string_view value) {
+  const auto offset = StartStringField(buffer, key);
+  AppendRaw(buffer, value);
+  FinishString(buffer, offset);
+}
+
+template <typename Buffer>
+void AppendField(Buffer& buffer, std::string_view key, std::int64_t value) {
+  AppendKey(buffer, key);
+  AppendByte(buffer, static_cast<std::uint8_t>(ValueType::kSigned));
+  // zigzag encoding keeps the small negative values short
+  AppendVarint(buffer, (static_cast<std::uint64_t>(value) << 1) ^
+                           static_cast<std::uint64_t>(value >> 63));
+}
+
+template <typename Buffer>
+void AppendField(Buffer& buffer, std::string_view key, std::uint64_t value) {
+  AppendKey(buffer, key);
+  AppendByte(buffer, static_cast<std::uint8_t>(ValueType::kUnsigned));
+  AppendVarint(buffer, value);
+}
+
+template <typename Buffer>
+void AppendField(Buffer& buffer, std::string_view key, double value) {
+  AppendKey(buffer, key);
+  AppendByte(buffer, static_cast<std::uint8_t>(ValueType::kDouble));
+  std::uint64_t bits{};
+  static_assert(sizeof(bits) == sizeof(value));
+  std::memcpy(&bits, &value, sizeof(bits));
+  AppendLittleEndian(buffer, bits);
+}
+
+template <typename Buffer>
+void AppendField(Buffer& buffer, std::string_view key, bool value) {
+  AppendKey(buffer, key);
+  AppendByte(buffer, static_cast<std::uint8_t>(ValueType::kBool));
+  AppendByte(buffer, value ? 1 : 0);
+}
+
+template <typename Buffer>
+void AppendField(Buffer& buffer, std::string_view key, Hex value) {
+  AppendKey(buffer, key);
+  AppendByte(buffer, static_cast<std::uint8_t>(ValueType::kHex));
+  AppendVarint(buffer, value.value);
+}
+
+template <typename Buffer>
+void AppendField(Buffer& buffer, std::string_view key, HexShort value) {
+  AppendKey(buffer, key);
+  AppendByte(buffer, static_cast<std::uint8_t>(ValueType::kHexShort));
+  AppendVarint(buffer, value.value);
+}
+
+}  // namespace logging::binary::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,248 @@
+#include <userver/logging/binary_format.hpp>
+
+#include <time.h>
+
+#include <cstring>
+
+#include <fmt/compile.h>
+#include <fmt/format.h>
+
+#include <logging/binary_encoder.hpp>
+#include <userver/formats/json/string_builder.hpp>
+#include <userver/utils/encoding/tskv.hpp>
+#include <userver/utils/overloaded.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace logging::binary {
+
+namespace {
+
+constexpr std::string_view kLevelNames[] = {
+    "TRACE", "DEBUG", "INFO", "WARNING", "ERROR", "CRITICAL", "OFF",
+};
+
+[[noreturn]] void ThrowTruncated() {
+  throw ParseError("Truncated field in the binary log record");
+}
+
+std::string_view ParseBytes(std::string_view& data, std::size_t size) {
+  if (data.size() < size) ThrowTruncated();
+  const auto result = data.substr(0, size);
+  data.remove_prefix(size);
+  return result;
+}
+
+std::uint8_t ParseByte(std::string_view& data) {
+  return static_cast<std::uint8_t>(ParseBytes(data, 1)[0]);
+}
+
+template <typename Unsigned>
+Unsigned ParseLittleEndian(std::string_view& data) {
+  const auto bytes = ParseBytes(data, sizeof(Unsigned));
+  Unsigned result = 0;
+  for (std::size_t i = sizeof(Unsigned); i > 0; --i) {
+    result = (result << 8) | static_cast<std::uint8_t>(bytes[i - 1]);
+  }
+  return result;
+}
+
+std::uint64_t ParseVarint(std::string_view& data) {
+  std::uint64_t result = 0;
+  for (int shift = 0; shift < 64; shift += 7) {
+    const auto byte = ParseByte(data);
+    result |= static_cast<std::uint64_t>(byte & 0x7f) << shift;
+    if (!(byte & 0x80)) return result;
+  }
+  throw ParseError("Too long varint in the binary log record");
+}
+
+std::string_view ParseKey(std::string_view& data) {
+  const auto id = ParseByte(data);
+  if (id == impl::kInlineKey) return ParseBytes(data, ParseVarint(data));
+  if (id > impl::kInternedKeysCount) {
+    throw ParseError(
+        fmt::format("Unknown key id {} in the binary log record", id));
+  }
+  return impl::kInternedKeys[id - 1];
+}
+
+Value ParseValue(std::string_view& data) {
+  const auto type = ParseByte(data);
+  switch (static_cast<ValueType>(type)) {
+    case ValueType::kString:
+      return ParseBytes(data, ParseLittleEndian<std::uint32_t>(data));
+    case ValueType::kSigned: {
+      const auto zigzag = ParseVarint(data);
+      return static_cast<std::int64_t>((zigzag >> 1) ^ (~(zigzag & 1) + 1));
+    }
+    case ValueType::kUnsigned:
+      return ParseVarint(data);
+    case ValueType::kDouble: {
+      const auto bits = ParseLittleEndian<std::uint64_t>(data);
+      double result{};
+      std::memcpy(&result, &bits, sizeof(result));
+      return result;
+    }
+    case ValueType::kBool:
+      return ParseByte(data) != 0;
+    case ValueType::kHex:
+      return Hex{ParseVarint(data)};
+    case ValueType::kHexShort:
+      return HexShort{ParseVarint(data)};
+  }
+  throw ParseError(
+      fmt::format("Unknown value type {} in the binary log record", type));
+}
+
+class PutCharString final {
+ public:
+  void operator()(std::string& to, char ch) const { to.push_back(ch); }
+};
+
+void AppendEncoded(std::string& result, std::string_view value,
+                   utils::encoding::EncodeTskvMode mode) {
+  result.reserve(result.size() + value.size());
+  utils::encoding::EncodeTskv(result, value.data(),
+                              value.data() + value.size(), mode,
+                              PutCharString{});
+}
+
+void AppendTimestamp(std::string& result,
+                     std::chrono::system_clock::time_point timestamp) {
+  const auto since_epoch = timestamp.time_since_epoch();
+  const auto seconds =
+      std::chrono::duration_cast<std::chrono::seconds>(since_epoch);
+  const auto microseconds =
+      std::chrono::duration_cast<std::chrono::microseconds>(since_epoch -
+                                                            seconds);
+  // Same as the "%Y-%m-%dT%H:%M:%S.%f" pattern of the text loggers
+  const time_t time = seconds.count();
+  struct tm tm {};
+  localtime_r(&time, &tm);
+  fmt::format_to(std::back_inserter(result),
+                 FMT_COMPILE("{:04}-{:02}-{:02}T{:02}:{:02}:{:02}.{:06}"),
+                 tm.tm_year + 1900, tm.tm_mon + 1, tm.tm_mday, tm.tm_hour,
+                 tm.tm_min, tm.tm_sec, microseconds.count());
+}
+
+std::string_view GetLevelName(Level level) {
+  const auto index = static_cast<std::size_t>(level);
+  return index < std::size(kLevelNames) ? kLevelNames[index] : "UNKNOWN";
+}
+
+}  // namespace
+
+bool ReadRecord(std::string_view& data, Record& record) {
+  if (data.size() < impl::kRecordSizeBytes) return false;
+
+  auto body = data;
+  const auto size = ParseLittleEndian<std::uint32_t>(body);
+  if (body.size() < size) return false;
+  body = body.substr(0, size);
+
+  const auto version = ParseByte(body);
+  if (version != kRecordVersion) {
+    throw ParseError(fmt::format(
+        "Unsupported binary log record version {}, expected {}", version,
+        kRecordVersion));
+  }
+
+  const auto nanoseconds = ParseLittleEndian<std::uint64_t>(body);
+  record.timestamp = std::chrono::system_clock::time_point{
+      std::chrono::duration_cast<std::chrono::system_clock::duration>(
+          std::chrono::nanoseconds{nanoseconds})};
+
+  const auto level = ParseByte(body);
+  if (level > static_cast<std::uint8_t>(Level::kNone)) {
+    throw ParseError(
+        fmt::format("Unknown level {} in the binary log record", level));
+  }
+  record.level = static_cast<Level>(level);
+
+  record.fields.clear();
+  while (!body.empty()) {
+    auto key = ParseKey(body);
+    record.fields.push_back({key, ParseValue(body)});
+  }
+
+  data.remove_prefix(impl::kRecordSizeBytes + size);
+  return true;
+}
+
+void FormatAsTskv(const Record& record, std::string& result) {
+  result.append("tskv\ttimestamp=");
+  AppendTimestamp(result, record.timestamp);
+  result.append("\tlevel=");
+  result.append(GetLevelName(record.level));
+
+  auto out = std::back_inserter(result);
+  for (const auto& field : record.fields) {
+    result.push_back(utils::encoding::kTskvPairsSeparator);
+    AppendEncoded(result, field.key,
+                  utils::encoding::EncodeTskvMode::kKeyReplacePeriod);
+    result.push_back(utils::encoding::kTskvKeyValueSeparator);
+    std::visit(
+        utils::Overloaded{
+            [&](std::string_view value) {
+              AppendEncoded(result, value,
+                            utils::encoding::EncodeTskvMode::kValue);
+            },
+            [&](Hex value) {
+              fmt::format_to(out, FMT_COMPILE("0x{:016X}"), value.value);
+            },
+            [&](HexShort value) {
+              fmt::format_to(out, FMT_COMPILE("{:X}"), value.value);
+            },
+            [&](const auto& value) {
+              fmt::format_to(out, FMT_COMPILE("{}"), value);
+            },
+        },
+        field.value);
+  }
+}
+
+void FormatAsJson(const Record& record, std::string& result) {
+  formats::json::StringBuilder builder;
+  {
+    formats::json::StringBuilder::ObjectGuard guard{builder};
+
+    std::string timestamp;
+    AppendTimestamp(timestamp, record.timestamp);
+    builder.Key("timestamp");
+    builder.WriteString(timestamp);
+    builder.Key("level");
+    builder.WriteString(GetLevelName(record.level));
+
+    std::string hex;
+    for (const auto& field : record.fields) {
+      builder.Key(field.key);
+      std::visit(
+          utils::Overloaded{
+              [&](std::string_view value) { builder.WriteString(value); },
+              [&](std::int64_t value) { builder.WriteInt64(value); },
+              [&](std::uint64_t value) { builder.WriteUInt64(value); },
+              [&](double value) { builder.WriteDouble(value); },
+              [&](bool value) { builder.WriteBool(value); },
+              [&](Hex value) {
+                hex.clear();
+                fmt::format_to(std::back_inserter(hex),
+                               FMT_COMPILE("0x{:016X}"), value.value);
+                builder.WriteString(hex);
+              },
+              [&](HexShort value) {
+                hex.clear();
+                fmt::format_to(std::back_inserter(hex), FMT_COMPILE("{:X}"),
+                               value.value);
+                builder.WriteString(hex);
+              },
+          },
+          field.value);
+    }
+  }
+  result.append(builder.GetString());
+}
+
+}  // namespace logging::binary
+
+USERVER_NAMESPACE_END
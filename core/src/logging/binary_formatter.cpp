@@ -0,0 +1,75 @@
+#include <logging/binary_formatter.hpp>
+
+#include <chrono>
+#include <string>
+
+#include <logging/binary_encoder.hpp>
+#include <userver/logging/binary_format.hpp>
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace logging::impl {
+
+namespace {
+
+template <typename Buffer>
+void AppendRecord(const spdlog::details::log_msg& msg, Buffer& dest) {
+  namespace binary = logging::binary;
+
+  const auto size_offset = dest.size();
+  dest.resize(size_offset + binary::impl::kRecordSizeBytes);
+
+  binary::impl::AppendByte(dest, binary::kRecordVersion);
+  binary::impl::AppendLittleEndian(
+      dest, static_cast<std::uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    msg.time.time_since_epoch())
+                    .count()));
+  binary::impl::AppendByte(dest, static_cast<std::uint8_t>(msg.level));
+
+  const std::string_view payload{msg.payload.data(), msg.payload.size()};
+  if (!payload.empty() && payload[0] == binary::impl::kFieldsMarker) {
+    binary::impl::AppendRaw(dest, payload.substr(1));
+  } else {
+    binary::impl::AppendField(dest, "text", payload);
+  }
+
+  // the record size has the same layout as the string size
+  binary::impl::FinishString(dest, size_offset);
+}
+
+}  // namespace
+
+void BinaryFormatter::format(const spdlog::details::log_msg& msg,
+                             spdlog::memory_buf_t& dest) {
+  AppendRecord(msg, dest);
+}
+
+std::unique_ptr<spdlog::formatter> BinaryFormatter::clone() const {
+  return std::make_unique<BinaryFormatter>();
+}
+
+void BinaryToTskvFormatter::format(const spdlog::details::log_msg& msg,
+                                   spdlog::memory_buf_t& dest) {
+  std::string record;
+  AppendRecord(msg, record);
+
+  std::string_view data = record;
+  binary::Record parsed;
+  [[maybe_unused]] const bool read = binary::ReadRecord(data, parsed);
+  UASSERT(read && data.empty());
+
+  std::string text;
+  binary::FormatAsTskv(parsed, text);
+  text.push_back('\n');
+  dest.append(text.data(), text.data() + text.size());
+}
+
+std::unique_ptr<spdlog::formatter> BinaryToTskvFormatter::clone() const {
+  return std::make_unique<BinaryToTskvFormatter>();
+}
+
+}  // namespace logging::impl
+
+USERVER_NAMESPACE_END
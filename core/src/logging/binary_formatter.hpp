@@ -0,0 +1,36 @@
+#pragma once
+
+#include <memory>
+
+// this header must be included before any spdlog headers
+// to override spdlog's level names
+#include <logging/spdlog.hpp>
+
+#include <spdlog/formatter.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace logging::impl {
+
+/// Writes the messages as logging::binary records
+class BinaryFormatter final : public spdlog::formatter {
+ public:
+  void format(const spdlog::details::log_msg& msg,
+              spdlog::memory_buf_t& dest) override;
+
+  std::unique_ptr<spdlog::formatter> clone() const override;
+};
+
+/// Writes the messages of a logging::Format::kBinary logger in the default
+/// TSKV layout, for the sinks that expect text (e.g. the testsuite capture)
+class BinaryToTskvFormatter final : public spdlog::formatter {
+ public:
+  void format(const spdlog::details::log_msg& msg,
+              spdlog::memory_buf_t& dest) override;
+
+  std::unique_ptr<spdlog::formatter> clone() const override;
+};
+
+}  // namespace logging::impl
+
+USERVER_NAMESPACE_END
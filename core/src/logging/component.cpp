@@ -15,7 +15,9 @@
 #include <spdlog/pattern_formatter.h>
 #include <spdlog/sinks/stdout_sinks.h>
 
+#include <logging/binary_formatter.hpp>
 #include <logging/logger_with_info.hpp>
+#include <logging/per_thread_buffer_sink.hpp>
 #include <logging/reopening_file_sink.hpp>
 #include <userver/components/component.hpp>
 #include <userver/engine/async.hpp>
@@ -25,6 +27,7 @@
 #include <userver/logging/logger.hpp>
 #include <userver/os_signals/component.hpp>
 #include <userver/utils/algo.hpp>
+#include <userver/utils/statistics/writer.hpp>
 #include <userver/utils/thread_name.hpp>
 #include <userver/yaml_config/merge_schemas.hpp>
 
@@ -62,18 +65,50 @@ std::optional<TestsuiteCaptureConfig> GetTestsuiteCaptureConfig(
   return config.As<TestsuiteCaptureConfig>();
 }
 
+template <typename Sink>
+void Reopen(const spdlog::sink_ptr& sink) {
+  auto reop = std::dynamic_pointer_cast<Sink>(sink);
+  if (!reop) {
+    return;
+  }
+
+  try {
+    bool should_truncate = false;
+    reop->Reopen(should_truncate);
+  } catch (const std::exception& e) {
+    LOG_ERROR() << "Exception on log reopen: " << e;
+  }
+}
+
 void ReopenAll(std::vector<spdlog::sink_ptr>& sinks) {
   for (const auto& s : sinks) {
-    auto reop = std::dynamic_pointer_cast<logging::ReopeningFileSinkMT>(s);
-    if (!reop) {
-      continue;
-    }
+    Reopen<logging::ReopeningFileSinkMT>(s);
+    Reopen<logging::impl::PerThreadBufferSink>(s);
+  }
+}
 
-    try {
-      bool should_truncate = false;
-      reop->Reopen(should_truncate);
-    } catch (const std::exception& e) {
-      LOG_ERROR() << "Exception on log reopen: " << e;
+void WriteSinkStatistics(utils::statistics::Writer& writer,
+                         std::string_view logger_name,
+                         const logging::impl::LoggerWithInfo& logger) {
+  for (const auto& sink : logger.ptr->sinks()) {
+    const auto* buffered =
+        dynamic_cast<const logging::impl::PerThreadBufferSink*>(sink.get());
+    if (!buffered) continue;
+
+    const auto stats = buffered->GetStatistics();
+    const utils::statistics::LabelView label{"logger", logger_name};
+    writer["queue-size"].ValueWithLabels(stats.queue_size, label);
+    writer["buffers"].ValueWithLabels(stats.buffers, label);
+    writer["dropped"].ValueWithLabels(stats.dropped, label);
+    writer["write-errors"].ValueWithLabels(stats.write_errors, label);
+
+    auto flush_latency = writer["flush-latency-us"];
+    for (const auto& [percentile, name] :
+         {std::pair{50.0, "p50"}, std::pair{95.0, "p95"},
+          std::pair{99.0, "p99"}, std::pair{100.0, "p100"}}) {
+      flush_latency.ValueWithLabels(
+          stats.flush_timings.GetPercentile(percentile),
+          {label, {"percentile", name}});
     }
   }
 }
@@ -111,8 +146,27 @@ std::shared_ptr<logging::impl::LoggerWithInfo> CreateAsyncLogger(
 
   CreateLogDirectory(logger_name, logger_config.file_path);
 
-  auto file_sink =
-      std::make_shared<logging::ReopeningFileSinkMT>(logger_config.file_path);
+  const bool separate_with_newline =
+      logger_config.format != logging::Format::kBinary;
+
+  if (logger_config.per_thread_buffer_size != 0) {
+    auto sink = std::make_shared<logging::impl::PerThreadBufferSink>(
+        logging::impl::PerThreadBufferSink::Settings{
+            logger_config.file_path,
+            "log/" + logger_name,
+            logger_config.per_thread_buffer_size,
+            logger_config.queue_overflow_behavior ==
+                logging::LoggerConfig::QueueOveflowBehavior::kBlock,
+            separate_with_newline,
+        });
+    return std::make_shared<logging::impl::LoggerWithInfo>(
+        logger_config.format,
+        std::shared_ptr<spdlog::details::thread_pool>{},
+        utils::MakeSharedRef<spdlog::logger>(logger_name, std::move(sink)));
+  }
+
+  auto file_sink = std::make_shared<logging::ReopeningFileSinkMT>(
+      logger_config.file_path, separate_with_newline);
   auto tp = std::make_shared<spdlog::details::thread_pool>(
       logger_config.message_queue_size, logger_config.thread_pool_size);
 
@@ -134,7 +188,8 @@ std::shared_ptr<logging::impl::LoggerWithInfo> CreateAsyncLogger(
 namespace impl {
 
 template <class Sink, class SinksVector>
-void AddSocketSink(const TestsuiteCaptureConfig&, Sink&, SinksVector&) {
+void AddSocketSink(const TestsuiteCaptureConfig&, logging::Format, Sink&,
+                   SinksVector&) {
   throw std::runtime_error(
       "TCP Sinks are disabled by the cmake option "
       "'USERVER_FEATURE_SPDLOG_TCP_SINK'. "
@@ -162,8 +217,8 @@ class Logging::TestsuiteCaptureSink final : public spdlog::sinks::tcp_sink_mt {
 namespace impl {
 
 template <class Sink, class SinksVector>
-void AddSocketSink(const TestsuiteCaptureConfig& config, Sink& socket_sink,
-                   SinksVector& sinks) {
+void AddSocketSink(const TestsuiteCaptureConfig& config, logging::Format format,
+                   Sink& socket_sink, SinksVector& sinks) {
   spdlog::sinks::tcp_sink_config spdlog_config{
       config.host,
       config.port,
@@ -172,8 +227,14 @@ void AddSocketSink(const TestsuiteCaptureConfig& config, Sink& socket_sink,
 
   socket_sink =
       std::make_shared<Logging::TestsuiteCaptureSink>(std::move(spdlog_config));
-  socket_sink->set_formatter(std::make_unique<spdlog::pattern_formatter>(
-      logging::LoggerConfig::kDefaultTskvPattern));
+  // testsuite parses the captured logs as TSKV
+  if (format == logging::Format::kBinary) {
+    socket_sink->set_formatter(
+        std::make_unique<logging::impl::BinaryToTskvFormatter>());
+  } else {
+    socket_sink->set_formatter(std::make_unique<spdlog::pattern_formatter>(
+        logging::LoggerConfig::kDefaultTskvPattern));
+  }
   socket_sink->set_level(spdlog::level::off);
 
   sinks.push_back(socket_sink);
@@ -205,15 +266,20 @@ Logging::Logging(const ComponentConfig& config, const ComponentContext& context)
 
     logger->ptr->set_level(
         static_cast<spdlog::level::level_enum>(logger_config.level));
-    logger->ptr->set_pattern(logger_config.pattern);
+    if (logger_config.format == logging::Format::kBinary) {
+      logger->ptr->set_formatter(
+          std::make_unique<logging::impl::BinaryFormatter>());
+    } else {
+      logger->ptr->set_pattern(logger_config.pattern);
+    }
     logger->ptr->flush_on(
         static_cast<spdlog::level::level_enum>(logger_config.flush_level));
 
     if (is_default_logger) {
       if (const auto& testsuite_config =
               GetTestsuiteCaptureConfig(logger_yaml)) {
-        impl::AddSocketSink(*testsuite_config, socket_sink_,
-                            logger->ptr->sinks());
+        impl::AddSocketSink(*testsuite_config, logger_config.format,
+                            socket_sink_, logger->ptr->sinks());
       }
       logging::SetDefaultLogger(logger);
     } else {
@@ -290,6 +356,13 @@ void Logging::OnLogRotate() {
   LOG_INFO() << "Log rotated";
 }
 
+void Logging::WriteStatistics(utils::statistics::Writer& writer) const {
+  WriteSinkStatistics(writer, "default", *logging::DefaultLogger());
+  for (const auto& [name, logger] : loggers_) {
+    WriteSinkStatistics(writer, name, *logger);
+  }
+}
+
 void Logging::FlushLogs() {
   logging::DefaultLogger()->ptr->flush();
   for (auto& item : loggers_) {
@@ -329,6 +402,7 @@ properties:
                     enum:
                       - tskv
                       - ltsv
+                      - binary
                 pattern:
                     type: string
                     description: message formatting pattern, see [spdlog wiki](https://github.com/gabime/spdlog/wiki/3.-Custom-formatting#pattern-flags) for details, %%v means message text
@@ -348,6 +422,10 @@ properties:
                     enum:
                       - discard
                       - block
+                per_thread_buffer_size:
+                    type: integer
+                    description: if non-zero, each thread puts the formatted messages into its own ring buffer of this size in bytes instead of the shared message queue, must be a power of 2
+                    defaultDescription: 0
                 testsuite-capture:
                     type: object
                     description: if exists, setups additional TCP log sink for testing purposes
@@ -44,6 +44,9 @@ LoggerConfig Parse(const yaml_config::YamlConfig& value,
     case Format::kLtsv:
       default_pattern = LoggerConfig::kDefaultLtsvPattern;
       break;
+    case Format::kBinary:
+      // the pattern is ignored, the records are written by BinaryFormatter
+      break;
   }
 
   config.pattern = value["pattern"].As<std::string>(default_pattern);
@@ -63,6 +66,12 @@ LoggerConfig Parse(const yaml_config::YamlConfig& value,
   config.thread_pool_size = value["thread_pool_size"].As<size_t>(
       LoggerConfig::kDefaultThreadPoolSize);
 
+  config.per_thread_buffer_size =
+      value["per_thread_buffer_size"].As<size_t>(0);
+  if (config.per_thread_buffer_size & (config.per_thread_buffer_size - 1)) {
+    throw std::runtime_error("per-thread log buffer size must be a power of 2");
+  }
+
   return config;
 }
 
@@ -33,6 +33,9 @@ struct LoggerConfig {
   QueueOveflowBehavior queue_overflow_behavior = QueueOveflowBehavior::kDiscard;
 
   size_t thread_pool_size = kDefaultThreadPoolSize;
+
+  // 0 means the shared message queue, otherwise must be a power of 2
+  size_t per_thread_buffer_size = 0;
 };
 
 LoggerConfig Parse(const yaml_config::YamlConfig& value,
@@ -19,10 +19,13 @@ Format FormatFromString(std::string_view format_str) {
     return Format::kLtsv;
   }
 
-  UINVARIANT(
-      false,
-      fmt::format("Unknown logging format '{}' (must be one of 'tskv', 'ltsv')",
-                  format_str));
+  if (format_str == "binary") {
+    return Format::kBinary;
+  }
+
+  UINVARIANT(false, fmt::format("Unknown logging format '{}' (must be one of "
+                                "'tskv', 'ltsv', 'binary')",
+                                format_str));
 }
 
 }  // namespace logging
@@ -0,0 +1,153 @@
+#include <gtest/gtest.h>
+
+#include <logging/logging_test.hpp>
+#include <userver/logging/binary_format.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/logging/log_extra.hpp>
+#include <userver/logging/logger.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+const logging::binary::Value* FindField(const logging::binary::Record& record,
+                                        std::string_view key) {
+  for (const auto& field : record.fields) {
+    if (field.key == key) return &field.value;
+  }
+  return nullptr;
+}
+
+template <typename T>
+T GetField(const logging::binary::Record& record, std::string_view key) {
+  const auto* value = FindField(record, key);
+  if (!value) {
+    ADD_FAILURE() << "No field " << key;
+    return {};
+  }
+  const auto* typed = std::get_if<T>(value);
+  if (!typed) {
+    ADD_FAILURE() << "Field " << key << " has type #" << value->index();
+    return {};
+  }
+  return *typed;
+}
+
+std::string ToTskv(const logging::binary::Record& record) {
+  std::string result;
+  logging::binary::FormatAsTskv(record, result);
+  return result;
+}
+
+}  // namespace
+
+TEST_F(LoggingBinaryTest, Basic) {
+  LOG_INFO() << "text\twith=special\nchars " << 42;
+  LOG_WARNING() << "second";
+
+  const auto records = LoggedRecords();
+  ASSERT_EQ(records.size(), 2);
+
+  const auto& record = records[0];
+  EXPECT_EQ(record.level, logging::Level::kInfo);
+  EXPECT_EQ(GetField<std::string_view>(record, "text"),
+            "text\twith=special\nchars 42");
+  EXPECT_NE(GetField<std::string_view>(record, "module").find(" ( "),
+            std::string_view::npos);
+  EXPECT_TRUE(std::holds_alternative<logging::HexShort>(
+      *FindField(record, "task_id")));
+  EXPECT_TRUE(
+      std::holds_alternative<logging::Hex>(*FindField(record, "thread_id")));
+
+  EXPECT_EQ(records[1].level, logging::Level::kWarning);
+  EXPECT_EQ(GetField<std::string_view>(records[1], "text"), "second");
+  EXPECT_LE(record.timestamp, records[1].timestamp);
+}
+
+TEST_F(LoggingBinaryTest, TypedLogExtra) {
+  LOG_INFO() << "text"
+             << logging::LogExtra{{"string", "value"},
+                                  {"negative", -5},
+                                  {"unsigned", 7ULL},
+                                  {"double", 1.5},
+                                  {"with.period", "x"}};
+
+  const auto records = LoggedRecords();
+  ASSERT_EQ(records.size(), 1);
+  const auto& record = records[0];
+
+  EXPECT_EQ(GetField<std::string_view>(record, "string"), "value");
+  EXPECT_EQ(GetField<std::int64_t>(record, "negative"), -5);
+  EXPECT_EQ(GetField<std::uint64_t>(record, "unsigned"), 7);
+  EXPECT_EQ(GetField<double>(record, "double"), 1.5);
+  EXPECT_EQ(GetField<std::string_view>(record, "with.period"), "x");
+}
+
+TEST_F(LoggingBinaryTest, Tskv) {
+  LOG_ERROR() << "text\twith=special\nchars"
+              << logging::LogExtra{{"negative", -5},
+                                   {"double", 1.5},
+                                   {"with.period", "a\tb"}};
+
+  const auto records = LoggedRecords();
+  ASSERT_EQ(records.size(), 1);
+  const auto tskv = ToTskv(records[0]);
+
+  EXPECT_EQ(tskv.rfind("tskv\ttimestamp=", 0), 0) << tskv;
+  EXPECT_NE(tskv.find("\tlevel=ERROR\tmodule="), std::string::npos) << tskv;
+  EXPECT_NE(tskv.find("\ttask_id="), std::string::npos) << tskv;
+  EXPECT_NE(tskv.find("\tthread_id=0x"), std::string::npos) << tskv;
+  EXPECT_NE(tskv.find("\ttext=text\\twith=special\\nchars\t"),
+            std::string::npos)
+      << tskv;
+  EXPECT_NE(tskv.find("\tnegative=-5"), std::string::npos) << tskv;
+  EXPECT_NE(tskv.find("\tdouble=1.5"), std::string::npos) << tskv;
+  EXPECT_NE(tskv.find("\twith_period=a\\tb"), std::string::npos) << tskv;
+  EXPECT_EQ(tskv.find('\n'), std::string::npos) << tskv;
+}
+
+TEST_F(LoggingBinaryTest, Json) {
+  LOG_INFO() << "text \"quoted\"" << logging::LogExtra{{"negative", -5}};
+
+  const auto records = LoggedRecords();
+  ASSERT_EQ(records.size(), 1);
+
+  std::string json;
+  logging::binary::FormatAsJson(records[0], json);
+  EXPECT_NE(json.find(R"("level":"INFO")"), std::string::npos) << json;
+  EXPECT_NE(json.find(R"("text":"text \"quoted\"")"), std::string::npos)
+      << json;
+  EXPECT_NE(json.find(R"("negative":-5)"), std::string::npos) << json;
+}
+
+TEST_F(LoggingBinaryTest, RawText) {
+  // e.g. access logs are written without LogHelper
+  logging::impl::LogRaw(*logging::DefaultLogger(), logging::Level::kInfo,
+                        "raw\ttext");
+
+  const auto records = LoggedRecords();
+  ASSERT_EQ(records.size(), 1);
+  ASSERT_EQ(records[0].fields.size(), 1);
+  EXPECT_EQ(records[0].fields[0].key, "text");
+  EXPECT_EQ(GetField<std::string_view>(records[0], "text"), "raw\ttext");
+}
+
+TEST_F(LoggingBinaryTest, Truncated) {
+  LOG_INFO() << "text";
+  LoggedRecords();
+
+  logging::binary::Record record;
+  for (std::size_t size = 0; size < data.size(); ++size) {
+    std::string_view truncated{data.data(), size};
+    EXPECT_FALSE(logging::binary::ReadRecord(truncated, record));
+    EXPECT_EQ(truncated.size(), size);
+  }
+
+  auto corrupted = data;
+  corrupted[4] = 42;  // version
+  std::string_view corrupted_view = corrupted;
+  EXPECT_THROW(logging::binary::ReadRecord(corrupted_view, record),
+               logging::binary::ParseError);
+}
+
+USERVER_NAMESPACE_END
@@ -88,6 +88,19 @@ class ThreadLocalMemPool {
 
 constexpr bool NeedsQuoteEscaping(char c) { return c == '\"' || c == '\\'; }
 
+template <typename T>
+auto ToBinaryValue(const T& value) {
+  if constexpr (std::is_same_v<T, std::string>) {
+    return std::string_view{value};
+  } else if constexpr (std::is_floating_point_v<T>) {
+    return static_cast<double>(value);
+  } else if constexpr (std::is_signed_v<T>) {
+    return static_cast<std::int64_t>(value);
+  } else {
+    return static_cast<std::uint64_t>(value);
+  }
+}
+
 // For the dynamic debug logging
 Level AdjustLevel(Level level, const spdlog::logger& logger) {
   return std::max(level, static_cast<Level>(logger.level()));
@@ -175,6 +188,17 @@ void LogHelper::AppendLogExtra() {
   const auto& items = pimpl_->GetLogExtra().extra_;
   if (items->empty()) return;
 
+  if (pimpl_->IsBinary()) {
+    for (const auto& item : *items) {
+      std::visit(
+          [this, &item](const auto& value) {
+            pimpl_->PutBinaryField(item.first, ToBinaryValue(value));
+          },
+          item.second.GetValue());
+    }
+    return;
+  }
+
   for (const auto& item : *items) {
     Put(utils::encoding::kTskvPairsSeparator);
     {
@@ -188,6 +212,11 @@ void LogHelper::AppendLogExtra() {
 }
 
 void LogHelper::LogTextKey() {
+  if (pimpl_->IsBinary()) {
+    pimpl_->StartBinaryField("text");
+    return;
+  }
+
   Put(utils::encoding::kTskvPairsSeparator);
   Put("text");
   pimpl_->PutKeyValueSeparator();
@@ -195,8 +224,12 @@ void LogHelper::LogTextKey() {
 
 void LogHelper::LogModule(std::string_view path, int line,
                           std::string_view func) {
-  Put("module");
-  pimpl_->PutKeyValueSeparator();
+  if (pimpl_->IsBinary()) {
+    pimpl_->StartBinaryField("module");
+  } else {
+    Put("module");
+    pimpl_->PutKeyValueSeparator();
+  }
   Put(func);
   Put(" ( ");
   Put(path);
@@ -210,6 +243,12 @@ void LogHelper::LogIds() {
   uint64_t task_id = task ? reinterpret_cast<uint64_t>(task) : 0;
   auto* thread_id = reinterpret_cast<void*>(pthread_self());
 
+  if (pimpl_->IsBinary()) {
+    pimpl_->PutBinaryField("task_id", HexShort{task_id});
+    pimpl_->PutBinaryField("thread_id", Hex{thread_id});
+    return;
+  }
+
   Put(utils::encoding::kTskvPairsSeparator);
   Put("task_id");
   pimpl_->PutKeyValueSeparator();
@@ -33,11 +33,17 @@ char GetSeparatorFromLogger(const LoggerPtr& logger_ptr) {
       return '=';
     case Format::kLtsv:
       return ':';
+    case Format::kBinary:
+      return '\0';  // Not used, the keys are written by StartBinaryField
   }
 
   UASSERT(false);
 }
 
+bool IsBinaryLogger(const LoggerPtr& logger_ptr) noexcept {
+  return logger_ptr && logger_ptr->format == Format::kBinary;
+}
+
 }  // namespace
 
 LogHelper::Impl::int_type LogHelper::Impl::BufferStd::overflow(int_type c) {
@@ -56,14 +62,23 @@ LogHelper::Impl::Impl(LoggerPtr logger, Level level) noexcept
     : logger_(std::move(logger)),
       level_(level),
       key_value_separator_(GetSeparatorFromLogger(logger_)),
+      is_binary_(IsBinaryLogger(logger_)),
       encode_mode_{Encode::kNone},
-      initial_length_{0} {
+      initial_length_{0},
+      binary_string_offset_{kNoBinaryString} {
   static_assert(sizeof(LogHelper::Impl) < 4096,
                 "Structures with size more than 4096 would consume at least "
                 "8KB memory in allocator.");
+  if (is_binary_) msg_.push_back(binary::impl::kFieldsMarker);
 }
 
 std::streamsize LogHelper::Impl::xsputn(const char_type* s, std::streamsize n) {
+  if (is_binary_) {
+    // binary strings are length prefixed and need no escaping
+    msg_.append(s, s + n);
+    return n;
+  }
+
   switch (encode_mode_) {
     case Encode::kNone:
       msg_.append(s, s + n);
@@ -88,6 +103,11 @@ std::streamsize LogHelper::Impl::xsputn(const char_type* s, std::streamsize n) {
 LogHelper::Impl::int_type LogHelper::Impl::overflow(int_type c) {
   if (c == std::streambuf::traits_type::eof()) return c;
 
+  if (is_binary_) {
+    msg_.push_back(c);
+    return c;
+  }
+
   switch (encode_mode_) {
     case Encode::kNone:
       msg_.push_back(c);
@@ -116,11 +136,25 @@ LogHelper::Impl::LazyInitedStream& LogHelper::Impl::GetLazyInitedStream() {
   return *lazy_stream_;
 }
 
-void LogHelper::Impl::LogTheMessage() const {
+void LogHelper::Impl::StartBinaryField(std::string_view key) {
+  UASSERT(is_binary_);
+  FinishBinaryField();
+  binary_string_offset_ = binary::impl::StartStringField(msg_, key);
+}
+
+void LogHelper::Impl::FinishBinaryField() {
+  if (binary_string_offset_ == kNoBinaryString) return;
+  binary::impl::FinishString(msg_, binary_string_offset_);
+  binary_string_offset_ = kNoBinaryString;
+}
+
+void LogHelper::Impl::LogTheMessage() {
   if (IsBroken()) {
     return;
   }
 
+  FinishBinaryField();
+
   UASSERT(logger_);
   std::string_view message(msg_.data(), msg_.size());
   logger_->ptr->log(static_cast<spdlog::level::level_enum>(level_), message);
@@ -1,10 +1,12 @@
 #pragma once
 
+#include <limits>
 #include <optional>
 #include <ostream>
 
 #include <fmt/format.h>
 
+#include <logging/binary_encoder.hpp>
 #include <userver/logging/level.hpp>
 #include <userver/logging/log.hpp>
 #include <userver/logging/log_extra.hpp>
@@ -39,7 +41,20 @@ class LogHelper::Impl final {
 
   void PutKeyValueSeparator() { xsputn(&key_value_separator_, 1); }
 
-  void LogTheMessage() const;
+  /// The logger writes logging::binary records, the fields are written by
+  /// StartBinaryField and PutBinaryField instead of the separators
+  bool IsBinary() const noexcept { return is_binary_; }
+
+  /// Starts a string field, its value is the data written up to the next field
+  void StartBinaryField(std::string_view key);
+
+  template <typename T>
+  void PutBinaryField(std::string_view key, T value) {
+    FinishBinaryField();
+    binary::impl::AppendField(msg_, key, value);
+  }
+
+  void LogTheMessage();
 
   void MarkTextBegin();
   size_t TextSize() const { return msg_.size() - initial_length_; }
@@ -69,16 +84,22 @@ class LogHelper::Impl final {
 
   LazyInitedStream& GetLazyInitedStream();
 
+  void FinishBinaryField();
+
   static constexpr size_t kOptimalBufferSize = 1500;
+  static constexpr size_t kNoBinaryString =
+      std::numeric_limits<size_t>::max();
 
   LoggerPtr logger_;
   const Level level_;
   const char key_value_separator_;
+  const bool is_binary_;
   Encode encode_mode_;
   fmt::basic_memory_buffer<char, kOptimalBufferSize> msg_;
   std::optional<LazyInitedStream> lazy_stream_;
   LogExtra extra_;
   size_t initial_length_;
+  size_t binary_string_offset_;
 };
 
 }  // namespace logging
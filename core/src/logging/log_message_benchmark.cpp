@@ -1,6 +1,18 @@
 #include <benchmark/benchmark.h>
 
+// this header must be included before any spdlog headers
+// to override spdlog's level names
+#include <logging/spdlog.hpp>
+
+#include <spdlog/details/null_mutex.h>
+#include <spdlog/pattern_formatter.h>
+#include <spdlog/sinks/base_sink.h>
+
+#include <logging/binary_formatter.hpp>
+#include <logging/config.hpp>
+#include <logging/logger_with_info.hpp>
 #include <userver/logging/log.hpp>
+#include <userver/logging/log_extra.hpp>
 #include <userver/logging/logger.hpp>
 
 #include <ostream>
@@ -98,4 +110,93 @@ BENCHMARK_REGISTER_F(LogHelperBenchmark, LogStruct)
     ->Range(8, 8 << 10)
     ->Complexity();
 
+namespace {
+
+// Formats the messages like a file sink does, but does not write them
+class FormattingNullSink final
+    : public spdlog::sinks::base_sink<spdlog::details::null_mutex> {
+ protected:
+  void sink_it_(const spdlog::details::log_msg& msg) override {
+    spdlog::memory_buf_t formatted;
+    formatter_->format(msg, formatted);
+    benchmark::DoNotOptimize(formatted.data());
+  }
+
+  void flush_() override {}
+};
+
+logging::LoggerPtr MakeFormattingNullLogger(logging::Format format) {
+  auto logger = std::make_shared<logging::impl::LoggerWithInfo>(
+      format, std::shared_ptr<spdlog::details::thread_pool>{},
+      utils::MakeSharedRef<spdlog::logger>(
+          "formatting_null_logger", std::make_shared<FormattingNullSink>()));
+
+  switch (format) {
+    case logging::Format::kTskv:
+      logger->ptr->set_pattern(logging::LoggerConfig::kDefaultTskvPattern);
+      break;
+    case logging::Format::kLtsv:
+      logger->ptr->set_pattern(logging::LoggerConfig::kDefaultLtsvPattern);
+      break;
+    case logging::Format::kBinary:
+      logger->ptr->set_formatter(
+          std::make_unique<logging::impl::BinaryFormatter>());
+      break;
+  }
+  return logger;
+}
+
+void FormatArgs(benchmark::internal::Benchmark* b) {
+  for (const auto format : {logging::Format::kTskv, logging::Format::kLtsv,
+                            logging::Format::kBinary}) {
+    for (const auto size : {8, 512, 8 << 10}) {
+      b->Args({static_cast<int>(format), size});
+    }
+  }
+}
+
+}  // namespace
+
+// Compares the whole formatting of the message, including the spdlog
+// formatter, for the first argument being logging::Format
+class LogFormatBenchmark : public benchmark::Fixture {
+  void SetUp(const benchmark::State& state) override {
+    old_ = logging::SetDefaultLogger(MakeFormattingNullLogger(
+        static_cast<logging::Format>(state.range(0))));
+  }
+
+  void TearDown(const benchmark::State&) override {
+    if (old_) logging::SetDefaultLogger(std::exchange(old_, nullptr));
+  }
+
+  logging::LoggerPtr old_;
+};
+
+BENCHMARK_DEFINE_F(LogFormatBenchmark, LogString)(benchmark::State& state) {
+  // tabs and newlines have to be escaped in text formats
+  std::string msg(state.range(1), '*');
+  for (std::size_t i = 0; i < msg.size(); i += 32) msg[i] = '\t';
+
+  for (auto _ : state) {
+    LOG_INFO() << msg;
+  }
+}
+BENCHMARK_REGISTER_F(LogFormatBenchmark, LogString)->Apply(FormatArgs);
+
+BENCHMARK_DEFINE_F(LogFormatBenchmark, LogExtra)(benchmark::State& state) {
+  const std::string msg(state.range(1), '*');
+  const logging::LogExtra extra{
+      {"trace_id", "0123456789abcdef0123456789abcdef"},
+      {"span_id", "0123456789abcdef"},
+      {"total_time", 12.345},
+      {"attempts", 3},
+      {"meta_code", 200},
+  };
+
+  for (auto _ : state) {
+    LOG_INFO() << msg << extra;
+  }
+}
+BENCHMARK_REGISTER_F(LogFormatBenchmark, LogExtra)->Apply(FormatArgs);
+
 USERVER_NAMESPACE_END
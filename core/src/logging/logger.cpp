@@ -6,6 +6,7 @@
 // to override spdlog's level names
 #include <logging/spdlog.hpp>
 
+#include <logging/binary_formatter.hpp>
 #include <logging/logger_with_info.hpp>
 #include <logging/reopening_file_sink.hpp>
 
@@ -29,17 +30,21 @@ LoggerPtr MakeSimpleLogger(const std::string& name, spdlog::sink_ptr sink,
       format, std::shared_ptr<spdlog::details::thread_pool>{},
       std::move(spdlog_logger));
 
-  std::string pattern;
+  std::unique_ptr<spdlog::formatter> formatter;
   switch (format) {
     case Format::kTskv:
-      pattern = LoggerConfig::kDefaultTskvPattern;
+      formatter = std::make_unique<spdlog::pattern_formatter>(
+          LoggerConfig::kDefaultTskvPattern);
       break;
     case Format::kLtsv:
-      pattern = LoggerConfig::kDefaultLtsvPattern;
+      formatter = std::make_unique<spdlog::pattern_formatter>(
+          LoggerConfig::kDefaultLtsvPattern);
+      break;
+    case Format::kBinary:
+      formatter = std::make_unique<impl::BinaryFormatter>();
       break;
   }
-  logger->ptr->set_formatter(
-      std::make_unique<spdlog::pattern_formatter>(std::move(pattern)));
+  logger->ptr->set_formatter(std::move(formatter));
 
   logger->ptr->set_level(level);
   logger->ptr->flush_on(level);
@@ -75,7 +80,9 @@ LoggerPtr MakeStdoutLogger(const std::string& name, Format format,
 LoggerPtr MakeFileLogger(const std::string& name, const std::string& path,
                          Format format, Level level) {
   return MakeSimpleLogger(
-      name, std::make_shared<logging::ReopeningFileSinkMT>(path),
+      name,
+      std::make_shared<logging::ReopeningFileSinkMT>(
+          path, format != Format::kBinary),
       static_cast<spdlog::level::level_enum>(level), format);
 }
 
@@ -2,12 +2,14 @@
 
 #include <logging/spdlog.hpp>
 
+#include <logging/binary_formatter.hpp>
 #include <logging/config.hpp>
 #include <logging/logger_with_info.hpp>
 
 #include <spdlog/pattern_formatter.h>
 #include <spdlog/sinks/ostream_sink.h>
 
+#include <userver/logging/binary_format.hpp>
 #include <userver/logging/log.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -123,4 +125,50 @@ class LoggingLtsvTest : public ::testing::Test {
   logging::LoggerPtr old_;
 };
 
+class LoggingBinaryTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    sstream.str(std::string());
+    old_ = logging::SetDefaultLogger(MakeBinaryStreamLogger(sstream));
+  }
+
+  void TearDown() override {
+    if (old_) {
+      logging::SetDefaultLogger(old_);
+      old_.reset();
+    }
+  }
+
+  logging::LoggerPtr MakeBinaryStreamLogger(std::ostream& stream) const {
+    std::ostringstream os;
+    os << this;
+    auto logger =
+        MakeNamedStreamLogger(os.str(), stream, logging::Format::kBinary);
+    logger->ptr->set_formatter(
+        std::make_unique<logging::impl::BinaryFormatter>());
+    return logger;
+  }
+
+  /// The records refer to `data`
+  std::vector<logging::binary::Record> LoggedRecords() {
+    logging::LogFlush();
+    data = sstream.str();
+
+    std::vector<logging::binary::Record> records;
+    std::string_view rest = data;
+    logging::binary::Record record;
+    while (logging::binary::ReadRecord(rest, record)) {
+      records.push_back(std::move(record));
+    }
+    EXPECT_TRUE(rest.empty());
+    return records;
+  }
+
+  std::ostringstream sstream;
+  std::string data;
+
+ private:
+  logging::LoggerPtr old_;
+};
+
 USERVER_NAMESPACE_END
@@ -0,0 +1,359 @@
+#include <logging/per_thread_buffer_sink.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <cstring>
+#include <string_view>
+#include <utility>
+
+#include <spdlog/pattern_formatter.h>
+
+#include <userver/utils/assert.hpp>
+#include <userver/utils/thread_name.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace logging::impl {
+
+namespace {
+
+// Latency of the messages that do not fill half of a ring
+constexpr std::chrono::milliseconds kDrainInterval{5};
+
+constexpr std::size_t kCacheLineSize = 64;
+
+#ifdef IOV_MAX
+constexpr std::size_t kMaxIovecs = IOV_MAX;
+#else
+constexpr std::size_t kMaxIovecs = 1024;
+#endif
+
+std::atomic<std::uint64_t> next_sink_id{0};
+
+// Returns false on errors, the rest of the data is not written
+bool WriteAll(int fd, iovec* iovecs, std::size_t count) {
+  while (count != 0) {
+    const auto written = ::writev(fd, iovecs, std::min(count, kMaxIovecs));
+    if (written < 0) {
+      if (errno == EINTR) continue;
+      return false;
+    }
+
+    auto left = static_cast<std::size_t>(written);
+    while (count != 0 && left >= iovecs->iov_len) {
+      left -= iovecs->iov_len;
+      ++iovecs;
+      --count;
+    }
+    if (left != 0) {
+      iovecs->iov_base = static_cast<char*>(iovecs->iov_base) + left;
+      iovecs->iov_len -= left;
+    }
+  }
+  return true;
+}
+
+fs::blocking::FileDescriptor OpenFile(const std::string& path, bool truncate) {
+  using fs::blocking::OpenFlag;
+  fs::blocking::OpenMode flags{OpenFlag::kWrite, OpenFlag::kCreateIfNotExists,
+                               OpenFlag::kAppend};
+  if (truncate) flags |= OpenFlag::kTruncate;
+
+  return fs::blocking::FileDescriptor::Open(
+      path, flags,
+      boost::filesystem::perms::owner_read |
+          boost::filesystem::perms::owner_write |
+          boost::filesystem::perms::group_read |
+          boost::filesystem::perms::others_read);
+}
+
+}  // namespace
+
+// Ring of bytes with a single producer (the owning thread) and a single
+// consumer (the draining thread under drain_mutex_). The positions grow
+// monotonically and never wrap.
+class alignas(kCacheLineSize) PerThreadBufferSink::ThreadBuffer final {
+ public:
+  explicit ThreadBuffer(std::size_t capacity)
+      : capacity_(capacity), data_(std::make_unique<char[]>(capacity)) {
+    UASSERT_MSG(capacity_ != 0 && (capacity_ & (capacity_ - 1)) == 0,
+                "capacity must be a power of 2");
+  }
+
+  // Producer side. Either puts the whole record or nothing.
+  bool TryPush(std::string_view record) noexcept {
+    const auto head = head_.load(std::memory_order_relaxed);
+    if (head + record.size() - cached_tail_ > capacity_) {
+      cached_tail_ = tail_.load(std::memory_order_acquire);
+      if (head + record.size() - cached_tail_ > capacity_) return false;
+    }
+
+    const auto offset = head & (capacity_ - 1);
+    const auto first_part = std::min(record.size(), capacity_ - offset);
+    std::memcpy(data_.get() + offset, record.data(), first_part);
+    std::memcpy(data_.get(), record.data() + first_part,
+                record.size() - first_part);
+
+    head_.store(head + record.size(), std::memory_order_release);
+    return true;
+  }
+
+  // Producer side
+  bool IsHalfFull() noexcept {
+    const auto head = head_.load(std::memory_order_relaxed);
+    if (head - cached_tail_ <= capacity_ / 2) return false;
+
+    cached_tail_ = tail_.load(std::memory_order_acquire);
+    return head - cached_tail_ > capacity_ / 2;
+  }
+
+  // Consumer side. Appends the committed bytes to `iovecs` and returns the
+  // position to pass to Consume() after the write.
+  std::uint64_t Peek(std::vector<iovec>& iovecs) const {
+    const auto tail = tail_.load(std::memory_order_relaxed);
+    const auto head = head_.load(std::memory_order_acquire);
+    if (head == tail) return head;
+
+    const auto offset = tail & (capacity_ - 1);
+    const auto size = head - tail;
+    const auto first_part = std::min<std::uint64_t>(size, capacity_ - offset);
+    iovecs.push_back({data_.get() + offset, first_part});
+    if (size != first_part) {
+      iovecs.push_back({data_.get(), size - first_part});
+    }
+    return head;
+  }
+
+  // Consumer side
+  void Consume(std::uint64_t position) noexcept {
+    tail_.store(position, std::memory_order_release);
+  }
+
+  std::uint64_t SizeApprox() const noexcept {
+    const auto tail = tail_.load(std::memory_order_acquire);
+    return head_.load(std::memory_order_acquire) - tail;
+  }
+
+  // Producer side, called on exit of the owning thread
+  void Retire() noexcept { retired_.store(true, std::memory_order_release); }
+
+  // Consumer side. Everything pushed is visible after it returns true.
+  bool IsRetired() const noexcept {
+    return retired_.load(std::memory_order_acquire);
+  }
+
+  // Owned by the producer
+  std::unique_ptr<spdlog::formatter> formatter;
+  std::uint64_t formatter_version{0};
+  spdlog::memory_buf_t formatted;
+
+ private:
+  const std::size_t capacity_;
+  const std::unique_ptr<char[]> data_;
+
+  alignas(kCacheLineSize) std::atomic<std::uint64_t> head_{0};
+  std::uint64_t cached_tail_{0};
+
+  alignas(kCacheLineSize) std::atomic<std::uint64_t> tail_{0};
+  std::atomic<bool> retired_{false};
+};
+
+PerThreadBufferSink::PerThreadBufferSink(Settings settings)
+    : settings_(std::move(settings)),
+      id_(next_sink_id.fetch_add(1, std::memory_order_relaxed)),
+      formatter_(std::make_unique<spdlog::pattern_formatter>()),
+      file_(OpenFile(settings_.file_path, false)) {
+  UINVARIANT(settings_.buffer_size != 0 &&
+                 (settings_.buffer_size & (settings_.buffer_size - 1)) == 0,
+             "per-thread log buffer size must be a power of 2");
+
+  if (settings_.separate_with_newline && file_.GetSize() > 0) {
+    file_.Write("\n");
+  }
+
+  flusher_ = std::thread([this] { RunFlusher(); });
+}
+
+PerThreadBufferSink::~PerThreadBufferSink() {
+  {
+    std::lock_guard lock(wake_mutex_);
+    stop_ = true;
+  }
+  wake_cv_.notify_one();
+  flusher_.join();
+}
+
+void PerThreadBufferSink::log(const spdlog::details::log_msg& msg) {
+  auto& buffer = GetThreadBuffer();
+
+  if (buffer.formatter_version !=
+      formatter_version_.load(std::memory_order_acquire)) {
+    std::lock_guard lock(formatter_mutex_);
+    buffer.formatter = formatter_->clone();
+    buffer.formatter_version =
+        formatter_version_.load(std::memory_order_relaxed);
+  }
+
+  buffer.formatted.clear();
+  buffer.formatter->format(msg, buffer.formatted);
+  const std::string_view record{buffer.formatted.data(),
+                                buffer.formatted.size()};
+
+  if (record.size() > settings_.buffer_size) {
+    dropped_.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+
+  while (!buffer.TryPush(record)) {
+    WakeUpFlusher();
+    if (!settings_.block_on_overflow) {
+      dropped_.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+    std::this_thread::yield();
+  }
+
+  if (buffer.IsHalfFull()) WakeUpFlusher();
+}
+
+void PerThreadBufferSink::flush() { WakeUpFlusher(); }
+
+void PerThreadBufferSink::set_pattern(const std::string& pattern) {
+  set_formatter(std::make_unique<spdlog::pattern_formatter>(pattern));
+}
+
+void PerThreadBufferSink::set_formatter(
+    std::unique_ptr<spdlog::formatter> formatter) {
+  std::lock_guard lock(formatter_mutex_);
+  formatter_ = std::move(formatter);
+  formatter_version_.fetch_add(1, std::memory_order_release);
+}
+
+void PerThreadBufferSink::Reopen(bool truncate) {
+  std::lock_guard lock(drain_mutex_);
+  DrainLocked();
+  file_ = OpenFile(settings_.file_path, truncate);
+}
+
+void PerThreadBufferSink::Drain() {
+  std::lock_guard lock(drain_mutex_);
+  DrainLocked();
+}
+
+PerThreadBufferSink::Statistics PerThreadBufferSink::GetStatistics() const {
+  Statistics result;
+  {
+    std::lock_guard lock(buffers_mutex_);
+    for (const auto& buffer : buffers_) {
+      result.queue_size += buffer->SizeApprox();
+    }
+    result.buffers = buffers_.size();
+  }
+  result.dropped = dropped_.load(std::memory_order_relaxed);
+  result.write_errors = write_errors_.load(std::memory_order_relaxed);
+  result.flush_timings = flush_timings_.GetStatsForPeriod();
+  return result;
+}
+
+PerThreadBufferSink::ThreadBuffer& PerThreadBufferSink::GetThreadBuffer() {
+  // Shares the rings of the current thread with the sinks and retires them on
+  // thread exit, so that the draining thread writes out the rest and frees
+  // them. Sink ids are never reused.
+  struct ThreadBuffers final {
+    ~ThreadBuffers() {
+      for (const auto& [id, buffer] : buffers) buffer->Retire();
+    }
+
+    std::vector<std::pair<std::uint64_t, std::shared_ptr<ThreadBuffer>>>
+        buffers;
+  };
+  thread_local ThreadBuffers cache;
+  auto& buffers = cache.buffers;
+
+  for (const auto& [id, buffer] : buffers) {
+    if (id == id_) return *buffer;
+  }
+  // Only the thread holds the rings of the destroyed sinks
+  buffers.erase(std::remove_if(buffers.begin(), buffers.end(),
+                               [](const auto& item) {
+                                 return item.second.use_count() == 1;
+                               }),
+                buffers.end());
+
+  auto buffer = std::make_shared<ThreadBuffer>(settings_.buffer_size);
+  {
+    std::lock_guard lock(buffers_mutex_);
+    buffers_.push_back(buffer);
+  }
+  return *buffers.emplace_back(id_, std::move(buffer)).second;
+}
+
+void PerThreadBufferSink::WakeUpFlusher() {
+  if (wake_requested_.load(std::memory_order_relaxed) ||
+      wake_requested_.exchange(true, std::memory_order_acq_rel)) {
+    return;
+  }
+
+  // the flusher may be between the predicate check and the wait
+  { std::lock_guard lock(wake_mutex_); }
+  wake_cv_.notify_one();
+}
+
+void PerThreadBufferSink::RunFlusher() {
+  utils::SetCurrentThreadName(settings_.thread_name);
+
+  std::unique_lock lock(wake_mutex_);
+  while (!stop_) {
+    wake_cv_.wait_for(lock, kDrainInterval, [this] {
+      return stop_ || wake_requested_.load(std::memory_order_acquire);
+    });
+    wake_requested_.store(false, std::memory_order_release);
+
+    lock.unlock();
+    Drain();
+    lock.lock();
+  }
+  lock.unlock();
+
+  Drain();
+}
+
+void PerThreadBufferSink::DrainLocked() {
+  iovecs_.clear();
+  drained_.clear();
+  {
+    std::lock_guard lock(buffers_mutex_);
+    for (const auto& buffer : buffers_) {
+      drained_.emplace_back(buffer.get(), buffer->Peek(iovecs_));
+    }
+  }
+  if (!iovecs_.empty()) {
+    const auto start = std::chrono::steady_clock::now();
+    if (!WriteAll(file_.GetNative(), iovecs_.data(), iovecs_.size())) {
+      write_errors_.fetch_add(1, std::memory_order_relaxed);
+    }
+    flush_timings_.GetCurrentCounter().Account(
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start)
+            .count());
+
+    for (const auto& [buffer, position] : drained_) {
+      buffer->Consume(position);
+    }
+  }
+
+  // The rings of the exited threads are freed once they are written out
+  std::lock_guard lock(buffers_mutex_);
+  buffers_.erase(std::remove_if(buffers_.begin(), buffers_.end(),
+                                [](const auto& buffer) {
+                                  return buffer->IsRetired() &&
+                                         buffer->SizeApprox() == 0;
+                                }),
+                 buffers_.end());
+}
+
+}  // namespace logging::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/uio.h>
+
+// this header must be included before any spdlog headers
+// to override spdlog's level names
+#include <logging/spdlog.hpp>
+
+#include <spdlog/sinks/sink.h>
+
+#include <userver/fs/blocking/file_descriptor.hpp>
+#include <userver/utils/statistics/hdr_histogram.hpp>
+#include <userver/utils/statistics/recentperiod.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace logging::impl {
+
+/// @brief File sink that keeps the formatted messages in per-thread rings
+///
+/// Each logging thread formats its messages with its own copy of the
+/// formatter and puts them into its own single-producer single-consumer ring,
+/// so the logging threads do not contend with each other. A dedicated thread
+/// drains all the rings with one writev() per batch.
+///
+/// Messages of a thread keep their order, messages of different threads may
+/// be reordered within a batch. A coroutine task may migrate to another
+/// thread between its messages, so the messages of a task may be reordered
+/// too.
+///
+/// The ring of a thread is freed after the thread exits and the rest of its
+/// messages are written out.
+class PerThreadBufferSink final : public spdlog::sinks::sink {
+ public:
+  struct Settings {
+    std::string file_path;
+    /// Name of the draining thread
+    std::string thread_name;
+    /// Size of the ring of each logging thread in bytes, a power of 2
+    std::size_t buffer_size{};
+    /// Wait for the draining thread if the ring is full instead of dropping
+    /// the message
+    bool block_on_overflow{false};
+    /// Write a newline on opening a non-empty file
+    bool separate_with_newline{true};
+  };
+
+  using FlushTimings =
+      utils::statistics::RecentPeriod<utils::statistics::HdrHistogram<>,
+                                      utils::statistics::HdrHistogram<>>;
+
+  struct Statistics {
+    /// Bytes in the rings waiting to be written
+    std::uint64_t queue_size{0};
+    /// Rings of the threads that have logged, the rings of the exited threads
+    /// are freed after the next write
+    std::uint64_t buffers{0};
+    /// Messages that did not fit into the rings
+    std::uint64_t dropped{0};
+    /// Failed writev() calls, the batch is lost
+    std::uint64_t write_errors{0};
+    /// Time of writing a batch to the file in microseconds for the last minute
+    utils::statistics::HdrHistogram<> flush_timings;
+  };
+
+  explicit PerThreadBufferSink(Settings settings);
+  ~PerThreadBufferSink() override;
+
+  void log(const spdlog::details::log_msg& msg) override;
+
+  /// Wakes up the draining thread, does not wait for the write
+  void flush() override;
+
+  void set_pattern(const std::string& pattern) override;
+  void set_formatter(std::unique_ptr<spdlog::formatter> formatter) override;
+
+  /// Writes out the buffered messages and reopens the file
+  void Reopen(bool truncate);
+
+  /// Synchronously writes out the buffered messages
+  void Drain();
+
+  Statistics GetStatistics() const;
+
+ private:
+  class ThreadBuffer;
+
+  ThreadBuffer& GetThreadBuffer();
+  void WakeUpFlusher();
+  void RunFlusher();
+  void DrainLocked();
+
+  const Settings settings_;
+  const std::uint64_t id_;
+
+  mutable std::mutex formatter_mutex_;
+  std::unique_ptr<spdlog::formatter> formatter_;
+  std::atomic<std::uint64_t> formatter_version_{1};
+
+  mutable std::mutex buffers_mutex_;
+  std::vector<std::shared_ptr<ThreadBuffer>> buffers_;
+
+  std::mutex drain_mutex_;
+  fs::blocking::FileDescriptor file_;
+  std::vector<iovec> iovecs_;
+  std::vector<std::pair<ThreadBuffer*, std::uint64_t>> drained_;
+  FlushTimings flush_timings_;
+
+  std::atomic<std::uint64_t> dropped_{0};
+  std::atomic<std::uint64_t> write_errors_{0};
+
+  std::mutex wake_mutex_;
+  std::condition_variable wake_cv_;
+  std::atomic<bool> wake_requested_{false};
+  bool stop_{false};
+  std::thread flusher_;
+};
+
+}  // namespace logging::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,56 @@
+#include <logging/per_thread_buffer_sink.hpp>
+
+#include <memory>
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#include <spdlog/async.h>
+
+#include <logging/config.hpp>
+#include <logging/reopening_file_sink.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr auto kLogFile = "/dev/null";
+
+std::shared_ptr<spdlog::logger> MakeQueueLogger() {
+  static const auto thread_pool =
+      std::make_shared<spdlog::details::thread_pool>(
+          logging::LoggerConfig::kDefaultMessageQueueSize, 1);
+  auto logger = std::make_shared<spdlog::async_logger>(
+      "queue", std::make_shared<logging::ReopeningFileSinkMT>(kLogFile),
+      thread_pool, spdlog::async_overflow_policy::block);
+  logger->set_pattern(logging::LoggerConfig::kDefaultTskvPattern);
+  return logger;
+}
+
+std::shared_ptr<spdlog::logger> MakePerThreadBufferLogger() {
+  auto logger = std::make_shared<spdlog::logger>(
+      "per_thread_buffer",
+      std::make_shared<logging::impl::PerThreadBufferSink>(
+          logging::impl::PerThreadBufferSink::Settings{
+              kLogFile, "log/benchmark", 1 << 16, true, true}));
+  logger->set_pattern(logging::LoggerConfig::kDefaultTskvPattern);
+  return logger;
+}
+
+template <auto MakeLogger>
+void log_message(benchmark::State& state) {
+  static const auto logger = MakeLogger();
+  const std::string msg(100, '*');
+  for (auto _ : state) {
+    logger->info(msg);
+  }
+}
+
+}  // namespace
+
+// All the threads write into the same logger
+BENCHMARK_TEMPLATE(log_message, &MakeQueueLogger)->ThreadRange(1, 32);
+BENCHMARK_TEMPLATE(log_message, &MakePerThreadBufferLogger)
+    ->ThreadRange(1, 32);
+
+USERVER_NAMESPACE_END
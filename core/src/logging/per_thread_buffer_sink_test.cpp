@@ -0,0 +1,144 @@
+#include <logging/per_thread_buffer_sink.hpp>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <boost/algorithm/string/split.hpp>
+
+#include <userver/fs/blocking/read.hpp>
+#include <userver/fs/blocking/temp_file.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+std::shared_ptr<spdlog::logger> MakeLogger(
+    std::shared_ptr<logging::impl::PerThreadBufferSink> sink) {
+  auto logger = std::make_shared<spdlog::logger>("test", std::move(sink));
+  logger->set_pattern("%v");
+  return logger;
+}
+
+std::vector<std::string> ReadLines(const std::string& path) {
+  const auto contents = fs::blocking::ReadFileContents(path);
+  std::vector<std::string> lines;
+  boost::algorithm::split(lines, contents, [](char c) { return c == '\n'; });
+  if (!lines.empty() && lines.back().empty()) lines.pop_back();
+  return lines;
+}
+
+}  // namespace
+
+TEST(PerThreadBufferSink, Basic) {
+  const auto file = fs::blocking::TempFile::Create();
+  auto sink = std::make_shared<logging::impl::PerThreadBufferSink>(
+      logging::impl::PerThreadBufferSink::Settings{file.GetPath(), "test-log",
+                                                   1024, true, true});
+  auto logger = MakeLogger(sink);
+
+  logger->info("first");
+  logger->info("second");
+  sink->Drain();
+  EXPECT_EQ(ReadLines(file.GetPath()),
+            (std::vector<std::string>{"first", "second"}));
+
+  const auto stats = sink->GetStatistics();
+  EXPECT_EQ(stats.queue_size, 0);
+  EXPECT_EQ(stats.dropped, 0);
+  EXPECT_EQ(stats.write_errors, 0);
+}
+
+TEST(PerThreadBufferSink, ManyThreads) {
+  constexpr int kThreads = 8;
+  constexpr int kMessages = 10000;
+
+  const auto file = fs::blocking::TempFile::Create();
+  auto sink = std::make_shared<logging::impl::PerThreadBufferSink>(
+      logging::impl::PerThreadBufferSink::Settings{file.GetPath(), "test-log",
+                                                   256, true, true});
+  auto logger = MakeLogger(sink);
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < kThreads; ++i) {
+    threads.emplace_back([&logger, i] {
+      for (int j = 0; j < kMessages; ++j) logger->info("{} {}", i, j);
+    });
+  }
+  for (auto& thread : threads) thread.join();
+  sink->Drain();
+
+  const auto lines = ReadLines(file.GetPath());
+  ASSERT_EQ(lines.size(), kThreads * kMessages);
+
+  // messages of a thread keep their order
+  std::vector<int> next(kThreads, 0);
+  for (const auto& line : lines) {
+    const auto space = line.find(' ');
+    ASSERT_NE(space, std::string::npos) << line;
+    const auto thread = std::stoi(line.substr(0, space));
+    ASSERT_EQ(std::stoi(line.substr(space + 1)), next.at(thread)) << line;
+    ++next[thread];
+  }
+  EXPECT_EQ(sink->GetStatistics().dropped, 0);
+}
+
+TEST(PerThreadBufferSink, ExitedThreads) {
+  constexpr int kThreads = 4;
+
+  const auto file = fs::blocking::TempFile::Create();
+  auto sink = std::make_shared<logging::impl::PerThreadBufferSink>(
+      logging::impl::PerThreadBufferSink::Settings{file.GetPath(), "test-log",
+                                                   1024, true, true});
+  auto logger = MakeLogger(sink);
+
+  logger->info("main");
+  for (int i = 0; i < kThreads; ++i) {
+    std::thread([&logger, i] { logger->info("thread {}", i); }).join();
+  }
+
+  // The messages of the exited threads are written out before their rings
+  // are freed
+  sink->Drain();
+  EXPECT_EQ(ReadLines(file.GetPath()).size(), kThreads + 1);
+  EXPECT_EQ(sink->GetStatistics().buffers, 1);
+}
+
+TEST(PerThreadBufferSink, Drops) {
+  constexpr int kMessages = 10000;
+
+  const auto file = fs::blocking::TempFile::Create();
+  auto sink = std::make_shared<logging::impl::PerThreadBufferSink>(
+      logging::impl::PerThreadBufferSink::Settings{file.GetPath(), "test-log",
+                                                   64, false, true});
+  auto logger = MakeLogger(sink);
+
+  logger->info(std::string(100, 'x'));  // does not fit into the buffer
+  for (int i = 0; i < kMessages; ++i) logger->info("message {}", i);
+  sink->Drain();
+
+  const auto dropped = sink->GetStatistics().dropped;
+  EXPECT_GE(dropped, 1);
+  EXPECT_EQ(ReadLines(file.GetPath()).size() + dropped, kMessages + 1);
+}
+
+TEST(PerThreadBufferSink, Reopen) {
+  const auto file = fs::blocking::TempFile::Create();
+  auto sink = std::make_shared<logging::impl::PerThreadBufferSink>(
+      logging::impl::PerThreadBufferSink::Settings{file.GetPath(), "test-log",
+                                                   1024, true, true});
+  auto logger = MakeLogger(sink);
+
+  logger->info("before");
+  sink->Reopen(true);
+  EXPECT_EQ(ReadLines(file.GetPath()), std::vector<std::string>{});
+
+  logger->info("after");
+  sink.reset();
+  logger.reset();
+  EXPECT_EQ(ReadLines(file.GetPath()), std::vector<std::string>{"after"});
+}
+
+USERVER_NAMESPACE_END
@@ -25,10 +25,13 @@ class ReopeningFileSink final : public spdlog::sinks::base_sink<Mutex> {
   using filename_t = spdlog::filename_t;
   using sink = spdlog::sinks::base_sink<Mutex>;
 
-  ReopeningFileSink(filename_t filename) : filename_{std::move(filename)} {
+  // Binary logs must not be separated by a newline, see logging::binary
+  explicit ReopeningFileSink(filename_t filename,
+                             bool separate_with_newline = true)
+      : filename_{std::move(filename)} {
     file_helper_.open(filename_);
 
-    if (file_helper_.size() > 0) {
+    if (separate_with_newline && file_helper_.size() > 0) {
       spdlog::memory_buf_t formatted;
       spdlog::details::fmt_helper::append_string_view("\n", formatted);
 
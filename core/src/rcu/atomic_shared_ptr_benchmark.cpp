@@ -7,6 +7,7 @@
 #include <userver/engine/async.hpp>
 #include <userver/engine/run_standalone.hpp>
 #include <userver/engine/sleep.hpp>
+#include <userver/rcu/rcu.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -85,4 +86,46 @@ BENCHMARK(atomic_shared_ptr_contention)
     ->RangeMultiplier(2)
     ->Ranges({{2, 32}, {false, true}});
 
+// Same load on rcu::Variable to compare with the reclamation backends
+template <typename RcuTraits>
+void rcu_variable_contention(benchmark::State& state) {
+  engine::RunStandalone(state.range(0), [&] {
+    std::atomic<bool> run{true};
+    rcu::Variable<std::unordered_map<int, int>, RcuTraits> var;
+
+    std::vector<engine::TaskWithResult<void>> tasks;
+    for (int i = 0; i < state.range(0) - 2; i++)
+      tasks.push_back(engine::AsyncNoSpan([&]() {
+        while (run) {
+          auto snapshot_ptr = var.Read();
+          benchmark::DoNotOptimize(*snapshot_ptr);
+        }
+      }));
+
+    if (state.range(1))
+      tasks.push_back(engine::AsyncNoSpan([&]() {
+        size_t i = 0;
+        while (run) {
+          auto writer = var.StartWrite();
+          (*writer)[1] = i++;
+          writer.Commit();
+          engine::SleepFor(10ms);
+        }
+      }));
+
+    for (auto _ : state) {
+      auto snapshot_ptr = var.Read();
+      benchmark::DoNotOptimize(*snapshot_ptr);
+    }
+
+    run = false;
+  });
+}
+BENCHMARK_TEMPLATE(rcu_variable_contention, rcu::DefaultRcuTraits)
+    ->RangeMultiplier(2)
+    ->Ranges({{2, 32}, {false, true}});
+BENCHMARK_TEMPLATE(rcu_variable_contention, rcu::HazardEraRcuTraits)
+    ->RangeMultiplier(2)
+    ->Ranges({{2, 32}, {false, true}});
+
 USERVER_NAMESPACE_END
@@ -1,16 +1,56 @@
 #include <userver/rcu/rcu.hpp>
 
+#include <algorithm>
 #include <atomic>
 
 USERVER_NAMESPACE_BEGIN
 
 namespace rcu::impl {
 
+namespace {
+
+std::atomic<EraRecord*> era_records_head{nullptr};
+
+}  // namespace
+
 uint64_t GetNextEpoch() noexcept {
   static std::atomic<uint64_t> counter{1};  // 0 is the default value in data
   return counter++;
 }
 
+// 0 is EraRecord::kFree
+std::atomic<std::uint64_t> global_era{1};
+
+EraRecord& AcquireEraRecordSlow() {
+  for (auto* record = era_records_head.load(); record; record = record->next) {
+    auto era = EraRecord::kFree;
+    if (record->era.load() == EraRecord::kFree &&
+        record->era.compare_exchange_strong(era, EraRecord::kUsed)) {
+      return *record;
+    }
+  }
+
+  // all the records are in use, the new one is never freed and is shared by
+  // all the variables
+  auto* record = new EraRecord();
+  auto* head = era_records_head.load();
+  do {
+    record->next = head;
+  } while (!era_records_head.compare_exchange_weak(head, record));
+  return *record;
+}
+
+void CollectReservedEras(std::vector<std::uint64_t>& eras) {
+  eras.clear();
+  for (auto* record = era_records_head.load(); record; record = record->next) {
+    const auto era = record->era.load();
+    if (era != EraRecord::kFree && era != EraRecord::kUsed) {
+      eras.push_back(era);
+    }
+  }
+  std::sort(eras.begin(), eras.end());
+}
+
 }  // namespace rcu::impl
 
 USERVER_NAMESPACE_END
@@ -13,10 +13,10 @@
 
 USERVER_NAMESPACE_BEGIN
 
-template <int VariableCount>
+template <int VariableCount, typename RcuTraits>
 void rcu_read(benchmark::State& state) {
   engine::RunStandalone([&] {
-    rcu::Variable<std::uint64_t> vars[VariableCount];
+    rcu::Variable<std::uint64_t, RcuTraits> vars[VariableCount];
     {
       std::uint64_t i = 0;
       for (auto& var : vars) {
@@ -33,14 +33,17 @@ void rcu_read(benchmark::State& state) {
     }
   });
 }
-BENCHMARK_TEMPLATE(rcu_read, 1);
-BENCHMARK_TEMPLATE(rcu_read, 2);
-BENCHMARK_TEMPLATE(rcu_read, 4);
-
-template <int VariableCount>
+BENCHMARK_TEMPLATE(rcu_read, 1, rcu::DefaultRcuTraits);
+BENCHMARK_TEMPLATE(rcu_read, 2, rcu::DefaultRcuTraits);
+BENCHMARK_TEMPLATE(rcu_read, 4, rcu::DefaultRcuTraits);
+BENCHMARK_TEMPLATE(rcu_read, 1, rcu::HazardEraRcuTraits);
+BENCHMARK_TEMPLATE(rcu_read, 2, rcu::HazardEraRcuTraits);
+BENCHMARK_TEMPLATE(rcu_read, 4, rcu::HazardEraRcuTraits);
+
+template <int VariableCount, typename RcuTraits>
 void rcu_write(benchmark::State& state) {
   engine::RunStandalone([&] {
-    rcu::Variable<std::uint64_t> vars[VariableCount];
+    rcu::Variable<std::uint64_t, RcuTraits> vars[VariableCount];
 
     std::uint64_t i = 0;
     for (auto _ : state) {
@@ -49,10 +52,14 @@ void rcu_write(benchmark::State& state) {
     }
   });
 }
-BENCHMARK_TEMPLATE(rcu_write, 1);
-BENCHMARK_TEMPLATE(rcu_write, 2);
-BENCHMARK_TEMPLATE(rcu_write, 4);
-
+BENCHMARK_TEMPLATE(rcu_write, 1, rcu::DefaultRcuTraits);
+BENCHMARK_TEMPLATE(rcu_write, 2, rcu::DefaultRcuTraits);
+BENCHMARK_TEMPLATE(rcu_write, 4, rcu::DefaultRcuTraits);
+BENCHMARK_TEMPLATE(rcu_write, 1, rcu::HazardEraRcuTraits);
+BENCHMARK_TEMPLATE(rcu_write, 2, rcu::HazardEraRcuTraits);
+BENCHMARK_TEMPLATE(rcu_write, 4, rcu::HazardEraRcuTraits);
+
+template <typename RcuTraits>
 void rcu_contention(benchmark::State& state) {
   const std::size_t readers_count = state.range(0);
   const std::size_t writers_count = state.range(1);
@@ -63,14 +70,14 @@ void rcu_contention(benchmark::State& state) {
 
   engine::RunStandalone(thread_count, [&] {
     std::atomic<bool> run{true};
-    rcu::Variable<std::uint64_t> var{0};
+    rcu::Variable<std::uint64_t, RcuTraits> var{0};
 
     std::vector<engine::TaskWithResult<void>> tasks;
     tasks.reserve(readers_count - 1 + writers_count);
 
     for (std::size_t j = 0; j < readers_count - 1; j++) {
       tasks.push_back(utils::Async("reader", [&] {
-        std::vector<rcu::ReadablePtr<std::uint64_t>> pointers;
+        std::vector<rcu::ReadablePtr<std::uint64_t, RcuTraits>> pointers;
         pointers.reserve(kept_readable_pointers_count);
 
         while (run) {
@@ -94,7 +101,7 @@ void rcu_contention(benchmark::State& state) {
     }
 
     {
-      std::queue<rcu::ReadablePtr<std::uint64_t>> pointers;
+      std::queue<rcu::ReadablePtr<std::uint64_t, RcuTraits>> pointers;
       for (std::size_t i = 0; i < kept_readable_pointers_count; i++) {
         pointers.push(var.Read());
       }
@@ -112,17 +119,22 @@ void rcu_contention(benchmark::State& state) {
     }
   });
 }
-BENCHMARK(rcu_contention)
+BENCHMARK_TEMPLATE(rcu_contention, rcu::DefaultRcuTraits)
+    ->RangeMultiplier(2)
+    ->Ranges({{1, 16}, {0, 1}, {1, 4}})
+    ->Ranges({{2048, 2048}, {0, 1}, {1, 4}});
+BENCHMARK_TEMPLATE(rcu_contention, rcu::HazardEraRcuTraits)
     ->RangeMultiplier(2)
     ->Ranges({{1, 16}, {0, 1}, {1, 4}})
     ->Ranges({{2048, 2048}, {0, 1}, {1, 4}});
 
+template <typename RcuTraits>
 void rcu_of_shared_ptr(benchmark::State& state) {
   const std::size_t readers_count = state.range(0);
 
   engine::RunStandalone(readers_count, [&] {
     std::atomic<bool> run{true};
-    rcu::Variable<std::shared_ptr<std::uint64_t>> var{
+    rcu::Variable<std::shared_ptr<std::uint64_t>, RcuTraits> var{
         std::make_shared<std::uint64_t>(42)};
 
     std::vector<engine::TaskWithResult<void>> tasks;
@@ -148,6 +160,11 @@ void rcu_of_shared_ptr(benchmark::State& state) {
     }
   });
 }
-BENCHMARK(rcu_of_shared_ptr)->RangeMultiplier(2)->Range(1, 32);
+BENCHMARK_TEMPLATE(rcu_of_shared_ptr, rcu::DefaultRcuTraits)
+    ->RangeMultiplier(2)
+    ->Range(1, 32);
+BENCHMARK_TEMPLATE(rcu_of_shared_ptr, rcu::HazardEraRcuTraits)
+    ->RangeMultiplier(2)
+    ->Range(1, 32);
 
 USERVER_NAMESPACE_END
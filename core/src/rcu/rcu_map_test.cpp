@@ -253,4 +253,22 @@ UTEST(RcuMap, MapOfConst) {
   EXPECT_EQ(value_sum, 30);
 }
 
+UTEST(RcuMap, HazardEras) {
+  rcu::RcuMap<int, int, rcu::HazardEraRcuTraits> map;
+  map.Emplace(1, 10);
+  map.Emplace(2, 20);
+
+  auto it = map.begin();
+  EXPECT_TRUE(map.Erase(1));
+  EXPECT_EQ(1, map.SizeApprox());
+
+  // the iterator keeps the old keyset alive
+  std::size_t count = 0;
+  for (; it != map.end(); ++it) ++count;
+  EXPECT_EQ(2, count);
+
+  map.Clear();
+  EXPECT_EQ(map.begin(), map.end());
+}
+
 USERVER_NAMESPACE_END
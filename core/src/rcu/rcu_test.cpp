@@ -404,14 +404,13 @@ constexpr std::size_t kSleeperTask = 1;
 constexpr std::size_t kTotalTasks =
     kReadablePtrPingPongTasks + kReadingTasks + kWritingTasks + kSleeperTask;
 
-}  // namespace
-
-UTEST_MT(Rcu, TortureTest, kTotalTasks) {
-  rcu::Variable<CleaningUpInt> data{1};
+template <typename RcuTraits>
+void TortureTest() {
+  rcu::Variable<CleaningUpInt, RcuTraits> data{1};
   std::atomic<bool> keep_running{true};
 
   engine::Mutex ping_pong_mutex;
-  rcu::ReadablePtr<CleaningUpInt> ptr = data.Read();
+  rcu::ReadablePtr<CleaningUpInt, RcuTraits> ptr = data.Read();
 
   std::vector<engine::TaskWithResult<void>> tasks;
 
@@ -448,6 +447,16 @@ UTEST_MT(Rcu, TortureTest, kTotalTasks) {
   keep_running = false;
 }
 
+}  // namespace
+
+UTEST_MT(Rcu, TortureTest, kTotalTasks) {
+  TortureTest<rcu::DefaultRcuTraits>();
+}
+
+UTEST_MT(Rcu, TortureTestHazardEras, kTotalTasks) {
+  TortureTest<rcu::HazardEraRcuTraits>();
+}
+
 UTEST(Rcu, WritablePtrUnlocksInCommit) {
   rcu::Variable<int> var{1};
 
@@ -568,4 +577,48 @@ UTEST_MT(Rcu, Core, 3) {
   }
 }
 
+UTEST(Rcu, HazardErasReclamation) {
+  std::atomic<bool> destroyed[4]{false, false, false, false};
+  rcu::Variable<DestructionTracker, rcu::HazardEraRcuTraits> var{
+      rcu::DestructionType::kSync, destroyed[0]};
+
+  {
+    auto reader = var.Read();
+    var.Emplace(destroyed[1]);
+    var.Emplace(destroyed[2]);
+    var.Emplace(destroyed[3]);
+
+    // the values that might have been read at the era of the reader
+    EXPECT_FALSE(destroyed[0]);
+    EXPECT_FALSE(destroyed[1]);
+    // became current after the era of the reader
+    EXPECT_TRUE(destroyed[2]);
+    EXPECT_FALSE(destroyed[3]);
+
+    // a copy reads the current value
+    const auto reader_copy = reader;
+    const auto current = var.Read();
+    EXPECT_EQ(reader_copy.Get(), current.Get());
+  }
+
+  var.Cleanup();
+  EXPECT_TRUE(destroyed[0]);
+  EXPECT_TRUE(destroyed[1]);
+  EXPECT_FALSE(destroyed[3]);
+}
+
+UTEST(Rcu, HazardErasAsyncGc) {
+  auto& mutation_task = engine::current_task::GetCurrentTaskContext();
+
+  rcu::Variable<utils::ScopeGuard, rcu::HazardEraRcuTraits> var(
+      [&] { EXPECT_FALSE(mutation_task.IsCurrent()); });
+
+  {
+    auto read_ptr = var.Read();
+    var.Emplace([&] { EXPECT_FALSE(mutation_task.IsCurrent()); });
+  }
+
+  var.Emplace([&] { EXPECT_TRUE(mutation_task.IsCurrent()); });
+}
+
 USERVER_NAMESPACE_END
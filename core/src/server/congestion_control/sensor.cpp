@@ -33,8 +33,8 @@ Sensor::Data Sensor::FetchCurrent() {
   // TODO: wrong value, it includes ratelimited ones too
   //       it might lead to too high start RPS limits
   auto server_stats = server_.GetServerStats();
-  auto requests = server_stats.active_request_count.load() +
-                  server_stats.requests_processed_count.load();
+  auto requests = server_stats.active_request_count.Load() +
+                  server_stats.requests_processed_count.Load();
   auto rps = (requests - last_requests_) * kSecond / duration_ms;
 
   last_fetch_tp_ = now;
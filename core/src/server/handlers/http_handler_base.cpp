@@ -113,6 +113,9 @@ class RequestProcessor final {
 
       const auto status_code = response.GetStatus();
       span.SetLogLevel(handler_.GetLogLevelForResponseStatus(status_code));
+      // Is also false for a span of a not sampled trace without the tail-based
+      // retention at any log level, so neither the response tags nor the
+      // response body for logging are collected for it
       if (!span.ShouldLogDefault()) {
         return;
       }
@@ -400,6 +403,10 @@ void HttpHandlerBase::HandleRequest(request::RequestBase& request,
     auto span = tracing::Span::MakeSpan(fmt::format("http/{}", HandlerName()),
                                         trace_id, parent_span_id);
 
+    const auto& sampled = http_request.GetHeader(
+        USERVER_NAMESPACE::http::headers::kXYaTraceSampled);
+    if (!sampled.empty()) span.SetSampled(sampled != "0");
+
     response.SetHeader(USERVER_NAMESPACE::http::headers::kXYaTraceId,
                        span.GetTraceId());
     response.SetHeader(USERVER_NAMESPACE::http::headers::kXYaSpanId,
@@ -553,10 +560,10 @@ void HttpHandlerBase::CheckRatelimit(
     throw ExceptionWithCode<HandlerErrorCode::kTooManyRequests>();
   }
 
+  // in-flight counter is sharded, read it only if the limit is set
   auto max_requests_in_flight = GetConfig().max_requests_in_flight;
-  auto requests_in_flight = statistics.GetInFlight();
   if (max_requests_in_flight &&
-      (requests_in_flight > *max_requests_in_flight)) {
+      (statistics.GetInFlight() > *max_requests_in_flight)) {
     tracing::SetThrottleReason(fmt::format("reached max_requests_in_flight={}",
                                            *max_requests_in_flight));
     statistics.IncrementTooManyRequestsInFlight();
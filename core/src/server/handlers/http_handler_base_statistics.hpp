@@ -8,9 +8,10 @@
 #include <server/http/handler_methods.hpp>
 #include <userver/server/handlers/http_handler_base.hpp>
 #include <userver/utils/statistics/aggregated_values.hpp>
+#include <userver/utils/statistics/hdr_histogram.hpp>
 #include <userver/utils/statistics/http_codes.hpp>
-#include <userver/utils/statistics/percentile.hpp>
 #include <userver/utils/statistics/recentperiod.hpp>
+#include <userver/utils/statistics/sharded_counter.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -28,34 +29,35 @@ class HttpHandlerMethodStatistics final {
     return reply_codes_.FormatReplyCodes();
   }
 
-  using Percentile = utils::statistics::Percentile<2048, unsigned int, 120>;
+  using Percentile = utils::statistics::HdrHistogram<>;
+  using ShardedPercentile = utils::statistics::ShardedHdrHistogram<>;
 
   Percentile GetTimings() const { return timings_.GetStatsForPeriod(); }
 
   size_t GetInFlight() const { return in_flight_; }
 
-  void IncrementInFlight() { in_flight_++; }
+  void IncrementInFlight() { ++in_flight_; }
 
-  void DecrementInFlight() { in_flight_--; }
+  void DecrementInFlight() { --in_flight_; }
 
-  void IncrementTooManyRequestsInFlight() { too_many_requests_in_flight_++; }
+  void IncrementTooManyRequestsInFlight() { ++too_many_requests_in_flight_; }
 
   size_t GetTooManyRequestsInFlight() const {
     return too_many_requests_in_flight_;
   }
 
-  void IncrementRateLimitReached() { rate_limit_reached_++; }
+  void IncrementRateLimitReached() { ++rate_limit_reached_; }
 
   size_t GetRateLimitReached() const { return rate_limit_reached_; }
 
  private:
-  utils::statistics::RecentPeriod<Percentile, Percentile,
+  utils::statistics::RecentPeriod<ShardedPercentile, Percentile,
                                   utils::datetime::SteadyClock>
       timings_;
   utils::statistics::HttpCodes reply_codes_{400, 401, 499, 500};
-  std::atomic<size_t> in_flight_{0};
-  std::atomic<size_t> too_many_requests_in_flight_{0};
-  std::atomic<size_t> rate_limit_reached_{0};
+  utils::statistics::ShardedCounter<size_t> in_flight_{0};
+  utils::statistics::ShardedCounter<size_t> too_many_requests_in_flight_{0};
+  utils::statistics::ShardedCounter<size_t> rate_limit_reached_{0};
 };
 
 class HttpHandlerStatistics final {
@@ -3,8 +3,12 @@
 #include <userver/components/component_context.hpp>
 #include <userver/components/statistics_storage.hpp>
 #include <userver/formats/json/serialize.hpp>
+#include <userver/http/content_type.hpp>
+#include <userver/server/handlers/exceptions.hpp>
 #include <userver/yaml_config/schema.hpp>
 
+#include <userver/utils/statistics/graphite.hpp>
+#include <userver/utils/statistics/prometheus.hpp>
 #include <userver/utils/statistics/storage.hpp>
 #include <utils/statistics/value_builder_helpers.hpp>
 
@@ -12,6 +16,19 @@ USERVER_NAMESPACE_BEGIN
 
 namespace server::handlers {
 
+namespace {
+
+const std::string kFormatArg = "format";
+
+const USERVER_NAMESPACE::http::ContentType kPrometheusContentType{
+    "text/plain; version=0.0.4; charset=utf-8"};
+const USERVER_NAMESPACE::http::ContentType kOpenMetricsContentType{
+    "application/openmetrics-text; version=1.0.0; charset=utf-8"};
+const USERVER_NAMESPACE::http::ContentType kGraphiteContentType{
+    "text/plain; charset=utf-8"};
+
+}  // namespace
+
 ServerMonitor::ServerMonitor(
     const components::ComponentConfig& config,
     const components::ComponentContext& component_context)
@@ -24,6 +41,26 @@ std::string ServerMonitor::HandleRequestThrow(const http::HttpRequest& request,
                                               request::RequestContext&) const {
   utils::statistics::StatisticsRequest statistics_request;
   statistics_request.prefix = request.GetArg("prefix");
+
+  const auto& format = request.GetArg(kFormatArg);
+  auto& response = request.GetHttpResponse();
+  if (format == "prometheus") {
+    response.SetContentType(kPrometheusContentType);
+    return utils::statistics::ToPrometheusFormat(statistics_storage_,
+                                                 statistics_request);
+  } else if (format == "openmetrics") {
+    response.SetContentType(kOpenMetricsContentType);
+    return utils::statistics::ToOpenMetricsFormat(statistics_storage_,
+                                                  statistics_request);
+  } else if (format == "graphite") {
+    response.SetContentType(kGraphiteContentType);
+    return utils::statistics::ToGraphiteFormat(statistics_storage_,
+                                               statistics_request);
+  } else if (!format.empty() && format != "json") {
+    const std::string message = "unknown metrics format: " + format;
+    throw ClientError(InternalMessage{message}, ExternalBody{message});
+  }
+
   formats::json::ValueBuilder monitor_data =
       statistics_storage_.GetAsJson(statistics_request);
 
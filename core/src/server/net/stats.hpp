@@ -1,21 +1,20 @@
 #pragma once
 
-#include <atomic>
 #include <cstddef>
 #include <vector>
 
+#include <userver/utils/statistics/sharded_counter.hpp>
+
 USERVER_NAMESPACE_BEGIN
 
 namespace server {
 namespace net {
 
-struct ParserStats {
-  ParserStats(const ParserStats& other)
-      : parsing_request_count(other.parsing_request_count.load()) {}
-
-  ParserStats() = default;
+// Modified on every request, so the counters are sharded
+using StatsCounter = utils::statistics::ShardedCounter<size_t>;
 
-  std::atomic<size_t> parsing_request_count{0};
+struct ParserStats {
+  StatsCounter parsing_request_count{0};
 };
 
 inline ParserStats& operator+=(ParserStats& lhs, const ParserStats& rhs) {
@@ -24,25 +23,15 @@ inline ParserStats& operator+=(ParserStats& lhs, const ParserStats& rhs) {
 }
 
 struct Stats {
-  Stats(const Stats& other)
-      : active_connections(other.active_connections.load()),
-        connections_created(other.connections_created.load()),
-        connections_closed(other.connections_closed.load()),
-        parser_stats(other.parser_stats),
-        active_request_count(other.active_request_count.load()),
-        requests_processed_count(other.requests_processed_count.load()) {}
-
-  Stats() = default;
-
   // per listener
-  std::atomic<size_t> active_connections{0};
-  std::atomic<size_t> connections_created{0};
-  std::atomic<size_t> connections_closed{0};
+  StatsCounter active_connections{0};
+  StatsCounter connections_created{0};
+  StatsCounter connections_closed{0};
 
   // per connection
   ParserStats parser_stats;
-  std::atomic<size_t> active_request_count{0};
-  std::atomic<size_t> requests_processed_count{0};
+  StatsCounter active_request_count{0};
+  StatsCounter requests_processed_count{0};
 };
 
 inline Stats& operator+=(Stats& lhs, const Stats& rhs) {
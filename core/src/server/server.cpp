@@ -173,22 +173,22 @@ formats::json::Value Server::GetMonitorData(
   auto server_stats = pimpl->GetServerStats();
   {
     formats::json::ValueBuilder json_conn_stats(formats::json::Type::kObject);
-    json_conn_stats["active"] = server_stats.active_connections.load();
-    json_conn_stats["opened"] = server_stats.connections_created.load();
-    json_conn_stats["closed"] = server_stats.connections_closed.load();
+    json_conn_stats["active"] = server_stats.active_connections.Load();
+    json_conn_stats["opened"] = server_stats.connections_created.Load();
+    json_conn_stats["closed"] = server_stats.connections_closed.Load();
 
     json_data["connections"] = std::move(json_conn_stats);
   }
   {
     formats::json::ValueBuilder json_request_stats(
         formats::json::Type::kObject);
-    json_request_stats["active"] = server_stats.active_request_count.load();
+    json_request_stats["active"] = server_stats.active_request_count.Load();
     json_request_stats["avg-lifetime-ms"] =
         pimpl->main_port_info_.data_accounter_.GetAvgRequestTime().count();
     json_request_stats["processed"] =
-        server_stats.requests_processed_count.load();
+        server_stats.requests_processed_count.Load();
     json_request_stats["parsing"] =
-        server_stats.parser_stats.parsing_request_count.load();
+        server_stats.parser_stats.parsing_request_count.Load();
 
     json_data["requests"] = std::move(json_request_stats);
   }
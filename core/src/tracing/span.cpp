@@ -7,8 +7,10 @@
 #include <fmt/format.h>
 
 #include <engine/task/task_context.hpp>
+#include <tracing/span_sampling.hpp>
 #include <userver/engine/task/local_variable.hpp>
 #include <userver/tracing/span.hpp>
+#include <userver/tracing/tags.hpp>
 #include <userver/tracing/tracer.hpp>
 #include <userver/utils/assert.hpp>
 #include <userver/utils/rand.hpp>
@@ -105,17 +107,47 @@ Span::Impl::Impl(TracerPtr tracer, std::string name, const Span::Impl* parent,
   if (parent) {
     log_extra_inheritable_ = parent->log_extra_inheritable_;
     local_log_level_ = parent->local_log_level_;
+    is_sampled_ = parent->is_sampled_;
+    tail_buffer_ = parent->tail_buffer_;
+  } else {
+    const auto sampling = impl::ReadSpanSampling();
+    SetSampled(impl::ShouldSampleTrace(*sampling), *sampling);
   }
   AttachToCoroStack();
 }
 
 Span::Impl::~Impl() {
-  if (!ShouldLog()) {
+  // The tail root finishes the trace even if its own record is not logged
+  const bool should_log = ShouldLog();
+  if (!should_log && !is_tail_root_) {
     return;
   }
 
-  const auto steady_now = std::chrono::steady_clock::now();
-  const auto duration = steady_now - start_steady_time_;
+  const auto duration = std::chrono::steady_clock::now() - start_steady_time_;
+
+  if (tail_buffer_) {
+    // The trace is not sampled, its spans are logged only if it turns out to
+    // be slow or failed. The local root decides when it finishes.
+    const auto tail_buffer = std::move(tail_buffer_);
+
+    if (!is_tail_root_) {
+      const auto decision =
+          tail_buffer->Defer(std::move(*this), duration, IsFailed());
+      if (decision != impl::TailBuffer::Decision::kKeep) return;
+    } else {
+      auto deferred = tail_buffer->Finish(duration, IsFailed());
+      if (!deferred) return;
+
+      for (auto& span : *deferred) {
+        span.span->LogRecord(span.duration);
+      }
+    }
+  }
+
+  if (should_log) LogRecord(duration);
+}
+
+void Span::Impl::LogRecord(std::chrono::steady_clock::duration duration) {
   const auto total_time_ms =
       std::chrono::duration_cast<RealMilliseconds>(duration).count();
 
@@ -132,7 +164,7 @@ Span::Impl::~Impl() {
   result.Extend(kTimeUnitsAttrName, "ms");
   result.Extend(kStartTimestampAttrName, StartTsToString(start_system_time_));
 
-  LogOpenTracing();
+  LogOpenTracing(duration);
 
   if (log_extra_local_) result.Extend(std::move(*log_extra_local_));
   time_storage_.MergeInto(result);
@@ -141,6 +173,22 @@ Span::Impl::~Impl() {
       << std::move(result) << std::move(*this);
 }
 
+bool Span::Impl::IsFailed() const {
+  // kNone of the no-log spans is not an error
+  if (log_level_ >= logging::Level::kError &&
+      log_level_ != logging::Level::kNone) {
+    return true;
+  }
+
+  const auto has_error_flag = [](const logging::LogExtra& extra) {
+    // `true` is stored as int
+    const auto* error = std::get_if<int>(&extra.GetValue(kErrorFlag));
+    return error && *error != 0;
+  };
+  return has_error_flag(log_extra_inheritable_) ||
+         (log_extra_local_ && has_error_flag(*log_extra_local_));
+}
+
 void Span::Impl::LogTo(logging::LogHelper& log_helper) const& {
   log_helper << log_extra_inheritable_;
   tracer_->LogSpanContextTo(*this, log_helper);
@@ -180,7 +228,31 @@ std::string Span::Impl::GetParentIdForLogging(const Span::Impl* parent) {
   return {};
 }
 
+void Span::Impl::SetSampled(bool sampled) {
+  const auto sampling = impl::ReadSpanSampling();
+  SetSampled(sampled, *sampling);
+}
+
+void Span::Impl::SetSampled(bool sampled, const SpanSampling& sampling) {
+  is_sampled_ = sampled;
+  if (sampled || !sampling.IsTailRetentionEnabled()) {
+    tail_buffer_.reset();
+    is_tail_root_ = false;
+    return;
+  }
+
+  if (!is_tail_root_) {
+    tail_buffer_ = std::make_shared<impl::TailBuffer>(
+        sampling.keep_slow_threshold, sampling.keep_failed,
+        sampling.max_kept_spans);
+    is_tail_root_ = true;
+  }
+}
+
 bool Span::Impl::ShouldLog() const {
+  // Spans of a not sampled trace are logged only through the tail buffer
+  if (!is_sampled_ && !tail_buffer_) return false;
+
   /* We must honour default log level, but use span's level from ourselves,
    * not the previous span's.
    */
@@ -310,6 +382,10 @@ void Span::SetLogLevel(logging::Level log_level) {
 
 logging::Level Span::GetLogLevel() const { return pimpl_->log_level_; }
 
+void Span::SetSampled(bool sampled) { pimpl_->SetSampled(sampled); }
+
+bool Span::IsSampled() const noexcept { return pimpl_->IsSampled(); }
+
 void Span::SetLocalLogLevel(std::optional<logging::Level> log_level) {
   pimpl_->local_log_level_ = log_level;
 }
@@ -32,6 +32,12 @@ class ValueBuilder;
 
 namespace tracing {
 
+struct SpanSampling;
+
+namespace impl {
+class TailBuffer;
+}  // namespace impl
+
 class Span::Impl
     : public boost::intrusive::list_base_hook<
           boost::intrusive::link_mode<boost::intrusive::auto_unlink>> {
@@ -67,17 +73,24 @@ class Span::Impl
 
   ReferenceType GetReferenceType() const noexcept { return reference_type_; }
 
+  void SetSampled(bool sampled);
+  bool IsSampled() const noexcept { return is_sampled_; }
+
   void DetachFromCoroStack();
   void AttachToCoroStack();
 
  private:
-  void LogOpenTracing() const;
+  void LogOpenTracing(std::chrono::steady_clock::duration duration) const;
   static void AddOpentracingTags(formats::json::ValueBuilder& output,
                                  const logging::LogExtra& input);
 
   static std::string GetParentIdForLogging(const Span::Impl* parent);
   bool ShouldLog() const;
 
+  void SetSampled(bool sampled, const SpanSampling& sampling);
+  void LogRecord(std::chrono::steady_clock::duration duration);
+  bool IsFailed() const;
+
   const std::string name_;
   const bool is_no_log_span_;
   logging::Level log_level_;
@@ -99,6 +112,11 @@ class Span::Impl
   std::string parent_id_;
   const ReferenceType reference_type_;
 
+  bool is_sampled_{true};
+  // Set for the spans of a not sampled trace with the tail-based retention
+  std::shared_ptr<impl::TailBuffer> tail_buffer_;
+  bool is_tail_root_{false};
+
   friend class Span;
 };
 
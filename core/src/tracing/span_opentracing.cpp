@@ -69,13 +69,12 @@ const std::string kDuration = "duration";
 }  // namespace jaeger
 }  // namespace
 
-void Span::Impl::LogOpenTracing() const {
+void Span::Impl::LogOpenTracing(
+    std::chrono::steady_clock::duration duration) const {
   auto logger = tracing::OpentracingLogger();
   if (!logger) {
     return;
   }
-  const auto steady_now = std::chrono::steady_clock::now();
-  const auto duration = steady_now - start_steady_time_;
   const auto duration_microseconds =
       std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
   logging::LogExtra jaeger_span;
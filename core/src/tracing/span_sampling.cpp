@@ -0,0 +1,86 @@
+#include <tracing/span_sampling.hpp>
+
+#include <stdexcept>
+
+#include <tracing/span_impl.hpp>
+#include <userver/formats/json/value.hpp>
+#include <userver/formats/parse/common.hpp>
+#include <userver/utils/assert.hpp>
+#include <userver/utils/rand.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace tracing {
+
+SpanSampling Parse(const formats::json::Value& value,
+                   formats::parse::To<SpanSampling>) {
+  SpanSampling result;
+  result.probability = value["probability"].As<double>();
+  if (result.probability < 0 || result.probability > 1) {
+    throw std::runtime_error("span sampling probability must be in [0, 1]");
+  }
+
+  result.keep_slow_threshold = std::chrono::milliseconds{
+      value["keep-slow-ms"].As<std::int64_t>(0)};
+  result.keep_failed = value["keep-failed"].As<bool>(false);
+  result.max_kept_spans =
+      value["max-kept-spans"].As<std::size_t>(result.max_kept_spans);
+  return result;
+}
+
+namespace impl {
+
+bool ShouldSampleTrace(const SpanSampling& sampling) {
+  if (sampling.probability >= 1) return true;
+  if (sampling.probability <= 0) return false;
+  return utils::RandRange(1.0) < sampling.probability;
+}
+
+TailBuffer::TailBuffer(std::chrono::milliseconds keep_slow_threshold,
+                       bool keep_failed, std::size_t max_spans)
+    : keep_slow_threshold_(keep_slow_threshold),
+      keep_failed_(keep_failed),
+      max_spans_(max_spans) {}
+
+TailBuffer::~TailBuffer() = default;
+
+TailBuffer::Decision TailBuffer::Defer(
+    Span::Impl&& span, std::chrono::steady_clock::duration duration,
+    bool failed) {
+  std::lock_guard lock(mutex_);
+  if (decision_ != Decision::kPending) return decision_;
+
+  has_failed_ = has_failed_ || failed;
+  if (spans_.size() < max_spans_) {
+    spans_.push_back(
+        {duration, std::make_unique<Span::Impl>(std::move(span))});
+  }
+  return Decision::kPending;
+}
+
+std::optional<std::vector<TailBuffer::DeferredSpan>> TailBuffer::Finish(
+    std::chrono::steady_clock::duration root_duration, bool root_failed) {
+  const bool is_slow = keep_slow_threshold_.count() > 0 &&
+                       root_duration >= keep_slow_threshold_;
+
+  std::vector<DeferredSpan> spans;
+  bool keep = false;
+  {
+    std::lock_guard lock(mutex_);
+    UASSERT(decision_ == Decision::kPending);
+
+    keep = is_slow || (keep_failed_ && (has_failed_ || root_failed));
+    decision_ = keep ? Decision::kKeep : Decision::kDrop;
+    spans = std::move(spans_);
+  }
+
+  // the dropped spans are destroyed outside of the lock
+  if (!keep) return std::nullopt;
+  return spans;
+}
+
+}  // namespace impl
+
+}  // namespace tracing
+
+USERVER_NAMESPACE_END
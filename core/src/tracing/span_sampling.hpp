@@ -0,0 +1,96 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+#include <userver/formats/parse/to.hpp>
+#include <userver/rcu/rcu.hpp>
+#include <userver/tracing/span.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace formats::json {
+class Value;
+}
+
+namespace tracing {
+
+struct SpanSampling {
+  /// Share of the new traces whose spans are logged
+  double probability{1.0};
+
+  /// Spans of a not sampled trace are kept until its local root span
+  /// finishes and are logged if it took at least this long, 0 disables
+  std::chrono::milliseconds keep_slow_threshold{0};
+
+  /// Spans of a not sampled trace are logged if any of them failed
+  bool keep_failed{false};
+
+  /// Limit of the kept spans of a trace, the rest are dropped
+  std::size_t max_kept_spans{1000};
+
+  bool IsTailRetentionEnabled() const {
+    return keep_failed || keep_slow_threshold.count() > 0;
+  }
+};
+
+SpanSampling Parse(const formats::json::Value& value,
+                   formats::parse::To<SpanSampling>);
+
+namespace impl {
+
+/// Returns the settings set by Tracer::SetSpanSampling()
+rcu::ReadablePtr<SpanSampling> ReadSpanSampling();
+
+/// Makes the head-based sampling decision for a new trace
+bool ShouldSampleTrace(const SpanSampling& sampling);
+
+/// @brief Keeps the records of the spans of a not sampled trace until its
+/// local root span decides whether the trace is worth logging
+///
+/// Spans of the trace may finish in different tasks, so the buffer is shared
+/// between them and is thread-safe.
+class TailBuffer final {
+ public:
+  struct DeferredSpan {
+    std::chrono::steady_clock::duration duration;
+    std::unique_ptr<Span::Impl> span;
+  };
+
+  enum class Decision { kPending, kKeep, kDrop };
+
+  TailBuffer(std::chrono::milliseconds keep_slow_threshold, bool keep_failed,
+             std::size_t max_spans);
+
+  ~TailBuffer();
+
+  /// Takes the span until Finish() is called. If the root span has already
+  /// finished, leaves the span intact and returns the decision.
+  Decision Defer(Span::Impl&& span,
+                 std::chrono::steady_clock::duration duration, bool failed);
+
+  /// Decides the fate of the trace when its local root span finishes.
+  /// Returns the spans to log if the trace is kept.
+  std::optional<std::vector<DeferredSpan>> Finish(
+      std::chrono::steady_clock::duration root_duration, bool root_failed);
+
+ private:
+  const std::chrono::milliseconds keep_slow_threshold_;
+  const bool keep_failed_;
+  const std::size_t max_spans_;
+
+  std::mutex mutex_;
+  Decision decision_{Decision::kPending};
+  bool has_failed_{false};
+  std::vector<DeferredSpan> spans_;
+};
+
+}  // namespace impl
+
+}  // namespace tracing
+
+USERVER_NAMESPACE_END
@@ -3,11 +3,13 @@
 
 #include <logging/logging_test.hpp>
 #include <tracing/no_log_spans.hpp>
+#include <tracing/span_sampling.hpp>
 #include <userver/engine/sleep.hpp>
 #include <userver/formats/json/serialize.hpp>
 #include <userver/tracing/noop.hpp>
 #include <userver/tracing/opentracing.hpp>
 #include <userver/tracing/span.hpp>
+#include <userver/tracing/tags.hpp>
 #include <userver/tracing/tracer.hpp>
 #include <userver/utest/utest.hpp>
 
@@ -486,6 +488,159 @@ UTEST_F(Span, NoLogWithSetLogLevel) {
   tracing::Tracer::SetNoLogSpans(tracing::NoLogSpans());
 }
 
+UTEST_F(Span, Sampling) {
+  tracing::SpanSampling sampling;
+  sampling.probability = 0;
+  tracing::Tracer::SetSpanSampling(std::move(sampling));
+
+  {
+    tracing::Span span("not_sampled_span");
+    EXPECT_FALSE(span.IsSampled());
+    tracing::Span child("not_sampled_child");
+    EXPECT_FALSE(child.IsSampled());
+    LOG_INFO() << "ordinary log";
+  }
+  {
+    tracing::Span span("sampled_span");
+    span.SetSampled(true);
+    tracing::Span child("sampled_child");
+    EXPECT_TRUE(child.IsSampled());
+  }
+
+  logging::LogFlush();
+  const auto output = sstream.str();
+  EXPECT_EQ(std::string::npos, output.find("not_sampled_")) << output;
+  EXPECT_NE(std::string::npos, output.find("ordinary log")) << output;
+  EXPECT_NE(std::string::npos, output.find("stopwatch_name=sampled_span"))
+      << output;
+  EXPECT_NE(std::string::npos, output.find("stopwatch_name=sampled_child"))
+      << output;
+
+  tracing::Tracer::SetSpanSampling(tracing::SpanSampling());
+}
+
+UTEST_F(Span, SamplingShouldLog) {
+  tracing::SpanSampling sampling;
+  sampling.probability = 0;
+  tracing::Tracer::SetSpanSampling(tracing::SpanSampling{sampling});
+
+  {
+    // HTTP handlers skip collecting the response tags of such spans
+    tracing::Span span("not_sampled_span");
+    span.SetLogLevel(logging::Level::kError);
+    EXPECT_FALSE(span.ShouldLogDefault());
+  }
+
+  sampling.keep_failed = true;
+  tracing::Tracer::SetSpanSampling(tracing::SpanSampling{sampling});
+  {
+    // The tags decide whether the span is kept
+    tracing::Span span("retained_span");
+    EXPECT_TRUE(span.ShouldLogDefault());
+  }
+
+  tracing::Tracer::SetSpanSampling(tracing::SpanSampling());
+}
+
+UTEST_F(Span, SamplingKeepSlow) {
+  tracing::SpanSampling sampling;
+  sampling.probability = 0;
+  sampling.keep_slow_threshold = std::chrono::milliseconds{10};
+  tracing::Tracer::SetSpanSampling(std::move(sampling));
+
+  {
+    tracing::Span span("fast_root");
+    tracing::Span child("fast_child");
+  }
+  {
+    tracing::Span span("slow_root");
+    { tracing::Span child("slow_child"); }
+    engine::SleepFor(std::chrono::milliseconds{20});
+  }
+
+  logging::LogFlush();
+  const auto output = sstream.str();
+  EXPECT_EQ(std::string::npos, output.find("fast_root")) << output;
+  EXPECT_EQ(std::string::npos, output.find("fast_child")) << output;
+  EXPECT_NE(std::string::npos, output.find("stopwatch_name=slow_root"))
+      << output;
+  EXPECT_NE(std::string::npos, output.find("stopwatch_name=slow_child"))
+      << output;
+
+  tracing::Tracer::SetSpanSampling(tracing::SpanSampling());
+}
+
+UTEST_F(Span, SamplingKeepFailed) {
+  auto json = formats::json::FromString(R"({
+        "probability": 0,
+        "keep-failed": true,
+        "max-kept-spans": 2
+    })");
+  tracing::Tracer::SetSpanSampling(
+      Parse(json, formats::parse::To<tracing::SpanSampling>{}));
+
+  {
+    tracing::Span span("ok_root");
+    tracing::Span child("ok_child");
+  }
+  {
+    tracing::Span span("failed_root");
+    { tracing::Span child("kept_child"); }
+    {
+      tracing::Span child("failed_child");
+      child.AddTag(tracing::kErrorFlag, true);
+    }
+    { tracing::Span child("over_the_limit_child"); }
+  }
+
+  logging::LogFlush();
+  const auto output = sstream.str();
+  EXPECT_EQ(std::string::npos, output.find("ok_root")) << output;
+  EXPECT_EQ(std::string::npos, output.find("ok_child")) << output;
+  EXPECT_NE(std::string::npos, output.find("stopwatch_name=failed_root"))
+      << output;
+  EXPECT_NE(std::string::npos, output.find("stopwatch_name=kept_child"))
+      << output;
+  EXPECT_NE(std::string::npos, output.find("stopwatch_name=failed_child"))
+      << output;
+  EXPECT_EQ(std::string::npos, output.find("over_the_limit_child")) << output;
+
+  tracing::Tracer::SetSpanSampling(tracing::SpanSampling());
+}
+
+UTEST_F(Span, SamplingNoLogRoot) {
+  tracing::SpanSampling sampling;
+  sampling.probability = 0;
+  sampling.keep_slow_threshold = std::chrono::milliseconds{10};
+  sampling.keep_failed = true;
+  tracing::Tracer::SetSpanSampling(std::move(sampling));
+
+  tracing::NoLogSpans no_logs;
+  no_logs.prefixes = {"no_log_root"};
+  tracing::Tracer::SetNoLogSpans(std::move(no_logs));
+
+  {
+    tracing::Span span("no_log_root_fast");
+    tracing::Span child("fast_child");
+  }
+  {
+    tracing::Span span("no_log_root_slow");
+    { tracing::Span child("slow_child"); }
+    engine::SleepFor(std::chrono::milliseconds{20});
+  }
+
+  logging::LogFlush();
+  const auto output = sstream.str();
+  // Only the record of the root itself is suppressed
+  EXPECT_EQ(std::string::npos, output.find("no_log_root")) << output;
+  EXPECT_EQ(std::string::npos, output.find("fast_child")) << output;
+  EXPECT_NE(std::string::npos, output.find("stopwatch_name=slow_child"))
+      << output;
+
+  tracing::Tracer::SetNoLogSpans(tracing::NoLogSpans());
+  tracing::Tracer::SetSpanSampling(tracing::SpanSampling());
+}
+
 UTEST_F(Span, ForeignSpan) {
   auto tracer = tracing::MakeNoopTracer("test_service");
 
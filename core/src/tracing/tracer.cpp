@@ -3,6 +3,7 @@
 #include <atomic>
 
 #include <tracing/no_log_spans.hpp>
+#include <tracing/span_sampling.hpp>
 #include <userver/rcu/rcu.hpp>
 #include <userver/tracing/noop.hpp>
 #include <userver/utils/uuid4.hpp>
@@ -18,6 +19,11 @@ auto& GlobalNoLogSpans() {
   return spans;
 }
 
+auto& GlobalSpanSampling() {
+  static rcu::Variable<SpanSampling> sampling{};
+  return sampling;
+}
+
 auto& GlobalTracer() {
   static const std::string kEmptyServiceName;
   static rcu::Variable<TracerPtr> tracer(
@@ -63,6 +69,14 @@ bool Tracer::IsNoLogSpan(const std::string& name) {
          spans->names.find(name) != spans->names.end();
 }
 
+void Tracer::SetSpanSampling(SpanSampling&& sampling) {
+  GlobalSpanSampling().Assign(std::move(sampling));
+}
+
+rcu::ReadablePtr<SpanSampling> impl::ReadSpanSampling() {
+  return GlobalSpanSampling().Read();
+}
+
 void Tracer::SetTracer(std::shared_ptr<Tracer> tracer) {
   GlobalTracer().Assign(tracer);
 }
@@ -0,0 +1,73 @@
+#include <userver/utils/statistics/graphite.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+
+#include <fmt/format.h>
+
+#include <userver/utils/datetime.hpp>
+#include <userver/utils/statistics/base_format_builder.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::statistics {
+
+namespace {
+
+// Same as utils::graphite::EscapeName(), `extra_allowed` characters are kept
+void AppendEscaped(std::string& out, std::string_view name,
+                   const char* extra_allowed) {
+  for (const char c : name) {
+    if (('a' <= c && c <= 'z') || ('A' <= c && c <= 'Z') ||
+        ('0' <= c && c <= '9') || (c && std::strchr(extra_allowed, c))) {
+      out += c;
+    } else {
+      out += '_';
+    }
+  }
+}
+
+class GraphiteBuilder final : public BaseFormatBuilder {
+ public:
+  explicit GraphiteBuilder(std::int64_t timestamp) : timestamp_(timestamp) {}
+
+  void HandleMetric(std::string_view path, const std::vector<LabelView>& labels,
+                    const MetricValue& value) override {
+    // '.' separates the path segments in Graphite
+    AppendEscaped(out_, path, "-_:=/[]()\"?.");
+    for (const auto& label : labels) {
+      // '=' separates the tag name from the tag value
+      out_ += ';';
+      AppendEscaped(out_, label.Name(), "-_:/[]()\"?.");
+      out_ += '=';
+      AppendEscaped(out_, label.Value(), "-_:=/[]()\"?.");
+    }
+    value.Visit([this](auto x) {
+      fmt::format_to(std::back_inserter(out_), " {} {}\n", x, timestamp_);
+    });
+  }
+
+  std::string Release() && { return std::move(out_); }
+
+ private:
+  const std::int64_t timestamp_;
+  std::string out_;
+};
+
+}  // namespace
+
+std::string ToGraphiteFormat(const Storage& storage,
+                             const StatisticsRequest& request) {
+  const auto timestamp = std::chrono::duration_cast<std::chrono::seconds>(
+                             utils::datetime::Now().time_since_epoch())
+                             .count();
+  GraphiteBuilder builder{timestamp};
+  storage.VisitMetrics(builder, request);
+  return std::move(builder).Release();
+}
+
+}  // namespace utils::statistics
+
+USERVER_NAMESPACE_END
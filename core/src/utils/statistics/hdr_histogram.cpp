@@ -0,0 +1,43 @@
+#include <userver/utils/statistics/hdr_histogram.hpp>
+
+#include <stdexcept>
+
+#include <fmt/format.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::statistics::impl {
+
+void AppendVarint(std::string& out, std::uint64_t value) {
+  while (value >= 0x80) {
+    out.push_back(static_cast<char>((value & 0x7F) | 0x80));
+    value >>= 7;
+  }
+  out.push_back(static_cast<char>(value));
+}
+
+std::uint64_t ParseVarint(std::string_view& data) {
+  std::uint64_t result = 0;
+  for (std::size_t i = 0; i < data.size(); ++i) {
+    const auto byte = static_cast<unsigned char>(data[i]);
+    if (i * 7 >= 64 || (i * 7 == 63 && byte > 1)) {
+      ThrowInvalidHdrHistogram("varint is too long");
+    }
+
+    result |= static_cast<std::uint64_t>(byte & 0x7F) << (i * 7);
+    if (!(byte & 0x80)) {
+      data.remove_prefix(i + 1);
+      return result;
+    }
+  }
+  ThrowInvalidHdrHistogram("truncated varint");
+}
+
+void ThrowInvalidHdrHistogram(std::string_view reason) {
+  throw std::runtime_error(
+      fmt::format("Invalid serialized HdrHistogram: {}", reason));
+}
+
+}  // namespace utils::statistics::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,122 @@
+#include <userver/utils/statistics/hdr_histogram.hpp>
+
+#include <cstdint>
+#include <stdexcept>
+
+#include <gtest/gtest.h>
+
+#include <userver/utils/statistics/percentile_format_json.hpp>
+#include <userver/utils/statistics/recentperiod.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using Histogram = utils::statistics::HdrHistogram<>;
+
+}  // namespace
+
+TEST(HdrHistogram, Buckets) {
+  static_assert(Histogram::kBucketsCount == 1728);
+  static_assert(Histogram::BucketIndex(Histogram::kMaxValue) ==
+                Histogram::kBucketsCount - 1);
+  static_assert(Histogram::BucketUpperBound(Histogram::kBucketsCount - 1) ==
+                Histogram::kMaxValue);
+
+  std::size_t previous_index = 0;
+  for (std::size_t value = 1; value < 1'000'000; ++value) {
+    const auto index = Histogram::BucketIndex(value);
+    ASSERT_LE(index, previous_index + 1) << value;
+    ASSERT_GE(index, previous_index) << value;
+    previous_index = index;
+
+    const auto upper_bound = Histogram::BucketUpperBound(index);
+    ASSERT_GE(upper_bound, value);
+    ASSERT_LE(upper_bound - value, value / 64) << value;
+    ASSERT_EQ(Histogram::BucketIndex(upper_bound), index);
+    ASSERT_EQ(Histogram::BucketIndex(upper_bound + 1), index + 1);
+  }
+
+  using Wide = utils::statistics::HdrHistogram<3, 64, std::uint64_t>;
+  static_assert(Wide::kMaxValue == std::numeric_limits<std::size_t>::max());
+  static_assert(Wide::BucketIndex(Wide::kMaxValue) == Wide::kBucketsCount - 1);
+  static_assert(Wide::BucketUpperBound(Wide::kBucketsCount - 1) ==
+                Wide::kMaxValue);
+}
+
+TEST(HdrHistogram, Percentiles) {
+  Histogram histogram;
+  EXPECT_EQ(0u, histogram.GetPercentile(50));
+
+  for (std::size_t i = 0; i < 100; ++i) histogram.Account(i);
+  EXPECT_EQ(100u, histogram.Count());
+  EXPECT_EQ(0u, histogram.GetPercentile(0));
+  EXPECT_EQ(50u, histogram.GetPercentile(50));
+  EXPECT_EQ(99u, histogram.GetPercentile(100));
+
+  // The tail is not clamped, the error is bounded by the bucket width
+  histogram.Account(123'456, 1000);
+  histogram.Account(1'000'000'000'000);
+  EXPECT_NEAR(123'456, histogram.GetPercentile(99), 123'456 / 64);
+  EXPECT_EQ(Histogram::kMaxValue, histogram.GetPercentile(100));
+}
+
+TEST(HdrHistogram, Add) {
+  Histogram first;
+  Histogram second;
+  first.Account(1);
+  second.Account(1'000);
+  second.Account(1'000);
+
+  first.Add(second);
+  EXPECT_EQ(3u, first.Count());
+  EXPECT_EQ(1u, first.GetPercentile(0));
+  EXPECT_EQ(Histogram::BucketUpperBound(Histogram::BucketIndex(1'000)),
+            first.GetPercentile(50));
+
+  using RecentPeriod = utils::statistics::RecentPeriod<Histogram, Histogram>;
+  RecentPeriod period;
+  period.GetCurrentCounter().Account(5);
+  EXPECT_EQ(5u, period.GetStatsForPeriod(RecentPeriod::Duration::min(), true)
+                    .GetPercentile(100));
+
+  const auto json = utils::statistics::PercentileToJson(first).ExtractValue();
+  EXPECT_EQ(1u, json["p0"].As<std::size_t>());
+}
+
+TEST(HdrHistogram, Sharded) {
+  utils::statistics::ShardedHdrHistogram<> sharded;
+  sharded.Account(1);
+  sharded.Account(100'000);
+
+  Histogram histogram;
+  histogram += sharded;
+  EXPECT_EQ(2u, histogram.Count());
+  EXPECT_EQ(1u, histogram.GetPercentile(0));
+  EXPECT_NEAR(100'000, histogram.GetPercentile(100), 100'000 / 64);
+}
+
+TEST(HdrHistogram, Serialization) {
+  Histogram histogram;
+  EXPECT_EQ(0u, Histogram::Deserialize(histogram.Serialize()).Count());
+
+  histogram.Account(3, 7);
+  histogram.Account(5'000, 300);
+  histogram.Account(Histogram::kMaxValue);
+  const auto serialized = histogram.Serialize();
+  EXPECT_LT(serialized.size(), 16u);
+
+  const auto parsed = Histogram::Deserialize(serialized);
+  EXPECT_EQ(histogram.Count(), parsed.Count());
+  for (const double percent : {0.0, 5.0, 50.0, 99.9, 100.0}) {
+    EXPECT_EQ(histogram.GetPercentile(percent), parsed.GetPercentile(percent));
+  }
+
+  EXPECT_THROW(Histogram::Deserialize(""), std::runtime_error);
+  EXPECT_THROW(Histogram::Deserialize(serialized.substr(0, 4)),
+               std::runtime_error);
+  EXPECT_THROW(utils::statistics::HdrHistogram<5>::Deserialize(serialized),
+               std::runtime_error);
+}
+
+USERVER_NAMESPACE_END
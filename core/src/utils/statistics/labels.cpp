@@ -0,0 +1,36 @@
+#include <userver/utils/statistics/labels.hpp>
+
+#include <tuple>
+#include <utility>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::statistics {
+
+LabelView::LabelView(const Label& label) noexcept
+    : name_(label.Name()), value_(label.Value()) {}
+
+bool operator<(const LabelView& x, const LabelView& y) noexcept {
+  return std::tuple(x.Name(), x.Value()) < std::tuple(y.Name(), y.Value());
+}
+
+bool operator==(const LabelView& x, const LabelView& y) noexcept {
+  return x.Name() == y.Name() && x.Value() == y.Value();
+}
+
+Label::Label(LabelView view) : name_(view.Name()), value_(view.Value()) {}
+
+Label::Label(std::string name, std::string value)
+    : name_(std::move(name)), value_(std::move(value)) {}
+
+bool operator<(const Label& x, const Label& y) noexcept {
+  return LabelView{x} < LabelView{y};
+}
+
+bool operator==(const Label& x, const Label& y) noexcept {
+  return LabelView{x} == LabelView{y};
+}
+
+}  // namespace utils::statistics
+
+USERVER_NAMESPACE_END
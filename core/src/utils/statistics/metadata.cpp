@@ -1,20 +1,17 @@
 #include <userver/utils/statistics/metadata.hpp>
 
 #include <userver/utils/assert.hpp>
+#include <utils/statistics/metadata_keys.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
 namespace utils::statistics {
-namespace {
 
-const std::string kMetadata = "$meta";
-
-const std::string kMetadataSolomonSkip = "solomon_skip";
-const std::string kMetadataSolomonRename = "solomon_rename";
-const std::string kMetadataSolomonLabel = "solomon_label";
-const std::string kMetadataSolomonChildrenLabels = "solomon_children_labels";
-
-}  // namespace
+using impl::kMetadata;
+using impl::kMetadataSolomonChildrenLabels;
+using impl::kMetadataSolomonLabel;
+using impl::kMetadataSolomonRename;
+using impl::kMetadataSolomonSkip;
 
 void SolomonSkip(formats::json::ValueBuilder& stats_node) {
   stats_node[kMetadata][kMetadataSolomonSkip] = true;
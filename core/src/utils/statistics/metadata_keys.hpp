@@ -0,0 +1,19 @@
+#pragma once
+
+#include <string>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::statistics::impl {
+
+inline const std::string kMetadata = "$meta";
+
+inline const std::string kMetadataSolomonSkip = "solomon_skip";
+inline const std::string kMetadataSolomonRename = "solomon_rename";
+inline const std::string kMetadataSolomonLabel = "solomon_label";
+inline const std::string kMetadataSolomonChildrenLabels =
+    "solomon_children_labels";
+
+}  // namespace utils::statistics::impl
+
+USERVER_NAMESPACE_END
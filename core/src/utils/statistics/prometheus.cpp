@@ -0,0 +1,183 @@
+#include <userver/utils/statistics/prometheus.hpp>
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include <userver/utils/assert.hpp>
+#include <userver/utils/statistics/base_format_builder.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::statistics {
+
+namespace {
+
+enum class Format { kPrometheus, kOpenMetrics };
+
+bool IsAsciiLetter(char c) {
+  return ('a' <= c && c <= 'z') || ('A' <= c && c <= 'Z');
+}
+
+bool IsAsciiDigit(char c) { return '0' <= c && c <= '9'; }
+
+// [a-zA-Z_:][a-zA-Z0-9_:]* for metrics, the same without ':' for labels
+void AppendName(std::string& out, std::string_view name, bool allow_colon) {
+  if (name.empty() || IsAsciiDigit(name.front())) out += '_';
+  for (const char c : name) {
+    if (IsAsciiLetter(c) || IsAsciiDigit(c) || c == '_' ||
+        (allow_colon && c == ':')) {
+      out += c;
+    } else {
+      out += '_';
+    }
+  }
+}
+
+void AppendLabelValue(std::string& out, std::string_view value) {
+  for (const char c : value) {
+    switch (c) {
+      case '\\':
+        out += "\\\\";
+        break;
+      case '"':
+        out += "\\\"";
+        break;
+      case '\n':
+        out += "\\n";
+        break;
+      default:
+        out += c;
+    }
+  }
+}
+
+void AppendValue(std::string& out, std::int64_t value) {
+  fmt::format_to(std::back_inserter(out), "{}", value);
+}
+
+void AppendValue(std::string& out, double value) {
+  if (std::isnan(value)) {
+    out += "NaN";
+  } else if (std::isinf(value)) {
+    out += (value > 0 ? "+Inf" : "-Inf");
+  } else {
+    fmt::format_to(std::back_inserter(out), "{}", value);
+  }
+}
+
+class PrometheusBuilder final : public BaseFormatBuilder {
+ public:
+  explicit PrometheusBuilder(Format format) : format_(format) {}
+
+  void HandleMetric(std::string_view path, const std::vector<LabelView>& labels,
+                    const MetricValue& value) override {
+    name_.clear();
+    AppendName(name_, path, /*allow_colon=*/true);
+
+    // All the samples of a family must go together, but the sources may
+    // write them apart from each other. Samples of the family that was seen
+    // last go right into the output, the rest wait in the family tail.
+    auto [it, inserted] = family_indexes_.emplace(name_, families_.size());
+    if (inserted) {
+      families_.emplace_back();
+      if (format_ == Format::kOpenMetrics) {
+        fmt::format_to(std::back_inserter(out_), "# TYPE {} unknown\n",
+                       name_);
+      }
+    }
+
+    const bool is_last_family = (it->second + 1 == families_.size());
+    auto& out = is_last_family ? out_ : families_[it->second].tail;
+    out += name_;
+    if (!labels.empty()) {
+      out += '{';
+      bool is_first = true;
+      for (const auto& label : labels) {
+        if (!is_first) out += ',';
+        is_first = false;
+        AppendName(out, label.Name(), /*allow_colon=*/false);
+        out += "=\"";
+        AppendLabelValue(out, label.Value());
+        out += '"';
+      }
+      out += '}';
+    }
+    out += ' ';
+    value.Visit([&out](auto x) { AppendValue(out, x); });
+    out += '\n';
+    if (is_last_family) families_.back().run_end = out_.size();
+  }
+
+  std::string Release() && {
+    std::size_t tails_size = 0;
+    for (const auto& family : families_) tails_size += family.tail.size();
+
+    if (tails_size != 0) {
+      // Inserts the tails after the runs of their families in place, moving
+      // the runs from the last one, so the output is never copied as a whole
+      std::size_t dst_end = out_.size() + tails_size;
+      out_.resize(dst_end);
+      for (auto i = families_.size(); i-- > 0;) {
+        auto& family = families_[i];
+        dst_end -= family.tail.size();
+        std::memcpy(out_.data() + dst_end, family.tail.data(),
+                    family.tail.size());
+        std::string{}.swap(family.tail);
+
+        const auto run_begin = (i == 0 ? 0 : families_[i - 1].run_end);
+        dst_end -= family.run_end - run_begin;
+        std::memmove(out_.data() + dst_end, out_.data() + run_begin,
+                     family.run_end - run_begin);
+      }
+      UASSERT(dst_end == 0);
+    }
+
+    if (format_ == Format::kOpenMetrics) out_ += "# EOF\n";
+    return std::move(out_);
+  }
+
+ private:
+  struct Family {
+    // end of the first run of the family samples in out_, the runs go in the
+    // order of the first appearance of the families
+    std::size_t run_end{0};
+    // samples written after the samples of the other families
+    std::string tail;
+  };
+
+  const Format format_;
+  std::string name_;
+  std::string out_;
+  std::vector<Family> families_;
+  std::unordered_map<std::string, std::size_t> family_indexes_;
+};
+
+std::string ToFormat(const Storage& storage, const StatisticsRequest& request,
+                     Format format) {
+  PrometheusBuilder builder{format};
+  storage.VisitMetrics(builder, request);
+  return std::move(builder).Release();
+}
+
+}  // namespace
+
+std::string ToPrometheusFormat(const Storage& storage,
+                               const StatisticsRequest& request) {
+  return ToFormat(storage, request, Format::kPrometheus);
+}
+
+std::string ToOpenMetricsFormat(const Storage& storage,
+                                const StatisticsRequest& request) {
+  return ToFormat(storage, request, Format::kOpenMetrics);
+}
+
+}  // namespace utils::statistics
+
+USERVER_NAMESPACE_END
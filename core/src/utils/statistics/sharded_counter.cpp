@@ -0,0 +1,14 @@
+#include <userver/utils/statistics/sharded_counter.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::statistics::impl {
+
+std::size_t AssignShardIndex() noexcept {
+  static std::atomic<std::size_t> next_index{0};
+  return next_index.fetch_add(1, std::memory_order_relaxed) % kShardsCount;
+}
+
+}  // namespace utils::statistics::impl
+
+USERVER_NAMESPACE_END
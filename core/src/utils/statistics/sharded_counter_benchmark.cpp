@@ -0,0 +1,32 @@
+#include <userver/utils/statistics/sharded_counter.hpp>
+
+#include <cstdint>
+
+#include <benchmark/benchmark.h>
+
+#include <userver/utils/statistics/relaxed_counter.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+template <typename Counter>
+void counter_increment(benchmark::State& state) {
+  static Counter counter;
+  for (auto _ : state) {
+    ++counter;
+  }
+  benchmark::DoNotOptimize(counter.Load());
+}
+
+}  // namespace
+
+// All the threads increment the same counter
+BENCHMARK_TEMPLATE(counter_increment,
+                   utils::statistics::RelaxedCounter<std::uint64_t>)
+    ->ThreadRange(1, 32);
+BENCHMARK_TEMPLATE(counter_increment,
+                   utils::statistics::ShardedCounter<std::uint64_t>)
+    ->ThreadRange(1, 32);
+
+USERVER_NAMESPACE_END
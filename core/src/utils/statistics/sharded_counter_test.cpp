@@ -0,0 +1,61 @@
+#include <userver/utils/statistics/sharded_counter.hpp>
+
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+USERVER_NAMESPACE_BEGIN
+
+TEST(ShardedCounter, Basic) {
+  utils::statistics::ShardedCounter<std::uint64_t> counter;
+  EXPECT_EQ(0, counter.Load());
+
+  ++counter;
+  counter += 10;
+  --counter;
+  EXPECT_EQ(10, counter.Load());
+
+  counter = 42;
+  EXPECT_EQ(42, counter.Load());
+
+  const auto copy = counter;
+  counter -= 2;
+  EXPECT_EQ(42, copy.Load());
+  EXPECT_EQ(40, static_cast<std::uint64_t>(counter));
+}
+
+TEST(ShardedCounter, MultipleThreads) {
+  constexpr int kThreads = 32;
+  constexpr int kIncrements = 10000;
+  utils::statistics::ShardedCounter<std::size_t> counter;
+
+  std::vector<std::thread> threads;
+  threads.reserve(kThreads);
+  for (int i = 0; i < kThreads; ++i) {
+    threads.emplace_back([&counter] {
+      for (int j = 0; j < kIncrements; ++j) ++counter;
+    });
+  }
+  for (auto& thread : threads) thread.join();
+
+  EXPECT_EQ(kThreads * kIncrements, counter.Load());
+}
+
+TEST(ShardedCounter, DecrementOnOtherThread) {
+  utils::statistics::ShardedCounter<std::size_t> counter;
+  ++counter;
+  std::thread([&counter] {
+    ++counter;
+    ++counter;
+  }).join();
+  std::thread([&counter] { --counter; }).join();
+
+  // the shards of an unsigned counter may wrap around, the sum may not
+  EXPECT_EQ(2, counter.Load());
+  std::thread([&counter] { counter -= 2; }).join();
+  EXPECT_EQ(0, counter.Load());
+}
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,83 @@
+#include <userver/utils/statistics/sharded_percentile.hpp>
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <userver/utils/statistics/recentperiod.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using Percentile = utils::statistics::Percentile<100, unsigned int, 10, 10>;
+using ShardedPercentile =
+    utils::statistics::ShardedPercentile<100, unsigned int, 10, 10>;
+
+}  // namespace
+
+TEST(ShardedPercentile, Hundred) {
+  ShardedPercentile sharded;
+  for (int i = 0; i < 100; i++) sharded.Account(i);
+
+  Percentile p;
+  p += sharded;
+  EXPECT_EQ(100u, p.Count());
+  EXPECT_EQ(0u, p.GetPercentile(0));
+  EXPECT_EQ(50u, p.GetPercentile(50));
+  EXPECT_EQ(99u, p.GetPercentile(100));
+}
+
+TEST(ShardedPercentile, ExtraBuckets) {
+  ShardedPercentile sharded;
+  sharded.Account(0);
+  sharded.Account(1000);
+
+  Percentile p;
+  p += sharded;
+  EXPECT_EQ(2u, p.Count());
+  EXPECT_EQ(0u, p.GetPercentile(0));
+  EXPECT_EQ(190u, p.GetPercentile(100));
+
+  sharded.Reset();
+  Percentile empty;
+  empty += sharded;
+  EXPECT_EQ(0u, empty.Count());
+}
+
+TEST(ShardedPercentile, MultipleThreads) {
+  constexpr int kThreads = 16;
+  ShardedPercentile sharded;
+
+  std::vector<std::thread> threads;
+  threads.reserve(kThreads);
+  for (int i = 0; i < kThreads; ++i) {
+    threads.emplace_back([&sharded, i] {
+      for (int j = 0; j < 100; ++j) sharded.Account(i);
+    });
+  }
+  for (auto& thread : threads) thread.join();
+
+  Percentile p;
+  p += sharded;
+  EXPECT_EQ(kThreads * 100u, p.Count());
+  EXPECT_EQ(kThreads / 2u, p.GetPercentile(50));
+  EXPECT_EQ(kThreads - 1u, p.GetPercentile(100));
+}
+
+TEST(ShardedPercentile, RecentPeriod) {
+  utils::statistics::RecentPeriod<ShardedPercentile, Percentile> period;
+
+  period.GetCurrentCounter().Account(3);
+  period.GetCurrentCounter().Account(3);
+
+  using Duration = decltype(period)::Duration;
+  const auto result =
+      period.GetStatsForPeriod(Duration::min(), /*with_current_epoch=*/true);
+  EXPECT_EQ(2u, result.Count());
+  EXPECT_EQ(3u, result.GetPercentile(100));
+}
+
+USERVER_NAMESPACE_END
@@ -1,12 +1,17 @@
 #include <userver/utils/statistics/storage.hpp>
 
+#include <algorithm>
+#include <cstdint>
 #include <utility>
 
 #include <userver/formats/common/utils.hpp>
 #include <userver/logging/log.hpp>
 #include <userver/utils/assert.hpp>
+#include <userver/utils/statistics/metadata.hpp>
 #include <userver/utils/text.hpp>
+#include <utils/statistics/metadata_keys.hpp>
 #include <utils/statistics/value_builder_helpers.hpp>
+#include <utils/statistics/writer_state.hpp>
 
 #include <utils/statistics/entry_impl.hpp>
 
@@ -21,6 +26,120 @@ constexpr int kVersion = 2;
 
 namespace utils::statistics {
 
+namespace {
+
+bool IsRequested(const impl::MetricsSource& source,
+                 const StatisticsRequest& request) {
+  return utils::text::StartsWith(source.prefix_path, request.prefix) ||
+         utils::text::StartsWith(request.prefix, source.prefix_path);
+}
+
+void SetMetric(formats::json::ValueBuilder& node, std::string_view path,
+               const LabelView* labels_begin, const LabelView* labels_end,
+               const MetricValue& value) {
+  if (!path.empty()) {
+    const auto segment = path.substr(0, path.find('.'));
+    path.remove_prefix(std::min(path.size(), segment.size() + 1));
+    auto child = node[std::string{segment}];
+    SetMetric(child, path, labels_begin, labels_end, value);
+  } else if (labels_begin != labels_end) {
+    SolomonChildrenAreLabelValues(node, std::string{labels_begin->Name()});
+    auto child = node[std::string{labels_begin->Value()}];
+    SetMetric(child, path, labels_begin + 1, labels_end, value);
+  } else {
+    value.Visit([&node](auto x) { node = x; });
+  }
+}
+
+// Puts the metrics of the writers into the JSON of GetAsJson(), labels become
+// the nodes marked with SolomonChildrenAreLabelValues()
+class JsonFormatBuilder final : public BaseFormatBuilder {
+ public:
+  explicit JsonFormatBuilder(formats::json::ValueBuilder& result)
+      : result_(result) {}
+
+  void HandleMetric(std::string_view path, const std::vector<LabelView>& labels,
+                    const MetricValue& value) override {
+    SetMetric(result_, path, labels.data(), labels.data() + labels.size(),
+              value);
+  }
+
+ private:
+  formats::json::ValueBuilder& result_;
+};
+
+void VisitJson(const formats::json::Value& node, impl::WriterState& state);
+
+void VisitJsonChild(const std::string& name, const formats::json::Value& child,
+                    impl::WriterState& state) {
+  const auto meta = child.IsObject() && child.HasMember(impl::kMetadata)
+                        ? child[impl::kMetadata]
+                        : formats::json::Value{};
+
+  if (meta.HasMember(impl::kMetadataSolomonLabel)) {
+    const auto label_name =
+        meta[impl::kMetadataSolomonLabel].As<std::string>();
+    state.labels.emplace_back(label_name, name);
+    VisitJson(child, state);
+    state.labels.pop_back();
+    return;
+  }
+
+  if (meta.HasMember(impl::kMetadataSolomonSkip)) {
+    VisitJson(child, state);
+    return;
+  }
+
+  const auto initial_path_size = state.path.size();
+  if (!state.path.empty()) state.path += '.';
+  if (meta.HasMember(impl::kMetadataSolomonRename)) {
+    state.path += meta[impl::kMetadataSolomonRename].As<std::string>();
+  } else {
+    state.path += name;
+  }
+  VisitJson(child, state);
+  state.path.resize(initial_path_size);
+}
+
+// Passes the metrics of the extenders to the builder applying the Solomon
+// metadata, so that the metrics look the same as if they were written by a
+// Writer
+void VisitJson(const formats::json::Value& node, impl::WriterState& state) {
+  if (node.IsBool()) {
+    state.builder.HandleMetric(state.path, state.labels, node.As<bool>());
+  } else if (node.IsInt64()) {
+    state.builder.HandleMetric(state.path, state.labels,
+                               node.As<std::int64_t>());
+  } else if (node.IsUInt64()) {
+    state.builder.HandleMetric(state.path, state.labels,
+                               node.As<std::uint64_t>());
+  } else if (node.IsDouble()) {
+    state.builder.HandleMetric(state.path, state.labels, node.As<double>());
+  } else if (node.IsObject()) {
+    std::string children_label;
+    if (node.HasMember(impl::kMetadata)) {
+      const auto meta = node[impl::kMetadata];
+      children_label =
+          meta[impl::kMetadataSolomonChildrenLabels].As<std::string>({});
+    }
+
+    for (auto it = node.begin(); it != node.end(); ++it) {
+      const auto name = it.GetName();
+      if (name == impl::kMetadata || name == kVersionField) continue;
+
+      if (children_label.empty()) {
+        VisitJsonChild(name, *it, state);
+      } else {
+        state.labels.emplace_back(children_label, name);
+        VisitJson(*it, state);
+        state.labels.pop_back();
+      }
+    }
+  }
+}
+
+}  // namespace
+
 Storage::Storage() : may_register_extenders_(true) {}
 
 formats::json::ValueBuilder Storage::GetAsJson(
@@ -31,17 +150,56 @@ formats::json::ValueBuilder Storage::GetAsJson(
   std::shared_lock lock(mutex_);
 
   for (const auto& entry : metrics_sources_) {
-    if (utils::text::StartsWith(entry.prefix_path, request.prefix) ||
-        utils::text::StartsWith(request.prefix, entry.prefix_path)) {
+    if (IsRequested(entry, request)) {
       LOG_DEBUG() << "Getting statistics for prefix=" << entry.prefix_path;
-      SetSubField(result, std::vector(entry.path_segments),
-                  entry.extender(request));
+      if (entry.writer) {
+        JsonFormatBuilder builder{result};
+        std::vector<LabelView> labels(entry.labels.begin(),
+                                      entry.labels.end());
+        impl::WriterState state{builder, entry.prefix_path, std::move(labels)};
+        Writer writer{state};
+        entry.writer(writer);
+      } else {
+        SetSubField(result, std::vector(entry.path_segments),
+                    entry.extender(request));
+      }
     }
   }
 
   return result;
 }
 
+void Storage::VisitMetrics(BaseFormatBuilder& out,
+                           const StatisticsRequest& request) const {
+  impl::WriterState state{out, {}, {}};
+
+  std::shared_lock lock(mutex_);
+
+  for (const auto& entry : metrics_sources_) {
+    if (!IsRequested(entry, request)) continue;
+    LOG_DEBUG() << "Visiting statistics for prefix=" << entry.prefix_path;
+
+    state.path = entry.prefix_path;
+    state.labels.clear();
+    for (const auto& label : entry.labels) state.labels.emplace_back(label);
+    if (entry.writer) {
+      Writer writer{state};
+      entry.writer(writer);
+    } else if (entry.path_segments.empty()) {
+      // The JSON of a single extender is alive only during its own visit
+      VisitJson(entry.extender(request).ExtractValue(), state);
+    } else {
+      // The metadata of the extender root applies to the last segment of its
+      // path, e.g. "cache.<name>" of a cache becomes "cache" with the
+      // cache_name label
+      state.path = JoinPath(
+          {entry.path_segments.begin(), entry.path_segments.end() - 1});
+      VisitJsonChild(entry.path_segments.back(),
+                     entry.extender(request).ExtractValue(), state);
+    }
+  }
+}
+
 void Storage::StopRegisteringExtenders() { may_register_extenders_ = false; }
 
 Entry Storage::RegisterExtender(std::string prefix, ExtenderFunc func) {
@@ -62,6 +220,14 @@ Entry Storage::RegisterExtender(std::initializer_list<std::string> prefix,
   return RegisterExtender(std::vector(prefix), std::move(func));
 }
 
+Entry Storage::RegisterWriter(std::string prefix, WriterFunc func,
+                              std::vector<Label> add_labels) {
+  auto prefix_split = formats::common::SplitPathString(prefix);
+  return DoRegisterExtender(impl::MetricsSource{
+      std::move(prefix), std::move(prefix_split), ExtenderFunc{},
+      std::move(func), std::move(add_labels)});
+}
+
 Entry Storage::DoRegisterExtender(impl::MetricsSource&& source) {
   UASSERT_MSG(may_register_extenders_.load(),
               "You may not register statistics extender outside of component "
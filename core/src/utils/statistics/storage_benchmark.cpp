@@ -0,0 +1,87 @@
+#include <userver/utils/statistics/storage.hpp>
+
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <userver/engine/run_standalone.hpp>
+#include <userver/formats/json/serialize.hpp>
+#include <userver/utils/statistics/prometheus.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr std::size_t kComponentsCount = 100;
+
+std::vector<utils::statistics::Entry> RegisterExtenders(
+    utils::statistics::Storage& storage, std::size_t metrics_per_component) {
+  std::vector<utils::statistics::Entry> holders;
+  for (std::size_t i = 0; i < kComponentsCount; ++i) {
+    holders.push_back(storage.RegisterExtender(
+        "component" + std::to_string(i), [metrics_per_component](const auto&) {
+          formats::json::ValueBuilder result;
+          for (std::size_t j = 0; j < metrics_per_component; ++j) {
+            result["metric" + std::to_string(j)]["value"] = j;
+          }
+          return result;
+        }));
+  }
+  return holders;
+}
+
+std::vector<utils::statistics::Entry> RegisterWriters(
+    utils::statistics::Storage& storage, std::size_t metrics_per_component) {
+  std::vector<utils::statistics::Entry> holders;
+  for (std::size_t i = 0; i < kComponentsCount; ++i) {
+    holders.push_back(storage.RegisterWriter(
+        "component" + std::to_string(i), [metrics_per_component](auto& writer) {
+          for (std::size_t j = 0; j < metrics_per_component; ++j) {
+            writer["metric" + std::to_string(j)]["value"] = j;
+          }
+        }));
+  }
+  return holders;
+}
+
+}  // namespace
+
+// The JSON of the whole metrics tree is built and serialized
+void statistics_json(benchmark::State& state) {
+  engine::RunStandalone([&] {
+    utils::statistics::Storage storage;
+    const auto holders = RegisterExtenders(storage, state.range(0));
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(
+          formats::json::ToString(storage.GetAsJson({}).ExtractValue()));
+    }
+  });
+}
+BENCHMARK(statistics_json)->Range(10, 2000);
+
+// The JSON is built per extender and converted to Prometheus format
+void statistics_prometheus_extenders(benchmark::State& state) {
+  engine::RunStandalone([&] {
+    utils::statistics::Storage storage;
+    const auto holders = RegisterExtenders(storage, state.range(0));
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(utils::statistics::ToPrometheusFormat(storage));
+    }
+  });
+}
+BENCHMARK(statistics_prometheus_extenders)->Range(10, 2000);
+
+// Metrics go directly into the Prometheus format, no JSON at all
+void statistics_prometheus_writers(benchmark::State& state) {
+  engine::RunStandalone([&] {
+    utils::statistics::Storage storage;
+    const auto holders = RegisterWriters(storage, state.range(0));
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(utils::statistics::ToPrometheusFormat(storage));
+    }
+  });
+}
+BENCHMARK(statistics_prometheus_writers)->Range(10, 2000);
+
+USERVER_NAMESPACE_END
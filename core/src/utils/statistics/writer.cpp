@@ -0,0 +1,45 @@
+#include <userver/utils/statistics/writer.hpp>
+
+#include <utils/statistics/writer_state.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::statistics {
+
+BaseFormatBuilder::~BaseFormatBuilder() = default;
+
+Writer::Writer(impl::WriterState& state) noexcept
+    : state_(state), initial_path_size_(state.path.size()) {}
+
+Writer::Writer(impl::WriterState& state, std::string_view path)
+    : state_(state), initial_path_size_(state.path.size()) {
+  if (!state_.path.empty()) state_.path += '.';
+  state_.path += path;
+}
+
+Writer::~Writer() { state_.path.resize(initial_path_size_); }
+
+Writer Writer::operator[](std::string_view path) {
+  return Writer{state_, path};
+}
+
+void Writer::ValueWithLabels(MetricValue value,
+                             std::initializer_list<LabelView> labels) {
+  const auto initial_labels_size = state_.labels.size();
+  state_.labels.insert(state_.labels.end(), labels.begin(), labels.end());
+  state_.builder.HandleMetric(state_.path, state_.labels, value);
+  state_.labels.erase(state_.labels.begin() + initial_labels_size,
+                      state_.labels.end());
+}
+
+void Writer::ValueWithLabels(MetricValue value, LabelView label) {
+  ValueWithLabels(value, {label});
+}
+
+void Writer::Write(MetricValue value) {
+  state_.builder.HandleMetric(state_.path, state_.labels, value);
+}
+
+}  // namespace utils::statistics
+
+USERVER_NAMESPACE_END
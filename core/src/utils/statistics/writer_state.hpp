@@ -0,0 +1,23 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <userver/utils/statistics/base_format_builder.hpp>
+#include <userver/utils/statistics/labels.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::statistics::impl {
+
+// Shared by all the writers of a single VisitMetrics() call. Writers append
+// their path segments and labels and truncate them back on destruction.
+struct WriterState final {
+  BaseFormatBuilder& builder;
+  std::string path;
+  std::vector<LabelView> labels;
+};
+
+}  // namespace utils::statistics::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,186 @@
+#include <userver/utils/statistics/writer.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <string>
+
+#include <userver/formats/json/value_builder.hpp>
+#include <userver/utest/utest.hpp>
+#include <userver/utils/mock_now.hpp>
+#include <userver/utils/statistics/graphite.hpp>
+#include <userver/utils/statistics/metadata.hpp>
+#include <userver/utils/statistics/prometheus.hpp>
+#include <userver/utils/statistics/relaxed_counter.hpp>
+#include <userver/utils/statistics/storage.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+struct ComponentStats {
+  std::atomic<int> hits{3};
+  utils::statistics::RelaxedCounter<unsigned> misses{2};
+  double load = 0.5;
+};
+
+void DumpMetric(utils::statistics::Writer& writer,
+                const ComponentStats& stats) {
+  writer["hits"] = stats.hits;
+  writer["misses"] = stats.misses;
+  writer["load"] = stats.load;
+  writer["by-code"].ValueWithLabels(1, {"code", "200"});
+}
+
+}  // namespace
+
+UTEST(StatisticsWriter, Prometheus) {
+  utils::statistics::Storage storage;
+  ComponentStats stats;
+  const auto holder = storage.RegisterWriter(
+      "component", [&stats](auto& writer) { writer["cache"] = stats; },
+      {{"name", "main"}});
+
+  EXPECT_EQ(utils::statistics::ToPrometheusFormat(storage),
+            "component_cache_hits{name=\"main\"} 3\n"
+            "component_cache_misses{name=\"main\"} 2\n"
+            "component_cache_load{name=\"main\"} 0.5\n"
+            "component_cache_by_code{name=\"main\",code=\"200\"} 1\n");
+
+  EXPECT_EQ(utils::statistics::ToPrometheusFormat(storage, {"other"}), "");
+}
+
+UTEST(StatisticsWriter, OpenMetrics) {
+  utils::statistics::Storage storage;
+  const auto holder = storage.RegisterWriter("a", [](auto& writer) {
+    writer.ValueWithLabels(1, {"label", "x\"y"});
+    writer.ValueWithLabels(2, {"label", "z"});
+    writer["1b"] = 3;
+  });
+
+  EXPECT_EQ(utils::statistics::ToOpenMetricsFormat(storage),
+            "# TYPE a unknown\n"
+            "a{label=\"x\\\"y\"} 1\n"
+            "a{label=\"z\"} 2\n"
+            "# TYPE a_1b unknown\n"
+            "a_1b 3\n"
+            "# EOF\n");
+}
+
+UTEST(StatisticsWriter, PrometheusInterleavedFamilies) {
+  utils::statistics::Storage storage;
+  const auto holder_a = storage.RegisterWriter("x", [](auto& writer) {
+    writer["a"].ValueWithLabels(1, {"source", "1"});
+    writer["b"].ValueWithLabels(2, {"source", "1"});
+    writer["c"].ValueWithLabels(3, {"source", "1"});
+  });
+  const auto holder_b = storage.RegisterWriter("x", [](auto& writer) {
+    writer["c"].ValueWithLabels(4, {"source", "2"});
+    writer["a"].ValueWithLabels(5, {"source", "2"});
+    writer["d"].ValueWithLabels(6, {"source", "2"});
+    writer["a"].ValueWithLabels(7, {"source", "3"});
+  });
+
+  EXPECT_EQ(utils::statistics::ToOpenMetricsFormat(storage),
+            "# TYPE x_a unknown\n"
+            "x_a{source=\"1\"} 1\n"
+            "x_a{source=\"2\"} 5\n"
+            "x_a{source=\"3\"} 7\n"
+            "# TYPE x_b unknown\n"
+            "x_b{source=\"1\"} 2\n"
+            "# TYPE x_c unknown\n"
+            "x_c{source=\"1\"} 3\n"
+            "x_c{source=\"2\"} 4\n"
+            "# TYPE x_d unknown\n"
+            "x_d{source=\"2\"} 6\n"
+            "# EOF\n");
+}
+
+UTEST(StatisticsWriter, UnsignedSaturation) {
+  utils::statistics::Storage storage;
+  const auto holder = storage.RegisterWriter("a", [](auto& writer) {
+    writer["max"] = std::numeric_limits<std::uint64_t>::max();
+    writer["small"] = std::uint64_t{42};
+  });
+
+  EXPECT_EQ(utils::statistics::ToPrometheusFormat(storage),
+            "a_max 9223372036854775807\n"
+            "a_small 42\n");
+}
+
+UTEST(StatisticsWriter, Graphite) {
+  utils::datetime::MockNowSet(std::chrono::system_clock::time_point{} +
+                              std::chrono::seconds{1234});
+  utils::statistics::Storage storage;
+  const auto holder = storage.RegisterWriter("a.b", [](auto& writer) {
+    writer["c d"].ValueWithLabels(1.5, {"tag", "v;al"});
+  });
+
+  EXPECT_EQ(utils::statistics::ToGraphiteFormat(storage),
+            "a.b.c_d;tag=v_al 1.5 1234\n");
+  utils::datetime::MockNowUnset();
+}
+
+UTEST(StatisticsWriter, LegacyExtenders) {
+  utils::statistics::Storage storage;
+  const auto holder = storage.RegisterExtender("legacy", [](const auto&) {
+    formats::json::ValueBuilder result;
+    result["skipped"]["value"] = 1;
+    utils::statistics::SolomonSkip(result["skipped"]);
+    result["renamed"]["value"] = 2;
+    utils::statistics::SolomonRename(result["renamed"], "new");
+    result["by-db"]["db1"]["value"] = 3;
+    utils::statistics::SolomonChildrenAreLabelValues(result["by-db"], "db");
+    result["host1"]["value"] = 4;
+    utils::statistics::SolomonLabelValue(result["host1"], "host");
+    result["text"] = "not a metric";
+    return result;
+  });
+
+  EXPECT_EQ(utils::statistics::ToPrometheusFormat(storage),
+            "legacy_value 1\n"
+            "legacy_value{host=\"host1\"} 4\n"
+            "legacy_new_value 2\n"
+            "legacy_by_db_value{db=\"db1\"} 3\n");
+}
+
+UTEST(StatisticsWriter, LegacyExtenderRootLabel) {
+  // Shaped as the statistics of the caches
+  const auto extender = [](const auto&) {
+    formats::json::ValueBuilder result;
+    utils::statistics::SolomonLabelValue(result, "cache_name");
+    result["full"]["documents"] = 1;
+    result["any"]["documents"] = 2;
+    return result;
+  };
+
+  utils::statistics::Storage storage;
+  const auto holder_a = storage.RegisterExtender("cache.a", extender);
+  const auto holder_b = storage.RegisterExtender("cache.b", extender);
+
+  EXPECT_EQ(utils::statistics::ToOpenMetricsFormat(storage),
+            "# TYPE cache_full_documents unknown\n"
+            "cache_full_documents{cache_name=\"a\"} 1\n"
+            "cache_full_documents{cache_name=\"b\"} 1\n"
+            "# TYPE cache_any_documents unknown\n"
+            "cache_any_documents{cache_name=\"a\"} 2\n"
+            "cache_any_documents{cache_name=\"b\"} 2\n"
+            "# EOF\n");
+}
+
+UTEST(StatisticsWriter, GetAsJson) {
+  utils::statistics::Storage storage;
+  const auto holder = storage.RegisterWriter("a", [](auto& writer) {
+    writer["b"] = 1;
+    writer["c"].ValueWithLabels(2, {"label", "x"});
+  });
+
+  const auto json = storage.GetAsJson({}).ExtractValue();
+  EXPECT_EQ(json["a"]["b"].As<int>(), 1);
+  EXPECT_EQ(json["a"]["c"]["x"].As<int>(), 2);
+  EXPECT_EQ(
+      json["a"]["c"]["$meta"]["solomon_children_labels"].As<std::string>(),
+      "label");
+}
+
+USERVER_NAMESPACE_END
@@ -4,6 +4,7 @@
 
 #include <fmt/format.h>
 
+#include <chrono>
 #include <cstdint>
 #include <cstdlib>
 #include <vector>
@@ -11,7 +12,6 @@
 #include <userver/engine/async.hpp>
 #include <userver/engine/io/sockaddr.hpp>
 #include <userver/engine/task/cancel.hpp>
-#include <userver/utest/utest.hpp>
 #include <userver/utils/assert.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -21,6 +21,10 @@ namespace {
 
 constexpr size_t kMaxMessageSize = 16 * 1024;
 
+// Same as utest::kMaxTestWaitTime, the mock is also linked into the
+// benchmarks that have no gtest
+constexpr std::chrono::seconds kMaxWaitTime{20};
+
 // For details on DNS message format see RFC1035
 // https://datatracker.ietf.org/doc/html/rfc1035
 
@@ -241,7 +245,7 @@ void DnsServerMock::ProcessRequests() {
 
   while (!engine::current_task::ShouldCancel()) {
     const auto iter_deadline =
-        engine::Deadline::FromDuration(utest::kMaxTestWaitTime);
+        engine::Deadline::FromDuration(kMaxWaitTime);
     const auto recv_result = listener_.socket.RecvSomeFrom(
         buffer.data(), buffer.size(), iter_deadline);
     size_t response_size = 0;
@@ -11,8 +11,9 @@ std::shared_ptr<clients::http::Client> CreateHttpClient() {
 }
 std::shared_ptr<clients::http::Client> CreateHttpClient(
     engine::TaskProcessor& fs_task_processor) {
-  return std::make_shared<clients::http::Client>(
-      clients::http::ClientSettings{"", 1, false}, fs_task_processor);
+  clients::http::ClientSettings settings;
+  settings.io_threads = 1;
+  return std::make_shared<clients::http::Client>(settings, fs_task_processor);
 }
 
 }  // namespace utest
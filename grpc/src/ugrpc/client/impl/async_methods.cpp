@@ -31,6 +31,8 @@ void SetupSpan(std::optional<tracing::InPlaceSpan>& span_holder,
                       ugrpc::impl::ToGrpcString(span.GetSpanId()));
   context.AddMetadata(ugrpc::impl::kXYaRequestId,
                       ugrpc::impl::ToGrpcString(span.GetLink()));
+  context.AddMetadata(ugrpc::impl::kXYaTraceSampled,
+                      span.IsSampled() ? "1" : "0");
 }
 
 void SetErrorForSpan(RpcData& data, std::string&& message) {
@@ -7,6 +7,7 @@ namespace ugrpc::impl {
 const grpc::string kXYaTraceId = "x-yatraceid";
 const grpc::string kXYaSpanId = "x-yaspanid";
 const grpc::string kXYaRequestId = "x-yarequestid";
+const grpc::string kXYaTraceSampled = "x-yatracesampled";
 
 }  // namespace ugrpc::impl
 
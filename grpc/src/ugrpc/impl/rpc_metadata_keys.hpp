@@ -11,6 +11,7 @@ namespace ugrpc::impl {
 extern const grpc::string kXYaTraceId;
 extern const grpc::string kXYaSpanId;
 extern const grpc::string kXYaRequestId;
+extern const grpc::string kXYaTraceSampled;
 
 }  // namespace ugrpc::impl
 
@@ -50,6 +50,12 @@ void SetupSpan(std::optional<tracing::InPlaceSpan>& span_holder,
     span.SetParentLink(ugrpc::impl::ToString(*parent_link));
   }
 
+  const auto* const sampled =
+      utils::FindOrNullptr(client_metadata, ugrpc::impl::kXYaTraceSampled);
+  if (sampled) {
+    span.SetSampled(*sampled != "0");
+  }
+
   context.AddInitialMetadata(ugrpc::impl::kXYaTraceId,
                              ugrpc::impl::ToGrpcString(span.GetTraceId()));
   context.AddInitialMetadata(ugrpc::impl::kXYaSpanId,
@@ -8,10 +8,10 @@
 
 #include <userver/storages/postgres/detail/time_types.hpp>
 
+#include <userver/utils/statistics/hdr_histogram.hpp>
 #include <userver/utils/statistics/min_max_avg.hpp>
-#include <userver/utils/statistics/percentile.hpp>
 #include <userver/utils/statistics/recentperiod.hpp>
-#include <userver/utils/statistics/relaxed_counter.hpp>
+#include <userver/utils/statistics/sharded_counter.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -118,10 +118,10 @@ struct InstanceStatisticsTemplate {
   PercentileAccumulator acquire_percentile;
 };
 
-using Percentile = USERVER_NAMESPACE::utils::statistics::Percentile<2048>;
+using Percentile = USERVER_NAMESPACE::utils::statistics::HdrHistogram<>;
 using MinMaxAvg = USERVER_NAMESPACE::utils::statistics::MinMaxAvg<uint32_t>;
 using InstanceStatistics = InstanceStatisticsTemplate<
-    USERVER_NAMESPACE::utils::statistics::RelaxedCounter<uint32_t>,
+    USERVER_NAMESPACE::utils::statistics::ShardedCounter<uint32_t>,
     USERVER_NAMESPACE::utils::statistics::RecentPeriod<Percentile, Percentile,
                                                        detail::SteadyClock>,
     USERVER_NAMESPACE::utils::statistics::RecentPeriod<MinMaxAvg, MinMaxAvg,
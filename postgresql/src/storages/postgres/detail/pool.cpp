@@ -199,8 +199,8 @@ void ConnectionPool::AccountConnectionStats(Connection::Statistics conn_stats) {
 
 void ConnectionPool::Release(Connection* connection) {
   UASSERT(connection);
-  using DecGuard = USERVER_NAMESPACE::utils::SizeGuard<
-      USERVER_NAMESPACE::utils::statistics::RelaxedCounter<uint32_t>>;
+  using DecGuard =
+      USERVER_NAMESPACE::utils::SizeGuard<decltype(stats_.connection.used)>;
   DecGuard dg{stats_.connection.used, DecGuard::DontIncrement{}};
 
   // Grab stats only if connection is not in transaction
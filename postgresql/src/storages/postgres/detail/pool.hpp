@@ -15,6 +15,7 @@
 #include <userver/rcu/rcu.hpp>
 #include <userver/testsuite/postgres_control.hpp>
 #include <userver/utils/periodic_task.hpp>
+#include <userver/utils/statistics/relaxed_counter.hpp>
 #include <userver/utils/token_bucket.hpp>
 #include <utils/size_guard.hpp>
 
@@ -9,7 +9,7 @@
 
 #include <userver/storages/redis/impl/command.hpp>
 #include <userver/utils/statistics/aggregated_values.hpp>
-#include <userver/utils/statistics/percentile.hpp>
+#include <userver/utils/statistics/hdr_histogram.hpp>
 #include <userver/utils/statistics/recentperiod.hpp>
 #include "redis_state.hpp"
 
@@ -33,7 +33,7 @@ class Statistics {
   void AccountPing(std::chrono::milliseconds ping);
   void AccountError(int code);
 
-  using Percentile = utils::statistics::Percentile<2048>;
+  using Percentile = utils::statistics::HdrHistogram<>;
 
   std::atomic<RedisState> state{RedisState::kInit};
   std::atomic_llong reconnects{0};
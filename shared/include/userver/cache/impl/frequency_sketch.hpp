@@ -0,0 +1,95 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace cache::impl {
+
+/// Count-min sketch of the access frequencies with saturating 4-bit counters,
+/// counters are halved periodically so the old accesses fade out.
+class FrequencySketch final {
+ public:
+  explicit FrequencySketch(std::size_t capacity) { Resize(capacity); }
+
+  /// Resets the counters
+  void Resize(std::size_t capacity) {
+    capacity = std::max(capacity, kMinCapacity);
+    std::size_t width = 1;
+    while (width < capacity * kCountersPerItem) width *= 2;
+
+    // two counters per byte
+    counters_.assign(width * kDepth / 2, 0);
+    width_mask_ = width - 1;
+    additions_ = 0;
+    sample_size_ = capacity * kSampleSizeMultiplier;
+  }
+
+  void RecordAccess(std::size_t hash) noexcept {
+    const auto [h1, h2] = Mix(hash);
+    bool is_added = false;
+    for (std::size_t row = 0; row < kDepth; ++row) {
+      is_added |= Increment(GetIndex(h1, h2, row));
+    }
+    if (is_added && ++additions_ >= sample_size_) Age();
+  }
+
+  std::uint8_t GetFrequency(std::size_t hash) const noexcept {
+    const auto [h1, h2] = Mix(hash);
+    std::uint8_t result = kMaxFrequency;
+    for (std::size_t row = 0; row < kDepth; ++row) {
+      result = std::min(result, GetCounter(GetIndex(h1, h2, row)));
+    }
+    return result;
+  }
+
+ private:
+  static constexpr std::size_t kDepth = 4;
+  static constexpr std::size_t kCountersPerItem = 2;
+  static constexpr std::size_t kMinCapacity = 16;
+  static constexpr std::size_t kSampleSizeMultiplier = 10;
+  static constexpr std::uint8_t kMaxFrequency = 15;
+
+  // std::hash is identity for integers, spread the bits (splitmix64)
+  static std::pair<std::uint64_t, std::uint64_t> Mix(
+      std::size_t hash) noexcept {
+    std::uint64_t h = static_cast<std::uint64_t>(hash) + 0x9e3779b97f4a7c15ULL;
+    h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    h = (h ^ (h >> 27)) * 0x94d049bb133111ebULL;
+    h ^= h >> 31;
+    return {h, (h >> 32) | 1};
+  }
+
+  std::size_t GetIndex(std::uint64_t h1, std::uint64_t h2,
+                       std::size_t row) const noexcept {
+    return row * (width_mask_ + 1) + ((h1 + row * h2) & width_mask_);
+  }
+
+  std::uint8_t GetCounter(std::size_t index) const noexcept {
+    return (counters_[index / 2] >> (index % 2 * 4)) & kMaxFrequency;
+  }
+
+  bool Increment(std::size_t index) noexcept {
+    if (GetCounter(index) == kMaxFrequency) return false;
+    counters_[index / 2] += 1 << (index % 2 * 4);
+    return true;
+  }
+
+  void Age() noexcept {
+    for (auto& counters : counters_) counters = (counters >> 1) & 0x77;
+    additions_ /= 2;
+  }
+
+  std::vector<std::uint8_t> counters_;
+  std::size_t width_mask_{0};
+  std::size_t additions_{0};
+  std::size_t sample_size_{0};
+};
+
+}  // namespace cache::impl
+
+USERVER_NAMESPACE_END
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <memory>
+#include <type_traits>
 #include <vector>
 
 #include <boost/intrusive/link_mode.hpp>
@@ -8,6 +10,9 @@
 #include <boost/intrusive/unordered_set.hpp>
 #include <boost/intrusive/unordered_set_hook.hpp>
 
+#include <userver/cache/impl/frequency_sketch.hpp>
+#include <userver/cache/policy.hpp>
+#include <userver/cache/weight.hpp>
 #include <userver/utils/assert.hpp>
 #include <userver/utils/impl/intrusive_link_mode.hpp>
 
@@ -37,9 +42,19 @@ class LruNode final : public LruListHook, public LruHashSetHook {
   const Value& GetValue() const noexcept { return value_; }
   Value& GetValue() noexcept { return value_; }
 
+  bool IsInWindow() const noexcept { return is_in_window_; }
+  void SetInWindow(bool is_in_window) noexcept {
+    is_in_window_ = is_in_window;
+  }
+
+  size_t GetWeight() const noexcept { return weight_; }
+  void SetWeight(size_t weight) noexcept { weight_ = weight; }
+
  private:
   Key key_;
   Value value_;
+  size_t weight_{0};
+  bool is_in_window_{false};
 };
 
 template <class Key>
@@ -61,8 +76,18 @@ class LruNode<Key, EmptyPlaceholder> final : public LruListHook,
     return kValue;
   }
 
+  bool IsInWindow() const noexcept { return is_in_window_; }
+  void SetInWindow(bool is_in_window) noexcept {
+    is_in_window_ = is_in_window;
+  }
+
+  size_t GetWeight() const noexcept { return weight_; }
+  void SetWeight(size_t weight) noexcept { weight_ = weight; }
+
  private:
   Key key_;
+  size_t weight_{0};
+  bool is_in_window_{false};
 };
 
 template <class Key, class Value>
@@ -79,16 +104,27 @@ template <typename T, typename U, typename Hash = std::hash<T>,
           typename Equal = std::equal_to<T>>
 class LruBase final {
  public:
-  explicit LruBase(size_t max_size, const Hash& hash, const Equal& equal);
+  explicit LruBase(size_t max_size, const Hash& hash, const Equal& equal,
+                   CachePolicy policy = CachePolicy::kLRU);
   ~LruBase() { Clear(); }
 
   LruBase(LruBase&& other) noexcept
       : buckets_(std::move(other.buckets_)),
         map_(std::move(other.map_)),
-        list_(std::move(other.list_)) {
+        list_(std::move(other.list_)),
+        window_(std::move(other.window_)),
+        window_size_(other.window_size_),
+        window_max_size_(other.window_max_size_),
+        sketch_(std::move(other.sketch_)),
+        weight_(other.weight_),
+        max_weight_(other.max_weight_),
+        evicted_weight_(other.evicted_weight_) {
     other.buckets_.clear();
     other.map_.clear();
     other.list_.clear();
+    other.window_.clear();
+    other.window_size_ = 0;
+    other.weight_ = 0;
   }
 
   LruBase& operator=(LruBase&& other) noexcept {
@@ -97,6 +133,13 @@ class LruBase final {
     swap(other.buckets_, buckets_);
     swap(other.map_, map_);
     swap(other.list_, list_);
+    swap(other.window_, window_);
+    std::swap(other.window_size_, window_size_);
+    std::swap(other.window_max_size_, window_max_size_);
+    swap(other.sketch_, sketch_);
+    std::swap(other.weight_, weight_);
+    std::swap(other.max_weight_, max_weight_);
+    std::swap(other.evicted_weight_, evicted_weight_);
 
     return *this;
   }
@@ -119,6 +162,16 @@ class LruBase final {
 
   void SetMaxSize(size_t new_max_size);
 
+  void SetPolicy(CachePolicy policy);
+
+  CachePolicy GetPolicy() const noexcept;
+
+  void SetMaxWeight(size_t new_max_weight);
+
+  size_t GetWeight() const noexcept { return weight_; }
+
+  size_t GetEvictedWeight() const noexcept { return evicted_weight_; }
+
   void Clear() noexcept;
 
   template <typename Function>
@@ -162,28 +215,57 @@ class LruBase final {
 
   U& Add(const T& key, U value);
   void MarkRecentlyUsed(Node& node) noexcept;
-  std::unique_ptr<Node> ExtractNode(typename List::iterator it) noexcept;
+  std::unique_ptr<Node> Evict(Node& node) noexcept;
+  void EvictOverweight(size_t extra_weight) noexcept;
+  size_t Weigh(const T& key, const U& value) const;
+  std::unique_ptr<Node> ExtractNode(Node& node) noexcept;
   Node& InsertNode(std::unique_ptr<Node>&& node) noexcept;
 
+  // W-TinyLFU helpers
+  List& GetList(Node& node) noexcept;
+  Node& SelectVictim() noexcept;
+  void RecordAccess(const T& key) noexcept;
+  size_t GetFrequency(const Node& node) const noexcept;
+  void UpdateWindowMaxSize() noexcept;
+  void ShrinkWindow() noexcept;
+
   std::vector<BucketType> buckets_;
   Map map_;
+  // main segment, the only one for CachePolicy::kLRU
   List list_;
+  // W-TinyLFU window segment
+  List window_;
+  // window_ does not track its size
+  size_t window_size_{0};
+  size_t window_max_size_{0};
+  // set for CachePolicy::kWTinyLFU only
+  std::unique_ptr<FrequencySketch> sketch_;
+  // weights are computed only if max_weight_ is set
+  size_t weight_{0};
+  size_t max_weight_{0};
+  size_t evicted_weight_{0};
 };
 
 template <typename T, typename U, typename Hash, typename Equal>
 LruBase<T, U, Hash, Equal>::LruBase(size_t max_size, const Hash& hash,
-                                    const Equal& eq)
+                                    const Equal& eq, CachePolicy policy)
     : buckets_(max_size ? max_size : 1),
       map_(BucketTraits(buckets_.data(), buckets_.size()), hash, eq) {
   UASSERT(max_size > 0);
+  SetPolicy(policy);
 }
 
 template <typename T, typename U, typename Hash, typename Eq>
 bool LruBase<T, U, Hash, Eq>::Put(const T& key, U value) {
+  RecordAccess(key);
   auto it = map_.find(key, map_.hash_function(), map_.key_eq());
   if (it != map_.end()) {
+    const auto weight = Weigh(key, value);
+    weight_ = weight_ - it->GetWeight() + weight;
+    it->SetWeight(weight);
     it->SetValue(std::move(value));
     MarkRecentlyUsed(*it);
+    EvictOverweight(0);
     return false;
   }
 
@@ -203,11 +285,12 @@ template <typename T, typename U, typename Hash, typename Eq>
 void LruBase<T, U, Hash, Eq>::Erase(const T& key) {
   auto it = map_.find(key, map_.hash_function(), map_.key_eq());
   if (it == map_.end()) return;
-  ExtractNode(list_.iterator_to(*it));
+  ExtractNode(*it);
 }
 
 template <typename T, typename U, typename Hash, typename Eq>
 U* LruBase<T, U, Hash, Eq>::Get(const T& key) {
+  RecordAccess(key);
   auto it = map_.find(key, map_.hash_function(), map_.key_eq());
   if (it == map_.end()) return nullptr;
   MarkRecentlyUsed(*it);
@@ -216,14 +299,14 @@ U* LruBase<T, U, Hash, Eq>::Get(const T& key) {
 
 template <typename T, typename U, typename Hash, typename Eq>
 const T* LruBase<T, U, Hash, Eq>::GetLeastUsedKey() {
-  if (list_.empty()) return nullptr;
-  return &list_.front().GetKey();
+  if (map_.empty()) return nullptr;
+  return &SelectVictim().GetKey();
 }
 
 template <typename T, typename U, typename Hash, typename Eq>
 U* LruBase<T, U, Hash, Eq>::GetLeastUsedValue() {
-  if (list_.empty()) return nullptr;
-  return &list_.front().GetValue();
+  if (map_.empty()) return nullptr;
+  return &SelectVictim().GetValue();
 }
 
 template <typename T, typename U, typename Hash, typename Eq>
@@ -236,18 +319,68 @@ void LruBase<T, U, Hash, Eq>::SetMaxSize(size_t new_max_size) {
   }
 
   while (map_.size() > new_max_size) {
-    ExtractNode(list_.begin());
+    Evict(SelectVictim());
   }
 
   std::vector<BucketType> new_buckets(new_max_size);
   map_.rehash(BucketTraits(new_buckets.data(), new_max_size));
   buckets_.swap(new_buckets);
+
+  if (sketch_) {
+    sketch_->Resize(new_max_size);
+    UpdateWindowMaxSize();
+    ShrinkWindow();
+  }
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+void LruBase<T, U, Hash, Eq>::SetPolicy(CachePolicy policy) {
+  if (policy == GetPolicy()) return;
+
+  switch (policy) {
+    case CachePolicy::kLRU:
+      // window items are the most recent ones
+      for (auto& node : window_) node.SetInWindow(false);
+      list_.splice(list_.end(), window_);
+      window_size_ = 0;
+      window_max_size_ = 0;
+      sketch_.reset();
+      break;
+
+    case CachePolicy::kWTinyLFU:
+      sketch_ = std::make_unique<FrequencySketch>(buckets_.size());
+      UpdateWindowMaxSize();
+      break;
+  }
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+CachePolicy LruBase<T, U, Hash, Eq>::GetPolicy() const noexcept {
+  return sketch_ ? CachePolicy::kWTinyLFU : CachePolicy::kLRU;
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+void LruBase<T, U, Hash, Eq>::SetMaxWeight(size_t new_max_weight) {
+  if (new_max_weight && !max_weight_) {
+    // weights were not tracked
+    max_weight_ = new_max_weight;
+    weight_ = 0;
+    for (auto& node : map_) {
+      node.SetWeight(Weigh(node.GetKey(), node.GetValue()));
+      weight_ += node.GetWeight();
+    }
+  }
+  max_weight_ = new_max_weight;
+  EvictOverweight(0);
 }
 
 template <typename T, typename U, typename Hash, typename Eq>
 void LruBase<T, U, Hash, Eq>::Clear() noexcept {
   while (!list_.empty()) {
-    ExtractNode(list_.begin());
+    ExtractNode(list_.front());
+  }
+  while (!window_.empty()) {
+    ExtractNode(window_.front());
   }
 }
 
@@ -274,30 +407,68 @@ size_t LruBase<T, U, Hash, Eq>::GetSize() const {
 
 template <typename T, typename U, typename Hash, typename Eq>
 U& LruBase<T, U, Hash, Eq>::Add(const T& key, U value) {
+  const auto weight = Weigh(key, value);
+  EvictOverweight(weight);
+
+  std::unique_ptr<Node> node;
   if (map_.size() < buckets_.size()) {
-    auto node = std::make_unique<Node>(T(key), std::move(value));
-    return InsertNode(std::move(node)).GetValue();
+    node = std::make_unique<Node>(T(key), std::move(value));
+  } else {
+    node = Evict(SelectVictim());
+    node->SetKey(key);
+    node->SetValue(std::move(value));
   }
 
-  auto node = ExtractNode(list_.begin());
-  node->SetKey(key);
-  node->SetValue(std::move(value));
-  return InsertNode(std::move(node)).GetValue();
+  node->SetWeight(weight);
+  // new items get into the window first
+  node->SetInWindow(window_max_size_ != 0);
+  auto& result = InsertNode(std::move(node)).GetValue();
+  ShrinkWindow();
+  return result;
 }
 
 template <typename T, typename U, typename Hash, typename Eq>
 void LruBase<T, U, Hash, Eq>::MarkRecentlyUsed(Node& node) noexcept {
-  list_.splice(list_.end(), list_, list_.iterator_to(node));
+  auto& list = GetList(node);
+  list.splice(list.end(), list, list.iterator_to(node));
 }
 
 template <typename T, typename U, typename Hash, typename Eq>
-std::unique_ptr<LruNode<T, U>> LruBase<T, U, Hash, Eq>::ExtractNode(
-    typename List::iterator it) noexcept {
-  UASSERT(it != list_.end());
+std::unique_ptr<LruNode<T, U>> LruBase<T, U, Hash, Eq>::Evict(
+    Node& node) noexcept {
+  evicted_weight_ += node.GetWeight();
+  return ExtractNode(node);
+}
 
-  std::unique_ptr<Node> ret(&*it);
-  map_.erase(map_.iterator_to(*it));
-  list_.erase(it);
+// Keeps at least one item, even if it is heavier than the max weight
+template <typename T, typename U, typename Hash, typename Eq>
+void LruBase<T, U, Hash, Eq>::EvictOverweight(size_t extra_weight) noexcept {
+  if (!max_weight_) return;
+  const size_t min_size = extra_weight ? 0 : 1;
+  while (map_.size() > min_size && weight_ + extra_weight > max_weight_) {
+    Evict(SelectVictim());
+  }
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+size_t LruBase<T, U, Hash, Eq>::Weigh(const T& key, const U& value) const {
+  if (!max_weight_) return 0;
+  if constexpr (std::is_same_v<U, EmptyPlaceholder>) {
+    return cache::GetWeight(key);
+  } else {
+    return cache::GetWeight(key) + cache::GetWeight(value);
+  }
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+std::unique_ptr<LruNode<T, U>> LruBase<T, U, Hash, Eq>::ExtractNode(
+    Node& node) noexcept {
+  weight_ -= node.GetWeight();
+  std::unique_ptr<Node> ret(&node);
+  map_.erase(map_.iterator_to(node));
+  auto& list = GetList(node);
+  list.erase(list.iterator_to(node));
+  if (node.IsInWindow()) --window_size_;
   return ret;
 }
 
@@ -308,11 +479,64 @@ LruNode<T, U>& LruBase<T, U, Hash, Eq>::InsertNode(
 
   auto [it, ok] = map_.insert(*node);  // noexcept
   UASSERT(ok);
-  list_.insert(list_.end(), *node);  // noexcept
+  weight_ += node->GetWeight();
+  auto& list = GetList(*node);
+  list.insert(list.end(), *node);  // noexcept
+  if (node->IsInWindow()) ++window_size_;
 
   return *node.release();
 }
 
+template <typename T, typename U, typename Hash, typename Eq>
+typename LruBase<T, U, Hash, Eq>::List& LruBase<T, U, Hash, Eq>::GetList(
+    Node& node) noexcept {
+  return node.IsInWindow() ? window_ : list_;
+}
+
+// With W-TinyLFU the window eviction candidate competes with the main segment
+// one, the less frequently accessed one is evicted. Otherwise the window
+// candidate moves to the main segment on the next insertion.
+template <typename T, typename U, typename Hash, typename Eq>
+LruNode<T, U>& LruBase<T, U, Hash, Eq>::SelectVictim() noexcept {
+  UASSERT(!map_.empty());
+  if (window_.empty()) return list_.front();
+  if (list_.empty()) return window_.front();
+  if (window_size_ < window_max_size_) return list_.front();
+
+  auto& candidate = window_.front();
+  auto& victim = list_.front();
+  return GetFrequency(candidate) > GetFrequency(victim) ? victim : candidate;
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+void LruBase<T, U, Hash, Eq>::RecordAccess(const T& key) noexcept {
+  if (sketch_) sketch_->RecordAccess(map_.hash_function()(key));
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+size_t LruBase<T, U, Hash, Eq>::GetFrequency(const Node& node) const noexcept {
+  UASSERT(sketch_);
+  return sketch_->GetFrequency(map_.hash_function()(node));
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+void LruBase<T, U, Hash, Eq>::UpdateWindowMaxSize() noexcept {
+  // 1% of the capacity, as recommended by the W-TinyLFU authors. Too small
+  // caches have no window and admit the new items unconditionally.
+  window_max_size_ = buckets_.size() < 2 ? 0 : (buckets_.size() + 99) / 100;
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+void LruBase<T, U, Hash, Eq>::ShrinkWindow() noexcept {
+  while (window_size_ > window_max_size_) {
+    auto& node = window_.front();
+    window_.pop_front();
+    --window_size_;
+    node.SetInWindow(false);
+    list_.insert(list_.end(), node);
+  }
+}
+
 }  // namespace cache::impl
 
 USERVER_NAMESPACE_END
@@ -19,8 +19,9 @@ template <typename T, typename U, typename Hash = std::hash<T>,
 class LruMap final {
  public:
   explicit LruMap(size_t max_size, const Hash& hash = Hash(),
-                  const Equal& equal = Equal())
-      : impl_(max_size, hash, equal) {}
+                  const Equal& equal = Equal(),
+                  CachePolicy policy = CachePolicy::kLRU)
+      : impl_(max_size, hash, equal, policy) {}
 
   LruMap(LruMap&& lru) noexcept = default;
   LruMap(const LruMap& lru) = delete;
@@ -65,6 +66,25 @@ class LruMap final {
     return impl_.SetMaxSize(new_max_size);
   }
 
+  /// @brief Limits the total weight of the keys and values, 0 is unlimited.
+  ///
+  /// Weights are computed by cache::GetWeight on Put, so the values must not
+  /// be changed in place in a weighted map.
+  void SetMaxWeight(size_t new_max_weight) {
+    impl_.SetMaxWeight(new_max_weight);
+  }
+
+  /// Total weight of the elements, 0 if the weight is unlimited
+  size_t GetWeight() const { return impl_.GetWeight(); }
+
+  /// Total weight of the elements evicted to make room for the new ones
+  size_t GetEvictedWeight() const { return impl_.GetEvictedWeight(); }
+
+  /// Switches the eviction policy, keeps the elements
+  void SetPolicy(CachePolicy policy) { impl_.SetPolicy(policy); }
+
+  CachePolicy GetPolicy() const { return impl_.GetPolicy(); }
+
   /// Removes all the elements
   void Clear() { return impl_.Clear(); }
 
@@ -17,8 +17,9 @@ template <typename T, typename Hash = std::hash<T>,
 class LruSet final {
  public:
   explicit LruSet(size_t max_size, const Hash& hash = Hash(),
-                  const Equal& equal = Equal())
-      : impl_(max_size, hash, equal) {}
+                  const Equal& equal = Equal(),
+                  CachePolicy policy = CachePolicy::kLRU)
+      : impl_(max_size, hash, equal, policy) {}
 
   LruSet(LruSet&& lru) noexcept = default;
   LruSet(const LruSet& lru) = delete;
@@ -40,6 +41,9 @@ class LruSet final {
     return impl_.SetMaxSize(new_max_size);
   }
 
+  /// Switches the eviction policy, keeps the elements
+  void SetPolicy(CachePolicy policy) { impl_.SetPolicy(policy); }
+
   /// Removes all the elements
   void Invalidate() { return impl_.Invalidate(); }
 
@@ -0,0 +1,27 @@
+#pragma once
+
+/// @file userver/cache/policy.hpp
+/// @brief @copybrief cache::CachePolicy
+
+USERVER_NAMESPACE_BEGIN
+
+namespace cache {
+
+/// Eviction and admission policy of cache::LruMap, cache::LruSet and the
+/// caches built on top of them
+enum class CachePolicy {
+  /// Least recently used item is evicted
+  kLRU,
+
+  /// @brief W-TinyLFU: new items get into a small LRU window, items leaving
+  /// the window are admitted into the main LRU segment only if they are
+  /// accessed more often than the main segment eviction candidate.
+  ///
+  /// Access frequencies are estimated with a count-min sketch. Resistant to
+  /// scans of cold keys, the sketch costs 4 to 8 bytes per item.
+  kWTinyLFU,
+};
+
+}  // namespace cache
+
+USERVER_NAMESPACE_END
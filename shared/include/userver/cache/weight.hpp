@@ -0,0 +1,50 @@
+#pragma once
+
+/// @file userver/cache/weight.hpp
+/// @brief @copybrief cache::GetWeight
+
+#include <cstddef>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <userver/utils/meta.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace cache {
+
+namespace impl {
+
+template <typename T>
+using HasCacheWeight = decltype(GetCacheWeight(std::declval<const T&>()));
+
+}  // namespace impl
+
+/// @brief Approximate memory footprint of a cached key or value in bytes,
+/// used by the weighted cache::LruMap and the caches built on top of it.
+///
+/// Define `std::size_t GetCacheWeight(const T&)` in the namespace of `T` to
+/// customize the weight, otherwise the weight is `sizeof(T)` plus the heap
+/// memory of the standard strings and vectors.
+template <typename T>
+std::size_t GetWeight(const T& value) {
+  if constexpr (meta::kIsDetected<impl::HasCacheWeight, T>) {
+    return GetCacheWeight(value);
+  } else if constexpr (std::is_same_v<T, std::string>) {
+    return sizeof(T) + value.capacity();
+  } else if constexpr (meta::kIsVector<T>) {
+    using Item = typename T::value_type;
+    std::size_t result = sizeof(T) + (value.capacity() - value.size()) *
+                                         sizeof(Item);
+    for (const auto& item : value) result += GetWeight(item);
+    return result;
+  } else {
+    return sizeof(T);
+  }
+}
+
+}  // namespace cache
+
+USERVER_NAMESPACE_END
@@ -5,6 +5,7 @@
 
 #include <iosfwd>
 #include <string_view>
+#include <vector>
 
 #include <fmt/format.h>
 
@@ -25,6 +26,11 @@ formats::json::Value FromString(std::string_view doc);
 /// Parse JSON from stream
 formats::json::Value FromStream(std::istream& is);
 
+/// Parse JSON from a document split into several consecutive pieces without
+/// concatenating them
+formats::json::Value FromStringChunks(
+    const std::vector<std::string_view>& chunks);
+
 /// Serialize JSON to stream
 void Serialize(const formats::json::Value& doc, std::ostream& os);
 
@@ -5,6 +5,7 @@
 
 #include <string_view>
 #include <type_traits>
+#include <vector>
 
 #include <userver/formats/common/items.hpp>
 #include <userver/formats/common/meta.hpp>
@@ -282,6 +283,8 @@ class Value final {
 
   friend formats::json::Value FromString(std::string_view);
   friend formats::json::Value FromStream(std::istream&);
+  friend formats::json::Value FromStringChunks(
+      const std::vector<std::string_view>&);
   friend void Serialize(const formats::json::Value&, std::ostream&);
   friend std::string ToString(const formats::json::Value&);
   friend std::string ToStableString(const formats::json::Value&);
@@ -122,6 +122,8 @@ inline constexpr char kConnection[] = "Connection";
 inline constexpr char kXYaRequestId[] = "X-YaRequestId";
 inline constexpr char kXYaTraceId[] = "X-YaTraceId";
 inline constexpr char kXYaSpanId[] = "X-YaSpanId";
+/// Head-based sampling decision of the trace, "1" or "0"
+inline constexpr char kXYaTraceSampled[] = "X-YaTraceSampled";
 /// @}
 
 /// @name Generic Yandex headers
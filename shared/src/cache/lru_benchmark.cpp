@@ -1,5 +1,9 @@
 #include <benchmark/benchmark.h>
 
+#include <algorithm>
+#include <random>
+#include <vector>
+
 #include <userver/cache/lru_set.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -19,6 +23,38 @@ Lru FillLru(unsigned elements_count) {
   return lru;
 }
 
+constexpr unsigned kKeysCount = 100000;
+constexpr unsigned kTraceSize = 1000000;
+constexpr unsigned kScanLength = 5000;
+constexpr unsigned kScanPeriod = 50000;
+
+// Zipfian distribution of keys with the skew 1
+std::vector<unsigned> MakeZipfianTrace(bool with_scans) {
+  std::vector<double> cdf(kKeysCount);
+  double sum = 0;
+  for (unsigned i = 0; i < kKeysCount; ++i) {
+    sum += 1.0 / (i + 1);
+    cdf[i] = sum;
+  }
+
+  std::mt19937 gen{42};
+  std::uniform_real_distribution<double> dist{0, sum};
+  std::vector<unsigned> trace;
+  trace.reserve(kTraceSize);
+  unsigned next_scan_key = kKeysCount;
+  while (trace.size() < kTraceSize) {
+    if (with_scans && trace.size() % kScanPeriod == 0) {
+      // one-time keys, as in a full table scan
+      for (unsigned i = 0; i < kScanLength; ++i) {
+        trace.push_back(next_scan_key++);
+      }
+    }
+    const auto it = std::lower_bound(cdf.begin(), cdf.end(), dist(gen));
+    trace.push_back(static_cast<unsigned>(it - cdf.begin()));
+  }
+  return trace;
+}
+
 }  // namespace
 
 void LruPut(benchmark::State& state) {
@@ -51,4 +87,33 @@ void LruPutOverflow(benchmark::State& state) {
 }
 BENCHMARK(LruPutOverflow);
 
+// Arguments: policy, trace (0 - Zipfian, 1 - Zipfian with scans)
+void LruHitRate(benchmark::State& state) {
+  const auto policy = static_cast<cache::CachePolicy>(state.range(0));
+  const auto trace = MakeZipfianTrace(state.range(1));
+
+  std::size_t hits = 0;
+  std::size_t accesses = 0;
+  for (auto _ : state) {
+    Lru lru(kElementsCount, {}, {}, policy);
+    for (const auto key : trace) {
+      if (lru.Has(key)) {
+        ++hits;
+      } else {
+        lru.Put(key);
+      }
+    }
+    accesses += trace.size();
+    benchmark::DoNotOptimize(lru);
+  }
+  state.counters["hit_rate"] = static_cast<double>(hits) / accesses;
+  state.SetItemsProcessed(accesses);
+}
+BENCHMARK(LruHitRate)
+    ->Args({static_cast<int>(cache::CachePolicy::kLRU), 0})
+    ->Args({static_cast<int>(cache::CachePolicy::kWTinyLFU), 0})
+    ->Args({static_cast<int>(cache::CachePolicy::kLRU), 1})
+    ->Args({static_cast<int>(cache::CachePolicy::kWTinyLFU), 1})
+    ->Unit(benchmark::kMillisecond);
+
 USERVER_NAMESPACE_END
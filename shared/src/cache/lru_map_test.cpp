@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 
+#include <string>
 #include <type_traits>
 
 #include <userver/cache/lru_map.hpp>
@@ -169,4 +170,131 @@ TEST(Lru, GetLeastUsed) {
   EXPECT_EQ(*cache.GetLeastUsed(), 20);
 }
 
+namespace {
+
+constexpr int kHotKeys = 50;
+
+// Fills the cache with frequently used keys, then scans many cold keys through
+// it. Returns the number of hot keys that survived the scan.
+int HotKeysAfterScan(cache::CachePolicy policy) {
+  Lru cache(kHotKeys * 2, {}, {}, policy);
+  for (int round = 0; round < 10; ++round) {
+    for (int key = 0; key < kHotKeys; ++key) {
+      if (!cache.Get(key)) cache.Put(key, key);
+    }
+  }
+
+  for (int key = 1000; key < 1500; ++key) {
+    if (!cache.Get(key)) cache.Put(key, key);
+  }
+
+  int hits = 0;
+  for (int key = 0; key < kHotKeys; ++key) {
+    if (cache.Get(key)) ++hits;
+  }
+  return hits;
+}
+
+}  // namespace
+
+TEST(Lru, ScanResistance) {
+  EXPECT_EQ(HotKeysAfterScan(cache::CachePolicy::kLRU), 0);
+  EXPECT_GE(HotKeysAfterScan(cache::CachePolicy::kWTinyLFU), kHotKeys * 9 / 10);
+}
+
+TEST(Lru, WTinyLFUOverflow) {
+  Lru cache(10, {}, {}, cache::CachePolicy::kWTinyLFU);
+  for (int i = 0; i < 100; ++i) cache.Put(i, i);
+  EXPECT_EQ(cache.GetSize(), 10);
+
+  cache.SetMaxSize(3);
+  EXPECT_EQ(cache.GetSize(), 3);
+
+  cache.Clear();
+  EXPECT_EQ(cache.GetSize(), 0);
+  EXPECT_EQ(cache.GetLeastUsed(), nullptr);
+}
+
+TEST(Lru, SetPolicy) {
+  Lru cache(200);
+  for (int i = 0; i < 100; ++i) cache.Put(i, i);
+
+  cache.SetPolicy(cache::CachePolicy::kWTinyLFU);
+  EXPECT_EQ(cache.GetPolicy(), cache::CachePolicy::kWTinyLFU);
+  for (int i = 100; i < 200; ++i) cache.Put(i, i);
+  EXPECT_EQ(cache.GetSize(), 200);
+
+  cache.SetPolicy(cache::CachePolicy::kLRU);
+  EXPECT_EQ(cache.GetPolicy(), cache::CachePolicy::kLRU);
+  EXPECT_EQ(cache.GetSize(), 200);
+  for (int i = 0; i < 200; ++i) EXPECT_EQ(cache.GetOr(i, -1), i);
+
+  // plain LRU order is restored
+  cache.Put(200, 200);
+  EXPECT_EQ(cache.Get(0), nullptr);
+  EXPECT_EQ(*cache.GetLeastUsed(), 1);
+}
+
+namespace {
+
+struct Blob {
+  std::size_t size;
+};
+
+std::size_t GetCacheWeight(const Blob& blob) { return blob.size; }
+
+using WeightedLru = cache::LruMap<int, Blob>;
+
+}  // namespace
+
+TEST(Lru, MaxWeight) {
+  WeightedLru cache(100);
+  cache.SetMaxWeight(1000 + 10 * sizeof(int));
+  for (int i = 0; i < 10; ++i) cache.Put(i, Blob{100});
+  EXPECT_EQ(cache.GetSize(), 10);
+  EXPECT_EQ(cache.GetWeight(), 1000 + 10 * sizeof(int));
+  EXPECT_EQ(cache.GetEvictedWeight(), 0);
+
+  cache.Put(10, Blob{300});
+  EXPECT_EQ(cache.GetSize(), 8);
+  EXPECT_EQ(cache.Get(0), nullptr);
+  EXPECT_EQ(cache.Get(2), nullptr);
+  EXPECT_NE(cache.Get(3), nullptr);
+  EXPECT_EQ(cache.GetEvictedWeight(), 3 * (100 + sizeof(int)));
+
+  // updates are weighed too
+  cache.Put(10, Blob{100});
+  EXPECT_EQ(cache.GetWeight(), 800 + 8 * sizeof(int));
+
+  cache.SetMaxWeight(300);
+  EXPECT_LE(cache.GetWeight(), 300);
+  EXPECT_EQ(cache.GetSize(), 2);
+}
+
+TEST(Lru, MaxWeightHeavyItem) {
+  WeightedLru cache(100);
+  cache.SetMaxWeight(1000);
+  cache.Put(1, Blob{100});
+  cache.Put(2, Blob{5000});
+  EXPECT_EQ(cache.GetSize(), 1);
+  EXPECT_EQ(cache.Get(1), nullptr);
+  EXPECT_NE(cache.Get(2), nullptr);
+
+  cache.Clear();
+  EXPECT_EQ(cache.GetWeight(), 0);
+}
+
+TEST(Lru, MaxWeightEnabledLater) {
+  cache::LruMap<std::string, std::string> cache(100);
+  for (int i = 0; i < 10; ++i) {
+    cache.Put(std::to_string(i), std::string(1000, 'x'));
+  }
+  EXPECT_EQ(cache.GetWeight(), 0);
+
+  cache.SetMaxWeight(5000);
+  EXPECT_GT(cache.GetWeight(), 0);
+  EXPECT_LE(cache.GetWeight(), 5000);
+  EXPECT_EQ(cache.GetSize(), 4);
+}
+
 USERVER_NAMESPACE_END
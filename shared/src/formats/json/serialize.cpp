@@ -116,6 +116,58 @@ bool AcceptStable(const impl::Value& origin, Handler& handler) {
   }
 }
 
+// rapidjson input stream over a sequence of buffers
+class ChunksStream final {
+ public:
+  using Ch = char;
+
+  explicit ChunksStream(const std::vector<std::string_view>& chunks)
+      : chunks_(chunks) {
+    SkipEmptyChunks();
+  }
+
+  Ch Peek() const {
+    return chunk_ < chunks_.size() ? chunks_[chunk_][pos_] : '\0';
+  }
+
+  Ch Take() {
+    if (chunk_ >= chunks_.size()) return '\0';
+
+    const Ch c = chunks_[chunk_][pos_];
+    ++offset_;
+    if (++pos_ == chunks_[chunk_].size()) {
+      ++chunk_;
+      pos_ = 0;
+      SkipEmptyChunks();
+    }
+    return c;
+  }
+
+  std::size_t Tell() const { return offset_; }
+
+  // Not used by the reader, required by the rapidjson stream concept
+  Ch* PutBegin() {
+    UASSERT(false);
+    return nullptr;
+  }
+  void Put(Ch) { UASSERT(false); }
+  void Flush() { UASSERT(false); }
+  std::size_t PutEnd(Ch*) {
+    UASSERT(false);
+    return 0;
+  }
+
+ private:
+  void SkipEmptyChunks() {
+    while (chunk_ < chunks_.size() && chunks_[chunk_].empty()) ++chunk_;
+  }
+
+  const std::vector<std::string_view>& chunks_;
+  std::size_t chunk_{0};
+  std::size_t pos_{0};
+  std::size_t offset_{0};
+};
+
 }  // namespace
 
 Value FromString(std::string_view doc) {
@@ -164,6 +216,27 @@ Value FromStream(std::istream& is) {
   return Value{EnsureValid(std::move(json))};
 }
 
+Value FromStringChunks(const std::vector<std::string_view>& chunks) {
+  if (std::all_of(chunks.begin(), chunks.end(),
+                  [](std::string_view chunk) { return chunk.empty(); })) {
+    throw ParseException("JSON document is empty");
+  }
+
+  ChunksStream in{chunks};
+  impl::Document json{&g_allocator};
+  rapidjson::ParseResult ok =
+      json.ParseStream<rapidjson::kParseDefaultFlags |
+                       rapidjson::kParseIterativeFlag |
+                       rapidjson::kParseFullPrecisionFlag>(in);
+  if (!ok) {
+    throw ParseException(fmt::format("JSON parse error at offset {}: {}",
+                                     ok.Offset(),
+                                     rapidjson::GetParseError_En(ok.Code())));
+  }
+
+  return Value{EnsureValid(std::move(json))};
+}
+
 void Serialize(const Value& doc, std::ostream& os) {
   rapidjson::OStreamWrapper out{os};
   rapidjson::Writer writer(out);
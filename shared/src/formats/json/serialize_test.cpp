@@ -78,6 +78,26 @@ TEST(FormatsJson, ParseFromBadFile) {
   }
 }
 
+TEST(FormatsJson, FromStringChunks) {
+  using formats::json::FromStringChunks;
+  using ParseException = formats::json::Value::ParseException;
+
+  const std::string doc = R"({"key":["value",12.5,{"nested":true}]})";
+  std::vector<std::string_view> chunks;
+  for (std::size_t pos = 0; pos < doc.size(); pos += 3) {
+    chunks.push_back(std::string_view{doc}.substr(pos, 3));
+    chunks.emplace_back();
+  }
+
+  EXPECT_EQ(FromStringChunks(chunks), formats::json::FromString(doc));
+  EXPECT_EQ(FromStringChunks({doc}), formats::json::FromString(doc));
+
+  EXPECT_THROW(FromStringChunks({}), ParseException);
+  EXPECT_THROW(FromStringChunks({"", ""}), ParseException);
+  EXPECT_THROW(FromStringChunks({"{\"key\":", "}"}), ParseException);
+  EXPECT_THROW(FromStringChunks({"{\"a\":1,", "\"a\":2}"}), ParseException);
+}
+
 class FmtFormatterParameterized : public testing::TestWithParam<std::string> {};
 
 TEST_P(FmtFormatterParameterized, FormatsJsonFmt) {
@@ -0,0 +1,123 @@
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <boost/program_options.hpp>
+
+#include <userver/logging/binary_format.hpp>
+
+#include <userver/utest/using_namespace_userver.hpp>
+
+namespace {
+
+struct Config {
+  std::string format = "tskv";
+  std::string input;
+  size_t buffer_size = 1024 * 1024;
+};
+
+Config ParseConfig(int argc, char** argv) {
+  namespace po = boost::program_options;
+
+  Config config;
+  po::options_description desc("Converts the logs written by the 'binary' "
+                               "format loggers to text.\nAllowed options");
+  desc.add_options()("help,h", "produce help message")(
+      "format,f", po::value(&config.format)->default_value(config.format),
+      "output format (tskv, json)")(
+      "input,i", po::value(&config.input),
+      "binary log filename (stdin by default)")(
+      "buffer,b",
+      po::value(&config.buffer_size)->default_value(config.buffer_size),
+      "read buffer size");
+
+  po::positional_options_description positional;
+  positional.add("input", 1);
+
+  po::variables_map vm;
+  try {
+    po::store(po::command_line_parser(argc, argv)
+                  .options(desc)
+                  .positional(positional)
+                  .run(),
+              vm);
+    po::notify(vm);
+  } catch (const std::exception& ex) {
+    std::cerr << "Cannot parse command line: " << ex.what() << '\n';
+    exit(1);
+  }
+
+  if (vm.count("help")) {
+    std::cout << desc << '\n';
+    exit(0);
+  }
+
+  if (config.format != "tskv" && config.format != "json") {
+    std::cerr << "Unknown output format '" << config.format
+              << "' (must be one of 'tskv', 'json')\n";
+    exit(1);
+  }
+
+  return config;
+}
+
+void Convert(std::istream& input, const Config& config) {
+  const auto format_record = config.format == "json"
+                                 ? &logging::binary::FormatAsJson
+                                 : &logging::binary::FormatAsTskv;
+
+  std::vector<char> buffer(config.buffer_size);
+  std::size_t buffered = 0;
+  logging::binary::Record record;
+  std::string line;
+
+  while (input) {
+    if (buffered == buffer.size()) {
+      // a record larger than the buffer
+      buffer.resize(buffer.size() * 2);
+    }
+    input.read(buffer.data() + buffered, buffer.size() - buffered);
+    buffered += input.gcount();
+
+    std::string_view data{buffer.data(), buffered};
+    while (logging::binary::ReadRecord(data, record)) {
+      line.clear();
+      format_record(record, line);
+      line.push_back('\n');
+      std::cout << line;
+    }
+
+    std::copy(data.begin(), data.end(), buffer.begin());
+    buffered = data.size();
+  }
+
+  if (buffered != 0) {
+    std::cerr << "Ignored " << buffered
+              << " bytes of the incomplete last record\n";
+  }
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  const auto config = ParseConfig(argc, argv);
+
+  try {
+    if (config.input.empty()) {
+      Convert(std::cin, config);
+    } else {
+      std::ifstream file(config.input, std::ios::binary);
+      if (!file) {
+        std::cerr << "Cannot open '" << config.input << "'\n";
+        return 1;
+      }
+      Convert(file, config);
+    }
+  } catch (const logging::binary::ParseError& ex) {
+    std::cerr << "Malformed binary log: " << ex.what() << '\n';
+    return 1;
+  }
+}